@@ -22,6 +22,7 @@
 
 #include <cstdint>
 #include <vector>
+#include <utility>
 #include <stdexcept>
 #include <initializer_list>
 #include <libFoundation/stream/expectation.hpp>
@@ -35,6 +36,7 @@ namespace foundation
     public:
         stream() = default;
         explicit stream(const std::vector<T>& items) : m_items(items) {}
+        explicit stream(std::vector<T>&& items) : m_items(std::move(items)) {}
         stream(const std::initializer_list<T>& items) : m_items(items) {}
 
         // Accessors
@@ -76,6 +76,14 @@ auto foundation::filesystem::file::string_contents() const -> const std::string&
     return m_cache.string_contents;
 }
 
+auto foundation::filesystem::file::contents() const -> std::string_view
+{
+    if (!m_raw) {
+        return {};
+    }
+    return { reinterpret_cast<const char *>(m_raw), static_cast<std::size_t>(m_length) };
+}
+
 auto foundation::filesystem::file::characters() const -> std::vector<char>
 {
     std::vector<char> v(m_raw, m_raw + m_length);
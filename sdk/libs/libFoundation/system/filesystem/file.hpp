@@ -21,6 +21,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <optional>
@@ -81,6 +82,13 @@ namespace foundation::filesystem
          */
         [[nodiscard]] auto string_contents() const -> const std::string&;
 
+        /**
+         * The contents of the file as a view onto the loaded buffer, without copying it.
+         * @note    The view is invalidated if the contents of the file are replaced.
+         * @return  Returns a view of the contents of the file.
+         */
+        [[nodiscard]] auto contents() const -> std::string_view;
+
         /**
          * The contents of the file as a vector of characters.
          * @return  Returns the contents of the file as a vector of characters.
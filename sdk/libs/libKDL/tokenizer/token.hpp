@@ -34,7 +34,7 @@ namespace kdl::tokenizer
         token(token_type type = error) : m_type(type) {}
 
         token(const lexer::lexeme& lx, token_type type)
-            : m_source(lx), m_value(lx.text()), m_type(type)
+            : m_source(lx), m_type(type)
         {}
 
         token(const lexer::lexeme& lx, const resource::reference& ref)
@@ -50,7 +50,7 @@ namespace kdl::tokenizer
         {}
 
         token(const std::string& str, token_type type)
-            : m_source(lexer::lexeme(str, lexer::identifier)), m_value(str), m_type(type)
+            : m_source(lexer::lexeme(str, lexer::identifier)), m_type(type)
         {};
 
         // MARK: - Look Ups
@@ -70,7 +70,7 @@ namespace kdl::tokenizer
         [[nodiscard]] auto string_value() const -> std::string
         {
             if (m_value.index() == value_lut::string) {
-                return std::get<std::string>(m_value);
+                return m_source.text();
             }
             else if (m_value.index() == value_lut::values) {
                 return std::get<std::vector<lexer::lexeme>>(m_value).back().text();
@@ -81,7 +81,7 @@ namespace kdl::tokenizer
         [[nodiscard]] auto path_value(const std::string& delimiter = "/") const -> std::string
         {
             if (m_value.index() == value_lut::string) {
-                return std::get<std::string>(m_value);
+                return m_source.text();
             }
             else if (m_value.index() == value_lut::values) {
                 std::string out;
@@ -128,13 +128,16 @@ namespace kdl::tokenizer
 
         [[nodiscard]] auto is(const std::string& value) const -> bool
         {
+            if (m_value.index() == value_lut::string) {
+                return m_source.view() == value;
+            }
             return string_value() == value;
         }
 
         [[nodiscard]] auto is(const std::vector<std::string>& options) const -> bool
         {
             for (const auto& str : options) {
-                if (string_value() == str) {
+                if (is(str)) {
                     return true;
                 }
             }
@@ -165,8 +168,9 @@ namespace kdl::tokenizer
     private:
         enum value_lut { string, size, reference, values };
 
+        // The string value of a token is the text of its source lexeme, so it is not stored separately.
         token_type m_type;
-        lexer::lexeme m_source { 0 };
-        std::variant<std::string, std::size_t, resource::reference, std::vector<lexer::lexeme>> m_value;
+        lexer::lexeme m_source;
+        std::variant<std::monostate, std::size_t, resource::reference, std::vector<lexer::lexeme>> m_value;
     };
 }
\ No newline at end of file
@@ -37,6 +37,10 @@ kdl::tokenizer::tokenizer::tokenizer(const foundation::stream<lexer::lexeme> &in
     : m_input(input)
 {}
 
+kdl::tokenizer::tokenizer::tokenizer(foundation::stream<lexer::lexeme>&& input)
+    : m_input(std::move(input))
+{}
+
 // MARK: - Helper
 
 static auto inline is_hex(char c) -> bool
@@ -46,8 +50,9 @@ static auto inline is_hex(char c) -> bool
 
 static auto inline is_fixed_cstr(const lexer::lexeme& lx) -> bool
 {
-    if (lx.text().size() == 4 && lx.text().starts_with('C')) {
-        return is_hex(lx.text()[1]) && is_hex(lx.text()[2]) && is_hex(lx.text()[3]);
+    auto text = lx.view();
+    if (text.size() == 4 && text.starts_with('C')) {
+        return is_hex(text[1]) && is_hex(text[2]) && is_hex(text[3]);
     }
     return false;
 }
@@ -30,6 +30,7 @@ namespace kdl::tokenizer
     {
     public:
         explicit tokenizer(const foundation::stream<lexer::lexeme>& input);
+        explicit tokenizer(foundation::stream<lexer::lexeme>&& input);
 
         auto process() -> foundation::stream<token>;
 
@@ -29,16 +29,20 @@
 
 // MARK: - Construction
 
-kdl::unit::file::file(sema::context& ctx)
+kdl::unit::file::file(sema::context& ctx, bool import_config_files)
     : m_context(&ctx)
 {
-    find_config_files({});
+    if (import_config_files) {
+        find_config_files({});
+    }
 }
 
-kdl::unit::file::file(resource_core::file& output, sema::context& ctx)
+kdl::unit::file::file(resource_core::file& output, sema::context& ctx, bool import_config_files)
     : m_output(&output), m_context(&ctx)
 {
-    find_config_files({});
+    if (import_config_files) {
+        find_config_files({});
+    }
 }
 
 // MARK: - Config Files
@@ -104,8 +108,7 @@ auto kdl::unit::file::import_and_tokenize_file(const std::string &path, const st
 
     // We now have a successfully imported textual file. Perform lexical
     // analysis upon it, and then pass it to the tokenizer.
-    auto lexical_result = lexer::lexer(file).analyze();
-    return tokenizer::tokenizer(lexical_result).process();
+    return tokenizer::tokenizer(lexer::lexer(file).analyze()).process();
 }
 
 auto kdl::unit::file::import_file(const std::string &path, const std::vector<std::string>& definitions) -> void
@@ -123,20 +126,31 @@ auto kdl::unit::file::import_file(const foundation::filesystem::path& path, cons
 
     // We now have a successfully imported textual file. Perform lexical
     // analysis upon it, and then pass it to the tokenizer.
-    auto lexical_result = lexer::lexer(file).analyze();
-    auto token_stream = tokenizer::tokenizer(lexical_result).process();
+    auto token_stream = tokenizer::tokenizer(lexer::lexer(file).analyze()).process();
 
     // Now that we have a token stream, we are ready to begin semantic analysis
     sema::analyser(token_stream, definitions).process(*m_context);
 
     // Using the result of the analysis, we now need to encode each of the resources
-    // that have been generated.
+    // that have been generated by this file.
+    emit_resources(definitions);
+}
+
+// MARK: - Resource Emission
+
+auto kdl::unit::file::emit_resources(const std::vector<std::string>& definitions) -> void
+{
     if (!m_output) {
         // There is no output file, therefore we do not need to generate resources.
         return;
     }
 
-    for (const auto& instance : m_context->resources) {
+    // The context accumulates resources across every file imported into it, so only
+    // the resources appended since the last emission need to be encoded. Everything
+    // before m_emitted_resources has already been added to the output file.
+    for (; m_emitted_resources < m_context->resources.size(); ++m_emitted_resources) {
+        const auto& instance = m_context->resources[m_emitted_resources];
+
         // Make sure the resource reference has a type name. If there is no type name,
         // then this can not be considered valid.
         const auto& ref = instance.reference();
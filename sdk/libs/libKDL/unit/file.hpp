@@ -33,8 +33,12 @@ namespace kdl::unit
     struct file
     {
     public:
-        explicit file(sema::context& ctx);
-        explicit file(resource_core::file& output, sema::context& ctx);
+        /**
+         * Construct a new unit. Unless disabled, the user and Homebrew configuration files are imported
+         * into the context first.
+         */
+        explicit file(sema::context& ctx, bool import_config_files = true);
+        explicit file(resource_core::file& output, sema::context& ctx, bool import_config_files = true);
         auto import_file(const std::string& path, const std::vector<std::string>& definitions) -> void;
         auto import_file(const foundation::filesystem::path& path, const std::vector<std::string>& definitions) -> void;
 
@@ -43,9 +47,11 @@ namespace kdl::unit
     private:
         auto find_config_files(const std::vector<std::string>& definitions) -> void;
         auto import_config_file(const foundation::filesystem::path& path, const std::vector<std::string>& definitions) -> void;
+        auto emit_resources(const std::vector<std::string>& definitions) -> void;
 
     private:
         resource_core::file *m_output { nullptr };
         sema::context *m_context { nullptr };
+        std::size_t m_emitted_resources { 0 };
     };
 }
\ No newline at end of file
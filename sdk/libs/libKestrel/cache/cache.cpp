@@ -22,32 +22,21 @@
 
 // MARK: - Storage
 
-static std::vector<std::tuple<kestrel::resource::key, kestrel::rtc::clock::time, std::any>> s_cache_assets;
+static kestrel::cache::lru_cache<kestrel::resource::key, std::any, kestrel::resource::key::hasher> s_cache_assets {
+    kestrel::cache::default_budget
+};
 
 // MARK: - Caching Functions
 
-auto kestrel::cache::add(const resource::descriptor::lua_reference &ref, const std::any &asset) -> void
+auto kestrel::cache::add(const resource::descriptor::lua_reference &ref, const std::any &asset, std::size_t cost) -> void
 {
-    resource::key key(*ref.get());
-    for (auto& it : s_cache_assets) {
-        if (std::get<0>(it) == key) {
-            std::get<2>(it) = asset;
-            std::get<1>(it) = rtc::clock::global().current();
-            return;
-        }
-    }
-
-    s_cache_assets.emplace(s_cache_assets.begin(), key, rtc::clock::global().current(), asset);
+    s_cache_assets.insert(resource::key(*ref.get()), asset, cost, rtc::clock::global().current());
 }
 
 auto kestrel::cache::fetch(const resource::descriptor::lua_reference &ref) -> std::optional<std::any>
 {
-    resource::key key(*ref.get());
-    for (auto& it : s_cache_assets) {
-        if (std::get<0>(it) == key) {
-            std::get<1>(it) = rtc::clock::global().current();
-            return std::get<2>(it);
-        }
+    if (auto asset = s_cache_assets.fetch(resource::key(*ref.get()), rtc::clock::global().current())) {
+        return *asset;
     }
     return {};
 }
@@ -61,12 +50,28 @@ auto kestrel::cache::purge_all() -> void
 
 auto kestrel::cache::purge_unused() -> void
 {
-    const auto death_interval = 2.0 * 60.0; // 2 Minutes
-    for (auto it = s_cache_assets.begin(); it != s_cache_assets.end(); ++it) {
-        if (rtc::clock::global().since(std::get<1>(*it)).count() >= death_interval) {
-            s_cache_assets.erase(it);
-        }
-    }
+    const auto death_interval = std::chrono::minutes(2);
+    s_cache_assets.evict_unused_since(rtc::clock::global().current() - death_interval);
+}
+
+// MARK: - Budget & Statistics
+
+auto kestrel::cache::budget() -> std::size_t
+{
+    return s_cache_assets.budget();
 }
 
+auto kestrel::cache::set_budget(std::size_t bytes) -> void
+{
+    s_cache_assets.set_budget(bytes);
+}
 
+auto kestrel::cache::stats() -> statistics
+{
+    return s_cache_assets.stats();
+}
+
+auto kestrel::cache::reset_statistics() -> void
+{
+    s_cache_assets.reset_statistics();
+}
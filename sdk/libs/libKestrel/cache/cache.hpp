@@ -28,6 +28,7 @@
 #include <libKestrel/resource/descriptor.hpp>
 #include <libKestrel/resource/key.hpp>
 #include <libKestrel/clock/clock.hpp>
+#include <libKestrel/cache/lru_cache.hpp>
 
 /**
  * The `kestrel::cache` namespace encapsulates functionality related to caching resource assets and data,
@@ -36,11 +37,23 @@
 namespace kestrel::cache
 {
     /**
-     * Add the specified asset to the cache using the specified reference as an identifier.
+     * The default memory budget of the asset cache, in bytes.
+     */
+    constexpr std::size_t default_budget = 256 * 1024 * 1024;
+
+    /**
+     * The estimated size of an asset, in bytes, when the caller does not provide one.
+     */
+    constexpr std::size_t default_asset_cost = 4 * 1024;
+
+    /**
+     * Add the specified asset to the cache using the specified reference as an identifier. If adding the asset
+     * takes the cache over its memory budget, then the least recently used assets are evicted.
      * @param ref   The `resource::descriptor` that identifies the asset.
      * @param asset The asset to cache.
+     * @param cost  The estimated size of the asset in bytes.
      */
-    auto add(const resource::descriptor::lua_reference& ref, const std::any& asset) -> void;
+    auto add(const resource::descriptor::lua_reference& ref, const std::any& asset, std::size_t cost = default_asset_cost) -> void;
 
     /**
      * Fetch the asset for the specified `resource::descriptor` if it exists.
@@ -58,4 +71,25 @@ namespace kestrel::cache
      * Remove all assets from the cache that have not been accessed for at least 2 minutes.
      */
     auto purge_unused() -> void;
+
+    /**
+     * The memory budget of the cache in bytes.
+     */
+    auto budget() -> std::size_t;
+
+    /**
+     * Set the memory budget of the cache in bytes, evicting the least recently used assets if the cache is
+     * currently over the new budget.
+     */
+    auto set_budget(std::size_t bytes) -> void;
+
+    /**
+     * The hit, miss and eviction counts of the cache, along with its current size.
+     */
+    auto stats() -> statistics;
+
+    /**
+     * Reset the hit, miss and eviction counts of the cache.
+     */
+    auto reset_statistics() -> void;
 }
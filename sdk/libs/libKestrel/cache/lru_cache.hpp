@@ -0,0 +1,233 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <list>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <libKestrel/clock/clock.hpp>
+
+namespace kestrel::cache
+{
+    /**
+     * Counters describing the behaviour of a cache since it was created, or since its statistics were last reset.
+     */
+    struct statistics
+    {
+        std::uint64_t hits { 0 };
+        std::uint64_t misses { 0 };
+        std::uint64_t evictions { 0 };
+        std::uint64_t evicted_bytes { 0 };
+        std::size_t entries { 0 };
+        std::size_t bytes { 0 };
+        std::size_t budget { 0 };
+
+        [[nodiscard]] auto lookups() const -> std::uint64_t
+        {
+            return hits + misses;
+        }
+
+        [[nodiscard]] auto hit_rate() const -> double
+        {
+            return lookups() > 0 ? static_cast<double>(hits) / static_cast<double>(lookups()) : 0.0;
+        }
+
+        [[nodiscard]] auto miss_rate() const -> double
+        {
+            return lookups() > 0 ? static_cast<double>(misses) / static_cast<double>(lookups()) : 0.0;
+        }
+    };
+
+    /**
+     * A hash indexed, least recently used cache that is bounded by an estimated size in bytes.
+     *
+     * Entries are held in a list ordered by access, most recent first, and indexed by the hash of their key.
+     * Keys that share a hash are compared with the equality functor, which is not required to be transitive,
+     * matching the behaviour of `resource::key`. Once the total cost of the entries exceeds the budget, the least
+     * recently used entries are evicted. The most recently inserted entry is always retained.
+     */
+    template<typename K, typename V, typename H = std::hash<K>, typename E = std::equal_to<K>>
+    class lru_cache
+    {
+    public:
+        typedef rtc::clock::time time;
+
+        explicit lru_cache(std::size_t budget)
+            : m_budget(budget)
+        {}
+
+        [[nodiscard]] auto budget() const -> std::size_t
+        {
+            return m_budget;
+        }
+
+        auto set_budget(std::size_t budget) -> void
+        {
+            m_budget = budget;
+            evict_to_budget();
+        }
+
+        [[nodiscard]] auto size() const -> std::size_t
+        {
+            return m_entries.size();
+        }
+
+        [[nodiscard]] auto bytes() const -> std::size_t
+        {
+            return m_bytes;
+        }
+
+        [[nodiscard]] auto stats() const -> statistics
+        {
+            auto result = m_stats;
+            result.entries = m_entries.size();
+            result.bytes = m_bytes;
+            result.budget = m_budget;
+            return result;
+        }
+
+        auto reset_statistics() -> void
+        {
+            m_stats = {};
+        }
+
+        auto insert(const K& key, const V& value, std::size_t cost, time now) -> void
+        {
+            const auto hash = m_hasher(key);
+            auto it = find(key, hash);
+
+            if (it != m_entries.end()) {
+                m_bytes -= it->cost;
+                it->value = value;
+                it->cost = cost;
+                it->last_access = now;
+                m_entries.splice(m_entries.begin(), m_entries, it);
+            }
+            else {
+                m_entries.push_front({ key, value, cost, now, hash });
+                m_index[hash].emplace_back(m_entries.begin());
+            }
+
+            m_bytes += cost;
+            evict_to_budget();
+        }
+
+        /**
+         * Lookup the value for the specified key, marking it as the most recently used entry.
+         * @return  A pointer to the cached value, which remains valid until the cache is next modified, or
+         *          `nullptr` if the key is not in the cache.
+         */
+        auto fetch(const K& key, time now) -> const V *
+        {
+            auto it = find(key, m_hasher(key));
+            if (it == m_entries.end()) {
+                ++m_stats.misses;
+                return nullptr;
+            }
+
+            ++m_stats.hits;
+            it->last_access = now;
+            m_entries.splice(m_entries.begin(), m_entries, it);
+            return &it->value;
+        }
+
+        /**
+         * Evict all entries that have not been accessed since the specified time.
+         */
+        auto evict_unused_since(time cutoff) -> void
+        {
+            // Entries are ordered by access, so the stale entries are all at the back of the list.
+            while (!m_entries.empty() && m_entries.back().last_access <= cutoff) {
+                evict(std::prev(m_entries.end()));
+            }
+        }
+
+        auto clear() -> void
+        {
+            m_entries.clear();
+            m_index.clear();
+            m_bytes = 0;
+        }
+
+    private:
+        struct entry
+        {
+            K key;
+            V value;
+            std::size_t cost;
+            time last_access;
+            std::size_t hash;
+        };
+
+        typedef typename std::list<entry>::iterator entry_iterator;
+
+        std::size_t m_budget { 0 };
+        std::size_t m_bytes { 0 };
+        statistics m_stats;
+        std::list<entry> m_entries;
+        std::unordered_map<std::size_t, std::vector<entry_iterator>> m_index;
+        H m_hasher;
+        E m_equal;
+
+        auto find(const K& key, std::size_t hash) -> entry_iterator
+        {
+            auto bucket = m_index.find(hash);
+            if (bucket != m_index.end()) {
+                for (auto it : bucket->second) {
+                    if (m_equal(it->key, key)) {
+                        return it;
+                    }
+                }
+            }
+            return m_entries.end();
+        }
+
+        auto evict(entry_iterator it) -> void
+        {
+            auto& bucket = m_index[it->hash];
+            for (auto& candidate : bucket) {
+                if (candidate == it) {
+                    candidate = bucket.back();
+                    bucket.pop_back();
+                    break;
+                }
+            }
+
+            if (bucket.empty()) {
+                m_index.erase(it->hash);
+            }
+
+            ++m_stats.evictions;
+            m_stats.evicted_bytes += it->cost;
+            m_bytes -= it->cost;
+            m_entries.erase(it);
+        }
+
+        auto evict_to_budget() -> void
+        {
+            while (m_bytes > m_budget && m_entries.size() > 1) {
+                evict(std::prev(m_entries.end()));
+            }
+        }
+    };
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <libKestrel/cache/lua_api.hpp>
+#include <libKestrel/cache/cache.hpp>
+
+// MARK: - API
+
+auto kestrel::cache::lua::api::hits() -> std::uint64_t
+{
+    return cache::stats().hits;
+}
+
+auto kestrel::cache::lua::api::misses() -> std::uint64_t
+{
+    return cache::stats().misses;
+}
+
+auto kestrel::cache::lua::api::hit_rate() -> double
+{
+    return cache::stats().hit_rate();
+}
+
+auto kestrel::cache::lua::api::miss_rate() -> double
+{
+    return cache::stats().miss_rate();
+}
+
+auto kestrel::cache::lua::api::evictions() -> std::uint64_t
+{
+    return cache::stats().evictions;
+}
+
+auto kestrel::cache::lua::api::evicted_bytes() -> std::uint64_t
+{
+    return cache::stats().evicted_bytes;
+}
+
+auto kestrel::cache::lua::api::entry_count() -> std::size_t
+{
+    return cache::stats().entries;
+}
+
+auto kestrel::cache::lua::api::bytes_in_use() -> std::size_t
+{
+    return cache::stats().bytes;
+}
+
+auto kestrel::cache::lua::api::budget() -> std::size_t
+{
+    return cache::budget();
+}
+
+auto kestrel::cache::lua::api::set_budget(std::size_t bytes) -> void
+{
+    cache::set_budget(bytes);
+}
+
+auto kestrel::cache::lua::api::reset_statistics() -> void
+{
+    cache::reset_statistics();
+}
@@ -0,0 +1,44 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <libKestrel/lua/runtime/runtime.hpp>
+#include <libKestrel/lua/scripting.hpp>
+
+namespace kestrel::cache::lua
+{
+    namespace lua_api(AssetCache, Available_0_9) api
+    {
+        has_lua_api;
+
+        lua_getter(hits, Available_0_9) auto hits() -> std::uint64_t;
+        lua_getter(misses, Available_0_9) auto misses() -> std::uint64_t;
+        lua_getter(hitRate, Available_0_9) auto hit_rate() -> double;
+        lua_getter(missRate, Available_0_9) auto miss_rate() -> double;
+        lua_getter(evictions, Available_0_9) auto evictions() -> std::uint64_t;
+        lua_getter(evictedBytes, Available_0_9) auto evicted_bytes() -> std::uint64_t;
+        lua_getter(entryCount, Available_0_9) auto entry_count() -> std::size_t;
+        lua_getter(bytesInUse, Available_0_9) auto bytes_in_use() -> std::size_t;
+        lua_getter(budget, Available_0_9) auto budget() -> std::size_t;
+        lua_function(setBudget, Available_0_9) auto set_budget(std::size_t bytes) -> void;
+        lua_function(resetStatistics, Available_0_9) auto reset_statistics() -> void;
+    }
+}
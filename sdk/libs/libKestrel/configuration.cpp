@@ -46,6 +46,16 @@ kestrel::configuration::configuration(const int argc, const char **argv)
         else if (option == "--openal") {
             audio.desired_api = sound::api::openal;
         }
+        else if (option == "--no-audio") {
+            audio.desired_api = sound::api::null;
+        }
+        else if (option == "--software-audio") {
+            audio.desired_api = sound::api::software;
+        }
+        else if (option == "--audio-wav") {
+            audio.desired_api = sound::api::software;
+            audio.output_path = argv[++n];
+        }
         else if (option == "--opengl") {
             renderer.desired_api = renderer::api::opengl;
         }
@@ -64,6 +74,9 @@ kestrel::configuration::configuration(const int argc, const char **argv)
         else if (option == "--fonts") {
             data_files.fonts = argv[++n];
         }
+        else if (option == "--script-cache") {
+            scripting.chunk_cache_directory = argv[++n];
+        }
         else {
             unparsed_options.emplace_back(option);
         }
@@ -67,6 +67,7 @@ namespace kestrel
                 sound::api::openal
 #endif
             };
+            std::string output_path;
         } audio;
 
         struct {
@@ -78,5 +79,9 @@ namespace kestrel
             std::vector<std::string> recognized_extensions { "rsrc", "rsrx" };
             bool include_dot_files { false };
         } data_files;
+
+        struct {
+            std::string chunk_cache_directory;
+        } scripting;
     };
 }
\ No newline at end of file
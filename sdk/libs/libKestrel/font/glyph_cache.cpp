@@ -0,0 +1,136 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cstring>
+#include <libKestrel/font/glyph_cache.hpp>
+
+// MARK: - Hashing
+
+auto kestrel::font::glyph_cache::key::hasher::operator()(const key &k) const -> std::size_t
+{
+    auto hash = static_cast<std::size_t>(k.face);
+    hash ^= static_cast<std::size_t>(k.size) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= static_cast<std::size_t>(k.dpi) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= static_cast<std::size_t>(k.glyph) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+// MARK: - Construction
+
+kestrel::font::glyph_cache::glyph_cache(std::uint32_t atlas_width, std::uint32_t atlas_height)
+    : m_atlas_width(atlas_width), m_atlas_height(atlas_height), m_atlas(static_cast<std::size_t>(atlas_width) * atlas_height, 0)
+{
+}
+
+auto kestrel::font::glyph_cache::shared_cache() -> glyph_cache&
+{
+    static glyph_cache cache;
+    return cache;
+}
+
+// MARK: - Lookup
+
+auto kestrel::font::glyph_cache::find(const key &k) -> const glyph *
+{
+    auto it = m_glyphs.find(k);
+    if (it == m_glyphs.end()) {
+        m_stats.misses++;
+        return nullptr;
+    }
+    m_stats.hits++;
+    return &it->second;
+}
+
+auto kestrel::font::glyph_cache::insert(const key &k, const bitmap &bmp) -> const glyph *
+{
+    if (bmp.width + padding > m_atlas_width || bmp.rows + padding > m_atlas_height) {
+        return nullptr;
+    }
+
+    glyph entry;
+    entry.left = bmp.left;
+    entry.top = bmp.top;
+    entry.width = bmp.width;
+    entry.rows = bmp.rows;
+
+    if (!allocate(bmp.width, bmp.rows, entry.atlas_x, entry.atlas_y)) {
+        // The atlas is full, so start again with an empty atlas. The glyphs in use will be rasterised again as they
+        // are next needed.
+        clear();
+        m_stats.atlas_resets++;
+        allocate(bmp.width, bmp.rows, entry.atlas_x, entry.atlas_y);
+    }
+
+    for (std::uint32_t row = 0; row < bmp.rows; ++row) {
+        auto dst = m_atlas.data() + (static_cast<std::size_t>(entry.atlas_y + row) * m_atlas_width) + entry.atlas_x;
+        std::memcpy(dst, bmp.coverage + (static_cast<std::ptrdiff_t>(row) * bmp.pitch), bmp.width);
+    }
+
+    return &(m_glyphs[k] = entry);
+}
+
+auto kestrel::font::glyph_cache::coverage(const glyph &g) const -> const std::uint8_t *
+{
+    return m_atlas.data() + (static_cast<std::size_t>(g.atlas_y) * m_atlas_width) + g.atlas_x;
+}
+
+// MARK: - Atlas
+
+auto kestrel::font::glyph_cache::allocate(std::uint32_t width, std::uint32_t height, std::uint32_t &x, std::uint32_t &y) -> bool
+{
+    if (m_shelf_x + width + padding > m_atlas_width) {
+        m_shelf_y += m_shelf_height;
+        m_shelf_x = 0;
+        m_shelf_height = 0;
+    }
+
+    if (m_shelf_y + height + padding > m_atlas_height) {
+        return false;
+    }
+
+    x = m_shelf_x;
+    y = m_shelf_y;
+    m_shelf_x += width + padding;
+    m_shelf_height = std::max(m_shelf_height, height + padding);
+    return true;
+}
+
+auto kestrel::font::glyph_cache::clear() -> void
+{
+    m_glyphs.clear();
+    m_shelf_x = 0;
+    m_shelf_y = 0;
+    m_shelf_height = 0;
+}
+
+// MARK: - Statistics
+
+auto kestrel::font::glyph_cache::stats() const -> statistics
+{
+    auto stats = m_stats;
+    stats.entries = m_glyphs.size();
+    return stats;
+}
+
+auto kestrel::font::glyph_cache::reset_statistics() -> void
+{
+    m_stats = {};
+}
@@ -0,0 +1,137 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+namespace kestrel::font
+{
+    /**
+     * Caches rasterised glyph coverage for each face, size and resolution, so that repeated text only costs a
+     * lookup and a blit. Coverage is packed into a single shared 8-bit atlas using a shelf allocator. When the atlas
+     * is full it is reset and refilled, which invalidates any glyphs previously returned by the cache.
+     */
+    class glyph_cache
+    {
+    public:
+        struct key
+        {
+            std::uint64_t face { 0 };
+            std::uint32_t size { 0 };
+            std::uint32_t dpi { 0 };
+            std::uint32_t glyph { 0 };
+
+            auto operator==(const key& rhs) const -> bool = default;
+
+            struct hasher
+            {
+                auto operator()(const key& k) const -> std::size_t;
+            };
+        };
+
+        /**
+         * Rasterised coverage for a glyph, as produced by FreeType, along with its bearings.
+         */
+        struct bitmap
+        {
+            std::int32_t left { 0 };
+            std::int32_t top { 0 };
+            std::uint32_t width { 0 };
+            std::uint32_t rows { 0 };
+            std::int32_t pitch { 0 };
+            const std::uint8_t *coverage { nullptr };
+        };
+
+        struct glyph
+        {
+            std::int32_t left { 0 };
+            std::int32_t top { 0 };
+            std::uint32_t width { 0 };
+            std::uint32_t rows { 0 };
+            std::uint32_t atlas_x { 0 };
+            std::uint32_t atlas_y { 0 };
+        };
+
+        struct statistics
+        {
+            std::uint64_t hits { 0 };
+            std::uint64_t misses { 0 };
+            std::uint64_t atlas_resets { 0 };
+            std::size_t entries { 0 };
+
+            [[nodiscard]] auto lookups() const -> std::uint64_t
+            {
+                return hits + misses;
+            }
+
+            [[nodiscard]] auto hit_rate() const -> double
+            {
+                return lookups() > 0 ? static_cast<double>(hits) / static_cast<double>(lookups()) : 0.0;
+            }
+        };
+
+        static constexpr std::uint32_t default_atlas_size { 1024 };
+
+        explicit glyph_cache(std::uint32_t atlas_width = default_atlas_size, std::uint32_t atlas_height = default_atlas_size);
+
+        static auto shared_cache() -> glyph_cache&;
+
+        /**
+         * Find a previously rasterised glyph, counting the lookup as a hit or a miss.
+         */
+        auto find(const key& k) -> const glyph *;
+
+        /**
+         * Copy the coverage of a rasterised glyph into the atlas. Returns null if the glyph can never fit in the atlas.
+         */
+        auto insert(const key& k, const bitmap& bmp) -> const glyph *;
+
+        /**
+         * The first row of the coverage of a glyph. Rows are `atlas_width()` bytes apart.
+         */
+        [[nodiscard]] auto coverage(const glyph& g) const -> const std::uint8_t *;
+
+        [[nodiscard]] inline auto atlas_width() const -> std::uint32_t { return m_atlas_width; }
+        [[nodiscard]] inline auto atlas_height() const -> std::uint32_t { return m_atlas_height; }
+        [[nodiscard]] inline auto atlas_data() const -> const std::uint8_t * { return m_atlas.data(); }
+
+        [[nodiscard]] auto stats() const -> statistics;
+        auto reset_statistics() -> void;
+        auto clear() -> void;
+
+    private:
+        auto allocate(std::uint32_t width, std::uint32_t height, std::uint32_t& x, std::uint32_t& y) -> bool;
+
+    private:
+        static constexpr std::uint32_t padding { 1 };
+
+        std::uint32_t m_atlas_width { 0 };
+        std::uint32_t m_atlas_height { 0 };
+        std::vector<std::uint8_t> m_atlas;
+        std::uint32_t m_shelf_x { 0 };
+        std::uint32_t m_shelf_y { 0 };
+        std::uint32_t m_shelf_height { 0 };
+        std::unordered_map<key, glyph, key::hasher> m_glyphs;
+        statistics m_stats;
+    };
+}
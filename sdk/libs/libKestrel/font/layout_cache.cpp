@@ -0,0 +1,88 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <libKestrel/font/layout_cache.hpp>
+#include <libKestrel/clock/clock.hpp>
+
+// MARK: - Keys
+
+auto kestrel::font::layout_key::same_setting(const layout_key &rhs) const -> bool
+{
+    return face == rhs.face && size == rhs.size && dpi == rhs.dpi && max_width == rhs.max_width && max_height == rhs.max_height;
+}
+
+auto kestrel::font::layout_key::hasher::operator()(const layout_key &key) const -> std::size_t
+{
+    auto hash = std::hash<std::wstring>()(key.text);
+    hash ^= static_cast<std::size_t>(key.face) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= static_cast<std::size_t>(key.size) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= static_cast<std::size_t>(key.dpi) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<float>()(key.max_width) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<float>()(key.max_height) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+// MARK: - Runs
+
+auto kestrel::font::layout_run::estimated_memory_size() const -> std::size_t
+{
+    return sizeof(layout_run)
+        + (key.text.size() * sizeof(wchar_t))
+        + (characters.size() * sizeof(typesetter::character))
+        + (lines.size() * sizeof(typesetter::line_start));
+}
+
+// MARK: - Construction
+
+kestrel::font::layout_cache::layout_cache(std::size_t budget)
+    : m_runs(budget)
+{
+}
+
+auto kestrel::font::layout_cache::shared_cache() -> layout_cache&
+{
+    static layout_cache cache;
+    return cache;
+}
+
+// MARK: - Lookup
+
+auto kestrel::font::layout_cache::find(const layout_key &key) -> std::shared_ptr<const layout_run>
+{
+    if (auto run = m_runs.fetch(key, rtc::clock::global().current())) {
+        return *run;
+    }
+    return nullptr;
+}
+
+auto kestrel::font::layout_cache::insert(const std::shared_ptr<const layout_run> &run) -> void
+{
+    m_runs.insert(run->key, run, run->estimated_memory_size(), rtc::clock::global().current());
+}
+
+auto kestrel::font::layout_cache::stats() const -> cache::statistics
+{
+    return m_runs.stats();
+}
+
+auto kestrel::font::layout_cache::clear() -> void
+{
+    m_runs.clear();
+}
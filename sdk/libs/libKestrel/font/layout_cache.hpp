@@ -0,0 +1,93 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <libKestrel/math/size.hpp>
+#include <libKestrel/cache/lru_cache.hpp>
+#include <libKestrel/font/typesetter.hpp>
+
+namespace kestrel::font
+{
+    /**
+     * Identifies a layout by the text, the font it is set in and the bounds it was wrapped to.
+     */
+    struct layout_key
+    {
+        std::wstring text;
+        std::uint64_t face { 0 };
+        std::uint32_t size { 0 };
+        std::uint32_t dpi { 0 };
+        float max_width { 0 };
+        float max_height { 0 };
+
+        auto operator==(const layout_key& rhs) const -> bool = default;
+
+        /**
+         * Whether the two layouts only differ in their text, in which case one can be resumed from the other.
+         */
+        [[nodiscard]] auto same_setting(const layout_key& rhs) const -> bool;
+
+        struct hasher
+        {
+            auto operator()(const layout_key& key) const -> std::size_t;
+        };
+    };
+
+    /**
+     * The laid out characters of a piece of text, along with the start of each wrapped line so that the layout can
+     * be resumed part way through after the text is edited.
+     */
+    struct layout_run
+    {
+        layout_key key;
+        std::vector<typesetter::character> characters;
+        std::vector<typesetter::line_start> lines;
+        math::size bounding_size { 0 };
+
+        [[nodiscard]] auto estimated_memory_size() const -> std::size_t;
+    };
+
+    /**
+     * A cache of text layouts that is shared by every typesetter, so that static text is only laid out once.
+     */
+    class layout_cache
+    {
+    public:
+        static constexpr std::size_t default_budget { 4 * 1024 * 1024 };
+
+        explicit layout_cache(std::size_t budget = default_budget);
+
+        static auto shared_cache() -> layout_cache&;
+
+        auto find(const layout_key& key) -> std::shared_ptr<const layout_run>;
+        auto insert(const std::shared_ptr<const layout_run>& run) -> void;
+
+        [[nodiscard]] auto stats() const -> cache::statistics;
+        auto clear() -> void;
+
+    private:
+        cache::lru_cache<layout_key, std::shared_ptr<const layout_run>, layout_key::hasher> m_runs;
+    };
+}
@@ -24,6 +24,8 @@
 #include <cmath>
 #include <libKestrel/font/typesetter.hpp>
 #include <libKestrel/font/font.hpp>
+#include <libKestrel/font/glyph_cache.hpp>
+#include <libKestrel/font/layout_cache.hpp>
 
 // MARK: - Construction
 
@@ -97,6 +99,7 @@ auto kestrel::font::typesetter::get_point_at_location(std::uint32_t location) co
 auto kestrel::font::typesetter::reset() -> void
 {
     m_layout.clear();
+    m_lines.clear();
     m_buffer.clear();
     m_pos = math::point(0);
     m_buffer_width = 0;
@@ -116,21 +119,100 @@ auto kestrel::font::typesetter::layout() -> void
         return;
     }
 
-    FT_Error error;
-    FT_GlyphSlot slot = m_base_font->face()->glyph;
-
     // In the event that we're performing layout for a second, third, etc... time, then we need to remove the
     // existing layout information so that we can run the layout for a clean slate.
     reset();
 
+    // Identical text in the same setting has already been laid out, possibly by another typesetter.
+    auto& cache = layout_cache::shared_cache();
+    auto key = current_layout_key();
+    if (auto cached = cache.find(key)) {
+        m_layout = cached->characters;
+        m_lines = cached->lines;
+        m_min_size = cached->bounding_size;
+        m_previous = cached;
+        return;
+    }
+
+    // If this typesetter previously laid out a different version of the text in the same setting, then only the
+    // lines affected by the edit need to be laid out again.
+    line_start from;
+    if (m_previous && m_previous->key.same_setting(key)) {
+        from = resume_point(*m_previous);
+    }
+
+    if (from.text_index > 0) {
+        m_layout.assign(m_previous->characters.begin(), m_previous->characters.begin() + static_cast<std::ptrdiff_t>(from.layout_index));
+        for (const auto& line : m_previous->lines) {
+            if (line.text_index > from.text_index) {
+                break;
+            }
+            m_lines.emplace_back(line);
+        }
+    }
+
+    perform_layout(from);
+
+    auto run = std::make_shared<layout_run>();
+    run->key = std::move(key);
+    run->characters = m_layout;
+    run->lines = m_lines;
+    run->bounding_size = m_min_size;
+    cache.insert(run);
+    m_previous = std::move(run);
+}
+
+auto kestrel::font::typesetter::current_layout_key() const -> struct layout_key
+{
+    struct layout_key key;
+    key.text = m_text;
+    key.face = std::hash<std::string>()(m_base_font->path());
+    key.size = static_cast<std::uint32_t>(m_base_font->size() * m_scale);
+    key.dpi = m_dpi;
+    key.max_width = m_max_size.width();
+    key.max_height = m_max_size.height();
+    return key;
+}
+
+auto kestrel::font::typesetter::resume_point(const layout_run &previous) const -> line_start
+{
+    const auto& text = previous.key.text;
+    auto prefix = static_cast<std::size_t>(std::mismatch(text.begin(), text.end(), m_text.begin(), m_text.end()).first - text.begin());
+
+    // Find the line containing the first edited character. Shortening the first word of a line may allow it to fit
+    // on the line above, so the layout resumes from the start of the preceding line.
+    auto line = std::upper_bound(previous.lines.begin(), previous.lines.end(), prefix, [] (std::size_t index, const line_start& start) {
+        return index < start.text_index;
+    });
+
+    if (line - previous.lines.begin() < 2) {
+        return {};
+    }
+    return *(line - 2);
+}
+
+auto kestrel::font::typesetter::mark_line_start(std::size_t text_index, std::uint32_t previous_glyph) -> void
+{
+    line_start start;
+    start.text_index = text_index;
+    start.layout_index = m_layout.size();
+    start.y = m_pos.y();
+    start.min_width = m_min_size.width();
+    start.previous_glyph = previous_glyph;
+    m_lines.emplace_back(start);
+}
+
+auto kestrel::font::typesetter::perform_layout(const line_start& from) -> void
+{
+    m_pos = math::point(0, from.y);
+    m_min_size = math::size(from.min_width, 0);
+
     // Ensure that the character set and font size is correctly configured, otherwise the layout will be invalid.
     FT_Select_Charmap(m_base_font->face(), FT_ENCODING_UNICODE);
     FT_Set_Char_Size(m_base_font->face(), 0, static_cast<std::int32_t>(m_base_font->size() * m_scale) << 6U, m_dpi, m_dpi);
 
-    // Prepare a buffer to keep track of character layouts, before committing them to the actual layout.
-    std::vector<character> buffer;
-    auto word_start = m_text.begin();
-    FT_UInt previous_glyph_index = 0;
+    auto word_start = m_text.begin() + static_cast<std::ptrdiff_t>(from.text_index);
+    FT_UInt previous_glyph_index = from.previous_glyph;
 
     // Loop over all of the characters in the text buffer, and attempt to add it to the layout. Special characters are
     // also considered, and update the layout accordingly, along with word breaks being calculated.
@@ -143,6 +225,7 @@ auto kestrel::font::typesetter::layout() -> void
                 commit_buffer();
                 newline();
                 word_start = ++i;
+                mark_line_start(word_start - m_text.begin(), previous_glyph_index);
                 continue;
             }
             else if (*i == '\t') {
@@ -172,6 +255,7 @@ auto kestrel::font::typesetter::layout() -> void
                 newline();
                 drop_buffer();
                 i = word_start;
+                mark_line_start(word_start - m_text.begin(), previous_glyph_index);
                 continue;
             }
 
@@ -194,6 +278,7 @@ auto kestrel::font::typesetter::layout() -> void
             // Are we going to overrun the boundary?
             if ((m_pos.x() + glyph_advance) >= m_max_size.width() - 2) {
                 newline();
+                mark_line_start(c - m_text.begin(), previous_glyph_index);
             }
 
             // Add the character directly to the layout.
@@ -215,19 +300,57 @@ auto kestrel::font::typesetter::layout() -> void
 
 auto kestrel::font::typesetter::render() -> std::vector<graphics::color>
 {
-    FT_Error error;
-    FT_GlyphSlot slot = m_base_font->face()->glyph;
     auto line_height = m_base_font->line_height();
+    auto& cache = glyph_cache::shared_cache();
 
     std::vector<graphics::color> buffer(static_cast<unsigned int>(m_min_size.width() * m_min_size.height()), graphics::color::clear_color());
+    const auto buffer_width = static_cast<int>(std::round(m_min_size.width()));
+    const auto hex_color = static_cast<unsigned int>(m_font_color.color_value() & 0x00FFFFFFU);
+
+    auto blit = [&] (const character& ch, std::int32_t left, std::int32_t top, std::uint32_t width, std::uint32_t rows, const std::uint8_t *coverage, std::int32_t pitch) {
+        auto y_offset = static_cast<int>(line_height - top);
+        auto x_offset = static_cast<int>(left);
+
+        for (auto yy = 0; yy < rows; ++yy) {
+            auto row = coverage + (yy * pitch);
+            auto row_offset = ((static_cast<int>(std::round(ch.y)) + y_offset + yy) * buffer_width) + static_cast<int>(std::round(ch.x)) + x_offset;
+            for (auto xx = 0; xx < width; ++xx) {
+                auto alpha = static_cast<unsigned int>(row[xx]);
+                auto offset = row_offset + xx;
+                if (alpha == 0 || offset < 0 || offset >= buffer.size()) {
+                    continue;
+                }
+                // Color of the glyph becomes the alpha for the text.
+                buffer[offset] = graphics::color::color_value(hex_color | (alpha << 24U));
+            }
+        }
+    };
 
-    // Ensure that the character set and font size is correctly configured, otherwise the layout will be invalid.
+    // Ensure that the character set is correctly configured, otherwise the glyph indices will be invalid. The size
+    // is only configured if a glyph needs to be rasterised.
     FT_Select_Charmap(m_base_font->face(), FT_ENCODING_UNICODE);
-    FT_Set_Char_Size(m_base_font->face(), 0, (static_cast<std::int32_t>(m_base_font->size() * m_scale) << 6U), m_dpi, m_dpi);
+    bool size_configured = false;
+
+    glyph_cache::key key;
+    key.face = std::hash<std::string>()(m_base_font->path());
+    key.size = static_cast<std::uint32_t>(m_base_font->size() * m_scale);
+    key.dpi = m_dpi;
 
     for (const auto& ch : m_layout) {
-        FT_UInt glyph_index = FT_Get_Char_Index(m_base_font->face(), ch.value);
-        if (FT_Load_Glyph(m_base_font->face(), glyph_index, FT_LOAD_DEFAULT | FT_LOAD_FORCE_AUTOHINT)) {
+        key.glyph = FT_Get_Char_Index(m_base_font->face(), ch.value);
+
+        if (auto glyph = cache.find(key)) {
+            blit(ch, glyph->left, glyph->top, glyph->width, glyph->rows, cache.coverage(*glyph), static_cast<std::int32_t>(cache.atlas_width()));
+            continue;
+        }
+
+        if (!size_configured) {
+            FT_Set_Char_Size(m_base_font->face(), 0, (static_cast<std::int32_t>(m_base_font->size() * m_scale) << 6U), m_dpi, m_dpi);
+            size_configured = true;
+        }
+
+        FT_GlyphSlot slot = m_base_font->face()->glyph;
+        if (FT_Load_Glyph(m_base_font->face(), key.glyph, FT_LOAD_DEFAULT | FT_LOAD_FORCE_AUTOHINT)) {
             continue;
         }
 
@@ -239,24 +362,28 @@ auto kestrel::font::typesetter::render() -> std::vector<graphics::color>
         FT_Bitmap_New(&bmp);
         FT_Bitmap_Convert(graphics::font::library(), &slot->bitmap, &bmp, 8);
 
-        auto y_offset = static_cast<int>(line_height - slot->bitmap_top);
-        auto x_offset = static_cast<int>(slot->bitmap_left);
-
-        for (auto yy = 0; yy < bmp.rows; ++yy) {
-            for (auto xx = 0; xx < bmp.width; ++xx) {
-                auto alpha = bmp.buffer[(yy * bmp.pitch) + xx];
-                if (bmp.num_grays == 2) {
-                    alpha *= 255;
-                }
-                auto hex_color = static_cast<unsigned int>(m_font_color.color_value() & 0x00FFFFFFU);
-                auto color = hex_color | (alpha << 24U); // Color of the glyph becomes the alpha for the text.
-                auto offset = ((static_cast<int>(std::round(ch.y)) + y_offset + yy) * static_cast<int>(std::round(m_min_size.width()))) + static_cast<int>(std::round(ch.x)) + x_offset + xx;
-                if (offset < buffer.size()) {
-                    buffer[offset] = graphics::color::color_value(color);
-                }
+        if (bmp.num_grays == 2) {
+            for (auto n = 0; n < bmp.rows * bmp.pitch; ++n) {
+                bmp.buffer[n] *= 255;
             }
         }
 
+        glyph_cache::bitmap raster;
+        raster.left = slot->bitmap_left;
+        raster.top = slot->bitmap_top;
+        raster.width = bmp.width;
+        raster.rows = bmp.rows;
+        raster.pitch = bmp.pitch;
+        raster.coverage = bmp.buffer;
+
+        if (auto glyph = cache.insert(key, raster)) {
+            blit(ch, glyph->left, glyph->top, glyph->width, glyph->rows, cache.coverage(*glyph), static_cast<std::int32_t>(cache.atlas_width()));
+        }
+        else {
+            // Glyphs too large for the atlas are drawn straight from the rasterised bitmap.
+            blit(ch, raster.left, raster.top, raster.width, raster.rows, raster.coverage, raster.pitch);
+        }
+
         FT_Bitmap_Done(graphics::font::library(), &bmp);
     }
 
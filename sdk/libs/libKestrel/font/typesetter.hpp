@@ -30,6 +30,9 @@
 
 namespace kestrel::font
 {
+    struct layout_key;
+    struct layout_run;
+
     class typesetter: public std::enable_shared_from_this<typesetter>
     {
     public:
@@ -43,6 +46,18 @@ namespace kestrel::font
             double w;
         };
 
+        /**
+         * The state of the layout at the start of a wrapped line, from which the layout can be resumed.
+         */
+        struct line_start
+        {
+            std::size_t text_index { 0 };
+            std::size_t layout_index { 0 };
+            float y { 0 };
+            float min_width { 0 };
+            std::uint32_t previous_glyph { 0 };
+        };
+
         explicit typesetter(const std::string& text, double scale = 1.0);
 
         auto set_margins(const math::size& margins) -> void;
@@ -71,12 +86,19 @@ namespace kestrel::font
         graphics::color m_font_color;
         std::vector<character> m_layout;
         std::vector<character> m_buffer;
+        std::vector<line_start> m_lines;
+        std::shared_ptr<const layout_run> m_previous;
         math::size m_max_size;
         math::size m_min_size;
         math::point m_pos;
         double m_buffer_width;
         double m_line_height;
 
+        [[nodiscard]] auto current_layout_key() const -> struct layout_key;
+        [[nodiscard]] auto resume_point(const layout_run& previous) const -> line_start;
+        auto perform_layout(const line_start& from) -> void;
+        auto mark_line_start(std::size_t text_index, std::uint32_t previous_glyph) -> void;
+
         auto commit_buffer() -> void;
         auto drop_buffer() -> void;
         auto newline() -> void;
@@ -97,10 +97,17 @@ auto kestrel::graphics::canvas::rebuild_texture() -> void
         return;
     }
 
-    // Rebuild the texture.
+    // Rebuild the texture. Once the texture is resident on the GPU, only the regions of the buffer that have been
+    // drawn into since the last rebuild need to be transferred.
     if (m_linked_tex) {
-        m_linked_tex->set_data(data());
+        if (m_linked_tex->uploaded()) {
+            m_linked_tex->update_regions(data(), m_rgba_buffer.dirty_regions());
+        }
+        else {
+            m_linked_tex->set_data(data());
+        }
     }
+    m_rgba_buffer.clear_dirty_regions();
     m_dirty = false;
 }
 
@@ -108,6 +115,8 @@ auto kestrel::graphics::canvas::spawn_entity(const math::point& position) -> std
 {
     // Create a new bitmap of the text.
     m_linked_tex = renderer::create_texture(m_scaled_size, data());
+    m_linked_tex->set_source("Canvas " + m_name);
+    m_rgba_buffer.clear_dirty_regions();
 
     m_entity = std::make_shared<ecs::entity>(m_size);
     m_entity->set_sprite_sheet(std::make_shared<graphics::sprite_sheet>(m_linked_tex, m_scaled_size));
@@ -314,200 +323,46 @@ auto kestrel::graphics::canvas::character_point_in_text(std::uint32_t position)
 
 auto kestrel::graphics::canvas::draw_text(const math::point &point) -> void
 {
-    auto inner_draw_text = [this] (const math::point& point) {
-        auto text_bmp = m_typesetter.render();
-        auto text_size = m_typesetter.get_bounding_size();
-
-        auto bmp_line_start = std::max<std::int64_t>(0LL, static_cast<std::int64_t>(-point.x()));
-        auto bmp_line_len = static_cast<std::int64_t>(text_size.width()) - bmp_line_start;
-        auto start = std::max<std::int64_t>(0LL, static_cast<std::int64_t>(point.x()));
-
-        // Drawing the text into the canvas buffer at the appropriate point.
-        for (auto y = 0; y < text_size.height(); ++y) {
-            auto dy = std::floor(y + point.y());
-            if (dy < 0) {
-                // TODO: Calculate the correct Y to be on, if it exists.
-                continue;
-            }
-            else if (y >= m_scaled_size.height()) {
-                break;
-            }
-
-            auto bmp_line_offset = static_cast<std::int64_t>(y * text_size.width());
+    auto text_bmp = m_typesetter.render();
+    auto text_size = m_typesetter.get_bounding_size();
 
-            auto vstart = text_bmp.cbegin() + bmp_line_offset + bmp_line_start;
-            auto vend = vstart + bmp_line_len;
-            std::vector<graphics::color> cv { vstart, vend };
-
-            m_rgba_buffer.apply_run(cv, start, dy);
-        }
+    // Drawing the text into the canvas buffer at the appropriate point, reading each scanline straight out of the
+    // typesetter output.
+    static_assert(sizeof(graphics::color) == sizeof(graphics::color::value));
+    auto pixels = reinterpret_cast<const graphics::color::value *>(text_bmp.data());
+    m_rgba_buffer.blit(pixels, text_size, static_cast<std::size_t>(text_size.width()), { (point * m_scale).round(), text_size });
 
-        m_typesetter.reset();
-    };
-    inner_draw_text((point * m_scale).round());
+    m_typesetter.reset();
     m_dirty = true;
 }
 
-auto kestrel::graphics::canvas::draw_static_image(const image::static_image::lua_reference &image, const math::rect &rect) -> void
+auto kestrel::graphics::canvas::blit_texture(const std::shared_ptr<graphics::texture>& tex, const math::rect& frame) -> void
 {
-    auto inner_draw_image = [this] (const image::static_image::lua_reference& image, const math::point& point, const math::size& sz) {
-        math::rect bounds(math::point(0), m_scaled_size);
-        math::rect img_bounds(math::point(0), image->size());
-        math::rect img_frame(point, { std::round(sz.width()), std::round(sz.height()) });
-
-        if (!img_frame.intersects(bounds)) {
-            return;
-        }
-
-        auto img_data = image->sprite_sheet()->texture()->data();
-        auto scaled_len = static_cast<std::uint32_t>(img_frame.size().area());
-
-        data::block scaled_data(scaled_len * 4);
-        scaled_data.set(static_cast<std::uint32_t>(0), scaled_data.size());
-
-        // Perform some initial calculations in order to determine how the scaling should be performed
-        auto scale = img_frame.size() / img_bounds.size();
-        auto x_scale = scale.width();
-        auto y_scale = scale.height();
-
-        for (auto y = 0; y < img_frame.height(); ++y) {
-            auto ry = static_cast<std::uint32_t>(std::floor(y / y_scale));
-            if (ry >= img_bounds.height()) {
-                break;
-            }
-
-            auto src_offset = static_cast<std::uint32_t>(ry * img_bounds.width());
-            auto dst_offset = static_cast<std::uint32_t>(y * img_frame.width());
-            for (auto x = 0; x < img_frame.width(); ++x) {
-                auto rx = static_cast<std::uint32_t>(std::floor(x / x_scale));
-                if (rx >= img_bounds.width()) {
-                    break;
-                }
-
-                auto color = img_data.get<std::uint32_t>((src_offset + rx) * 4);
-                scaled_data.set(color, 4, (dst_offset + x) * 4);
-            }
-        }
-
-        // Drawing
-        auto bmp_line_start = std::max<std::int64_t>(0LL, static_cast<std::int64_t>(-point.x()));
-        auto bmp_line_len = static_cast<std::int64_t>(img_frame.width()) - bmp_line_start;
-        auto start = std::max<std::int64_t>(0LL, static_cast<std::int64_t>(point.x()));
-
-        for (auto y = 0; y < img_frame.height(); ++y) {
-            auto dy = std::floor(y + point.y());
-            if (dy < 0) {
-                continue;
-            }
-            else if (y >= m_scaled_size.height()) {
-                break;
-            }
+    if (!tex) {
+        return;
+    }
+    auto pixels = tex->data().get<graphics::color::value *>();
+    m_rgba_buffer.blit(pixels, tex->size(), static_cast<std::size_t>(tex->size().width()), frame);
+}
 
-            auto bmp_line_offset = static_cast<std::int64_t>(y * img_frame.width());
-            auto cv = scaled_data.slice((bmp_line_offset + bmp_line_start) * 4, bmp_line_len * 4);
-            m_rgba_buffer.apply_run(cv, start, dy);
-        }
-    };
+auto kestrel::graphics::canvas::draw_static_image(const image::static_image::lua_reference &image, const math::rect &rect) -> void
+{
     if (rect.width() <= 0 || rect.height() <= 0) {
         return;
     }
-    auto scaled = (rect * m_scale).round();
-    inner_draw_image(image, scaled.origin(), scaled.size());
+    blit_texture(image->sprite_sheet()->texture(), (rect * m_scale).round());
     m_dirty = true;
 }
 
 auto kestrel::graphics::canvas::draw_image(const image::legacy::macintosh::quickdraw::picture::lua_reference& image, const math::point& point, const math::size& sz) -> void
 {
-    auto inner_draw_image = [this] (const image::legacy::macintosh::quickdraw::picture::lua_reference& image, const math::point& point, const math::size& sz) {
-        math::rect bounds(math::point(0), m_scaled_size);
-        math::rect img_bounds(math::point(0), image->size());
-        math::rect img_frame(point, sz.round());
-
-        if (!img_frame.intersects(bounds)) {
-            return;
-        }
-
-        auto img_data = image->sprite_sheet()->texture()->data();
-        auto scaled_len = static_cast<std::uint32_t>(img_frame.size().area());
-
-        data::block scaled_data(scaled_len * 4);
-        scaled_data.set(static_cast<std::uint32_t>(0), scaled_data.size());
-
-        // Perform some initial calculations in order to determine how the scaling should be performed
-        auto scale = img_frame.size() / img_bounds.size();
-        auto x_scale = scale.width();
-        auto y_scale = scale.height();
-
-        for (auto y = 0; y < img_frame.height(); ++y) {
-            auto ry = static_cast<std::uint32_t>(std::floor(y / y_scale));
-            if (ry >= img_bounds.height()) {
-                break;
-            }
-
-            auto src_offset = static_cast<std::uint32_t>(ry * img_bounds.width()) << 2;
-            auto dst_offset = static_cast<std::uint32_t>(y * img_frame.width()) << 2;
-            for (auto x = 0; x < img_frame.width(); ++x) {
-                auto rx = static_cast<std::uint32_t>(std::floor(x / x_scale));
-                if (rx >= img_bounds.width()) {
-                    break;
-                }
-                scaled_data.set(img_data.get<std::uint32_t>(src_offset), 4, dst_offset);
-            }
-        }
-
-        // Drawing
-        auto bmp_line_start = std::max<std::int64_t>(0LL, static_cast<std::int64_t>(-point.x()));
-        auto bmp_line_len = static_cast<std::int64_t>(img_frame.width()) - bmp_line_start - 1;
-        auto start = std::max<std::int64_t>(0LL, static_cast<std::int64_t>(point.x()));
-
-        for (auto y = 0; y < img_frame.height(); ++y) {
-            auto dy = std::floor(y + point.y());
-            if (dy < 0) {
-                continue;
-            }
-            else if (y >= m_scaled_size.height()) {
-                break;
-            }
-
-            auto bmp_line_offset = static_cast<std::int64_t>(y * img_frame.width());
-            auto cv = scaled_data.slice((bmp_line_offset + bmp_line_start) * 4, bmp_line_len * 4);
-            m_rgba_buffer.apply_run(cv, start, dy);
-        }
-    };
-    inner_draw_image(image, (point * m_scale).round(), (sz * m_scale).round());
+    blit_texture(image->sprite_sheet()->texture(), { (point * m_scale).round(), (sz * m_scale).round() });
     m_dirty = true;
 }
 
 auto kestrel::graphics::canvas::draw_picture_at_point(const image::legacy::macintosh::quickdraw::picture::lua_reference& pict, const math::point& point) -> void
 {
-    auto inner_draw = [this] (const image::legacy::macintosh::quickdraw::picture::lua_reference& pict, const math::point& point) {
-        math::rect bounds(math::point(0), m_scaled_size);
-        math::rect pict_bounds(point, pict->size());
-        if (!pict_bounds.intersects(bounds)) {
-            return;
-        }
-
-        auto raw_pict_data = pict->sprite_sheet()->texture()->data();
-
-        auto bmp_line_start = std::max<std::int64_t>(0LL, static_cast<std::int64_t>(-point.x()));
-        auto bmp_line_len = static_cast<std::int64_t>(pict_bounds.width()) - bmp_line_start;
-        auto start = std::max<std::int64_t>(0LL, static_cast<std::int64_t>(point.x()));
-
-        for (auto y = 0; y < pict->size().height(); ++y) {
-            auto dy = std::floor(y + point.y());
-            if (dy < 0) {
-                continue;
-            }
-            else if (y >= m_scaled_size.height()) {
-                break;
-            }
-
-            auto bmp_line_offset = static_cast<std::int64_t>(y * pict_bounds.width());
-            auto cv = raw_pict_data.slice((bmp_line_offset + bmp_line_start) * 4, bmp_line_len * 4);
-            m_rgba_buffer.apply_run(cv, start, dy);
-        }
-    };
-    inner_draw(pict, (point * m_scale).round());
+    blit_texture(pict->sprite_sheet()->texture(), { (point * m_scale).round(), pict->size() });
     m_dirty = true;
 }
 
@@ -522,35 +377,8 @@ auto kestrel::graphics::canvas::draw_picture(const image::legacy::macintosh::qui
 
 auto kestrel::graphics::canvas::draw_color_icon(const image::legacy::macintosh::quickdraw::color_icon::lua_reference& icon, const math::point &point, const math::size &sz) -> void
 {
-    auto inner_draw = [this] (const image::legacy::macintosh::quickdraw::color_icon::lua_reference& icon, const math::point& point, const math::size& sz) {
-        math::rect bounds(math::point(0), m_scaled_size);
-        math::rect icon_bounds(point, icon->size());
-        if (!icon_bounds.intersects(bounds)) {
-            return;
-        }
-
-        auto raw_icon_data = icon->sprite_sheet()->texture()->data();
-
-        auto bmp_line_start = std::max(static_cast<std::int64_t>(0LL), static_cast<std::int64_t>(-point.x()));
-        auto bmp_line_len = static_cast<std::int64_t>(icon_bounds.width()) - bmp_line_start;
-        auto start = std::max(static_cast<std::int64_t>(0LL), static_cast<std::int64_t>(point.x()));
-
-        for (auto y = 0; y < icon->size().height(); ++y) {
-            auto dy = std::floor(y + point.y());
-            if (dy < 0) {
-                continue;
-            }
-            else if (y >= m_scaled_size.height()) {
-                break;
-            }
-
-            auto bmp_line_offset = static_cast<std::int64_t>(y * icon_bounds.width());
-            auto cv = raw_icon_data.slice((bmp_line_offset + bmp_line_start) * 4, bmp_line_len * 4);
-
-            m_rgba_buffer.apply_run(cv, start, dy);
-        }
-    };
-    inner_draw(icon, (point * m_scale).round(), (sz * m_scale).round());
+    // Color icons are always drawn at their natural size.
+    blit_texture(icon->sprite_sheet()->texture(), { (point * m_scale).round(), icon->size() });
     m_dirty = true;
 }
 
@@ -104,6 +104,7 @@ namespace kestrel::graphics
         auto raw() const -> std::uint8_t *;
         auto data() const -> data::block;
         auto draw_picture_at_point(const image::legacy::macintosh::quickdraw::picture::lua_reference& pict, const math::point &point) -> void;
+        auto blit_texture(const std::shared_ptr<graphics::texture>& tex, const math::rect& frame) -> void;
     };
 
 }
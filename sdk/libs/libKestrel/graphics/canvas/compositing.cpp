@@ -0,0 +1,405 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <libKestrel/graphics/canvas/compositing.hpp>
+#include <libKestrel/util/availability.hpp>
+
+#if TARGET_INTEL && (defined(__GNUC__) || defined(__clang__))
+#   define COMPOSITING_X86      true
+#   include <immintrin.h>
+#else
+#   define COMPOSITING_X86      false
+#endif
+
+#if TARGET_ARM && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#   define COMPOSITING_NEON     true
+#   include <arm_neon.h>
+#else
+#   define COMPOSITING_NEON     false
+#endif
+
+using kestrel::graphics::color;
+using kestrel::graphics::compositing::instruction_set;
+
+// MARK: - Scalar Reference
+
+auto kestrel::graphics::compositing::blend(color::value bottom, color::value top) -> color::value
+{
+    std::uint8_t ta = (top >> 24);
+    std::uint8_t ba = (bottom >> 24);
+
+    color::value rb = bottom & 0xff00ff;
+    color::value g  = bottom & 0x00ff00;
+    std::uint8_t a = ta + ((ba * (0x100 - ta)) >> 8);
+    rb += (((top & 0xff00ff) - rb) * ta) >> 8;
+    g  += (((top & 0x00ff00) -  g) * ta) >> 8;
+
+    return (rb & 0xff00ff) | (g & 0xff00) | (a << 24);
+}
+
+static auto scalar_fill(color::value *dst, color::value c, std::size_t count) -> void
+{
+    for (std::size_t n = 0; n < count; ++n) {
+        dst[n] = c;
+    }
+}
+
+static auto scalar_blend_color(color::value *dst, color::value c, std::size_t count) -> void
+{
+    for (std::size_t n = 0; n < count; ++n) {
+        dst[n] = kestrel::graphics::compositing::blend(dst[n], c);
+    }
+}
+
+static auto scalar_copy(color::value *dst, const color::value *src, std::size_t count) -> void
+{
+    std::copy_n(src, count, dst);
+}
+
+static auto scalar_blend_run(color::value *dst, const color::value *src, std::size_t count) -> void
+{
+    for (std::size_t n = 0; n < count; ++n) {
+        dst[n] = kestrel::graphics::compositing::blend(dst[n], src[n]);
+    }
+}
+
+static auto scalar_mask(color::value *dst, const color::value *mask, std::size_t count) -> void
+{
+    for (std::size_t n = 0; n < count; ++n) {
+        dst[n] = (dst[n] & 0x00FFFFFF) | ((0xFF - (mask[n] & 0xFF)) << 24);
+    }
+}
+
+// MARK: - SSE4.1
+
+#if COMPOSITING_X86
+// The vector kernels mirror the scalar reference lane for lane, including its use of wrapping 32-bit arithmetic on
+// the packed red/blue channels, so that every instruction set produces identical pixels.
+__attribute__((target("sse4.1")))
+static inline auto sse41_blend(__m128i bottom, __m128i top) -> __m128i
+{
+    const auto rb_mask = _mm_set1_epi32(0x00ff00ff);
+    const auto g_mask = _mm_set1_epi32(0x0000ff00);
+
+    auto ta = _mm_srli_epi32(top, 24);
+    auto ba = _mm_srli_epi32(bottom, 24);
+    auto a = _mm_add_epi32(ta, _mm_srli_epi32(_mm_mullo_epi32(ba, _mm_sub_epi32(_mm_set1_epi32(0x100), ta)), 8));
+
+    auto rb = _mm_and_si128(bottom, rb_mask);
+    auto g = _mm_and_si128(bottom, g_mask);
+    rb = _mm_add_epi32(rb, _mm_srli_epi32(_mm_mullo_epi32(_mm_sub_epi32(_mm_and_si128(top, rb_mask), rb), ta), 8));
+    g = _mm_add_epi32(g, _mm_srli_epi32(_mm_mullo_epi32(_mm_sub_epi32(_mm_and_si128(top, g_mask), g), ta), 8));
+
+    return _mm_or_si128(
+        _mm_or_si128(_mm_and_si128(rb, rb_mask), _mm_and_si128(g, g_mask)),
+        _mm_slli_epi32(a, 24)
+    );
+}
+
+__attribute__((target("sse4.1")))
+static auto sse41_fill(color::value *dst, color::value c, std::size_t count) -> void
+{
+    auto v = _mm_set1_epi32(static_cast<int>(c));
+    std::size_t n = 0;
+    for (; n + 4 <= count; n += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + n), v);
+    }
+    scalar_fill(dst + n, c, count - n);
+}
+
+__attribute__((target("sse4.1")))
+static auto sse41_blend_color(color::value *dst, color::value c, std::size_t count) -> void
+{
+    auto v = _mm_set1_epi32(static_cast<int>(c));
+    std::size_t n = 0;
+    for (; n + 4 <= count; n += 4) {
+        auto bottom = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + n));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + n), sse41_blend(bottom, v));
+    }
+    scalar_blend_color(dst + n, c, count - n);
+}
+
+__attribute__((target("sse4.1")))
+static auto sse41_blend_run(color::value *dst, const color::value *src, std::size_t count) -> void
+{
+    std::size_t n = 0;
+    for (; n + 4 <= count; n += 4) {
+        auto bottom = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + n));
+        auto top = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + n));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + n), sse41_blend(bottom, top));
+    }
+    scalar_blend_run(dst + n, src + n, count - n);
+}
+
+__attribute__((target("sse4.1")))
+static auto sse41_mask(color::value *dst, const color::value *mask, std::size_t count) -> void
+{
+    const auto rgb_mask = _mm_set1_epi32(0x00FFFFFF);
+    const auto red_mask = _mm_set1_epi32(0xFF);
+    std::size_t n = 0;
+    for (; n + 4 <= count; n += 4) {
+        auto pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + n));
+        auto alpha = _mm_andnot_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(mask + n)), red_mask);
+        pixels = _mm_or_si128(_mm_and_si128(pixels, rgb_mask), _mm_slli_epi32(alpha, 24));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + n), pixels);
+    }
+    scalar_mask(dst + n, mask + n, count - n);
+}
+
+// MARK: - AVX2
+
+__attribute__((target("avx2")))
+static inline auto avx2_blend(__m256i bottom, __m256i top) -> __m256i
+{
+    const auto rb_mask = _mm256_set1_epi32(0x00ff00ff);
+    const auto g_mask = _mm256_set1_epi32(0x0000ff00);
+
+    auto ta = _mm256_srli_epi32(top, 24);
+    auto ba = _mm256_srli_epi32(bottom, 24);
+    auto a = _mm256_add_epi32(ta, _mm256_srli_epi32(_mm256_mullo_epi32(ba, _mm256_sub_epi32(_mm256_set1_epi32(0x100), ta)), 8));
+
+    auto rb = _mm256_and_si256(bottom, rb_mask);
+    auto g = _mm256_and_si256(bottom, g_mask);
+    rb = _mm256_add_epi32(rb, _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(_mm256_and_si256(top, rb_mask), rb), ta), 8));
+    g = _mm256_add_epi32(g, _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(_mm256_and_si256(top, g_mask), g), ta), 8));
+
+    return _mm256_or_si256(
+        _mm256_or_si256(_mm256_and_si256(rb, rb_mask), _mm256_and_si256(g, g_mask)),
+        _mm256_slli_epi32(a, 24)
+    );
+}
+
+__attribute__((target("avx2")))
+static auto avx2_fill(color::value *dst, color::value c, std::size_t count) -> void
+{
+    auto v = _mm256_set1_epi32(static_cast<int>(c));
+    std::size_t n = 0;
+    for (; n + 8 <= count; n += 8) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + n), v);
+    }
+    scalar_fill(dst + n, c, count - n);
+}
+
+__attribute__((target("avx2")))
+static auto avx2_blend_color(color::value *dst, color::value c, std::size_t count) -> void
+{
+    auto v = _mm256_set1_epi32(static_cast<int>(c));
+    std::size_t n = 0;
+    for (; n + 8 <= count; n += 8) {
+        auto bottom = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + n));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + n), avx2_blend(bottom, v));
+    }
+    scalar_blend_color(dst + n, c, count - n);
+}
+
+__attribute__((target("avx2")))
+static auto avx2_blend_run(color::value *dst, const color::value *src, std::size_t count) -> void
+{
+    std::size_t n = 0;
+    for (; n + 8 <= count; n += 8) {
+        auto bottom = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + n));
+        auto top = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + n));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + n), avx2_blend(bottom, top));
+    }
+    scalar_blend_run(dst + n, src + n, count - n);
+}
+
+__attribute__((target("avx2")))
+static auto avx2_mask(color::value *dst, const color::value *mask, std::size_t count) -> void
+{
+    const auto rgb_mask = _mm256_set1_epi32(0x00FFFFFF);
+    const auto red_mask = _mm256_set1_epi32(0xFF);
+    std::size_t n = 0;
+    for (; n + 8 <= count; n += 8) {
+        auto pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + n));
+        auto alpha = _mm256_andnot_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(mask + n)), red_mask);
+        pixels = _mm256_or_si256(_mm256_and_si256(pixels, rgb_mask), _mm256_slli_epi32(alpha, 24));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + n), pixels);
+    }
+    scalar_mask(dst + n, mask + n, count - n);
+}
+#endif
+
+// MARK: - NEON
+
+#if COMPOSITING_NEON
+static inline auto neon_blend(uint32x4_t bottom, uint32x4_t top) -> uint32x4_t
+{
+    const auto rb_mask = vdupq_n_u32(0x00ff00ff);
+    const auto g_mask = vdupq_n_u32(0x0000ff00);
+
+    auto ta = vshrq_n_u32(top, 24);
+    auto ba = vshrq_n_u32(bottom, 24);
+    auto a = vaddq_u32(ta, vshrq_n_u32(vmulq_u32(ba, vsubq_u32(vdupq_n_u32(0x100), ta)), 8));
+
+    auto rb = vandq_u32(bottom, rb_mask);
+    auto g = vandq_u32(bottom, g_mask);
+    rb = vaddq_u32(rb, vshrq_n_u32(vmulq_u32(vsubq_u32(vandq_u32(top, rb_mask), rb), ta), 8));
+    g = vaddq_u32(g, vshrq_n_u32(vmulq_u32(vsubq_u32(vandq_u32(top, g_mask), g), ta), 8));
+
+    return vorrq_u32(vorrq_u32(vandq_u32(rb, rb_mask), vandq_u32(g, g_mask)), vshlq_n_u32(a, 24));
+}
+
+static auto neon_fill(color::value *dst, color::value c, std::size_t count) -> void
+{
+    auto v = vdupq_n_u32(c);
+    std::size_t n = 0;
+    for (; n + 4 <= count; n += 4) {
+        vst1q_u32(dst + n, v);
+    }
+    scalar_fill(dst + n, c, count - n);
+}
+
+static auto neon_blend_color(color::value *dst, color::value c, std::size_t count) -> void
+{
+    auto v = vdupq_n_u32(c);
+    std::size_t n = 0;
+    for (; n + 4 <= count; n += 4) {
+        vst1q_u32(dst + n, neon_blend(vld1q_u32(dst + n), v));
+    }
+    scalar_blend_color(dst + n, c, count - n);
+}
+
+static auto neon_blend_run(color::value *dst, const color::value *src, std::size_t count) -> void
+{
+    std::size_t n = 0;
+    for (; n + 4 <= count; n += 4) {
+        vst1q_u32(dst + n, neon_blend(vld1q_u32(dst + n), vld1q_u32(src + n)));
+    }
+    scalar_blend_run(dst + n, src + n, count - n);
+}
+
+static auto neon_mask(color::value *dst, const color::value *mask, std::size_t count) -> void
+{
+    const auto rgb_mask = vdupq_n_u32(0x00FFFFFF);
+    const auto red_mask = vdupq_n_u32(0xFF);
+    std::size_t n = 0;
+    for (; n + 4 <= count; n += 4) {
+        auto alpha = vbicq_u32(red_mask, vld1q_u32(mask + n));
+        vst1q_u32(dst + n, vorrq_u32(vandq_u32(vld1q_u32(dst + n), rgb_mask), vshlq_n_u32(alpha, 24)));
+    }
+    scalar_mask(dst + n, mask + n, count - n);
+}
+#endif
+
+// MARK: - Kernel Tables
+
+static const kestrel::graphics::compositing::kernels s_scalar_kernels {
+    instruction_set::scalar, scalar_fill, scalar_blend_color, scalar_copy, scalar_blend_run, scalar_mask
+};
+
+#if COMPOSITING_X86
+static const kestrel::graphics::compositing::kernels s_sse41_kernels {
+    instruction_set::sse41, sse41_fill, sse41_blend_color, scalar_copy, sse41_blend_run, sse41_mask
+};
+
+static const kestrel::graphics::compositing::kernels s_avx2_kernels {
+    instruction_set::avx2, avx2_fill, avx2_blend_color, scalar_copy, avx2_blend_run, avx2_mask
+};
+#endif
+
+#if COMPOSITING_NEON
+static const kestrel::graphics::compositing::kernels s_neon_kernels {
+    instruction_set::neon, neon_fill, neon_blend_color, scalar_copy, neon_blend_run, neon_mask
+};
+#endif
+
+// MARK: - Dispatch
+
+auto kestrel::graphics::compositing::name(instruction_set isa) -> const char *
+{
+    switch (isa) {
+        case instruction_set::sse41:    return "SSE4.1";
+        case instruction_set::avx2:     return "AVX2";
+        case instruction_set::neon:     return "NEON";
+        default:                        return "Scalar";
+    }
+}
+
+auto kestrel::graphics::compositing::supported(instruction_set isa) -> bool
+{
+    switch (isa) {
+        case instruction_set::scalar:
+            return true;
+#if COMPOSITING_X86
+        case instruction_set::sse41:
+            return __builtin_cpu_supports("sse4.1");
+        case instruction_set::avx2:
+            return __builtin_cpu_supports("avx2");
+#endif
+#if COMPOSITING_NEON
+        case instruction_set::neon:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+auto kestrel::graphics::compositing::best_instruction_set() -> instruction_set
+{
+    for (auto isa : { instruction_set::avx2, instruction_set::sse41, instruction_set::neon }) {
+        if (supported(isa)) {
+            return isa;
+        }
+    }
+    return instruction_set::scalar;
+}
+
+auto kestrel::graphics::compositing::kernels_for(instruction_set isa) -> const struct kernels&
+{
+    if (!supported(isa)) {
+        return s_scalar_kernels;
+    }
+
+    switch (isa) {
+#if COMPOSITING_X86
+        case instruction_set::sse41:    return s_sse41_kernels;
+        case instruction_set::avx2:     return s_avx2_kernels;
+#endif
+#if COMPOSITING_NEON
+        case instruction_set::neon:     return s_neon_kernels;
+#endif
+        default:                        return s_scalar_kernels;
+    }
+}
+
+static auto active_kernels() -> const kestrel::graphics::compositing::kernels *&
+{
+    static const kestrel::graphics::compositing::kernels *s_active = &kestrel::graphics::compositing::kernels_for(
+        kestrel::graphics::compositing::best_instruction_set()
+    );
+    return s_active;
+}
+
+auto kestrel::graphics::compositing::active() -> const struct kernels&
+{
+    return *active_kernels();
+}
+
+auto kestrel::graphics::compositing::select(instruction_set isa) -> bool
+{
+    if (!supported(isa)) {
+        return false;
+    }
+    active_kernels() = &kernels_for(isa);
+    return true;
+}
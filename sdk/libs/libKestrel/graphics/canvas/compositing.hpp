@@ -0,0 +1,98 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <libKestrel/graphics/types/color.hpp>
+
+namespace kestrel::graphics::compositing
+{
+    /**
+     * The instruction sets that compositing kernels have been written for. Every instruction set produces results
+     * that are bit identical to the scalar reference implementation.
+     */
+    enum class instruction_set : std::uint8_t
+    {
+        scalar, sse41, avx2, neon
+    };
+
+    /**
+     * A table of the pixel kernels used by graphics::rgba_buffer. Each kernel operates on tightly packed RGBA pixels,
+     * and makes no assumptions about the alignment of the buffers it is given.
+     */
+    struct kernels
+    {
+        typedef void(*color_function)(color::value *dst, color::value c, std::size_t count);
+        typedef void(*run_function)(color::value *dst, const color::value *src, std::size_t count);
+
+        instruction_set isa { instruction_set::scalar };
+
+        /**
+         * Store the color into each of the destination pixels.
+         */
+        color_function fill { nullptr };
+
+        /**
+         * Blend the color over each of the destination pixels.
+         */
+        color_function blend_color { nullptr };
+
+        /**
+         * Copy each of the source pixels into the destination.
+         */
+        run_function copy { nullptr };
+
+        /**
+         * Blend each of the source pixels over the corresponding destination pixel.
+         */
+        run_function blend_run { nullptr };
+
+        /**
+         * Replace the alpha of each destination pixel with the inverse of the red component of the mask pixel.
+         */
+        run_function mask { nullptr };
+    };
+
+    [[nodiscard]] auto name(instruction_set isa) -> const char *;
+
+    /**
+     * Reports if the instruction set is supported by both the build and the CPU that is currently executing.
+     */
+    [[nodiscard]] auto supported(instruction_set isa) -> bool;
+    [[nodiscard]] auto best_instruction_set() -> instruction_set;
+
+    /**
+     * Returns the kernels for the specified instruction set, or the scalar kernels if it is not supported.
+     */
+    [[nodiscard]] auto kernels_for(instruction_set isa) -> const struct kernels&;
+
+    /**
+     * The kernels currently used for compositing. These default to the best instruction set available at runtime.
+     */
+    [[nodiscard]] auto active() -> const struct kernels&;
+    auto select(instruction_set isa) -> bool;
+
+    /**
+     * Blend a single pixel using source-over compositing. This is the reference that all kernels conform to.
+     */
+    [[nodiscard]] auto blend(color::value bottom, color::value top) -> color::value;
+}
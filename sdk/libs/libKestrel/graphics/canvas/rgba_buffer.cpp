@@ -18,11 +18,11 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-#if __x86_64__
-#   include <emmintrin.h>
-#endif
-
+#include <cmath>
+#include <tuple>
+#include <algorithm>
 #include <libKestrel/graphics/canvas/rgba_buffer.hpp>
+#include <libKestrel/graphics/canvas/compositing.hpp>
 #include <libKestrel/math/point.hpp>
 #include <libKestrel/math/size.hpp>
 
@@ -37,15 +37,10 @@ kestrel::graphics::rgba_buffer::rgba_buffer(const math::size &sz)
 kestrel::graphics::rgba_buffer::rgba_buffer(const std::vector<color::value>& data, const math::size& sz)
     : m_size(sz)
 {
-    // We need
     common_construction();
 
-    // Copy the data into the buffer. This code path is _not_ optimal and there should be some effort in the future
-    // to optimise this. However this is a low frequency path and as such is not worth immediate optimisation.
-    auto dst = reinterpret_cast<std::uint32_t *>(m_buffer);
-    for (const auto& i : data) {
-        *dst++ = i;
-    }
+    auto len = std::min<std::size_t>(data.size(), m_count >> 2);
+    compositing::active().copy(reinterpret_cast<color::value *>(m_buffer), data.data(), len);
 }
 
 auto kestrel::graphics::rgba_buffer::common_construction() -> void
@@ -121,41 +116,6 @@ auto kestrel::graphics::rgba_buffer::color(const math::point &p) const -> graphi
 }
 
 // MARK: - Operations
-// TODO: The following operations need to be optimised to use SIMD instructions where possible.
-// Each of these operations will likely need differing versions for Intel/ARM machines.
-
-auto kestrel::graphics::rgba_buffer::blend_func_i(color::value bottom, color::value top) -> color::value
-{
-    std::uint8_t ta = (top >> 24);
-    std::uint8_t ba = (bottom >> 24);
-
-    color::value rb = bottom & 0xff00ff;
-    color::value g  = bottom & 0x00ff00;
-    std::uint8_t a = ta + ((ba * (0x100 - ta)) >> 8);
-    rb += (((top & 0xff00ff) - rb) * ta) >> 8;
-    g  += (((top & 0x00ff00) -  g) * ta) >> 8;
-
-    return (rb & 0xff00ff) | (g & 0xff00) | (a << 24);
-};
-
-auto kestrel::graphics::rgba_buffer::blend_func(const union simd_value& bottom, const union simd_value& top) -> union simd_value
-{
-    union simd_value r;
-
-#if TARGET_SUPPORTS_128BIT
-    r.f[0] = blend_func_i(bottom.f[0], top.f[0]);
-    r.f[1] = blend_func_i(bottom.f[1], top.f[1]);
-    r.f[2] = blend_func_i(bottom.f[2], top.f[2]);
-    r.f[3] = blend_func_i(bottom.f[3], top.f[3]);
-#elif TARGET_64BIT
-    r.f[0] = blend_func_i(bottom.f[0], top.f[0]);
-    r.f[1] = blend_func_i(bottom.f[1], top.f[1]);
-#else
-    r.wide = top.wide;
-#endif
-
-    return r;
-}
 
 auto kestrel::graphics::rgba_buffer::clear(const graphics::color &c) -> void
 {
@@ -171,60 +131,17 @@ auto kestrel::graphics::rgba_buffer::clear_rect(const graphics::color &c, const
     auto width = hi_x - lo_x;
     auto height = hi_y - lo_y;
 
-    auto stride = static_cast<std::uint64_t>(m_size.width());
-    auto pitch = stride - width;
-    auto ptr = reinterpret_cast<color::value *>(m_buffer) + (lo_y * static_cast<std::uint64_t>(m_size.width())) + lo_x;
-    auto ptr_value = reinterpret_cast<std::uint64_t>(m_buffer);
-
-    union simd_value v {};
-    for (unsigned int & i : v.f) {
-        i = c.rgba.value;
+    if (hi_x <= lo_x || hi_y <= lo_y) {
+        return;
     }
+    mark_dirty({ static_cast<float>(lo_x), static_cast<float>(lo_y), static_cast<float>(width), static_cast<float>(height) });
 
+    const auto& kernels = compositing::active();
+    auto stride = static_cast<std::uint64_t>(m_size.width());
+    auto ptr = reinterpret_cast<color::value *>(m_buffer) + (lo_y * stride) + lo_x;
     for (auto scanline = 0; scanline < height; ++scanline) {
-#if TARGET_SUPPORTS_128BIT && 0
-        std::uint32_t n = 0;
-        std::uint64_t i = 0;
-        while (n < stride) {
-
-            if ((reinterpret_cast<std::uint64_t>(ptr) & 0xF) || (stride - n) < 4) {
-                *ptr = v.f[n & 3];
-                ++ptr;
-                ++n;
-            }
-            else {
-                *reinterpret_cast<unsigned __int128*>(ptr) = v.wide;
-                ptr += 4;
-                n += 4;
-            }
-
-        }
-        ptr += pitch;
-
-#elif TARGET_64BIT
-        std::uint32_t n = 0;
-        while (n < stride) {
-            if ((ptr_value & 0x7) || (stride - n) < 2) {
-                *ptr = v.f[n & 1];
-                ++ptr;
-                ++n;
-                ptr_value += 4;
-            }
-            else {
-                *reinterpret_cast<std::uint64_t*>(ptr) = v.wide;
-                ptr += 2;
-                n += 2;
-                ptr_value += 8;
-            }
-        }
-#else
-#warning Using a naive graphics::rgba_buffer::clear_rect implementation for architecture.
-        // Fallback on a default naive implementation.
-        for (auto x = lo_x; x < hi_x; ++x) {
-            *ptr++ = v.wide;
-        }
-        ptr += pitch;
-#endif
+        kernels.fill(ptr, c.rgba.value, width);
+        ptr += stride;
     }
 }
 
@@ -264,52 +181,16 @@ auto kestrel::graphics::rgba_buffer::apply_run(const graphics::color &c, std::ui
 
     auto ptr = reinterpret_cast<color::value *>(m_buffer) + (line * static_cast<std::uint64_t>(m_size.width())) + start;
     auto len = end - start;
+    mark_dirty({ static_cast<float>(start), static_cast<float>(line), static_cast<float>(len), 1 });
 
-    union simd_value v {};
-    for (unsigned int & i : v.f) {
-        i = c.rgba.value;
-    }
-
-#if TARGET_SUPPORTS_128BIT
-    std::uint32_t n = 0;
-    while (n < len) {
-
-        if ((reinterpret_cast<std::uint64_t>(ptr) & 0xF) || (len - n) < 4) {
-            *ptr = blend_func_i(*ptr, v.f[n & 3]);
-            ++ptr;
-            ++n;
-        }
-        else {
-            *reinterpret_cast<unsigned __int128 *>(ptr) = blend_func({ .wide = *reinterpret_cast<unsigned __int128*>(ptr) }, v).wide;
-            ptr += 4;
-            n += 4;
-        }
-
-    }
-#elif TARGET_64BIT
-    std::uint32_t n = 0;
-    while (n < len) {
-        if ((reinterpret_cast<std::uint64_t>(ptr) & 0x7) || (len - n) < 2) {
-            *ptr = blend_func_i(*ptr, v.f[n & 1]);
-            ++ptr;
-            ++n;
-        }
-        else {
-            *reinterpret_cast<std::uint64_t*>(ptr) = blend_func({ .wide = *reinterpret_cast<std::uint64_t*>(ptr) }, v).wide;
-            ptr += 2;
-            n += 2;
-        }
-    }
-#else
-    // Fallback on a default naive implementation.
-    for (auto x = start; x < end; ++x) {
-        *ptr++ = v.wide;
-    }
-#endif
+    compositing::active().blend_color(ptr, c.rgba.value, len);
 }
 
 auto kestrel::graphics::rgba_buffer::apply_run(const std::vector<graphics::color> &cv, std::uint64_t start, std::uint64_t line) -> void
 {
+    // The colors are blended directly out of the vector, which relies on a color being nothing more than its value.
+    static_assert(sizeof(graphics::color) == sizeof(color::value));
+
     if (line < m_clipping_rect.y() || line >= m_clipping_rect.max_y()) {
         return;
     }
@@ -317,54 +198,9 @@ auto kestrel::graphics::rgba_buffer::apply_run(const std::vector<graphics::color
     auto ptr = reinterpret_cast<color::value *>(m_buffer) + (line * static_cast<std::uint64_t>(m_size.width())) + start;
     auto len = cv.size();
     len = (len > m_clipping_rect.width()) ? m_clipping_rect.width() : len;
+    mark_dirty({ static_cast<float>(start), static_cast<float>(line), static_cast<float>(len), 1 });
 
-    union simd_value v {};
-
-#if TARGET_SUPPORTS_128BIT
-    std::uint32_t n = 0;
-    std::uint64_t i = 0;
-    while (n < len) {
-
-        if ((reinterpret_cast<std::uint64_t>(ptr) & 0xF) || (len - n) < 4) {
-            *ptr = blend_func_i(*ptr, cv[i++].rgba.value);
-            ++ptr;
-            ++n;
-        }
-        else {
-            v.f[0] = cv[i++].rgba.value;
-            v.f[1] = cv[i++].rgba.value;
-            v.f[2] = cv[i++].rgba.value;
-            v.f[3] = cv[i++].rgba.value;
-
-            *reinterpret_cast<unsigned __int128 *>(ptr) = blend_func({ .wide = *reinterpret_cast<unsigned __int128*>(ptr) }, v).wide;
-            ptr += 4;
-            n += 4;
-        }
-
-    }
-#elif TARGET_64BIT
-    std::uint32_t n = 0;
-    std::uint32_t i = 0;
-    while (n < len) {
-        if ((reinterpret_cast<std::uint64_t>(ptr) & 0x7) || (len - n) < 2) {
-            *ptr = blend_func_i(*ptr, cv[i++].rgba.value);
-            ++ptr;
-            ++n;
-        }
-        else {
-            v.f[0] = cv[i++].rgba.value;
-            v.f[1] = cv[i++].rgba.value;
-            *reinterpret_cast<std::uint64_t*>(ptr) = blend_func({ .wide = *reinterpret_cast<std::uint64_t*>(ptr) }, v).wide;
-            ptr += 2;
-            n += 2;
-        }
-    }
-#else
-    // Fallback on a default naive implementation.
-    for (auto x = start; x < end; ++x) {
-        *ptr++ = cv[i++].rgba.value;
-    }
-#endif
+    compositing::active().blend_run(ptr, reinterpret_cast<const color::value *>(cv.data()), len);
 }
 
 auto kestrel::graphics::rgba_buffer::apply_run(const data::block& cv, std::uint64_t start, std::uint64_t line) -> void
@@ -376,58 +212,117 @@ auto kestrel::graphics::rgba_buffer::apply_run(const data::block& cv, std::uint6
     auto ptr = reinterpret_cast<color::value *>(m_buffer) + (line * static_cast<std::uint64_t>(m_size.width())) + start;
     auto len = cv.size() >> 2; // We're looking at bytes, not colors, so divide by 4 to account for the components
     len = (len > m_clipping_rect.width()) ? m_clipping_rect.width() : len;
+    mark_dirty({ static_cast<float>(start), static_cast<float>(line), static_cast<float>(len), 1 });
 
-    union simd_value v {};
+    compositing::active().blend_run(ptr, cv.get<color::value *>(), len);
+}
 
-#if TARGET_SUPPORTS_128BIT
-    std::uint32_t n = 0;
-    std::uint64_t i = 0;
-    while (n < len) {
+// MARK: - Blitting
 
-        if ((reinterpret_cast<std::uint64_t>(ptr) & 0xF) || (len - n) < 4) {
-            *ptr = blend_func_i(*ptr, cv.get<color::value>(i));
-            i += 4;
-            ++ptr;
-            ++n;
-        }
-        else {
-            v.f[0] = cv.get<uint32_t>(i); i += 4;
-            v.f[1] = cv.get<uint32_t>(i); i += 4;
-            v.f[2] = cv.get<uint32_t>(i); i += 4;
-            v.f[3] = cv.get<uint32_t>(i); i += 4;
-
-            *reinterpret_cast<unsigned __int128 *>(ptr) = blend_func({ .wide = *reinterpret_cast<unsigned __int128*>(ptr) }, v).wide;
-            ptr += 4;
-            n += 4;
+static auto lerp_pixel(kestrel::graphics::color::value a, kestrel::graphics::color::value b, std::uint32_t weight) -> kestrel::graphics::color::value
+{
+    // Interpolate two channels at a time, using 8-bit fixed point weights.
+    auto inverse = 0x100 - weight;
+    auto rb = (((a & 0xff00ff) * inverse) + ((b & 0xff00ff) * weight)) >> 8;
+    auto ag = ((((a >> 8) & 0xff00ff) * inverse) + (((b >> 8) & 0xff00ff) * weight));
+    return (rb & 0xff00ff) | (ag & 0xff00ff00);
+}
+
+static auto scale_sample(std::int64_t offset, std::uint32_t src_len, float scale, bool linear) -> std::tuple<std::uint32_t, std::uint32_t, std::uint32_t>
+{
+    if (!linear) {
+        auto index = static_cast<std::int64_t>(std::floor(static_cast<float>(offset) * scale));
+        auto lo = static_cast<std::uint32_t>(std::clamp<std::int64_t>(index, 0, src_len - 1));
+        return { lo, lo, 0 };
+    }
+
+    // Sample from pixel centres, so that the edges of the source are not over represented.
+    auto position = std::max(0.f, ((static_cast<float>(offset) + 0.5f) * scale) - 0.5f);
+    auto lo = static_cast<std::uint32_t>(std::min<std::int64_t>(static_cast<std::int64_t>(position), src_len - 1));
+    auto hi = std::min(lo + 1, src_len - 1);
+    auto weight = static_cast<std::uint32_t>((position - static_cast<float>(lo)) * 256.f);
+    return { lo, hi, std::min(weight, 0x100U) };
+}
+
+auto kestrel::graphics::rgba_buffer::blit(const color::value *src, const math::size &src_size, std::size_t stride, const math::rect &frame, scale_filter filter) -> void
+{
+    auto src_width = static_cast<std::uint32_t>(src_size.width());
+    auto src_height = static_cast<std::uint32_t>(src_size.height());
+    auto frame_x = static_cast<std::int64_t>(std::floor(frame.x()));
+    auto frame_y = static_cast<std::int64_t>(std::floor(frame.y()));
+    auto frame_width = static_cast<std::int64_t>(std::round(frame.width()));
+    auto frame_height = static_cast<std::int64_t>(std::round(frame.height()));
+    if (!src || src_width == 0 || src_height == 0 || frame_width <= 0 || frame_height <= 0) {
+        return;
+    }
+
+    // Determine the part of the frame that is both inside the buffer and the clipping rect.
+    auto lo_x = std::max({ frame_x, static_cast<std::int64_t>(m_clipping_rect.x()), std::int64_t(0) });
+    auto lo_y = std::max({ frame_y, static_cast<std::int64_t>(m_clipping_rect.y()), std::int64_t(0) });
+    auto hi_x = std::min({ frame_x + frame_width, static_cast<std::int64_t>(m_clipping_rect.max_x()), static_cast<std::int64_t>(m_size.width()) });
+    auto hi_y = std::min({ frame_y + frame_height, static_cast<std::int64_t>(m_clipping_rect.max_y()), static_cast<std::int64_t>(m_size.height()) });
+    if (lo_x >= hi_x || lo_y >= hi_y) {
+        return;
+    }
+    mark_dirty({ static_cast<float>(lo_x), static_cast<float>(lo_y), static_cast<float>(hi_x - lo_x), static_cast<float>(hi_y - lo_y) });
+
+    const auto& kernels = compositing::active();
+    auto stride_width = static_cast<std::uint64_t>(m_size.width());
+    auto len = static_cast<std::size_t>(hi_x - lo_x);
+    auto dst = reinterpret_cast<color::value *>(m_buffer) + (lo_y * stride_width) + lo_x;
+
+    // Unscaled sources are blended directly out of the source rows.
+    if (frame_width == static_cast<std::int64_t>(src_width) && frame_height == static_cast<std::int64_t>(src_height)) {
+        auto row = src + ((lo_y - frame_y) * stride) + (lo_x - frame_x);
+        for (auto y = lo_y; y < hi_y; ++y) {
+            kernels.blend_run(dst, row, len);
+            dst += stride_width;
+            row += stride;
         }
+        return;
+    }
+
+    auto linear = (filter == scale_filter::linear);
+    auto x_scale = static_cast<float>(src_width) / static_cast<float>(frame_width);
+    auto y_scale = static_cast<float>(src_height) / static_cast<float>(frame_height);
 
+    m_blit_columns.resize(len);
+    m_blit_scanline.resize(len);
+    for (std::size_t n = 0; n < len; ++n) {
+        auto [lo, hi, weight] = scale_sample(lo_x - frame_x + static_cast<std::int64_t>(n), src_width, x_scale, linear);
+        m_blit_columns[n] = { lo, hi, weight };
     }
-#elif TARGET_64BIT
-    std::uint32_t n = 0;
-    std::uint32_t i = 0;
-    while (n < len) {
-        if ((reinterpret_cast<std::uint64_t>(ptr) & 0x7) || (len - n) < 2) {
-            *ptr = blend_func_i(*ptr, cv.get<color::value>(i));
-            i += 4;
-            ++ptr;
-            ++n;
+
+    std::optional<std::uint32_t> sampled_row;
+    for (auto y = lo_y; y < hi_y; ++y) {
+        auto [row_lo, row_hi, row_weight] = scale_sample(y - frame_y, src_height, y_scale, linear);
+
+        if (!linear) {
+            // Consecutive destination rows frequently sample the same source row when enlarging.
+            if (sampled_row != row_lo) {
+                auto row = src + (row_lo * stride);
+                for (std::size_t n = 0; n < len; ++n) {
+                    m_blit_scanline[n] = row[m_blit_columns[n].lo];
+                }
+                sampled_row = row_lo;
+            }
         }
         else {
-            v.f[0] = cv.get<color::value>(i);
-            i += 4;
-            v.f[1] = cv.get<color::value>(i);
-            i += 4;
-            *reinterpret_cast<std::uint64_t*>(ptr) = blend_func({ .wide = *reinterpret_cast<std::uint64_t*>(ptr) }, v).wide;
-            ptr += 2;
-            n += 2;
+            auto top = src + (row_lo * stride);
+            auto bottom = src + (row_hi * stride);
+            for (std::size_t n = 0; n < len; ++n) {
+                const auto& column = m_blit_columns[n];
+                m_blit_scanline[n] = lerp_pixel(
+                    lerp_pixel(top[column.lo], top[column.hi], column.weight),
+                    lerp_pixel(bottom[column.lo], bottom[column.hi], column.weight),
+                    row_weight
+                );
+            }
         }
+
+        kernels.blend_run(dst, m_blit_scanline.data(), len);
+        dst += stride_width;
     }
-#else
-    // Fallback on a default naive implementation.
-    for (auto x = start; x < end; ++x) {
-        *ptr++ = cv.get<color::value>(i); i += 4;
-    }
-#endif
 }
 
 // MARK: - Masking
@@ -441,13 +336,77 @@ auto kestrel::graphics::rgba_buffer::apply_mask(const graphics::rgba_buffer &buf
 
     auto len = count() >> 2;
     auto ptr = reinterpret_cast<color::value *>(m_buffer);
-    auto mask_ptr = reinterpret_cast<color::value *>(buffer.m_buffer);
+    mark_dirty({ math::point(0), m_size });
+    auto mask_ptr = reinterpret_cast<const color::value *>(buffer.m_buffer);
 
-    // TODO: This needs to be made more efficient on each architecture
+    compositing::active().mask(ptr, mask_ptr, len);
+}
+
+// MARK: - Dirty Regions
 
-    std::uint32_t n = 0;
-    do {
-        ptr[n] &= 0x00FFFFFF;
-        ptr[n] |= ((0xFF - (mask_ptr[n] & 0xFF)) << 24);
-    } while (++n < len);
+static auto regions_touch(const kestrel::math::rect& a, const kestrel::math::rect& b) -> bool
+{
+    auto x_overlap = a.x() < b.max_x() && b.x() < a.max_x();
+    auto y_overlap = a.y() < b.max_y() && b.y() < a.max_y();
+    auto x_touch = a.x() <= b.max_x() && b.x() <= a.max_x();
+    auto y_touch = a.y() <= b.max_y() && b.y() <= a.max_y();
+
+    // Rects that only meet at a corner are kept apart, as their union would mostly be untouched pixels.
+    return (x_overlap && y_touch) || (y_overlap && x_touch);
+}
+
+static auto region_union(const kestrel::math::rect& a, const kestrel::math::rect& b) -> kestrel::math::rect
+{
+    auto x = std::min(a.x(), b.x());
+    auto y = std::min(a.y(), b.y());
+    return { x, y, std::max(a.max_x(), b.max_x()) - x, std::max(a.max_y(), b.max_y()) - y };
+}
+
+auto kestrel::graphics::rgba_buffer::mark_dirty(const math::rect &r) -> void
+{
+    auto lo_x = std::max(0.f, std::floor(r.x()));
+    auto lo_y = std::max(0.f, std::floor(r.y()));
+    auto hi_x = std::min(m_size.width(), std::ceil(r.max_x()));
+    auto hi_y = std::min(m_size.height(), std::ceil(r.max_y()));
+    if (hi_x <= lo_x || hi_y <= lo_y) {
+        return;
+    }
+    math::rect region(lo_x, lo_y, hi_x - lo_x, hi_y - lo_y);
+
+    // Absorb every existing region that the new one touches. Growing the region may bring it into contact with
+    // regions that were previously skipped, so restart the scan after each merge.
+    auto it = m_dirty_regions.begin();
+    while (it != m_dirty_regions.end()) {
+        if (regions_touch(region, *it)) {
+            region = region_union(region, *it);
+            m_dirty_regions.erase(it);
+            it = m_dirty_regions.begin();
+        }
+        else {
+            ++it;
+        }
+    }
+
+    if (m_dirty_regions.size() >= max_dirty_regions) {
+        for (const auto& existing : m_dirty_regions) {
+            region = region_union(region, existing);
+        }
+        m_dirty_regions.clear();
+    }
+    m_dirty_regions.emplace_back(region);
+}
+
+auto kestrel::graphics::rgba_buffer::clear_dirty_regions() -> void
+{
+    m_dirty_regions.clear();
+}
+
+auto kestrel::graphics::rgba_buffer::has_dirty_regions() const -> bool
+{
+    return !m_dirty_regions.empty();
+}
+
+auto kestrel::graphics::rgba_buffer::dirty_regions() const -> const std::vector<math::rect>&
+{
+    return m_dirty_regions;
 }
@@ -38,40 +38,37 @@ namespace kestrel::graphics
         std::uint64_t m_count { 0 };
         math::size m_size { 0 };
         math::rect m_clipping_rect;
+        std::vector<math::rect> m_dirty_regions;
 
-        struct components
+        struct sample
         {
-            std::uint8_t r;
-            std::uint8_t g;
-            std::uint8_t b;
-            std::uint8_t a;
+            std::uint32_t lo;
+            std::uint32_t hi;
+            std::uint32_t weight;
         };
 
-        union alignas(16) simd_value
-        {
-        #if TARGET_SUPPORTS_128BIT
-            unsigned __int128 wide;
-            std::uint32_t f[4];
-            struct components c[4];
-        #elif TARGET_64BIT
-            std::uint64_t wide;
-            std::uint32_t f[2];
-            struct components c[2];
-        #else
-            std::uint32_t wide;
-            std::uint32_t f[1];
-            struct components c[1];
-        #endif
-        };
+        std::vector<sample> m_blit_columns;
+        std::vector<graphics::color::value> m_blit_scanline;
 
         auto common_construction() -> void;
         [[nodiscard]] static auto corrected(std::uint64_t i) -> std::uint64_t;
         [[nodiscard]] auto index(const math::point& p) const -> std::uint64_t;
 
-        static inline auto blend_func_i(color::value bottom, color::value top) -> color::value;
-        static inline auto blend_func(const union simd_value& bottom, const union simd_value& top) -> union simd_value;
-
     public:
+        /**
+         * The filter used to sample a source image when a blit scales it.
+         */
+        enum class scale_filter : std::uint8_t
+        {
+            nearest, linear
+        };
+
+        /**
+         * The maximum number of disjoint dirty regions tracked before they are collapsed into a single bounding
+         * region. Beyond this point the cost of issuing many small uploads outweighs the extra pixels sent.
+         */
+        static constexpr std::size_t max_dirty_regions = 16;
+
         explicit rgba_buffer(const math::size& sz);
         rgba_buffer(const std::vector<color::value>& data, const math::size& sz);
 
@@ -99,7 +96,23 @@ namespace kestrel::graphics
         auto apply_run(const std::vector<graphics::color>& cv, std::uint64_t start, std::uint64_t line) -> void;
         auto apply_run(const data::block& cv, std::uint64_t start, std::uint64_t line) -> void;
 
+        /**
+         * Blend a source image over the buffer, scaling it to fill the destination frame. The source rows are read in
+         * place, each being `stride` pixels apart, and only the portion of the frame inside the clipping rect is
+         * touched. Scaled blits sample into a scratch scanline that is reused between calls.
+         */
+        auto blit(const graphics::color::value *src, const math::size& src_size, std::size_t stride, const math::rect& frame, scale_filter filter = scale_filter::nearest) -> void;
+
         auto apply_mask(const rgba_buffer& buffer) -> void;
+
+        /**
+         * Record that the pixels within the specified rect have been modified. The rect is clipped to the buffer
+         * and merged with any existing dirty region that it overlaps or shares an edge with.
+         */
+        auto mark_dirty(const math::rect& r) -> void;
+        auto clear_dirty_regions() -> void;
+        [[nodiscard]] auto has_dirty_regions() const -> bool;
+        [[nodiscard]] auto dirty_regions() const -> const std::vector<math::rect>&;
     };
 
 }
@@ -82,6 +82,15 @@ auto kestrel::image::basic_image::sprite_sheet() const -> std::shared_ptr<graphi
     return m_sheet;
 }
 
+auto kestrel::image::basic_image::estimated_memory_size() const -> std::size_t
+{
+    if (!m_sheet || !m_sheet->texture()) {
+        return 0;
+    }
+    auto size = m_sheet->texture()->size();
+    return static_cast<std::size_t>(size.width()) * static_cast<std::size_t>(size.height()) * 4;
+}
+
 // MARK: - Configuration
 
 auto kestrel::image::basic_image::configure(resource_core::identifier id, const std::string &name, const math::size &size, const data::block &data) -> void
@@ -101,6 +110,17 @@ auto kestrel::image::basic_image::configure(int64_t id, const std::string& name,
     m_sheet = sheet;
 }
 
+auto kestrel::image::basic_image::make_reloadable(const std::string& type, const graphics::texture::reload_function& reload) -> void
+{
+    if (!m_sheet || !m_sheet->texture()) {
+        return;
+    }
+
+    auto tex = m_sheet->texture();
+    tex->set_source(type + " #" + std::to_string(m_id) + (m_name.empty() ? "" : " " + m_name));
+    tex->set_residency_policy(graphics::residency_policy::reload_on_demand, reload);
+    m_sheet->allow_atlas_packing();
+}
 
 auto kestrel::image::basic_image::layout_sprites(const math::size& sprite_size) -> void
 {
@@ -49,6 +49,11 @@ namespace kestrel::image
 
         [[nodiscard]] auto sprite_sheet() const -> std::shared_ptr<graphics::sprite_sheet>;
 
+        /**
+         * An estimate of the memory used by the image, in bytes, based on the size of its texture.
+         */
+        [[nodiscard]] auto estimated_memory_size() const -> std::size_t;
+
         [[nodiscard]] virtual auto spawn_entity(const math::point& position) const -> std::shared_ptr<ecs::entity>;
 
     protected:
@@ -58,5 +63,12 @@ namespace kestrel::image
 
         auto configure(resource_core::identifier id, const std::string& name, const math::size& size, const data::block& data) -> void;
         auto configure(resource_core::identifier id, const std::string& name, const std::shared_ptr<graphics::sprite_sheet>& sheet) -> void;
+
+        /**
+         * Attribute the texture to the resource it was decoded from, and allow its pixel data to be released once
+         * uploaded. The reload function reproduces the pixel data if it is needed again. As the pixels of a decoded
+         * resource never change, small images are also allowed to be packed into the texture atlas.
+         */
+        auto make_reloadable(const std::string& type, const graphics::texture::reload_function& reload) -> void;
     };
 }
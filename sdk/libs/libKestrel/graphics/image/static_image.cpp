@@ -18,6 +18,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <optional>
 #include <stdexcept>
 #include <libResourceCore/manager.hpp>
 #include <libData/reader.hpp>
@@ -29,6 +30,54 @@
 #include <libKestrel/graphics/image/tga.hpp>
 #include <libImage/codecs/png/png.hpp>
 
+// MARK: - Decoding
+
+struct decoded_surface
+{
+    kestrel::math::size size;
+    data::block data;
+};
+
+static auto decode_surface(const kestrel::resource::descriptor::lua_reference& descriptor, const resource_core::instance *resource) -> std::optional<decoded_surface>
+{
+    using namespace kestrel::image;
+
+    if (descriptor->type == legacy::macintosh::quickdraw::picture::resource_type::code) {
+        ::quickdraw::picture pict(resource->data(), resource->id(), resource->name());
+        const auto& surface = pict.surface();
+        return decoded_surface { kestrel::math::size(surface.size().width, surface.size().height), surface.raw() };
+    }
+    else if (descriptor->type == legacy::macintosh::quickdraw::color_icon::resource_type::code) {
+        ::quickdraw::color_icon cicn(resource->data(), resource->id(), resource->name());
+        const auto& surface = cicn.surface();
+        return decoded_surface { kestrel::math::size(surface.size().width, surface.size().height), surface.raw() };
+    }
+    else if (descriptor->type == static_image::resource_type::code) {
+        data::reader reader(&resource->data());
+        reader.change_byte_order(data::byte_order::msb);
+        auto format = reader.read_cstr(4);
+
+        if (format == "TGA ") {
+            auto tga_raw_data = reader.read_data(reader.size() - 4);
+            kestrel::image::tga tga(tga_raw_data);
+
+            const auto& surface = tga.surface();
+            return decoded_surface { kestrel::math::size(surface.size().width, surface.size().height), surface.raw() };
+        }
+        else if (format == "PNG ") {
+            auto png_raw_data = reader.read_data(reader.size() - 4);
+            ::image::codec::png png(png_raw_data);
+
+            const auto& surface = png.surface();
+            return decoded_surface { kestrel::math::size(surface.size().width, surface.size().height), surface.raw() };
+        }
+        else {
+            throw std::runtime_error("Unrecognised StaticImage format: '" + format + "' in resource: " + descriptor->type + " #" + std::to_string(descriptor->id));
+        }
+    }
+    return {};
+}
+
 // MARK: - Construction
 
 kestrel::image::static_image::static_image(resource_core::identifier id, const std::string& name, const std::shared_ptr<graphics::sprite_sheet>& sheet)
@@ -71,41 +120,16 @@ kestrel::image::static_image::static_image(const resource::descriptor::lua_refer
 
     // Attempt to load the resource data in preparation for determining the correct decoding procedure.
     if (auto resource = descriptor->load()) {
-        if (descriptor->type == legacy::macintosh::quickdraw::picture::resource_type::code) {
-            ::quickdraw::picture pict(resource->data(), resource->id(), resource->name());
-            const auto& surface = pict.surface();
-            configure(resource->id(), resource->name(), math::size(surface.size().width, surface.size().height), surface.raw());
-            return;
-        }
-        else if (descriptor->type == legacy::macintosh::quickdraw::color_icon::resource_type::code) {
-            ::quickdraw::color_icon cicn(resource->data(), resource->id(), resource->name());
-            const auto& surface = cicn.surface();
-            configure(resource->id(), resource->name(), math::size(surface.size().width, surface.size().height), surface.raw());
-            return;
-        }
-        else if (descriptor->type == resource_type::code) {
-            data::reader reader(&resource->data());
-            reader.change_byte_order(data::byte_order::msb);
-            auto format = reader.read_cstr(4);
-
-            if (format == "TGA ") {
-                auto tga_raw_data = reader.read_data(reader.size() - 4);
-                kestrel::image::tga tga(tga_raw_data);
-
-                const auto& surface = tga.surface();
-                configure(resource->id(), resource->name(), math::size(surface.size().width, surface.size().height), surface.raw());
-            }
-            else if (format == "PNG ") {
-                auto png_raw_data = reader.read_data(reader.size() - 4);
-                ::image::codec::png png(png_raw_data);
-
-                const auto& surface = png.surface();
-                configure(resource->id(), resource->name(), math::size(surface.size().width, surface.size().height), surface.raw());
-            }
-            else {
-                throw std::runtime_error("Unrecognised StaticImage format: '" + format + "' in resource: " + descriptor->type + " #" + std::to_string(descriptor->id));
-            }
-
+        if (auto surface = decode_surface(descriptor, resource)) {
+            configure(resource->id(), resource->name(), surface->size, surface->data);
+            make_reloadable(descriptor->type, [descriptor] () -> data::block {
+                if (auto resource = descriptor->load()) {
+                    if (auto surface = decode_surface(descriptor, resource)) {
+                        return surface->data;
+                    }
+                }
+                return {};
+            });
             return;
         }
     }
@@ -149,17 +173,17 @@ auto kestrel::image::static_image::load_best(const std::vector<resource::descrip
     // We couldn't de-cache, so load the asset from the manager fresh.
     if (ref->type == legacy::macintosh::quickdraw::picture::resource_type::code) {
         auto image = legacy::macintosh::quickdraw::picture::lua_reference(new legacy::macintosh::quickdraw::picture(ref));
-        cache::add(ref, image);
+        cache::add(ref, image, image->estimated_memory_size());
         return static_image::using_pict(image);
     }
     else if (ref->type == legacy::macintosh::quickdraw::color_icon::resource_type::code) {
         auto image = legacy::macintosh::quickdraw::color_icon::lua_reference(new legacy::macintosh::quickdraw::color_icon(ref));
-        cache::add(ref, image);
+        cache::add(ref, image, image->estimated_memory_size());
         return static_image::using_cicn(image);
     }
     else if (ref->type == resource_type::code) {
         auto image = static_image::lua_reference(new static_image(ref));
-        cache::add(ref, image);
+        cache::add(ref, image, image->estimated_memory_size());
         return image;
     }
 
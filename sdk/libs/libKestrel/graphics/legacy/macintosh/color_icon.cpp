@@ -33,6 +33,13 @@ kestrel::image::legacy::macintosh::quickdraw::color_icon::color_icon(const resou
         ::quickdraw::color_icon icon(resource->data(), resource->id(), resource->name());
         const auto& surface = icon.surface();
         configure(resource->id(), resource->name(), math::size(surface.size().width, surface.size().height), surface.raw());
+        make_reloadable(resource_type::code, [ref] () -> data::block {
+            if (auto resource = ref->with_type(resource_type::code)->load()) {
+                ::quickdraw::color_icon icon(resource->data(), resource->id(), resource->name());
+                return icon.surface().raw();
+            }
+            return {};
+        });
         return;
     }
     throw std::logic_error("Bad resource reference encountered: Unable to load resource.");
@@ -47,7 +54,7 @@ auto kestrel::image::legacy::macintosh::quickdraw::color_icon::load(const resour
     }
 
     auto icon = kestrel::image::legacy::macintosh::quickdraw::color_icon::lua_reference(new color_icon(ref));
-    cache::add(ref->with_type(resource_type::code), icon);
+    cache::add(ref->with_type(resource_type::code), icon, icon->estimated_memory_size());
     return icon;
 }
 
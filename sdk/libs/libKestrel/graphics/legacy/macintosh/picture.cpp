@@ -33,6 +33,13 @@ kestrel::image::legacy::macintosh::quickdraw::picture::picture(const resource::d
         ::quickdraw::picture pict(resource->data(), resource->id(), resource->name());
         const auto& surface = pict.surface();
         configure(resource->id(), resource->name(), math::size(surface.size().width, surface.size().height), surface.raw());
+        make_reloadable(resource_type::code, [ref] () -> data::block {
+            if (auto resource = ref->with_type(resource_type::code)->load()) {
+                ::quickdraw::picture pict(resource->data(), resource->id(), resource->name());
+                return pict.surface().raw();
+            }
+            return {};
+        });
         return;
     }
     throw std::logic_error("Bad resource reference encountered: Unable to load resource.");
@@ -47,7 +54,7 @@ auto kestrel::image::legacy::macintosh::quickdraw::picture::load(const resource:
     }
 
     auto image = lua_reference(new picture(ref));
-    cache::add(ref->with_type(resource_type::code), image);
+    cache::add(ref->with_type(resource_type::code), image, image->estimated_memory_size());
     return image;
 }
 
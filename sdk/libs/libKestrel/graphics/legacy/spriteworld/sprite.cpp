@@ -34,13 +34,20 @@ kestrel::image::legacy::spriteworld::sprite::sprite(const resource::descriptor::
         if (auto resource = ref->with_type(resource_type::code)->load()) {
             m_source_type = std::string(resource_type::code);
             ::spriteworld::rleD rle(resource->data(), resource->id(), resource->name());
-            m_surface = rle.surface();
+            const auto& surface = rle.surface();
             configure(resource->id(),
                       resource->name(), {
-                          static_cast<float>(m_surface.size().width),
-                          static_cast<float>(m_surface.size().height)
+                          static_cast<float>(surface.size().width),
+                          static_cast<float>(surface.size().height)
                       },
-                      m_surface.raw());
+                      surface.raw());
+            make_reloadable(resource_type::code, [ref] () -> data::block {
+                if (auto resource = ref->with_type(resource_type::code)->load()) {
+                    ::spriteworld::rleD rle(resource->data(), resource->id(), resource->name());
+                    return rle.surface().raw();
+                }
+                return {};
+            });
 
             auto frame_size = rle.frame_rect(0).size;
             layout_sprites({ static_cast<float>(frame_size.width), static_cast<float>(frame_size.height) });
@@ -52,13 +59,20 @@ kestrel::image::legacy::spriteworld::sprite::sprite(const resource::descriptor::
         if (auto resource = ref->with_type(alternate_type::code)->load()) {
             m_source_type = std::string(alternate_type::code);
             ::spriteworld::rleX rle(resource->data(), resource->id(), resource->name());
-            m_surface = rle.surface();
+            const auto& surface = rle.surface();
             configure(resource->id(),
                       resource->name(), {
-                          static_cast<float>(m_surface.size().width),
-                          static_cast<float>(m_surface.size().height)
+                          static_cast<float>(surface.size().width),
+                          static_cast<float>(surface.size().height)
                       },
-                      m_surface.raw());
+                      surface.raw());
+            make_reloadable(alternate_type::code, [ref] () -> data::block {
+                if (auto resource = ref->with_type(alternate_type::code)->load()) {
+                    ::spriteworld::rleX rle(resource->data(), resource->id(), resource->name());
+                    return rle.surface().raw();
+                }
+                return {};
+            });
 
             auto frame_size = rle.frame_rect(0).size;
             layout_sprites({ static_cast<float>(frame_size.width), static_cast<float>(frame_size.height) });
@@ -91,7 +105,7 @@ auto kestrel::image::legacy::spriteworld::sprite::load(const resource::descripto
     }
 
     auto image = lua_reference(new sprite(ref));
-    cache::add(ref->with_type(image->type()), image);
+    cache::add(ref->with_type(image->type()), image, image->estimated_memory_size());
     return image;
 }
 
@@ -24,7 +24,6 @@
 #include <libKestrel/resource/descriptor.hpp>
 #include <libKestrel/lua/runtime/runtime.hpp>
 #include <libKestrel/lua/scripting.hpp>
-#include <libQuickdraw/surface/surface.hpp>
 #include <libKestrel/resource/macro.hpp>
 
 namespace kestrel::image::legacy::spriteworld
@@ -51,6 +50,5 @@ namespace kestrel::image::legacy::spriteworld
 
     private:
         std::string m_source_type;
-        quickdraw::surface m_surface;
     };
 };
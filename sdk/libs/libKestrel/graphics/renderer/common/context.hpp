@@ -48,6 +48,12 @@ namespace kestrel::renderer
 
         virtual auto draw(const draw_buffer *buffer) -> void = 0;
 
+        /**
+         * Give the backend an opportunity to provide the storage that the next batch of vertices is written into.
+         * Backends that stream through their own buffers leave the draw buffer untouched.
+         */
+        virtual auto prepare_draw_buffer(draw_buffer *buffer) -> void {}
+
         virtual auto create_framebuffer(const math::size& size) -> renderer::framebuffer * = 0;
         virtual auto create_texture(const data::block& data, const math::size& size) -> std::shared_ptr<graphics::texture> = 0;
 
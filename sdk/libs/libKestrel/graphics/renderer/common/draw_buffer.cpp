@@ -18,14 +18,17 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
 #include <libKestrel/graphics/renderer/common/draw_buffer.hpp>
 
 // MARK: - Construction
 
 kestrel::renderer::draw_buffer::draw_buffer(std::size_t vertex_count, std::size_t texture_slots)
-    : m_max(vertex_count), m_max_textures(texture_slots)
+    : m_max(vertex_count), m_owned_max(vertex_count), m_max_textures(texture_slots)
 {
-    m_vertices = new vertex[vertex_count];
+    m_owned_vertices = new vertex[vertex_count];
+    m_vertices = m_owned_vertices;
+    m_attachments = new quad_attachments[(vertex_count + vertices_per_quad - 1) / vertices_per_quad];
     m_texture_slots = new std::shared_ptr<graphics::texture>[texture_slots];
 
     m_vertex_ptr = m_vertices;
@@ -36,8 +39,9 @@ kestrel::renderer::draw_buffer::draw_buffer(std::size_t vertex_count, std::size_
 
 kestrel::renderer::draw_buffer::~draw_buffer()
 {
-    delete m_vertices;
-    delete m_texture_slots;
+    delete[] m_owned_vertices;
+    delete[] m_attachments;
+    delete[] m_texture_slots;
 }
 
 // MARK: - Vertex Management
@@ -49,6 +53,7 @@ auto kestrel::renderer::draw_buffer::reset() -> void
 
     m_texture_count = 0;
     m_count = 0;
+    m_attachment_count = 0;
     m_blend = blending::normal;
 }
 
@@ -57,6 +62,20 @@ auto kestrel::renderer::draw_buffer::clear() -> void
     reset();
 }
 
+auto kestrel::renderer::draw_buffer::set_vertex_storage(struct vertex *storage, std::size_t vertex_count) -> void
+{
+    if (storage) {
+        m_vertices = storage;
+        m_max = std::min(vertex_count, m_owned_max);
+    }
+    else {
+        m_vertices = m_owned_vertices;
+        m_max = m_owned_max;
+    }
+
+    m_vertex_ptr = m_vertices + m_count;
+}
+
 auto kestrel::renderer::draw_buffer::can_accept_texture(const std::shared_ptr<graphics::texture> &texture) const -> bool
 {
     if (!m_texture_slots) {
@@ -95,52 +114,94 @@ auto kestrel::renderer::draw_buffer::push_texture(const std::shared_ptr<graphics
     return static_cast<float>(slot);
 }
 
-auto kestrel::renderer::draw_buffer::push_vertex(const math::vec2 &v, const math::point &tex_coord, float alpha, float texture, const std::array<math::vec4, 8>& shader_info) -> void
+auto kestrel::renderer::draw_buffer::push_quad(const math::vec2 &position, const math::vec2 &size, const math::rect &tex_coords, float alpha, float texture) -> void
+{
+    auto uv_x = tex_coords.origin().x();
+    auto uv_y = tex_coords.origin().y();
+    auto uv_w = tex_coords.size().width();
+    auto uv_h = tex_coords.size().height();
+
+    push_vertex({ position.x(), position.y() + size.y() }, { uv_x, uv_y + uv_h }, alpha, texture);
+    push_vertex({ position.x() + size.x(), position.y() + size.y() }, { uv_x + uv_w, uv_y + uv_h }, alpha, texture);
+    push_vertex({ position.x() + size.x(), position.y() }, { uv_x + uv_w, uv_y }, alpha, texture);
+    push_vertex({ position.x(), position.y() }, { uv_x, uv_y }, alpha, texture);
+}
+
+auto kestrel::renderer::draw_buffer::push_vertex(const math::vec2 &v, const math::point &tex_coord, float alpha, float texture) -> void
 {
-    m_vertex_ptr->position = vec4(v);
+    m_vertex_ptr->position = vec2(v);
     m_vertex_ptr->tex_coord = vec2(tex_coord);
-    m_vertex_ptr->color = vec4(1, 1, 1, alpha);
+    m_vertex_ptr->color = pack_color(1, 1, 1, alpha);
     m_vertex_ptr->texture = texture;
 
-    for (auto i = 0; i < shader_info.size(); ++i) {
-        m_vertex_ptr->attachments[i] = vec4(shader_info[i]);
-    }
-
     m_vertex_ptr++;
     m_count++;
 }
 
-auto kestrel::renderer::draw_buffer::push_vertex(const math::vec2 &v, const math::point &tex_coord, float alpha, float texture, const std::array<math::vec4, 8>& shader_info, const graphics::color& color) -> void
+auto kestrel::renderer::draw_buffer::push_vertex(const math::vec2 &v, const math::point &tex_coord, float alpha, float texture, const graphics::color& color) -> void
 {
-    m_vertex_ptr->position = vec4(v);
+    m_vertex_ptr->position = vec2(v);
     m_vertex_ptr->tex_coord = vec2(tex_coord);
-    m_vertex_ptr->color = vec4(color.get_red() / 255.f, color.get_green() / 255.f, color.get_blue() / 255.f, alpha);
+    m_vertex_ptr->color = pack_color(color.get_red() / 255.f, color.get_green() / 255.f, color.get_blue() / 255.f, alpha);
     m_vertex_ptr->texture = texture;
 
-    for (auto i = 0; i < shader_info.size(); ++i) {
-        m_vertex_ptr->attachments[i] = vec4(shader_info[i]);
-    }
+    m_vertex_ptr++;
+    m_count++;
+}
+
+auto kestrel::renderer::draw_buffer::push_vertex(const math::vec2 &v, const graphics::color& color) -> void
+{
+    m_vertex_ptr->position = vec2(v);
+    m_vertex_ptr->tex_coord = vec2(math::point(0));
+    m_vertex_ptr->color = pack_color(
+        color.rgba.components.r / 255.f,
+        color.rgba.components.g / 255.f,
+        color.rgba.components.b / 255.f,
+        color.rgba.components.a / 255.f
+    );
+    m_vertex_ptr->texture = -1.f;
 
     m_vertex_ptr++;
     m_count++;
 }
 
-auto kestrel::renderer::draw_buffer::push_vertex(const math::vec2 &v, const graphics::color& color, const std::array<math::vec4, 8>& shader_info) -> void
+// MARK: - Indices
+
+auto kestrel::renderer::draw_buffer::quad_indices(std::size_t quad_count) -> std::vector<std::uint32_t>
 {
-    m_vertex_ptr->position = vec4(v);
-    m_vertex_ptr->color = vec4(math::vec4(
-        color.rgba.components.r,
-        color.rgba.components.g,
-        color.rgba.components.b,
-        color.rgba.components.a
-    ) / 255.f);
+    std::vector<std::uint32_t> indices;
+    indices.reserve(quad_count * indices_per_quad);
+    for (std::size_t quad = 0; quad < quad_count; ++quad) {
+        const auto base = static_cast<std::uint32_t>(quad * vertices_per_quad);
+        for (auto index : quad_index_pattern) {
+            indices.emplace_back(base + index);
+        }
+    }
+    return indices;
+}
 
-    m_vertex_ptr->texture = -1.f;
+// MARK: - Attachment Management
 
-    for (auto i = 0; i < shader_info.size(); ++i) {
-        m_vertex_ptr->attachments[i] = vec4(shader_info[i]);
+auto kestrel::renderer::draw_buffer::push_attachments(const std::array<math::vec4, attachments_per_quad> &shader_info) -> void
+{
+    const auto quad = m_count / vertices_per_quad;
+
+    if (m_attachment_count == 0) {
+        auto is_empty = std::all_of(shader_info.begin(), shader_info.end(), [] (const math::vec4& v) {
+            return v.x() == 0 && v.y() == 0 && v.z() == 0 && v.w() == 0;
+        });
+        if (is_empty) {
+            return;
+        }
     }
 
-    m_vertex_ptr++;
-    m_count++;
+    // Quads that were pushed before the attachment stream was started still need an entry.
+    for (; m_attachment_count < quad; ++m_attachment_count) {
+        m_attachments[m_attachment_count] = {};
+    }
+
+    for (auto i = 0; i < shader_info.size(); ++i) {
+        m_attachments[quad].values[i] = vec4(shader_info[i]);
+    }
+    m_attachment_count = quad + 1;
 }
\ No newline at end of file
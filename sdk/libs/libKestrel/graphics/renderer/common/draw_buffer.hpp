@@ -21,6 +21,7 @@
 #pragma once
 
 #include <array>
+#include <vector>
 #include <libKestrel/math/point.hpp>
 #include <libKestrel/math/size.hpp>
 #include <libKestrel/math/rect.hpp>
@@ -45,6 +46,8 @@ namespace kestrel::renderer
         [[nodiscard]] inline auto is_full() const -> bool { return m_count >= m_max; }
         [[nodiscard]] inline auto is_empty() const -> bool { return m_count == 0; }
         [[nodiscard]] inline auto count() const -> std::size_t { return m_count; }
+        [[nodiscard]] inline auto quad_count() const -> std::size_t { return m_count / vertices_per_quad; }
+        [[nodiscard]] inline auto index_count() const -> std::size_t { return quad_count() * indices_per_quad; }
 
         auto set_camera(const camera& camera) -> void { m_camera = camera; }
         [[nodiscard]] inline auto camera() const -> const camera& { return m_camera; }
@@ -57,15 +60,41 @@ namespace kestrel::renderer
 
         [[nodiscard]] auto can_accept_texture(const std::shared_ptr<graphics::texture>& texture) const -> bool;
         auto push_texture(const std::shared_ptr<graphics::texture>& texture) -> float;
-        auto push_vertex(const math::vec2& v, const math::point& tex_coord, float alpha, float texture, const std::array<math::vec4, 8>& shader_info) -> void;
-        auto push_vertex(const math::vec2& v, const math::point& tex_coord, float alpha, float texture, const std::array<math::vec4, 8>& shader_info, const graphics::color& color) -> void;
-        auto push_vertex(const math::vec2 &v, const graphics::color& color, const std::array<math::vec4, 8>& shader_info) -> void;
+        auto push_quad(const math::vec2& position, const math::vec2& size, const math::rect& tex_coords, float alpha, float texture) -> void;
+        auto push_vertex(const math::vec2& v, const math::point& tex_coord, float alpha, float texture) -> void;
+        auto push_vertex(const math::vec2& v, const math::point& tex_coord, float alpha, float texture, const graphics::color& color) -> void;
+        auto push_vertex(const math::vec2 &v, const graphics::color& color) -> void;
+
+        /**
+         * Bind shader attachments to the next quad that is pushed. The attachment stream is only started once a
+         * quad has non-zero attachments, at which point every quad in the buffer is given an entry.
+         */
+        auto push_attachments(const std::array<math::vec4, attachments_per_quad>& shader_info) -> void;
 
         [[nodiscard]] inline auto data() const -> void * { return reinterpret_cast<void *>(m_vertices); }
         [[nodiscard]] inline auto data_size() const -> std::size_t { return (m_count * sizeof(vertex)); }
 
+        /**
+         * Redirect the vertices of the next batch into external storage, such as a region of mapped GPU memory, so
+         * that the backend does not need to copy them. Passing a null storage pointer returns the buffer to its own
+         * storage. The buffer must be empty when the storage is changed.
+         */
+        auto set_vertex_storage(struct vertex *storage, std::size_t vertex_count) -> void;
+        [[nodiscard]] inline auto uses_external_storage() const -> bool { return m_vertices != m_owned_vertices; }
+
+        /**
+         * Build the indices for drawing the specified number of quads. The indices are the same for every
+         * draw buffer, so backends generate them once into a static index buffer.
+         */
+        [[nodiscard]] static auto quad_indices(std::size_t quad_count) -> std::vector<std::uint32_t>;
+
+        [[nodiscard]] inline auto has_attachments() const -> bool { return m_attachment_count > 0; }
+        [[nodiscard]] inline auto attachment_data() const -> void * { return reinterpret_cast<void *>(m_attachments); }
+        [[nodiscard]] inline auto attachment_data_size() const -> std::size_t { return (m_attachment_count * sizeof(quad_attachments)); }
+
         [[nodiscard]] inline auto texture(std::uint8_t idx) const -> std::shared_ptr<graphics::texture> { return m_texture_slots[idx]; }
         [[nodiscard]] inline auto texture_slots() const -> std::size_t { return m_texture_count; }
+        [[nodiscard]] inline auto max_texture_slots() const -> std::size_t { return m_max_textures; }
 
     private:
         renderer::camera m_camera;
@@ -78,10 +107,15 @@ namespace kestrel::renderer
         std::size_t m_texture_count { 0 };
 
         std::size_t m_max { 0 };
+        std::size_t m_owned_max { 0 };
         std::size_t m_count { 0 };
 
+        struct vertex *m_owned_vertices { nullptr };
         struct vertex *m_vertices { nullptr };
         struct vertex *m_vertex_ptr { nullptr };
 
+        struct quad_attachments *m_attachments { nullptr };
+        std::size_t m_attachment_count { 0 };
+
     };
 }
\ No newline at end of file
@@ -0,0 +1,121 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <tuple>
+#include <algorithm>
+#include <libKestrel/graphics/renderer/common/draw_queue.hpp>
+
+// MARK: - Sort Key
+
+auto kestrel::renderer::draw_queue::sort_key::operator<(const sort_key &rhs) const -> bool
+{
+    return std::tie(layer, shader, blend, texture, sequence) < std::tie(rhs.layer, rhs.shader, rhs.blend, rhs.texture, rhs.sequence);
+}
+
+auto kestrel::renderer::draw_queue::make_key(const std::shared_ptr<graphics::texture>& texture, const std::shared_ptr<shader::program>& shader, enum blending mode) -> sort_key
+{
+    sort_key key;
+    key.layer = m_layer;
+    key.sequence = m_sequence++;
+
+    // Painter's order layers leave the state fields empty, so the sequence alone decides their order.
+    if (m_order == layer_order::sorted) {
+        key.shader = reinterpret_cast<std::uintptr_t>(shader.get());
+        key.blend = static_cast<std::uint8_t>(mode);
+        key.texture = reinterpret_cast<std::uintptr_t>(texture.get());
+    }
+
+    return key;
+}
+
+// MARK: - Recording
+
+auto kestrel::renderer::draw_queue::set_layer(std::uint16_t layer, enum layer_order order) -> void
+{
+    m_layer = layer;
+    m_order = order;
+}
+
+auto kestrel::renderer::draw_queue::push_quad(const std::shared_ptr<graphics::texture> &texture, const math::rect &frame,
+                                              const math::rect &tex_coords, enum blending mode, float alpha, float scale,
+                                              const std::shared_ptr<shader::program> &shader,
+                                              const std::array<math::vec4, 8> &shader_info) -> void
+{
+    auto& entry = m_commands.emplace_back();
+    entry.type = command_type::quad;
+    entry.key = make_key(texture, shader, mode);
+    entry.texture = texture;
+    entry.shader = shader;
+    entry.blend = mode;
+    entry.frame = frame;
+    entry.tex_coords = tex_coords;
+    entry.alpha = alpha;
+    entry.scale = scale;
+    entry.shader_info = shader_info;
+}
+
+auto kestrel::renderer::draw_queue::push_line(const math::point &p, const math::point &q, enum blending mode,
+                                              const graphics::color &color, float weight,
+                                              const std::shared_ptr<shader::program> &shader,
+                                              const std::array<math::vec4, 8> &shader_info) -> void
+{
+    auto& entry = m_commands.emplace_back();
+    entry.type = command_type::line;
+    entry.key = make_key(nullptr, shader, mode);
+    entry.shader = shader;
+    entry.blend = mode;
+    entry.line_start = p;
+    entry.line_end = q;
+    entry.color = color;
+    entry.weight = weight;
+    entry.shader_info = shader_info;
+}
+
+// MARK: - Submission
+
+auto kestrel::renderer::draw_queue::sort() -> void
+{
+    // Commands are large, so only their keys are sorted, and each command is then moved once into its final position.
+    m_sort_order.clear();
+    m_sort_order.reserve(m_commands.size());
+    for (std::uint32_t n = 0; n < m_commands.size(); ++n) {
+        m_sort_order.emplace_back(m_commands[n].key, n);
+    }
+
+    std::sort(m_sort_order.begin(), m_sort_order.end(), [] (const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    m_sorted_commands.clear();
+    m_sorted_commands.reserve(m_commands.size());
+    for (const auto& entry : m_sort_order) {
+        m_sorted_commands.emplace_back(std::move(m_commands[entry.second]));
+    }
+    m_commands.swap(m_sorted_commands);
+    m_sorted_commands.clear();
+}
+
+auto kestrel::renderer::draw_queue::clear() -> void
+{
+    m_commands.clear();
+    m_sequence = 0;
+    m_layer = 0;
+    m_order = layer_order::painters;
+}
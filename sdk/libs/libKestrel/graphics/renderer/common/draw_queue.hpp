@@ -0,0 +1,121 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <libKestrel/math/rect.hpp>
+#include <libKestrel/math/vec4.hpp>
+#include <libKestrel/graphics/types/color.hpp>
+#include <libKestrel/graphics/texture/texture.hpp>
+#include <libKestrel/graphics/renderer/common/shader/program.hpp>
+#include <libKestrel/graphics/renderer/common/blending.hpp>
+
+namespace kestrel::renderer
+{
+    /**
+     * How the quads recorded into a layer may be reordered. Painter's order keeps quads in the order they were
+     * submitted, whilst sorted layers are grouped by shader, blend mode and texture to reduce the number of batches.
+     */
+    enum class layer_order : std::uint8_t
+    {
+        painters, sorted
+    };
+
+    /**
+     * Records draw commands for deferred submission, so that they can be sorted into as few batches as possible
+     * before being handed to the draw buffer at the end of the frame.
+     */
+    class draw_queue
+    {
+    public:
+        enum class command_type : std::uint8_t { quad, line };
+
+        struct sort_key
+        {
+            std::uint16_t layer { 0 };
+            std::uintptr_t shader { 0 };
+            std::uint8_t blend { 0 };
+            std::uintptr_t texture { 0 };
+            std::uint32_t sequence { 0 };
+
+            auto operator<(const sort_key& rhs) const -> bool;
+        };
+
+        struct command
+        {
+            enum command_type type { command_type::quad };
+            sort_key key;
+            std::shared_ptr<graphics::texture> texture;
+            std::shared_ptr<shader::program> shader;
+            enum blending blend { blending::normal };
+            math::rect frame;
+            math::rect tex_coords;
+            float alpha { 1.f };
+            float scale { 1.f };
+            math::point line_start;
+            math::point line_end;
+            graphics::color color { graphics::color::clear_color() };
+            float weight { 1.f };
+            std::array<math::vec4, 8> shader_info;
+        };
+
+        draw_queue() = default;
+
+        /**
+         * Set the layer that subsequent commands are recorded into. Layers are drawn in ascending order.
+         */
+        auto set_layer(std::uint16_t layer, enum layer_order order = layer_order::painters) -> void;
+        [[nodiscard]] inline auto layer() const -> std::uint16_t { return m_layer; }
+        [[nodiscard]] inline auto order() const -> enum layer_order { return m_order; }
+
+        auto push_quad(const std::shared_ptr<graphics::texture>& texture, const math::rect& frame, const math::rect& tex_coords,
+                       enum blending mode, float alpha, float scale, const std::shared_ptr<shader::program>& shader,
+                       const std::array<math::vec4, 8>& shader_info) -> void;
+
+        auto push_line(const math::point& p, const math::point& q, enum blending mode, const graphics::color& color, float weight,
+                       const std::shared_ptr<shader::program>& shader, const std::array<math::vec4, 8>& shader_info) -> void;
+
+        /**
+         * Sort the recorded commands into submission order.
+         */
+        auto sort() -> void;
+        auto clear() -> void;
+
+        [[nodiscard]] inline auto is_empty() const -> bool { return m_commands.empty(); }
+        [[nodiscard]] inline auto size() const -> std::size_t { return m_commands.size(); }
+        [[nodiscard]] inline auto commands() const -> const std::vector<command>& { return m_commands; }
+
+    private:
+        auto make_key(const std::shared_ptr<graphics::texture>& texture, const std::shared_ptr<shader::program>& shader, enum blending mode) -> sort_key;
+
+    private:
+        std::uint16_t m_layer { 0 };
+        enum layer_order m_order { layer_order::painters };
+        std::uint32_t m_sequence { 0 };
+        std::vector<command> m_commands;
+        std::vector<command> m_sorted_commands;
+        std::vector<std::pair<sort_key, std::uint32_t>> m_sort_order;
+    };
+}
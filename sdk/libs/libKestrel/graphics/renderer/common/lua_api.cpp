@@ -52,3 +52,43 @@ auto kestrel::renderer::lua::api::requires_new_frame() -> bool
 {
     return kestrel::renderer::frame_render_required();
 }
+
+auto kestrel::renderer::lua::api::draw_calls() -> std::uint32_t
+{
+    return renderer::last_frame_statistics().draw_calls;
+}
+
+auto kestrel::renderer::lua::api::flushes() -> std::uint32_t
+{
+    return renderer::last_frame_statistics().flushes;
+}
+
+auto kestrel::renderer::lua::api::atlas_quads() -> std::uint32_t
+{
+    return renderer::last_frame_statistics().atlas_quads;
+}
+
+auto kestrel::renderer::lua::api::draw_calls_saved() -> std::uint32_t
+{
+    return renderer::last_frame_statistics().draw_calls_saved;
+}
+
+auto kestrel::renderer::lua::api::deferred_drawing() -> bool
+{
+    return renderer::deferred_drawing();
+}
+
+auto kestrel::renderer::lua::api::set_deferred_drawing(bool deferred) -> void
+{
+    renderer::set_deferred_drawing(deferred);
+}
+
+auto kestrel::renderer::lua::api::draw_layer() -> std::uint16_t
+{
+    return renderer::draw_layer();
+}
+
+auto kestrel::renderer::lua::api::set_draw_layer(std::uint16_t layer, bool sorted) -> void
+{
+    renderer::set_draw_layer(layer, sorted ? layer_order::sorted : layer_order::painters);
+}
@@ -35,5 +35,13 @@ namespace kestrel::renderer::lua
         lua_getter(targetFrameRate, Available_0_8) auto target_framerate() -> std::uint32_t;
         lua_getter(targetFrameTime, Available_0_8) auto target_frame_time() -> float;
         lua_getter(requiresNewFrame, Available_0_8) auto requires_new_frame() -> bool;
+        lua_getter(drawCalls, Available_0_9) auto draw_calls() -> std::uint32_t;
+        lua_getter(flushes, Available_0_9) auto flushes() -> std::uint32_t;
+        lua_getter(atlasQuads, Available_0_9) auto atlas_quads() -> std::uint32_t;
+        lua_getter(drawCallsSaved, Available_0_9) auto draw_calls_saved() -> std::uint32_t;
+        lua_getter(deferredDrawing, Available_0_9) auto deferred_drawing() -> bool;
+        lua_function(setDeferredDrawing, Available_0_9) auto set_deferred_drawing(bool deferred) -> void;
+        lua_getter(drawLayer, Available_0_9) auto draw_layer() -> std::uint16_t;
+        lua_function(setDrawLayer, Available_0_9) auto set_draw_layer(std::uint16_t layer, bool sorted) -> void;
     }
 }
\ No newline at end of file
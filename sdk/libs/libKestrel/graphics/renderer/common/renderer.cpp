@@ -18,10 +18,14 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <vector>
+#include <algorithm>
 #include <imgui/imgui.h>
 #include <libKestrel/graphics/renderer/common/context.hpp>
 #include <libKestrel/graphics/renderer/common/renderer.hpp>
 #include <libKestrel/graphics/renderer/common/draw_buffer.hpp>
+#include <libKestrel/graphics/texture/atlas.hpp>
+#include <libKestrel/graphics/texture/residency.hpp>
 #include <libKestrel/graphics/renderer/opengl/context.hpp>
 #include <libKestrel/graphics/renderer/metal/context.h>
 #include <libKestrel/ui/imgui/imgui.hpp>
@@ -33,6 +37,11 @@ static struct {
     kestrel::renderer::context *context { nullptr };
     enum kestrel::renderer::api api { kestrel::renderer::api::none };
     struct kestrel::renderer::draw_buffer *drawing_buffer { nullptr };
+    kestrel::renderer::draw_queue deferred_queue;
+    bool deferred { false };
+    struct kestrel::renderer::frame_statistics frame_statistics;
+    struct kestrel::renderer::frame_statistics last_frame_statistics;
+    std::vector<const kestrel::graphics::texture *> unbatched_textures;
     bool imgui { false };
     float last_frame_time { 0.f };
     float maximum_frame_time { 0.f };
@@ -43,6 +52,146 @@ static struct {
     bool hitbox_debug { false };
 } s_renderer_api;
 
+// MARK: - Batching
+
+static auto break_batch() -> void
+{
+    s_renderer_api.frame_statistics.flushes++;
+    kestrel::renderer::flush_frame();
+}
+
+/**
+ * Follow the texture slots that the current batch would have needed had no textures been packed into the atlas. Each
+ * time those slots would have overflowed without the real batch being broken, the atlas has saved a draw call.
+ */
+static auto track_unbatched_texture(const kestrel::renderer::draw_buffer *buffer, const kestrel::graphics::texture *texture) -> void
+{
+    auto& textures = s_renderer_api.unbatched_textures;
+    if (std::find(textures.begin(), textures.end(), texture) != textures.end()) {
+        return;
+    }
+
+    if (textures.size() >= buffer->max_texture_slots()) {
+        s_renderer_api.frame_statistics.draw_calls_saved++;
+        textures.clear();
+    }
+    textures.emplace_back(texture);
+}
+
+static auto submit_quad(const std::shared_ptr<kestrel::graphics::texture> &texture, const kestrel::math::rect &frame,
+                        const kestrel::math::rect &tex_coords, enum kestrel::renderer::blending mode, float alpha, float scale,
+                        const std::shared_ptr<kestrel::renderer::shader::program>& shader,
+                        const std::array<kestrel::math::vec4, 8>& shader_info) -> void
+{
+    auto buffer = s_renderer_api.drawing_buffer;
+    auto new_shader = shader ?: kestrel::renderer::current_context()->shader_program("basic");
+
+    if ((buffer->blend() != mode || buffer->shader() != new_shader) && !buffer->is_empty()) {
+        break_batch();
+    }
+    buffer->set_blend(mode);
+    buffer->set_shader(new_shader);
+
+    // Textures that have been packed into the atlas are drawn from their page instead, which lets quads from many
+    // small textures share a single texture slot.
+    auto draw_texture = texture;
+    auto uv = tex_coords;
+    if (auto placement = kestrel::graphics::texture_atlas::shared_atlas().resolve(texture)) {
+        draw_texture = placement->page;
+        uv = placement->map(tex_coords);
+        s_renderer_api.frame_statistics.atlas_quads++;
+    }
+
+    if (!buffer->can_accept_texture(draw_texture)) {
+        break_batch();
+    }
+    track_unbatched_texture(buffer, texture.get());
+
+    auto texture_slot = buffer->push_texture(draw_texture);
+
+    auto p = (kestrel::math::vec2(frame.origin()) + buffer->camera().translation()) * buffer->camera().scale() * kestrel::renderer::scale_factor();
+    auto s = (kestrel::math::vec2(frame.size())) * buffer->camera().scale() * kestrel::renderer::scale_factor();
+
+    // Only custom shaders can make use of attachments, so the basic shader never needs them streamed.
+    if (shader) {
+        buffer->push_attachments(shader_info);
+    }
+
+    buffer->push_quad(p, s, uv, alpha, texture_slot);
+
+    if (buffer->is_full()) {
+        break_batch();
+    }
+}
+
+static auto submit_line(const kestrel::math::point &p, const kestrel::math::point &q, enum kestrel::renderer::blending mode,
+                        const kestrel::graphics::color &color, float weight,
+                        const std::shared_ptr<kestrel::renderer::shader::program>& shader,
+                        const std::array<kestrel::math::vec4, 8>& shader_info) -> void
+{
+    auto buffer = s_renderer_api.drawing_buffer;
+    auto new_shader = shader ?: kestrel::renderer::current_context()->shader_program("basic");
+
+    if ((buffer->blend() != mode || buffer->shader() != new_shader) && !buffer->is_empty()) {
+        break_batch();
+    }
+    buffer->set_blend(mode);
+    buffer->set_shader(new_shader);
+
+    auto start = (kestrel::math::vec2(p) + buffer->camera().translation()) * buffer->camera().scale();
+    auto end = (kestrel::math::vec2(q) + buffer->camera().translation()) * buffer->camera().scale();
+
+    auto delta = end - start;
+    auto width = weight / 2.f;
+    kestrel::math::vec2 normals[] = {
+        kestrel::math::vec2(-delta.y(), delta.x()).unit() * width,
+        kestrel::math::vec2(delta.y(), -delta.x()).unit() * width
+    };
+
+
+    auto uv_x = 0.0f;
+    auto uv_y = 0.0f;
+    auto uv_w = 1.0f;
+    auto uv_h = 1.0f;
+
+    if (shader) {
+        buffer->push_attachments(shader_info);
+    }
+
+    // The line is drawn as a quad, so its corners are pushed in the same order as any other quad.
+    buffer->push_vertex(start + normals[0], { uv_x +uv_w, uv_y }, 1.0, -1.f, color);
+    buffer->push_vertex(start + normals[1], { uv_x, uv_y }, 1.0, -1.f, color);
+    buffer->push_vertex(end + normals[1], { uv_x, uv_y +uv_h }, 1.0, -1.f, color);
+    buffer->push_vertex(end + normals[0], { uv_x +uv_w, uv_y +uv_h }, 1.0, -1.f, color);
+
+    if (buffer->is_full()) {
+        break_batch();
+    }
+}
+
+static auto submit_deferred_commands() -> void
+{
+    auto& queue = s_renderer_api.deferred_queue;
+    if (queue.is_empty()) {
+        return;
+    }
+
+    queue.sort();
+    for (const auto& command : queue.commands()) {
+        switch (command.type) {
+            case kestrel::renderer::draw_queue::command_type::quad: {
+                submit_quad(command.texture, command.frame, command.tex_coords, command.blend, command.alpha, command.scale, command.shader, command.shader_info);
+                break;
+            }
+            case kestrel::renderer::draw_queue::command_type::line: {
+                submit_line(command.line_start, command.line_end, command.blend, command.color, command.weight, command.shader, command.shader_info);
+                break;
+            }
+        }
+    }
+    queue.clear();
+}
+
 auto kestrel::renderer::initialize(enum renderer::api api, const math::size& size, double scale, const std::function<auto()->void> &callback) -> void
 {
     s_renderer_api.api = api;
@@ -58,7 +207,7 @@ auto kestrel::renderer::initialize(enum renderer::api api, const math::size& siz
             s_renderer_api.api = renderer::api::metal;
             metal::context::start_application(size, scale, [&, callback] (metal::context *context) {
                 s_renderer_api.context = context;
-                s_renderer_api.drawing_buffer = new draw_buffer(metal::constants::max_quads * 6, metal::constants::texture_slots);
+                s_renderer_api.drawing_buffer = new draw_buffer(metal::constants::max_quads * vertices_per_quad, metal::constants::texture_slots);
 
                 auto shader = s_renderer_api.context->shader_program("basic");
                 s_renderer_api.drawing_buffer->set_shader(shader);
@@ -71,7 +220,7 @@ auto kestrel::renderer::initialize(enum renderer::api api, const math::size& siz
         case api::opengl: {
             s_renderer_api.api = renderer::api::opengl;
             s_renderer_api.context = new opengl::context(size, scale, [] {});
-            s_renderer_api.drawing_buffer = new draw_buffer(opengl::constants::max_quads * 6, opengl::constants::texture_slots);
+            s_renderer_api.drawing_buffer = new draw_buffer(opengl::constants::max_quads * vertices_per_quad, opengl::constants::texture_slots);
 
             auto shader = s_renderer_api.context->shader_program("basic");
             s_renderer_api.drawing_buffer->set_shader(shader);
@@ -237,11 +386,19 @@ auto kestrel::renderer::start_frame(struct camera &camera, bool imgui) -> void
     s_renderer_api.drawing_buffer->set_shader(s_renderer_api.context->shader_program("basic"));
     s_renderer_api.drawing_buffer->set_blend(blending::normal);
     s_renderer_api.context->start_frame(nullptr, imgui);
+    s_renderer_api.context->prepare_draw_buffer(s_renderer_api.drawing_buffer);
 }
 
 auto kestrel::renderer::end_frame() -> void
 {
+    submit_deferred_commands();
     flush_frame();
+
+    s_renderer_api.last_frame_statistics = s_renderer_api.frame_statistics;
+    s_renderer_api.frame_statistics = {};
+    graphics::texture_atlas::shared_atlas().next_frame();
+    graphics::residency::next_frame();
+
     s_renderer_api.context->finalize_frame([] {
         auto duration = rtc::clock::global().since(s_renderer_api.frame_start_time);
         s_renderer_api.last_frame_time = duration.count();
@@ -250,10 +407,15 @@ auto kestrel::renderer::end_frame() -> void
 
 auto kestrel::renderer::flush_frame() -> void
 {
+    s_renderer_api.unbatched_textures.clear();
     if (!s_renderer_api.drawing_buffer->is_empty()) {
+        graphics::texture_atlas::shared_atlas().commit();
+        s_renderer_api.frame_statistics.draw_calls++;
+        s_renderer_api.frame_statistics.quads += s_renderer_api.drawing_buffer->quad_count();
         s_renderer_api.context->draw(s_renderer_api.drawing_buffer);
         s_renderer_api.drawing_buffer->clear();
         s_renderer_api.drawing_buffer->set_shader(s_renderer_api.context->shader_program("basic"));
+        s_renderer_api.context->prepare_draw_buffer(s_renderer_api.drawing_buffer);
     }
 }
 
@@ -262,39 +424,11 @@ auto kestrel::renderer::draw_quad(const std::shared_ptr<graphics::texture> &text
                                   const std::shared_ptr<shader::program>& shader,
                                   const std::array<math::vec4, 8>& shader_info) -> void
 {
-    auto buffer = s_renderer_api.drawing_buffer;
-    auto new_shader = shader ?: current_context()->shader_program("basic");
-
-    if ((buffer->blend() != mode || buffer->shader() != new_shader) && !buffer->is_empty()) {
-        flush_frame();
-    }
-    buffer->set_blend(mode);
-    buffer->set_shader(new_shader);
-
-    if (!buffer->can_accept_texture(texture)) {
-        flush_frame();
-    }
-
-    auto texture_slot = buffer->push_texture(texture);
-
-    auto p = (math::vec2(frame.origin()) + buffer->camera().translation()) * buffer->camera().scale() * scale_factor();
-    auto s = (math::vec2(frame.size())) * buffer->camera().scale() * scale_factor();
-
-    auto uv_x = tex_coords.origin().x();
-    auto uv_y = tex_coords.origin().y();
-    auto uv_w = tex_coords.size().width();
-    auto uv_h = tex_coords.size().height();
-
-    buffer->push_vertex({ p.x(), p.y() + s.y() }, { uv_x, uv_y +uv_h }, alpha, texture_slot, shader_info);
-    buffer->push_vertex({ p.x() + s.x(), p.y() + s.y() }, { uv_x +uv_w, uv_y +uv_h }, alpha, texture_slot, shader_info);
-    buffer->push_vertex({ p.x() + s.x(), p.y()}, { uv_x +uv_w, uv_y }, alpha, texture_slot, shader_info);
-    buffer->push_vertex({ p.x(), p.y() + s.y() }, { uv_x, uv_y +uv_h }, alpha, texture_slot, shader_info);
-    buffer->push_vertex({ p.x(), p.y() }, { uv_x, uv_y }, alpha, texture_slot, shader_info);
-    buffer->push_vertex({ p.x() + s.x(), p.y() }, { uv_x +uv_w, uv_y }, alpha, texture_slot, shader_info);
-
-    if (buffer->is_full()) {
-        flush_frame();
+    if (s_renderer_api.deferred) {
+        s_renderer_api.deferred_queue.push_quad(texture, frame, tex_coords, mode, alpha, scale, shader, shader_info);
+        return;
     }
+    submit_quad(texture, frame, tex_coords, mode, alpha, scale, shader, shader_info);
 }
 
 auto kestrel::renderer::draw_line(const math::point &p,
@@ -305,42 +439,46 @@ auto kestrel::renderer::draw_line(const math::point &p,
                                   const std::shared_ptr<shader::program>& shader,
                                   const std::array<math::vec4, 8>& shader_info) -> void
 {
-    auto buffer = s_renderer_api.drawing_buffer;
-    auto new_shader = shader ?: current_context()->shader_program("basic");
-
-    if ((buffer->blend() != mode || buffer->shader() != new_shader) && !buffer->is_empty()) {
-        flush_frame();
+    if (s_renderer_api.deferred) {
+        s_renderer_api.deferred_queue.push_line(p, q, mode, color, weight, shader, shader_info);
+        return;
     }
-    buffer->set_blend(mode);
-    buffer->set_shader(new_shader);
+    submit_line(p, q, mode, color, weight, shader, shader_info);
+}
 
-    auto start = (math::vec2(p) + buffer->camera().translation()) * buffer->camera().scale();
-    auto end = (math::vec2(q) + buffer->camera().translation()) * buffer->camera().scale();
+// MARK: - Deferred Drawing
 
-    auto delta = end - start;
-    auto width = weight / 2.f;
-    math::vec2 normals[] = {
-        math::vec2(-delta.y(), delta.x()).unit() * width,
-        math::vec2(delta.y(), -delta.x()).unit() * width
-    };
+auto kestrel::renderer::set_deferred_drawing(bool deferred) -> void
+{
+    if (s_renderer_api.deferred && !deferred) {
+        submit_deferred_commands();
+    }
+    s_renderer_api.deferred = deferred;
+}
 
+auto kestrel::renderer::deferred_drawing() -> bool
+{
+    return s_renderer_api.deferred;
+}
 
-    auto uv_x = 0.0f;
-    auto uv_y = 0.0f;
-    auto uv_w = 1.0f;
-    auto uv_h = 1.0f;
+auto kestrel::renderer::set_draw_layer(std::uint16_t layer, enum layer_order order) -> void
+{
+    s_renderer_api.deferred_queue.set_layer(layer, order);
+}
 
-    buffer->push_vertex(start + normals[0], { uv_x +uv_w, uv_y }, 1.0, -1.f, shader_info, color);
-    buffer->push_vertex(start + normals[1], { uv_x, uv_y }, 1.0, -1.f, shader_info, color);
-    buffer->push_vertex(end + normals[1], { uv_x, uv_y +uv_h }, 1.0, -1.f, shader_info, color);
+auto kestrel::renderer::draw_layer() -> std::uint16_t
+{
+    return s_renderer_api.deferred_queue.layer();
+}
 
-    buffer->push_vertex(end + normals[1], { uv_x, uv_y +uv_h }, 1.0, -1.f, shader_info, color);
-    buffer->push_vertex(end + normals[0], { uv_x +uv_w, uv_y +uv_h }, 1.0, -1.f, shader_info, color);
-    buffer->push_vertex(start + normals[0], { uv_x +uv_w, uv_y }, 1.0, -1.f, shader_info, color);
+auto kestrel::renderer::draw_layer_order() -> enum layer_order
+{
+    return s_renderer_api.deferred_queue.order();
+}
 
-    if (buffer->is_full()) {
-        flush_frame();
-    }
+auto kestrel::renderer::last_frame_statistics() -> struct frame_statistics
+{
+    return s_renderer_api.last_frame_statistics;
 }
 
 // MARK: - Textures
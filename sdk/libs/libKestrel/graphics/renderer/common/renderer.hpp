@@ -32,6 +32,7 @@
 #include <libKestrel/graphics/renderer/common/api.hpp>
 #include <libKestrel/graphics/renderer/common/blending.hpp>
 #include <libKestrel/graphics/renderer/common/camera.hpp>
+#include <libKestrel/graphics/renderer/common/draw_queue.hpp>
 #include <libKestrel/graphics/renderer/common/render_pass.hpp>
 #include <libKestrel/graphics/renderer/common/shader/program.hpp>
 
@@ -83,6 +84,37 @@ namespace kestrel::renderer
 
     auto create_texture(const math::size& size, const data::block& data) -> std::shared_ptr<graphics::texture>;
 
+    /**
+     * Counters describing how the quads of a frame were submitted. Draw calls are the batches handed to the
+     * backend, and flushes are the batches that were ended early by a change in blend mode, shader or textures,
+     * or by the draw buffer filling up. Atlas quads were drawn from a texture atlas page rather than their own
+     * texture, and draw calls saved is an estimate of the extra batches those quads would otherwise have needed.
+     */
+    struct frame_statistics
+    {
+        std::uint32_t quads { 0 };
+        std::uint32_t draw_calls { 0 };
+        std::uint32_t flushes { 0 };
+        std::uint32_t atlas_quads { 0 };
+        std::uint32_t draw_calls_saved { 0 };
+    };
+
+    [[nodiscard]] auto last_frame_statistics() -> struct frame_statistics;
+
+    /**
+     * In deferred mode, quads and lines are recorded and sorted into batches when the frame ends, rather than
+     * being drawn immediately. Quads are grouped by shader, blend mode and texture only within sorted layers.
+     */
+    auto set_deferred_drawing(bool deferred) -> void;
+    [[nodiscard]] auto deferred_drawing() -> bool;
+
+    /**
+     * Set the layer that subsequent deferred quads and lines are recorded into. Layers are drawn in ascending order.
+     */
+    auto set_draw_layer(std::uint16_t layer, enum layer_order order = layer_order::painters) -> void;
+    [[nodiscard]] auto draw_layer() -> std::uint16_t;
+    [[nodiscard]] auto draw_layer_order() -> enum layer_order;
+
     auto draw_quad(const std::shared_ptr<graphics::texture>& texture,
                    const math::rect& frame,
                    const math::rect& tex_coords,
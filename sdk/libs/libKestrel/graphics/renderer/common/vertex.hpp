@@ -20,6 +20,9 @@
 
 #pragma once
 
+#include <array>
+#include <algorithm>
+#include <cstdint>
 #include <libKestrel/math/vec2.hpp>
 #include <libKestrel/math/vec4.hpp>
 
@@ -52,13 +55,50 @@ namespace kestrel::renderer
         explicit vec2(const math::point& p) : x(p.x()), y(p.y()) {};
     };
 
+    /**
+     * The number of vertices that are pushed for each quad. Quads are drawn as two triangles that share an edge,
+     * using a static index buffer.
+     */
+    constexpr std::size_t vertices_per_quad = 4;
+
+    /**
+     * The number of indices used to draw each quad, and the pattern they follow. The vertices of a quad are
+     * expected in the order: bottom-left, bottom-right, top-right, top-left.
+     */
+    constexpr std::size_t indices_per_quad = 6;
+    constexpr std::array<std::uint32_t, indices_per_quad> quad_index_pattern { 0, 1, 2, 0, 3, 2 };
+
+    /**
+     * The number of shader attachments that can be bound to a quad.
+     */
+    constexpr std::size_t attachments_per_quad = 8;
+
+    /**
+     * The vertex format used by all draw calls. Colors are packed as 8-bit RGBA, and are normalised by the
+     * backend when the vertex is consumed.
+     */
     struct vertex
     {
-        struct vec4 position;
-        struct vec4 color;
-        struct vec4 attachments[8];
+        struct vec2 position;
         struct vec2 tex_coord;
+        std::uint32_t color { 0 };
         float texture { 0 };
-        float unused { 0 };
     };
+
+    /**
+     * Shader attachments are only used by custom shaders. Rather than carrying them on every vertex, they are
+     * streamed separately with a single entry per quad, and only when a batch actually needs them.
+     */
+    struct quad_attachments
+    {
+        struct vec4 values[attachments_per_quad];
+    };
+
+    static inline auto pack_color(float r, float g, float b, float a) -> std::uint32_t
+    {
+        auto component = [] (float v) -> std::uint32_t {
+            return static_cast<std::uint32_t>(std::clamp(v, 0.f, 1.f) * 255.f + 0.5f);
+        };
+        return component(r) | (component(g) << 8) | (component(b) << 16) | (component(a) << 24);
+    }
 }
\ No newline at end of file
@@ -32,5 +32,7 @@ namespace kestrel::renderer::metal::constants
     {
         vertices = 0,
         viewport_size = 1,
+        attachments = 2,
+        has_attachments = 3,
     } vertex_input_index;
 }
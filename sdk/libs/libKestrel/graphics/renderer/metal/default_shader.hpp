@@ -66,6 +66,8 @@ namespace kestrel::renderer::metal
         {
         	vertices = 0,
         	viewport_size = 1,
+        	attachments = 2,
+        	has_attachments = 3,
         } vertex_input_index;
 
         typedef enum
@@ -75,17 +77,9 @@ namespace kestrel::renderer::metal
 
         typedef struct
         {
-        	float4 position;
-        	float4 color;
-            float4 attachment_0;
-            float4 attachment_1;
-            float4 attachment_2;
-            float4 attachment_3;
-            float4 attachment_4;
-            float4 attachment_5;
-            float4 attachment_6;
-            float4 attachment_7;
-        	float2 tex_coord;
+        	packed_float2 position;
+        	packed_float2 tex_coord;
+        	uchar4 color;
         	float texture;
         } vertex_descriptor;
 
@@ -114,24 +108,34 @@ namespace kestrel::renderer::metal
         vertex raster_data vertex_shader(
         	uint vertex_id [[vertex_id]],
         	constant vertex_descriptor *vertex_array [[buffer(vertex_input_index::vertices)]],
-        	constant vector_uint2 *viewport_size_ptr [[buffer(vertex_input_index::viewport_size)]]
+        	constant vector_uint2 *viewport_size_ptr [[buffer(vertex_input_index::viewport_size)]],
+        	constant float4 *attachments [[buffer(vertex_input_index::attachments)]],
+        	constant uint *has_attachments_ptr [[buffer(vertex_input_index::has_attachments)]]
         ) {
         	raster_data out;
 
-        	auto position = vertex_array[vertex_id].position;
-        	auto tex_coord = vertex_array[vertex_id].tex_coord;
-        	auto color = vertex_array[vertex_id].color;
+        	auto position = float4(float2(vertex_array[vertex_id].position), 0.0, 0.0);
+        	auto tex_coord = float2(vertex_array[vertex_id].tex_coord);
+        	auto color = float4(vertex_array[vertex_id].color) / 255.0;
         	auto texture = floor(vertex_array[vertex_id].texture);
             auto scale = 1.f;
 
-            out.attachment_0 = vertex_array[vertex_id].attachment_0;
-            out.attachment_1 = vertex_array[vertex_id].attachment_1;
-            out.attachment_2 = vertex_array[vertex_id].attachment_2;
-            out.attachment_3 = vertex_array[vertex_id].attachment_3;
-            out.attachment_4 = vertex_array[vertex_id].attachment_4;
-            out.attachment_5 = vertex_array[vertex_id].attachment_5;
-            out.attachment_6 = vertex_array[vertex_id].attachment_6;
-            out.attachment_7 = vertex_array[vertex_id].attachment_7;
+            // Attachments are streamed once per quad, and each quad is made up of 4 vertices.
+            if (*has_attachments_ptr) {
+                auto quad_attachments = attachments + (vertex_id / 4) * 8;
+                out.attachment_0 = quad_attachments[0];
+                out.attachment_1 = quad_attachments[1];
+                out.attachment_2 = quad_attachments[2];
+                out.attachment_3 = quad_attachments[3];
+                out.attachment_4 = quad_attachments[4];
+                out.attachment_5 = quad_attachments[5];
+                out.attachment_6 = quad_attachments[6];
+                out.attachment_7 = quad_attachments[7];
+            }
+            else {
+                out.attachment_0 = out.attachment_1 = out.attachment_2 = out.attachment_3 = float4(0);
+                out.attachment_4 = out.attachment_5 = out.attachment_6 = out.attachment_7 = float4(0);
+            }
 
         	float2 viewport_size = float2(*viewport_size_ptr);
             float2 pixel_space_position = floor(position.xy * scale);
@@ -55,6 +55,8 @@ namespace kestrel::renderer::metal
         id<MTLDevice> m_device { nullptr };
         id<MTLTexture> m_texture { nullptr };
         id<MTLBuffer> m_buffer { nullptr };
+        id<MTLBuffer> m_attachment_buffer { nullptr };
+        id<MTLBuffer> m_index_buffer { nullptr };
         id<MTLCommandQueue> m_command_queue { nullptr };
         id<MTLRenderCommandEncoder> m_command_encoder { nullptr };
         id<MTLCommandBuffer> m_command_buffer { nullptr };
@@ -71,7 +71,11 @@ auto kestrel::renderer::metal::framebuffer::invalidate() -> void
     m_pass_descriptor.colorAttachments[0].storeAction = MTLStoreActionStore;
 
     // Setup the vertex buffer
-    m_buffer = [m_device newBufferWithLength:constants::max_quads * 6 * sizeof(vertex) options:MTLResourceStorageModeShared];
+    m_buffer = [m_device newBufferWithLength:constants::max_quads * vertices_per_quad * sizeof(vertex) options:MTLResourceStorageModeShared];
+    m_attachment_buffer = [m_device newBufferWithLength:constants::max_quads * sizeof(quad_attachments) options:MTLResourceStorageModeShared];
+
+    auto indices = draw_buffer::quad_indices(constants::max_quads);
+    m_index_buffer = [m_device newBufferWithBytes:indices.data() length:indices.size() * sizeof(std::uint32_t) options:MTLResourceStorageModeShared];
 }
 
 // MARK: - Frame Lifecycle
@@ -123,6 +127,20 @@ auto kestrel::renderer::metal::framebuffer::draw(const draw_buffer *buffer) -> v
                                length:sizeof(m_viewport_size)
                               atIndex:constants::vertex_input_index::viewport_size];
 
+    std::uint32_t has_attachments = buffer->has_attachments() ? 1 : 0;
+    if (has_attachments) {
+        memcpy(reinterpret_cast<uint8_t *>(m_attachment_buffer.contents), buffer->attachment_data(), buffer->attachment_data_size());
+        [m_attachment_buffer didModifyRange:NSMakeRange(0, buffer->attachment_data_size())];
+    }
+
+    [m_command_encoder setVertexBuffer:m_attachment_buffer
+                                offset:0
+                               atIndex:constants::vertex_input_index::attachments];
+
+    [m_command_encoder setVertexBytes:&has_attachments
+                               length:sizeof(has_attachments)
+                              atIndex:constants::vertex_input_index::has_attachments];
+
     std::size_t slots = buffer->texture_slots();
     for (uint32_t i = 0; i < slots; ++i) {
         auto texture_container = reinterpret_cast<renderer::metal::texture *>(buffer->texture(i).get());
@@ -130,6 +148,10 @@ auto kestrel::renderer::metal::framebuffer::draw(const draw_buffer *buffer) -> v
         [m_command_encoder setFragmentTexture:texture atIndex:i];
     }
 
-    [m_command_encoder drawPrimitives:MTLPrimitiveTypeTriangle vertexStart:0 vertexCount:buffer->count()];
+    [m_command_encoder drawIndexedPrimitives:MTLPrimitiveTypeTriangle
+                                  indexCount:buffer->index_count()
+                                   indexType:MTLIndexTypeUInt32
+                                 indexBuffer:m_index_buffer
+                           indexBufferOffset:0];
 
 }
@@ -60,6 +60,9 @@ namespace kestrel::renderer::metal
         std::uint8_t *m_buffer_ptr { nullptr };
         std::size_t m_buffer_offset { 0 };
         std::size_t m_buffer_next_vertex { 0 };
+        std::array<id<MTLBuffer>, 10> m_attachment_buffer;
+        id<MTLBuffer> m_index_buffer { nullptr };
+        std::size_t m_attachment_offset { 0 };
         id<MTLCommandQueue> m_command_queue { nullptr };
         id<MTLRenderCommandEncoder> m_command_encoder { nullptr };
         id<MTLCommandBuffer> m_command_buffer { nullptr };
@@ -34,9 +34,17 @@ kestrel::renderer::metal::swap_chain::swap_chain()
 {
     // Construct a series of buffers to cycle between.
     for (auto i = 0; i < m_buffer.max_size(); ++i) {
-        m_buffer[i] = [m_device newBufferWithLength:sizeof(vertex) * constants::max_quads
+        m_buffer[i] = [m_device newBufferWithLength:sizeof(vertex) * constants::max_quads * vertices_per_quad
                                             options:MTLResourceStorageModeShared];
+        m_attachment_buffer[i] = [m_device newBufferWithLength:sizeof(quad_attachments) * constants::max_quads
+                                                       options:MTLResourceStorageModeShared];
     }
+
+    // The index buffer is identical for every draw, so it is generated once and shared by all draws.
+    auto indices = draw_buffer::quad_indices(constants::max_quads);
+    m_index_buffer = [m_device newBufferWithBytes:indices.data()
+                                           length:indices.size() * sizeof(std::uint32_t)
+                                          options:MTLResourceStorageModeShared];
 }
 
 // MARK: - Frame Lifecycle
@@ -75,6 +83,7 @@ auto kestrel::renderer::metal::swap_chain::start(id<CAMetalDrawable> drawable, i
     m_buffer_ptr = reinterpret_cast<uint8_t *>(m_buffer[m_buffer_idx].contents);
     m_buffer_offset = 0;
     m_buffer_next_vertex = 0;
+    m_attachment_offset = 0;
 }
 
 auto kestrel::renderer::metal::swap_chain::finalize(const std::function<auto() -> void>& callback) -> void
@@ -110,6 +119,19 @@ auto kestrel::renderer::metal::swap_chain::draw(const draw_buffer *buffer) -> vo
                                length:sizeof(m_viewport_size)
                               atIndex:constants::vertex_input_index::viewport_size];
 
+    std::uint32_t has_attachments = buffer->has_attachments() ? 1 : 0;
+    if (has_attachments) {
+        memcpy(reinterpret_cast<uint8_t *>(m_attachment_buffer[m_buffer_idx].contents) + m_attachment_offset, buffer->attachment_data(), buffer->attachment_data_size());
+    }
+
+    [m_command_encoder setVertexBuffer:m_attachment_buffer[m_buffer_idx]
+                                offset:m_attachment_offset
+                               atIndex:constants::vertex_input_index::attachments];
+
+    [m_command_encoder setVertexBytes:&has_attachments
+                               length:sizeof(has_attachments)
+                              atIndex:constants::vertex_input_index::has_attachments];
+
     std::size_t slots = buffer->texture_slots();
     for (uint32_t i = 0; i < slots; ++i) {
         auto texture_container = reinterpret_cast<renderer::metal::texture *>(buffer->texture(i).get());
@@ -117,10 +139,15 @@ auto kestrel::renderer::metal::swap_chain::draw(const draw_buffer *buffer) -> vo
         [m_command_encoder setFragmentTexture:texture atIndex:i];
     }
 
-    [m_command_encoder drawPrimitives:MTLPrimitiveTypeTriangle vertexStart:0 vertexCount:buffer->count()];
+    [m_command_encoder drawIndexedPrimitives:MTLPrimitiveTypeTriangle
+                                  indexCount:buffer->index_count()
+                                   indexType:MTLIndexTypeUInt32
+                                 indexBuffer:m_index_buffer
+                           indexBufferOffset:0];
     m_buffer_ptr += buffer->data_size();
     m_buffer_offset += buffer->data_size();
     m_buffer_next_vertex += buffer->count();
+    m_attachment_offset += buffer->attachment_data_size();
 }
 
 // MARK: - ImGUI
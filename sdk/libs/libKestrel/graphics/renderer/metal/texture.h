@@ -42,6 +42,7 @@ namespace kestrel::renderer::metal
         ~texture();
 
         auto set_data(const data::block& data) -> void override;
+        auto update_regions(const data::block& data, const std::vector<math::rect>& regions) -> void override;
 
         auto handle() const -> std::uint64_t override;
         auto handle_ptr() const -> id<MTLTexture>;
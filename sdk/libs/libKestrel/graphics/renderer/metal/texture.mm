@@ -81,6 +81,26 @@ auto kestrel::renderer::metal::texture::set_data(const data::block &data) -> voi
     }
 }
 
+auto kestrel::renderer::metal::texture::update_regions(const data::block &data, const std::vector<math::rect>& regions) -> void
+{
+    graphics::texture::update_regions(data, regions);
+
+    if (uploaded()) {
+        NSUInteger bytes_per_row = m_handle.width << 2;
+        auto pixels = reinterpret_cast<const std::uint8_t *>(m_data.get<void *>());
+
+        for (const auto& r : regions) {
+            auto x = static_cast<NSUInteger>(r.x());
+            auto y = static_cast<NSUInteger>(r.y());
+            MTLRegion region = MTLRegionMake2D(x, y, static_cast<NSUInteger>(r.width()), static_cast<NSUInteger>(r.height()));
+            region.origin.z = 0;
+            region.size.depth = 1;
+
+            [m_handle replaceRegion:region mipmapLevel:0 withBytes:pixels + (y * bytes_per_row) + (x << 2) bytesPerRow:bytes_per_row];
+        }
+    }
+}
+
 auto kestrel::renderer::metal::texture::handle() const -> std::uint64_t
 {
     return reinterpret_cast<std::uint64_t>(m_handle);
@@ -95,6 +115,11 @@ auto kestrel::renderer::metal::texture::handle_ptr() const -> id<MTLTexture>
 
 auto kestrel::renderer::metal::texture::upload_to_gpu() -> void
 {
+    // Pixel data that was dropped after the first upload, and can not be reproduced, is not uploaded again.
+    if (!has_data()) {
+        return;
+    }
+
     m_id = s_texture_id++;
 
     auto ctx = reinterpret_cast<metal::context *>(renderer::current_context());
@@ -112,7 +137,7 @@ auto kestrel::renderer::metal::texture::upload_to_gpu() -> void
     region.size.depth = 1;
 
     NSUInteger bytes_per_row = m_handle.width << 2;
-    [m_handle replaceRegion:region mipmapLevel:0 withBytes:m_data.get<void *>() bytesPerRow:bytes_per_row];
+    [m_handle replaceRegion:region mipmapLevel:0 withBytes:data().get<void *>() bytesPerRow:bytes_per_row];
 
     graphics::texture::upload_to_gpu();
 }
@@ -27,4 +27,5 @@ namespace kestrel::renderer::opengl::constants
     constexpr std::size_t max_quads { 10'000 };
     constexpr std::size_t texture_slots { 16 };
     constexpr std::size_t swap_count { 1 };
+    constexpr std::size_t batches_in_flight { 3 };
 }
@@ -103,42 +103,7 @@ auto kestrel::renderer::opengl::context::link_api() -> void
 
 auto kestrel::renderer::opengl::context::configure_vertex_buffer() -> void
 {
-    glGenVertexArrays(1, &m_opengl.vao);
-
-    glGenBuffers(1, &m_opengl.vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, m_opengl.vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertex) * constants::max_quads * 6, nullptr, GL_DYNAMIC_DRAW);
-
-    glBindVertexArray(m_opengl.vao);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(vertex), (const void *)offsetof(vertex, position));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(vertex), (const void *)offsetof(vertex, color));
-
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(vertex), (const void *)offsetof(vertex, tex_coord));
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(vertex), (const void *) offsetof(vertex, texture));
-
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(vertex), (const void *)offsetof(vertex, attachments[0]));
-    glEnableVertexAttribArray(5);
-    glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(vertex), (const void *)offsetof(vertex, attachments[1]));
-    glEnableVertexAttribArray(6);
-    glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(vertex), (const void *)offsetof(vertex, attachments[2]));
-    glEnableVertexAttribArray(7);
-    glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, sizeof(vertex), (const void *)offsetof(vertex, attachments[3]));
-    glEnableVertexAttribArray(8);
-    glVertexAttribPointer(8, 4, GL_FLOAT, GL_FALSE, sizeof(vertex), (const void *)offsetof(vertex, attachments[0]));
-    glEnableVertexAttribArray(9);
-    glVertexAttribPointer(9, 4, GL_FLOAT, GL_FALSE, sizeof(vertex), (const void *)offsetof(vertex, attachments[1]));
-    glEnableVertexAttribArray(10);
-    glVertexAttribPointer(10, 4, GL_FLOAT, GL_FALSE, sizeof(vertex), (const void *)offsetof(vertex, attachments[2]));
-    glEnableVertexAttribArray(11);
-    glVertexAttribPointer(11, 4, GL_FLOAT, GL_FALSE, sizeof(vertex), (const void *)offsetof(vertex, attachments[3]));
-
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    m_opengl.stream.configure(constants::max_quads, constants::batches_in_flight);
 
     for (auto i = 0; i < constants::texture_slots; ++i) {
         m_opengl.texture_samplers[i] = i;
@@ -147,7 +112,7 @@ auto kestrel::renderer::opengl::context::configure_vertex_buffer() -> void
     glEnable(GL_BLEND);
 
     for (auto i = 0; i < constants::swap_count; ++i) {
-        m_swap.passes[i] = new opengl::swap_chain(m_screen.window, m_opengl.texture_samplers, constants::texture_slots, m_opengl.vao, m_opengl.vbo);
+        m_swap.passes[i] = new opengl::swap_chain(m_screen.window, m_opengl.texture_samplers, constants::texture_slots, &m_opengl.stream);
         reinterpret_cast<opengl::swap_chain *>(m_swap.passes[i])->set_projection(m_opengl.projection);
     }
 }
@@ -248,7 +213,7 @@ auto kestrel::renderer::opengl::context::set_viewport_size(const math::size &vie
     m_opengl.projection = glm::ortho(0.0, (double)m_opengl.scaled_viewport_width, (double)m_opengl.scaled_viewport_height, 0.0, 1.0, -1.0);
 
     for (auto i = 0; i < constants::swap_count; ++i) {
-        m_swap.passes[i] = new opengl::swap_chain(m_screen.window, m_opengl.texture_samplers, constants::texture_slots, m_opengl.vao, m_opengl.vbo);
+        m_swap.passes[i] = new opengl::swap_chain(m_screen.window, m_opengl.texture_samplers, constants::texture_slots, &m_opengl.stream);
         reinterpret_cast<opengl::swap_chain *>(m_swap.passes[i])->set_projection(m_opengl.projection);
     }
 }
@@ -421,6 +386,11 @@ auto kestrel::renderer::opengl::context::draw(const draw_buffer *buffer) -> void
     render_pass->draw(buffer);
 }
 
+auto kestrel::renderer::opengl::context::prepare_draw_buffer(draw_buffer *buffer) -> void
+{
+    m_opengl.stream.prepare(buffer);
+}
+
 // MARK: - Shaders
 
 auto kestrel::renderer::opengl::context::create_shader_library(const std::string& name, const std::string &source) -> void
@@ -536,7 +506,7 @@ auto kestrel::renderer::opengl::context::link_shader_program(GLuint vertex, GLui
 
 auto kestrel::renderer::opengl::context::create_framebuffer(const math::size &size) -> renderer::framebuffer *
 {
-    auto fb = new opengl::framebuffer(m_opengl.viewport_width, m_opengl.viewport_height, m_opengl.texture_samplers, constants::texture_slots, m_opengl.vao, m_opengl.vbo);
+    auto fb = new opengl::framebuffer(m_opengl.viewport_width, m_opengl.viewport_height, m_opengl.texture_samplers, constants::texture_slots, &m_opengl.stream);
 
     return fb;
 }
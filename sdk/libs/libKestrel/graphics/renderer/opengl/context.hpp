@@ -28,6 +28,7 @@
 #include <libKestrel/event/event.hpp>
 #include <libKestrel/graphics/renderer/opengl/opengl.hpp>
 #include <libKestrel/graphics/renderer/opengl/constants.hpp>
+#include <libKestrel/graphics/renderer/opengl/vertex_stream.hpp>
 #include <libKestrel/graphics/renderer/common/shader/program.hpp>
 #include <libKestrel/graphics/renderer/common/context.hpp>
 #include <libKestrel/graphics/renderer/common/render_pass.hpp>
@@ -54,6 +55,7 @@ namespace kestrel::renderer::opengl
         auto finalize_frame(const std::function<auto() -> void>& callback) -> void override;
 
         auto draw(const draw_buffer *buffer) -> void override;
+        auto prepare_draw_buffer(draw_buffer *buffer) -> void override;
 
         auto create_framebuffer(const math::size& size) -> renderer::framebuffer * override;
         auto create_texture(const data::block& data, const math::size& size) -> std::shared_ptr<graphics::texture> override;
@@ -105,8 +107,7 @@ namespace kestrel::renderer::opengl
         } m_screen;
 
         struct {
-            GLuint vao { 0 };
-            GLuint vbo { 0 };
+            opengl::vertex_stream stream;
             std::int32_t viewport_width { 1440 };
             std::int32_t viewport_height { 900 };
             std::int32_t scaled_viewport_width { 1440 };
@@ -60,23 +60,34 @@ namespace kestrel::renderer::opengl
         layout(location = 1) in vec4 a_color;
         layout(location = 2) in vec2 a_tex_coord;
         layout(location = 3) in float a_texture;
-        layout(location = 4) in vec4 a_attachment_0;
-        layout(location = 5) in vec4 a_attachment_1;
-        layout(location = 6) in vec4 a_attachment_2;
-        layout(location = 7) in vec4 a_attachment_3;
-        layout(location = 8) in vec4 a_attachment_4;
-        layout(location = 9) in vec4 a_attachment_5;
-        layout(location = 10) in vec4 a_attachment_6;
-        layout(location = 11) in vec4 a_attachment_7;
 
         out vec2 v_tex_coord;
         out vec4 v_color;
         out float v_tex_index;
 
         uniform mat4 u_projection;
+        uniform samplerBuffer u_attachments;
+        uniform bool u_has_attachments;
+        uniform int u_vertex_base;
+
+        vec4 attachment(int n)
+        {
+            // Attachments are streamed once per quad, and each quad is made up of 4 vertices. The vertex ID includes
+            // the base vertex of the batch within the vertex ring.
+            return u_has_attachments ? texelFetch(u_attachments, ((gl_VertexID - u_vertex_base) / 4) * 8 + n) : vec4(0.0);
+        }
 
         void main()
         {
+            vec4 a_attachment_0 = attachment(0);
+            vec4 a_attachment_1 = attachment(1);
+            vec4 a_attachment_2 = attachment(2);
+            vec4 a_attachment_3 = attachment(3);
+            vec4 a_attachment_4 = attachment(4);
+            vec4 a_attachment_5 = attachment(5);
+            vec4 a_attachment_6 = attachment(6);
+            vec4 a_attachment_7 = attachment(7);
+
             @@VERTEX_FUNCTION@@
         }
     )"};
@@ -29,14 +29,13 @@
 
 // MARK: - Construction
 
-kestrel::renderer::opengl::framebuffer::framebuffer(std::uint32_t width, std::uint32_t height, const GLint *textures, std::uint32_t slot_count, std::uint32_t vao, std::uint32_t vbo)
+kestrel::renderer::opengl::framebuffer::framebuffer(std::uint32_t width, std::uint32_t height, const GLint *textures, std::uint32_t slot_count, vertex_stream *stream)
     : renderer::framebuffer(width, height),
       m_width(width),
       m_height(height),
       m_textures(textures),
       m_slot_count(slot_count),
-      m_vao(vao),
-      m_vbo(vbo)
+      m_stream(stream)
 {
     // Acquire a new framebuffer for OpenGL.
     invalidate();
@@ -119,19 +118,13 @@ auto kestrel::renderer::opengl::framebuffer::draw(const draw_buffer *buffer) ->
     auto projection_location = glGetUniformLocation(shader_id, "u_projection");
     glUniformMatrix4fv(projection_location, 1, false, glm::value_ptr(m_projection));
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizei>(buffer->data_size()), buffer->data());
-
     auto slots = buffer->texture_slots();
     for (auto i = 0; i < slots; ++i) {
         glActiveTexture(GL_TEXTURE0 + i);
         glBindTexture(GL_TEXTURE_2D, buffer->texture(i).get()->handle());
     }
 
-    glBindVertexArray(m_vao);
-    glDrawArrays(GL_TRIANGLES, 0, buffer->count());
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    m_stream->draw(buffer, shader_id, static_cast<GLint>(m_slot_count));
 }
 
 // MARK: - Texture
@@ -23,13 +23,14 @@
 #include <libKestrel/util/availability.hpp>
 #include <libKestrel/graphics/renderer/common/render_pass.hpp>
 #include <libKestrel/graphics/renderer/opengl/opengl.hpp>
+#include <libKestrel/graphics/renderer/opengl/vertex_stream.hpp>
 
 namespace kestrel::renderer::opengl
 {
     class framebuffer : public renderer::framebuffer
     {
     public:
-        framebuffer(std::uint32_t width, std::uint32_t height, const GLint *textures, std::uint32_t slot_count, std::uint32_t vao, std::uint32_t vbo);
+        framebuffer(std::uint32_t width, std::uint32_t height, const GLint *textures, std::uint32_t slot_count, vertex_stream *stream);
         ~framebuffer();
 
         auto invalidate() -> void override;
@@ -51,8 +52,7 @@ namespace kestrel::renderer::opengl
         std::uint32_t m_width { 0 };
         std::uint32_t m_height { 0 };
         std::uint32_t m_slot_count { 0 };
-        std::uint32_t m_vao { 0 };
-        std::uint32_t m_vbo { 0 };
+        vertex_stream *m_stream { nullptr };
         const GLint *m_textures { nullptr };
         glm::mat4 m_projection;
         GLint m_viewport[4] { 0 };
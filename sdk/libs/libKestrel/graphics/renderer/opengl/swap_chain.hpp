@@ -23,6 +23,7 @@
 #include <libKestrel/util/availability.hpp>
 #include <libKestrel/graphics/renderer/common/render_pass.hpp>
 #include <libKestrel/graphics/renderer/opengl/opengl.hpp>
+#include <libKestrel/graphics/renderer/opengl/vertex_stream.hpp>
 
 namespace kestrel::renderer::opengl
 {
@@ -30,7 +31,7 @@ namespace kestrel::renderer::opengl
     {
     public:
         swap_chain() = default;
-        swap_chain(GLFWwindow *window, const GLint *textures, std::uint32_t slot_count, std::uint32_t vao, std::uint32_t vbo);
+        swap_chain(GLFWwindow *window, const GLint *textures, std::uint32_t slot_count, vertex_stream *stream);
         ~swap_chain() = default;
 
         auto start() -> void override;
@@ -45,8 +46,7 @@ namespace kestrel::renderer::opengl
     private:
         GLFWwindow *m_window { nullptr };
         std::uint32_t m_slot_count { 0 };
-        std::uint32_t m_vao { 0 };
-        std::uint32_t m_vbo { 0 };
+        vertex_stream *m_stream { nullptr };
         const GLint *m_textures { nullptr };
         glm::mat4 m_projection;
     };
@@ -67,10 +67,18 @@ auto kestrel::renderer::opengl::texture::handle() const -> std::uint64_t
 
 auto kestrel::renderer::opengl::texture::upload_to_gpu() -> void
 {
-    glGenTextures(1, &m_id);
+    // Pixel data that was dropped after the first upload, and can not be reproduced, is not uploaded again.
+    if (!has_data()) {
+        return;
+    }
+
+    // Replacing the data of an existing texture re-specifies its storage rather than allocating a new name.
+    if (m_id == 0) {
+        glGenTextures(1, &m_id);
+    }
 
     glBindTexture(GL_TEXTURE_2D, m_id);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, static_cast<GLsizei>(m_size.width()), static_cast<GLsizei>(m_size.height()), 0, GL_RGBA, GL_UNSIGNED_BYTE, m_data.get<void *>());
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, static_cast<GLsizei>(m_size.width()), static_cast<GLsizei>(m_size.height()), 0, GL_RGBA, GL_UNSIGNED_BYTE, data().get<void *>());
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -78,4 +86,30 @@ auto kestrel::renderer::opengl::texture::upload_to_gpu() -> void
     glBindTexture(GL_TEXTURE_2D, 0);
 
     graphics::texture::upload_to_gpu();
-}
\ No newline at end of file
+}
+
+auto kestrel::renderer::opengl::texture::update_regions(const data::block& data, const std::vector<math::rect>& regions) -> void
+{
+    graphics::texture::update_regions(data, regions);
+
+    // Until the texture is resident the whole image will be uploaded, so there is nothing to do here.
+    if (!m_uploaded || m_id == 0 || regions.empty()) {
+        return;
+    }
+
+    auto width = static_cast<GLint>(m_size.width());
+    auto pixels = reinterpret_cast<const std::uint8_t *>(m_data.get<void *>());
+
+    glBindTexture(GL_TEXTURE_2D, m_id);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+    for (const auto& region : regions) {
+        auto x = static_cast<GLint>(region.x());
+        auto y = static_cast<GLint>(region.y());
+        auto offset = (static_cast<std::size_t>(y) * width + x) << 2;
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y,
+                        static_cast<GLsizei>(region.width()), static_cast<GLsizei>(region.height()),
+                        GL_RGBA, GL_UNSIGNED_BYTE, pixels + offset);
+    }
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
@@ -41,6 +41,8 @@ namespace kestrel::renderer::opengl
 
         auto handle() const -> std::uint64_t override;
 
+        auto update_regions(const data::block& data, const std::vector<math::rect>& regions) -> void override;
+
         auto upload_to_gpu() -> void override;
 
     private:
@@ -0,0 +1,313 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <libKestrel/graphics/renderer/opengl/vertex_stream.hpp>
+#include <libKestrel/graphics/renderer/common/draw_buffer.hpp>
+#include <libKestrel/graphics/renderer/common/vertex.hpp>
+
+// MARK: - Construction
+
+kestrel::renderer::opengl::vertex_stream::vertex_stream(vertex_stream&& stream) noexcept
+{
+    *this = std::move(stream);
+}
+
+auto kestrel::renderer::opengl::vertex_stream::operator=(vertex_stream&& stream) noexcept -> vertex_stream&
+{
+    if (this != &stream) {
+        destroy();
+
+        // The source is left holding no OpenGL objects, so that its destructor does not release them.
+        m_vao = std::exchange(stream.m_vao, 0);
+        m_vbo = std::exchange(stream.m_vbo, 0);
+        m_ibo = std::exchange(stream.m_ibo, 0);
+        m_attachment_buffer = std::exchange(stream.m_attachment_buffer, 0);
+        m_attachment_texture = std::exchange(stream.m_attachment_texture, 0);
+        m_batch_capacity = std::exchange(stream.m_batch_capacity, 0);
+        m_capacity = std::exchange(stream.m_capacity, 0);
+        m_head = std::exchange(stream.m_head, 0);
+        m_attachment_capacity = std::exchange(stream.m_attachment_capacity, 0);
+        m_mapped = std::exchange(stream.m_mapped, nullptr);
+        m_prepared_base = std::exchange(stream.m_prepared_base, 0);
+        m_fences = std::move(stream.m_fences);
+        stream.m_fences.clear();
+    }
+    return *this;
+}
+
+// MARK: - Destruction
+
+kestrel::renderer::opengl::vertex_stream::~vertex_stream()
+{
+    destroy();
+}
+
+auto kestrel::renderer::opengl::vertex_stream::destroy() -> void
+{
+    // Deleting a fence or buffer that the GPU is still using is deferred by the driver until the work completes.
+    for (const auto& fence : m_fences) {
+        glDeleteSync(fence.sync);
+    }
+    m_fences.clear();
+
+    if (m_mapped) {
+        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        m_mapped = nullptr;
+    }
+
+    if (m_attachment_texture) {
+        glDeleteTextures(1, &m_attachment_texture);
+        m_attachment_texture = 0;
+    }
+
+    GLuint buffers[] = { m_vbo, m_ibo, m_attachment_buffer };
+    for (auto buffer : buffers) {
+        if (buffer) {
+            glDeleteBuffers(1, &buffer);
+        }
+    }
+    m_vbo = 0;
+    m_ibo = 0;
+    m_attachment_buffer = 0;
+
+    if (m_vao) {
+        glDeleteVertexArrays(1, &m_vao);
+        m_vao = 0;
+    }
+
+    m_head = 0;
+    m_prepared_base = 0;
+}
+
+// MARK: - Configuration
+
+auto kestrel::renderer::opengl::vertex_stream::supports_persistent_mapping() -> bool
+{
+#if TARGET_MACOS
+    // macOS tops out at OpenGL 4.1, which predates buffer storage.
+    return false;
+#else
+    return GLEW_ARB_buffer_storage;
+#endif
+}
+
+auto kestrel::renderer::opengl::vertex_stream::configure(std::size_t max_quads, std::size_t batches_in_flight) -> void
+{
+    // Reconfiguring replaces the existing buffers, rather than leaking them.
+    destroy();
+
+    m_batch_capacity = max_quads * vertices_per_quad;
+    m_capacity = m_batch_capacity * std::max<std::size_t>(batches_in_flight, 1);
+    m_attachment_capacity = max_quads;
+    m_head = 0;
+
+    const auto size = static_cast<GLsizeiptr>(sizeof(vertex) * m_capacity);
+
+    glGenVertexArrays(1, &m_vao);
+    glGenBuffers(1, &m_vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+
+#if !TARGET_MACOS
+    if (supports_persistent_mapping()) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+        m_mapped = reinterpret_cast<vertex *>(glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+
+        if (!m_mapped) {
+            // Buffer storage is immutable, so a fresh buffer is needed to fall back to orphaning.
+            glDeleteBuffers(1, &m_vbo);
+            glGenBuffers(1, &m_vbo);
+            glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+        }
+    }
+#endif
+
+    if (!m_mapped) {
+        glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    }
+
+    glBindVertexArray(m_vao);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(vertex), (const void *)offsetof(vertex, position));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(vertex), (const void *)offsetof(vertex, color));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(vertex), (const void *)offsetof(vertex, tex_coord));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(vertex), (const void *)offsetof(vertex, texture));
+
+    // The index buffer is identical for every draw, so it is generated once and bound to the vertex array. Each
+    // batch is drawn with a base vertex that locates it within the ring.
+    auto indices = draw_buffer::quad_indices(max_quads);
+    glGenBuffers(1, &m_ibo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(std::uint32_t)), indices.data(), GL_STATIC_DRAW);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    // Attachments are read by the vertex shader through a buffer texture, indexed by quad.
+    glGenBuffers(1, &m_attachment_buffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, m_attachment_buffer);
+    glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(sizeof(quad_attachments) * m_attachment_capacity), nullptr, GL_STREAM_DRAW);
+
+    glGenTextures(1, &m_attachment_texture);
+    glBindTexture(GL_TEXTURE_BUFFER, m_attachment_texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_attachment_buffer);
+
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+// MARK: - Ring Management
+
+auto kestrel::renderer::opengl::vertex_stream::prepare(draw_buffer *buffer) -> void
+{
+    if (!is_persistent() || !buffer->is_empty()) {
+        return;
+    }
+
+    // Always hand out room for a full batch, wrapping early rather than splitting a batch across the end of the ring.
+    if (m_head + m_batch_capacity > m_capacity) {
+        m_head = 0;
+    }
+
+    wait_for_region(m_head, m_head + m_batch_capacity);
+    m_prepared_base = m_head;
+    buffer->set_vertex_storage(m_mapped + m_head, m_batch_capacity);
+}
+
+auto kestrel::renderer::opengl::vertex_stream::reserve(std::size_t vertex_count) -> std::size_t
+{
+    if (m_head + vertex_count > m_capacity) {
+        if (is_persistent()) {
+            m_head = 0;
+        }
+        else {
+            orphan();
+        }
+    }
+
+    if (is_persistent()) {
+        wait_for_region(m_head, m_head + vertex_count);
+    }
+
+    return m_head;
+}
+
+auto kestrel::renderer::opengl::vertex_stream::wait_for_region(std::size_t first, std::size_t last) -> void
+{
+    for (auto it = m_fences.begin(); it != m_fences.end();) {
+        if (it->first >= last || first >= it->last) {
+            ++it;
+            continue;
+        }
+
+        // The GPU is normally several batches behind the ring head, so this wait only blocks when the CPU has
+        // lapped it within the ring.
+        GLenum result;
+        do {
+            result = glClientWaitSync(it->sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+        } while (result == GL_TIMEOUT_EXPIRED);
+
+        glDeleteSync(it->sync);
+        it = m_fences.erase(it);
+    }
+}
+
+auto kestrel::renderer::opengl::vertex_stream::orphan() -> void
+{
+    // Respecifying the storage hands the old allocation to the driver, which releases it once pending draws have
+    // completed, so the ring can start again from the beginning without waiting.
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(vertex) * m_capacity), nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    m_head = 0;
+}
+
+// MARK: - Drawing
+
+auto kestrel::renderer::opengl::vertex_stream::upload_attachments(const draw_buffer *buffer) -> void
+{
+    // Attachments are only streamed for custom shaders, so the buffer is simply orphaned before each upload.
+    glBindBuffer(GL_TEXTURE_BUFFER, m_attachment_buffer);
+    glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(sizeof(quad_attachments) * m_attachment_capacity), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, static_cast<GLsizeiptr>(buffer->attachment_data_size()), buffer->attachment_data());
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+auto kestrel::renderer::opengl::vertex_stream::draw(const draw_buffer *buffer, GLuint shader, GLint attachment_unit) -> void
+{
+    const auto count = buffer->count();
+    std::size_t base;
+
+    if (is_persistent() && buffer->data() == reinterpret_cast<void *>(m_mapped + m_prepared_base)) {
+        // The vertices were written straight into the ring.
+        base = m_prepared_base;
+    }
+    else {
+        base = reserve(count);
+
+        if (is_persistent()) {
+            std::memcpy(m_mapped + base, buffer->data(), buffer->data_size());
+        }
+        else {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+            glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+            auto ptr = glMapBufferRange(GL_ARRAY_BUFFER, static_cast<GLintptr>(base * sizeof(vertex)), static_cast<GLsizeiptr>(buffer->data_size()), flags);
+            if (ptr) {
+                std::memcpy(ptr, buffer->data(), buffer->data_size());
+                glUnmapBuffer(GL_ARRAY_BUFFER);
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+    }
+    m_head = base + count;
+
+    auto has_attachments_location = glGetUniformLocation(shader, "u_has_attachments");
+    glUniform1i(has_attachments_location, buffer->has_attachments() ? 1 : 0);
+
+    auto vertex_base_location = glGetUniformLocation(shader, "u_vertex_base");
+    glUniform1i(vertex_base_location, static_cast<GLint>(base));
+
+    if (buffer->has_attachments()) {
+        upload_attachments(buffer);
+
+        glActiveTexture(GL_TEXTURE0 + attachment_unit);
+        glBindTexture(GL_TEXTURE_BUFFER, m_attachment_texture);
+
+        auto attachments_location = glGetUniformLocation(shader, "u_attachments");
+        glUniform1i(attachments_location, attachment_unit);
+    }
+
+    glBindVertexArray(m_vao);
+    glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(buffer->index_count()), GL_UNSIGNED_INT, nullptr, static_cast<GLint>(base));
+    glBindVertexArray(0);
+
+    if (is_persistent()) {
+        m_fences.push_back({ base, base + count, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) });
+    }
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <deque>
+#include <libKestrel/util/availability.hpp>
+#include <libKestrel/graphics/renderer/opengl/opengl.hpp>
+
+namespace kestrel::renderer
+{
+    class draw_buffer;
+    struct vertex;
+}
+
+namespace kestrel::renderer::opengl
+{
+    /**
+     * Owns the vertex array and the buffers that draw buffers are streamed through. A single stream is shared by
+     * the swap chain and all framebuffers of a context.
+     *
+     * Vertices are streamed through a ring buffer that is large enough to hold several batches, so that a flush
+     * never writes to a region that the GPU may still be reading. When persistent buffer mapping is available, the
+     * ring is mapped once and draw buffers write into it directly, with fences guarding regions that are reused.
+     * Otherwise each batch is copied into the ring without synchronisation, and the buffer is orphaned when it wraps.
+     */
+    class vertex_stream
+    {
+    public:
+        vertex_stream() = default;
+        vertex_stream(const vertex_stream&) = delete;
+        vertex_stream(vertex_stream&& stream) noexcept;
+
+        /**
+         * Release the OpenGL objects of the stream. The context that the stream was configured in must be current.
+         */
+        ~vertex_stream();
+
+        auto operator=(const vertex_stream&) -> vertex_stream& = delete;
+        auto operator=(vertex_stream&& stream) noexcept -> vertex_stream&;
+
+        /**
+         * Create the buffers for the stream. This must be called once the OpenGL context has been created.
+         */
+        auto configure(std::size_t max_quads, std::size_t batches_in_flight) -> void;
+
+        /**
+         * Point the draw buffer at the next free region of the ring, if the ring is persistently mapped.
+         */
+        auto prepare(draw_buffer *buffer) -> void;
+
+        /**
+         * Upload the contents of the draw buffer and draw it using the currently bound shader program. The
+         * attachment stream, if present, is bound to the specified texture unit.
+         */
+        auto draw(const draw_buffer *buffer, GLuint shader, GLint attachment_unit) -> void;
+
+        [[nodiscard]] inline auto is_persistent() const -> bool { return m_mapped != nullptr; }
+
+    private:
+        struct fence
+        {
+            std::size_t first { 0 };
+            std::size_t last { 0 };
+            GLsync sync { nullptr };
+        };
+
+        static auto supports_persistent_mapping() -> bool;
+
+        auto destroy() -> void;
+
+        auto reserve(std::size_t vertex_count) -> std::size_t;
+        auto wait_for_region(std::size_t first, std::size_t last) -> void;
+        auto orphan() -> void;
+        auto upload_attachments(const draw_buffer *buffer) -> void;
+
+    private:
+        GLuint m_vao { 0 };
+        GLuint m_vbo { 0 };
+        GLuint m_ibo { 0 };
+        GLuint m_attachment_buffer { 0 };
+        GLuint m_attachment_texture { 0 };
+
+        std::size_t m_batch_capacity { 0 };
+        std::size_t m_capacity { 0 };
+        std::size_t m_head { 0 };
+        std::size_t m_attachment_capacity { 0 };
+
+        struct vertex *m_mapped { nullptr };
+        std::size_t m_prepared_base { 0 };
+        std::deque<struct fence> m_fences;
+    };
+}
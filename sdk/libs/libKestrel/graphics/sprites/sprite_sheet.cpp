@@ -19,6 +19,7 @@
 // SOFTWARE.
 
 #include <libKestrel/graphics/sprites/sprite_sheet.hpp>
+#include <libKestrel/graphics/texture/atlas.hpp>
 #include <libKestrel/physics/constructors/hitbox_constructor.hpp>
 
 // MARK: - Sprite Construction
@@ -199,4 +200,11 @@ auto kestrel::graphics::sprite_sheet::build_hitboxes() -> void
         auto hb = std::move(physics::hitbox_constructor::hitbox(shared_from_this(), sprite.frame()));
         sprite.set_hitbox(hb);
     }
-}
\ No newline at end of file
+}
+
+// MARK: - Atlas
+
+auto kestrel::graphics::sprite_sheet::allow_atlas_packing() -> void
+{
+    texture_atlas::shared_atlas().enroll(m_backing_texture);
+}
@@ -67,6 +67,12 @@ namespace kestrel::graphics
 
         auto build_hitboxes() -> void;
 
+        /**
+         * Allow the backing texture to be packed into the shared texture atlas. Sprite frames remain expressed in
+         * terms of the backing texture, and are rewritten into atlas coordinates by the renderer as they are drawn.
+         */
+        auto allow_atlas_packing() -> void;
+
     private:
         std::shared_ptr<graphics::texture> m_backing_texture;
         std::vector<sprite_sheet::sprite> m_sprites;
@@ -0,0 +1,361 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <limits>
+#include <cstring>
+#include <algorithm>
+#include <libKestrel/graphics/texture/atlas.hpp>
+#include <libKestrel/graphics/texture/texture.hpp>
+#include <libKestrel/graphics/renderer/common/renderer.hpp>
+
+// MARK: - Placement
+
+auto kestrel::graphics::texture_atlas::placement::map(const math::rect &uv) const -> math::rect
+{
+    return {
+        frame.x() + (uv.x() * frame.width()),
+        frame.y() + (uv.y() * frame.height()),
+        uv.width() * frame.width(),
+        uv.height() * frame.height()
+    };
+}
+
+// MARK: - Construction
+
+kestrel::graphics::texture_atlas::texture_atlas(page_factory factory, std::uint32_t page_size, std::uint32_t page_limit, std::uint32_t max_dimension)
+    : m_factory(std::move(factory)), m_page_size(page_size), m_page_limit(page_limit), m_max_dimension(std::min(max_dimension, page_size - (border * 2)))
+{
+}
+
+auto kestrel::graphics::texture_atlas::shared_atlas() -> texture_atlas&
+{
+    static texture_atlas atlas([] (const math::size& size, const data::block& data) {
+        return renderer::create_texture(size, data);
+    });
+    return atlas;
+}
+
+// MARK: - Enrollment
+
+auto kestrel::graphics::texture_atlas::enroll(const std::shared_ptr<graphics::texture> &tex) -> void
+{
+    if (!tex) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_enrolled[tex.get()] = tex;
+}
+
+auto kestrel::graphics::texture_atlas::is_enrolled(const graphics::texture *tex) const -> bool
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    auto it = m_enrolled.find(tex);
+    return (it != m_enrolled.end()) && (it->second.lock().get() == tex);
+}
+
+// MARK: - Lookup
+
+auto kestrel::graphics::texture_atlas::resolve(const std::shared_ptr<graphics::texture> &tex) -> const placement *
+{
+    if (!tex) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (!m_enabled) {
+        return nullptr;
+    }
+
+    // Entries are keyed by address, so an entry is only valid if it still refers to the same texture.
+    auto it = m_entries.find(tex.get());
+    if (it != m_entries.end()) {
+        if (it->second.source.lock() == tex) {
+            m_stats.hits++;
+            m_pages[it->second.location.page_index].last_frame = m_frame;
+            return &it->second.location;
+        }
+        m_entries.erase(it);
+    }
+
+    auto enrolled = m_enrolled.find(tex.get());
+    if (enrolled == m_enrolled.end() || enrolled->second.lock() != tex) {
+        return nullptr;
+    }
+
+    auto width = static_cast<std::uint32_t>(tex->size().width());
+    auto height = static_cast<std::uint32_t>(tex->size().height());
+    const auto& source = tex->data();
+    if (width == 0 || height == 0 || width > m_max_dimension || height > m_max_dimension
+        || source.size() < static_cast<std::size_t>(width) * height * 4)
+    {
+        m_enrolled.erase(enrolled);
+        m_stats.rejected++;
+        return nullptr;
+    }
+
+    std::uint32_t index = 0;
+    std::uint32_t x = 0;
+    std::uint32_t y = 0;
+    if (!place(width, height, index, x, y)) {
+        // Every page is in use by the current frame. The texture will be drawn on its own until space can be found.
+        return nullptr;
+    }
+
+    // Copy the texture inside its border, and extrude its edge rows and columns (and so its corners) outwards to
+    // fill the border.
+    auto& p = m_pages[index];
+    auto src = source.get<std::uint32_t *>();
+    auto dst = p.pixels.get<std::uint32_t *>();
+    for (std::uint32_t row = 0; row < height + (border * 2); ++row) {
+        auto source_row = std::min(row - std::min(row, border), height - 1);
+        auto in = src + (static_cast<std::size_t>(source_row) * width);
+        auto out = dst + (static_cast<std::size_t>(y + row) * m_page_size) + x;
+        std::fill_n(out, border, in[0]);
+        std::memcpy(out + border, in, static_cast<std::size_t>(width) << 2);
+        std::fill_n(out + border + width, border, in[width - 1]);
+    }
+    p.pending.emplace_back(static_cast<float>(x), static_cast<float>(y),
+                           static_cast<float>(width + (border * 2)), static_cast<float>(height + (border * 2)));
+    p.last_frame = m_frame;
+
+    auto scale = static_cast<float>(m_page_size);
+    entry e;
+    e.source = tex;
+    e.location.page = p.texture;
+    e.location.page_index = index;
+    e.location.frame = { (x + border) / scale, (y + border) / scale, width / scale, height / scale };
+    m_stats.packed++;
+
+    return &(m_entries[tex.get()] = std::move(e)).location;
+}
+
+// MARK: - Pages
+
+auto kestrel::graphics::texture_atlas::place(std::uint32_t width, std::uint32_t height, std::uint32_t &index, std::uint32_t &x, std::uint32_t &y) -> bool
+{
+    for (index = 0; index < m_pages.size(); ++index) {
+        if (allocate(m_pages[index], width, height, x, y)) {
+            return true;
+        }
+    }
+
+    if (m_pages.size() < m_page_limit) {
+        page p;
+        p.pixels = data::block(static_cast<std::size_t>(m_page_size) * m_page_size * 4);
+        p.pixels.set(static_cast<std::uint32_t>(0), p.pixels.size());
+        p.skyline.push_back({ 0, 0, m_page_size });
+        p.texture = m_factory(math::size(static_cast<float>(m_page_size)), p.pixels);
+        p.texture->set_source("Texture Atlas Page " + std::to_string(m_pages.size() + 1));
+        m_pages.emplace_back(std::move(p));
+
+        index = static_cast<std::uint32_t>(m_pages.size() - 1);
+        return allocate(m_pages.back(), width, height, x, y);
+    }
+
+    // Reclaim pages that only hold textures that no longer exist before evicting any live textures.
+    discard_expired();
+    for (index = 0; index < m_pages.size(); ++index) {
+        if (allocate(m_pages[index], width, height, x, y)) {
+            return true;
+        }
+    }
+
+    auto oldest = std::numeric_limits<std::uint64_t>::max();
+    for (auto i = 0; i < m_pages.size(); ++i) {
+        if (m_pages[i].last_frame < m_frame && m_pages[i].last_frame < oldest) {
+            oldest = m_pages[i].last_frame;
+            index = i;
+        }
+    }
+
+    if (oldest == std::numeric_limits<std::uint64_t>::max()) {
+        return false;
+    }
+
+    reset_page(index);
+    m_stats.evictions++;
+    return allocate(m_pages[index], width, height, x, y);
+}
+
+auto kestrel::graphics::texture_atlas::allocate(page &p, std::uint32_t width, std::uint32_t height, std::uint32_t &x, std::uint32_t &y) -> bool
+{
+    width += border * 2;
+    height += border * 2;
+
+    // Find the lowest position along the skyline that the rectangle will fit, preferring the narrowest segment
+    // when there are several candidates at the same height.
+    auto best = p.skyline.size();
+    auto best_y = std::numeric_limits<std::uint32_t>::max();
+    auto best_width = std::numeric_limits<std::uint32_t>::max();
+    for (auto i = 0; i < p.skyline.size(); ++i) {
+        if (p.skyline[i].x + width > m_page_size) {
+            break;
+        }
+
+        std::uint32_t top = 0;
+        auto remaining = static_cast<std::int64_t>(width);
+        for (auto j = i; remaining > 0 && j < p.skyline.size(); ++j) {
+            top = std::max(top, p.skyline[j].y);
+            remaining -= p.skyline[j].width;
+        }
+
+        if (top + height > m_page_size) {
+            continue;
+        }
+
+        if (top < best_y || (top == best_y && p.skyline[i].width < best_width)) {
+            best = i;
+            best_y = top;
+            best_width = p.skyline[i].width;
+        }
+    }
+
+    if (best == p.skyline.size()) {
+        return false;
+    }
+
+    x = p.skyline[best].x;
+    y = best_y;
+
+    // Raise the skyline over the allocated rectangle, trimming or removing the segments it now covers.
+    auto right = x + width;
+    p.skyline.insert(p.skyline.begin() + static_cast<std::ptrdiff_t>(best), { x, y + height, width });
+    auto next = p.skyline.begin() + static_cast<std::ptrdiff_t>(best + 1);
+    while (next != p.skyline.end() && next->x < right) {
+        auto end = next->x + next->width;
+        if (end <= right) {
+            next = p.skyline.erase(next);
+        }
+        else {
+            next->width = end - right;
+            next->x = right;
+            break;
+        }
+    }
+
+    for (auto i = 1; i < p.skyline.size();) {
+        if (p.skyline[i - 1].y == p.skyline[i].y) {
+            p.skyline[i - 1].width += p.skyline[i].width;
+            p.skyline.erase(p.skyline.begin() + i);
+        }
+        else {
+            ++i;
+        }
+    }
+
+    return true;
+}
+
+auto kestrel::graphics::texture_atlas::reset_page(std::uint32_t index) -> void
+{
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        it = (it->second.location.page_index == index) ? m_entries.erase(it) : std::next(it);
+    }
+
+    auto& p = m_pages[index];
+    p.skyline.clear();
+    p.skyline.push_back({ 0, 0, m_page_size });
+    p.pixels.set(static_cast<std::uint32_t>(0), p.pixels.size());
+    p.pending.clear();
+    p.pending.emplace_back(0.f, 0.f, static_cast<float>(m_page_size), static_cast<float>(m_page_size));
+}
+
+auto kestrel::graphics::texture_atlas::discard_expired() -> void
+{
+    for (auto it = m_enrolled.begin(); it != m_enrolled.end();) {
+        it = it->second.expired() ? m_enrolled.erase(it) : std::next(it);
+    }
+
+    std::vector<bool> live(m_pages.size(), false);
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->second.source.expired()) {
+            it = m_entries.erase(it);
+        }
+        else {
+            live[it->second.location.page_index] = true;
+            ++it;
+        }
+    }
+
+    for (auto i = 0; i < m_pages.size(); ++i) {
+        if (!live[i] && m_pages[i].last_frame < m_frame) {
+            reset_page(i);
+        }
+    }
+}
+
+// MARK: - Frames
+
+auto kestrel::graphics::texture_atlas::commit() -> void
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    for (auto& p : m_pages) {
+        if (!p.pending.empty()) {
+            p.texture->update_regions(p.pixels, p.pending);
+            p.pending.clear();
+        }
+    }
+}
+
+auto kestrel::graphics::texture_atlas::next_frame() -> void
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_frame++;
+}
+
+// MARK: - Configuration
+
+auto kestrel::graphics::texture_atlas::set_enabled(bool enabled) -> void
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_enabled = enabled;
+}
+
+auto kestrel::graphics::texture_atlas::enabled() const -> bool
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_enabled;
+}
+
+// MARK: - Statistics
+
+auto kestrel::graphics::texture_atlas::stats() const -> statistics
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    auto stats = m_stats;
+    stats.entries = m_entries.size();
+    stats.pages = m_pages.size();
+    return stats;
+}
+
+auto kestrel::graphics::texture_atlas::reset_statistics() -> void
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_stats = {};
+}
+
+auto kestrel::graphics::texture_atlas::clear() -> void
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_entries.clear();
+    m_enrolled.clear();
+    m_pages.clear();
+}
@@ -0,0 +1,168 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <libData/block.hpp>
+#include <libKestrel/math/rect.hpp>
+#include <libKestrel/math/size.hpp>
+
+namespace kestrel::graphics
+{
+    class texture;
+
+    /**
+     * Packs small, unchanging textures into shared pages so that quads drawn from different sprite sheets and images
+     * can be submitted in the same batch. Textures must be enrolled before they will be packed, and are then packed
+     * the first time they are drawn. Space within a page is allocated with a skyline packer. When every page is full,
+     * the least recently drawn page that has not been drawn from in the current frame is emptied and reused.
+     *
+     * Each packed texture is surrounded by a border of its own edge texels, so that linear filtering at the edge of
+     * a texture blends with itself rather than with whatever has been packed next to it.
+     */
+    class texture_atlas
+    {
+    public:
+        typedef std::function<auto(const math::size&, const data::block&)->std::shared_ptr<graphics::texture>> page_factory;
+
+        /**
+         * The location of a packed texture within a page, in normalized page coordinates.
+         */
+        struct placement
+        {
+            std::shared_ptr<graphics::texture> page;
+            std::uint32_t page_index { 0 };
+            math::rect frame;
+
+            /**
+             * Translate texture coordinates of the original texture into texture coordinates of the page.
+             */
+            [[nodiscard]] auto map(const math::rect& uv) const -> math::rect;
+        };
+
+        struct statistics
+        {
+            std::uint64_t hits { 0 };
+            std::uint64_t packed { 0 };
+            std::uint64_t rejected { 0 };
+            std::uint64_t evictions { 0 };
+            std::size_t entries { 0 };
+            std::size_t pages { 0 };
+        };
+
+        static constexpr std::uint32_t default_page_size { 2048 };
+        static constexpr std::uint32_t default_page_limit { 4 };
+        static constexpr std::uint32_t default_max_dimension { 256 };
+
+        explicit texture_atlas(page_factory factory,
+                               std::uint32_t page_size = default_page_size,
+                               std::uint32_t page_limit = default_page_limit,
+                               std::uint32_t max_dimension = default_max_dimension);
+
+        static auto shared_atlas() -> texture_atlas&;
+
+        /**
+         * Allow a texture to be packed. Only textures whose pixels do not change after enrollment should be enrolled,
+         * as the page keeps its own copy of the pixels.
+         */
+        auto enroll(const std::shared_ptr<graphics::texture>& tex) -> void;
+        [[nodiscard]] auto is_enrolled(const graphics::texture *tex) const -> bool;
+
+        /**
+         * Find where a texture has been packed, packing it if it has been enrolled but not yet placed. Returns null
+         * if the texture should be drawn from its own texture.
+         */
+        auto resolve(const std::shared_ptr<graphics::texture>& tex) -> const placement *;
+
+        /**
+         * Transfer the regions of each page that have been written since the last commit to the page textures.
+         */
+        auto commit() -> void;
+
+        /**
+         * Mark the end of a frame. Pages drawn from during the current frame are never evicted, as quads referencing
+         * them may still be waiting to be drawn.
+         */
+        auto next_frame() -> void;
+
+        auto set_enabled(bool enabled) -> void;
+        [[nodiscard]] auto enabled() const -> bool;
+
+        [[nodiscard]] inline auto page_size() const -> std::uint32_t { return m_page_size; }
+        [[nodiscard]] inline auto max_dimension() const -> std::uint32_t { return m_max_dimension; }
+
+        [[nodiscard]] auto stats() const -> statistics;
+        auto reset_statistics() -> void;
+
+        /**
+         * Discard every page, along with every packed and enrolled texture.
+         */
+        auto clear() -> void;
+
+    private:
+        struct skyline_segment
+        {
+            std::uint32_t x { 0 };
+            std::uint32_t y { 0 };
+            std::uint32_t width { 0 };
+        };
+
+        struct page
+        {
+            std::shared_ptr<graphics::texture> texture;
+            data::block pixels;
+            std::vector<skyline_segment> skyline;
+            std::vector<math::rect> pending;
+            std::uint64_t last_frame { 0 };
+        };
+
+        struct entry
+        {
+            std::weak_ptr<graphics::texture> source;
+            placement location;
+        };
+
+        auto allocate(page& p, std::uint32_t width, std::uint32_t height, std::uint32_t& x, std::uint32_t& y) -> bool;
+        auto place(std::uint32_t width, std::uint32_t height, std::uint32_t& index, std::uint32_t& x, std::uint32_t& y) -> bool;
+        auto reset_page(std::uint32_t index) -> void;
+        auto discard_expired() -> void;
+
+    private:
+        static constexpr std::uint32_t border { 1 };
+
+        mutable std::mutex m_lock;
+        page_factory m_factory;
+        std::uint32_t m_page_size { default_page_size };
+        std::uint32_t m_page_limit { default_page_limit };
+        std::uint32_t m_max_dimension { default_max_dimension };
+        bool m_enabled { true };
+        std::uint64_t m_frame { 1 };
+        std::vector<page> m_pages;
+        std::unordered_map<const graphics::texture *, std::weak_ptr<graphics::texture>> m_enrolled;
+        std::unordered_map<const graphics::texture *, entry> m_entries;
+        statistics m_stats;
+    };
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <libKestrel/graphics/texture/lua_api.hpp>
+#include <libKestrel/graphics/texture/residency.hpp>
+#include <libKestrel/device/console.hpp>
+
+// MARK: - API
+
+auto kestrel::graphics::residency::lua::api::texture_count() -> std::size_t
+{
+    return memory_report().textures;
+}
+
+auto kestrel::graphics::residency::lua::api::cpu_bytes() -> std::size_t
+{
+    return memory_report().cpu_bytes;
+}
+
+auto kestrel::graphics::residency::lua::api::gpu_bytes() -> std::size_t
+{
+    return memory_report().gpu_bytes;
+}
+
+auto kestrel::graphics::residency::lua::api::releases() -> std::uint64_t
+{
+    return memory_report().releases;
+}
+
+auto kestrel::graphics::residency::lua::api::reloads() -> std::uint64_t
+{
+    return memory_report().reloads;
+}
+
+auto kestrel::graphics::residency::lua::api::budget() -> std::size_t
+{
+    return residency::budget();
+}
+
+auto kestrel::graphics::residency::lua::api::set_budget(std::size_t bytes) -> void
+{
+    residency::set_budget(bytes);
+}
+
+auto kestrel::graphics::residency::lua::api::report() -> void
+{
+    for (const auto& line : format_report(memory_report())) {
+        device::console::write(line, device::console::status::note);
+    }
+}
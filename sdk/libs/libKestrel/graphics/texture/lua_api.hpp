@@ -0,0 +1,41 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <libKestrel/lua/runtime/runtime.hpp>
+#include <libKestrel/lua/scripting.hpp>
+
+namespace kestrel::graphics::residency::lua
+{
+    namespace lua_api(TextureMemory, Available_0_9) api
+    {
+        has_lua_api;
+
+        lua_getter(textureCount, Available_0_9) auto texture_count() -> std::size_t;
+        lua_getter(cpuBytes, Available_0_9) auto cpu_bytes() -> std::size_t;
+        lua_getter(gpuBytes, Available_0_9) auto gpu_bytes() -> std::size_t;
+        lua_getter(releases, Available_0_9) auto releases() -> std::uint64_t;
+        lua_getter(reloads, Available_0_9) auto reloads() -> std::uint64_t;
+        lua_getter(budget, Available_0_9) auto budget() -> std::size_t;
+        lua_function(setBudget, Available_0_9) auto set_budget(std::size_t bytes) -> void;
+        lua_function(report, Available_0_9) auto report() -> void;
+    }
+}
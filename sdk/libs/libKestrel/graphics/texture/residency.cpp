@@ -0,0 +1,210 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <libKestrel/graphics/texture/residency.hpp>
+#include <libKestrel/graphics/texture/texture.hpp>
+
+// MARK: - Storage
+
+static struct {
+    std::mutex lock;
+    std::unordered_set<kestrel::graphics::texture *> textures;
+    std::size_t budget { kestrel::graphics::residency::default_budget };
+    std::atomic<std::uint64_t> access { 0 };
+    std::uint64_t frame_start { 0 };
+    std::uint64_t releases { 0 };
+    std::uint64_t reloads { 0 };
+} s_residency;
+
+// MARK: - Tracking
+
+auto kestrel::graphics::residency::track(texture *tex) -> void
+{
+    std::lock_guard<std::mutex> guard(s_residency.lock);
+    s_residency.textures.emplace(tex);
+}
+
+auto kestrel::graphics::residency::untrack(texture *tex) -> void
+{
+    std::lock_guard<std::mutex> guard(s_residency.lock);
+    s_residency.textures.erase(tex);
+}
+
+auto kestrel::graphics::residency::next_access() -> std::uint64_t
+{
+    return ++s_residency.access;
+}
+
+// MARK: - Policy
+
+auto kestrel::graphics::residency::did_upload(texture *tex) -> void
+{
+    if (tex->residency() == residency_policy::drop_after_upload && tex->release_cpu_data()) {
+        std::lock_guard<std::mutex> guard(s_residency.lock);
+        s_residency.releases++;
+    }
+    enforce_budget();
+}
+
+auto kestrel::graphics::residency::did_reload(texture *tex) -> void
+{
+    {
+        std::lock_guard<std::mutex> guard(s_residency.lock);
+        s_residency.reloads++;
+    }
+
+    // The reloaded data counts against the budget, so make room for it by releasing older textures.
+    if (tex->uploaded()) {
+        enforce_budget();
+    }
+}
+
+auto kestrel::graphics::residency::enforce_budget() -> void
+{
+    std::lock_guard<std::mutex> guard(s_residency.lock);
+
+    std::size_t resident_bytes = 0;
+    std::vector<texture *> candidates;
+    for (auto tex : s_residency.textures) {
+        resident_bytes += tex->cpu_bytes();
+
+        // The data of a texture accessed during the current frame may still be in use by whoever accessed it.
+        auto releasable = tex->residency() != residency_policy::keep && tex->uploaded() && tex->is_cpu_resident();
+        if (releasable && tex->last_access() <= s_residency.frame_start) {
+            candidates.emplace_back(tex);
+        }
+    }
+
+    if (resident_bytes <= s_residency.budget) {
+        return;
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [] (texture *lhs, texture *rhs) {
+        return lhs->last_access() < rhs->last_access();
+    });
+
+    for (auto tex : candidates) {
+        if (resident_bytes <= s_residency.budget) {
+            break;
+        }
+        auto bytes = tex->cpu_bytes();
+        if (tex->release_cpu_data()) {
+            resident_bytes -= bytes;
+            s_residency.releases++;
+        }
+    }
+}
+
+auto kestrel::graphics::residency::next_frame() -> void
+{
+    std::lock_guard<std::mutex> guard(s_residency.lock);
+    s_residency.frame_start = s_residency.access;
+}
+
+// MARK: - Budget
+
+auto kestrel::graphics::residency::budget() -> std::size_t
+{
+    std::lock_guard<std::mutex> guard(s_residency.lock);
+    return s_residency.budget;
+}
+
+auto kestrel::graphics::residency::set_budget(std::size_t bytes) -> void
+{
+    {
+        std::lock_guard<std::mutex> guard(s_residency.lock);
+        s_residency.budget = bytes;
+    }
+    enforce_budget();
+}
+
+// MARK: - Reporting
+
+auto kestrel::graphics::residency::memory_report() -> struct report
+{
+    std::lock_guard<std::mutex> guard(s_residency.lock);
+
+    struct report result;
+    result.releases = s_residency.releases;
+    result.reloads = s_residency.reloads;
+
+    std::unordered_map<std::string, std::size_t> source_index;
+    for (auto tex : s_residency.textures) {
+        auto cpu = tex->cpu_bytes();
+        auto gpu = tex->gpu_bytes();
+        result.textures++;
+        result.cpu_bytes += cpu;
+        result.gpu_bytes += gpu;
+
+        const auto& source = tex->source().empty() ? std::string("(unattributed)") : tex->source();
+        auto it = source_index.find(source);
+        if (it == source_index.end()) {
+            it = source_index.emplace(source, result.sources.size()).first;
+            result.sources.emplace_back(source_usage { .source = source });
+        }
+
+        auto& usage = result.sources[it->second];
+        usage.textures++;
+        usage.cpu_bytes += cpu;
+        usage.gpu_bytes += gpu;
+    }
+
+    std::sort(result.sources.begin(), result.sources.end(), [] (const source_usage& lhs, const source_usage& rhs) {
+        return (lhs.cpu_bytes + lhs.gpu_bytes) > (rhs.cpu_bytes + rhs.gpu_bytes);
+    });
+    return result;
+}
+
+static auto format_bytes(std::size_t bytes) -> std::string
+{
+    if (bytes >= 1024 * 1024) {
+        return std::to_string(bytes / (1024 * 1024)) + "." + std::to_string(((bytes % (1024 * 1024)) * 10) / (1024 * 1024)) + " MiB";
+    }
+    else if (bytes >= 1024) {
+        return std::to_string(bytes / 1024) + " KiB";
+    }
+    return std::to_string(bytes) + " B";
+}
+
+auto kestrel::graphics::residency::format_report(const struct report& report) -> std::vector<std::string>
+{
+    std::vector<std::string> lines;
+    lines.emplace_back(
+        "Textures: " + std::to_string(report.textures) +
+        ", CPU: " + format_bytes(report.cpu_bytes) +
+        ", GPU: " + format_bytes(report.gpu_bytes) +
+        ", Released: " + std::to_string(report.releases) +
+        ", Reloaded: " + std::to_string(report.reloads)
+    );
+
+    for (const auto& usage : report.sources) {
+        lines.emplace_back(
+            "  " + usage.source + " (" + std::to_string(usage.textures) + ")" +
+            " CPU: " + format_bytes(usage.cpu_bytes) +
+            ", GPU: " + format_bytes(usage.gpu_bytes)
+        );
+    }
+    return lines;
+}
@@ -0,0 +1,111 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace kestrel::graphics
+{
+    class texture;
+
+    /**
+     * Determines what happens to the CPU-side pixel data of a texture once it has been uploaded to the GPU.
+     * - keep               The pixel data is retained for the lifetime of the texture.
+     * - drop_after_upload  The pixel data is released as soon as the texture has been uploaded. If the texture has a
+     *                      reload function the data is reproduced when it must be uploaded again, otherwise a
+     *                      second upload is refused.
+     * - reload_on_demand   The pixel data may be released when the memory budget is exceeded, and is reproduced
+     *                      by the textures reload function when it is next accessed.
+     */
+    enum class residency_policy : std::uint8_t
+    {
+        keep, drop_after_upload, reload_on_demand
+    };
+}
+
+namespace kestrel::graphics::residency
+{
+    /**
+     * The default budget for the CPU-side pixel data of every tracked texture. Only the data of textures that are
+     * not kept is released to meet it.
+     */
+    constexpr std::size_t default_budget = 128 * 1024 * 1024;
+
+    /**
+     * The texture memory attributed to a single source resource.
+     */
+    struct source_usage
+    {
+        std::string source;
+        std::size_t textures { 0 };
+        std::size_t cpu_bytes { 0 };
+        std::size_t gpu_bytes { 0 };
+    };
+
+    struct report
+    {
+        std::size_t textures { 0 };
+        std::size_t cpu_bytes { 0 };
+        std::size_t gpu_bytes { 0 };
+        std::uint64_t releases { 0 };
+        std::uint64_t reloads { 0 };
+
+        /**
+         * Usage grouped by source resource, ordered from the largest combined footprint to the smallest.
+         */
+        std::vector<source_usage> sources;
+    };
+
+    auto track(texture *tex) -> void;
+    auto untrack(texture *tex) -> void;
+
+    /**
+     * Informs the manager that a texture has been uploaded, so that its residency policy can be applied and the
+     * budget enforced.
+     */
+    auto did_upload(texture *tex) -> void;
+    auto did_reload(texture *tex) -> void;
+
+    /**
+     * Release the pixel data of the least recently accessed releasable textures until the CPU-side memory used by all
+     * textures fits within the budget. Textures accessed during the current frame are never released, so the budget
+     * may be exceeded until the frame ends.
+     */
+    auto enforce_budget() -> void;
+
+    /**
+     * Mark the end of a frame. Textures accessed after this point belong to the next frame.
+     */
+    auto next_frame() -> void;
+
+    [[nodiscard]] auto budget() -> std::size_t;
+    auto set_budget(std::size_t bytes) -> void;
+
+    /**
+     * A monotonically increasing value used to order texture accesses.
+     */
+    [[nodiscard]] auto next_access() -> std::uint64_t;
+
+    [[nodiscard]] auto memory_report() -> struct report;
+    [[nodiscard]] auto format_report(const struct report& report) -> std::vector<std::string>;
+}
@@ -25,11 +25,13 @@
 kestrel::graphics::texture::texture(std::uint32_t width, std::uint32_t height, const data::block &data)
     : m_data(data),  m_size(width, height)
 {
+    residency::track(this);
 }
 
 kestrel::graphics::texture::texture(const math::size &size, const data::block &data)
     : m_data(data), m_size(size)
 {
+    residency::track(this);
 }
 
 kestrel::graphics::texture::texture(std::uint32_t width, std::uint32_t height, bool populate)
@@ -38,6 +40,7 @@ kestrel::graphics::texture::texture(std::uint32_t width, std::uint32_t height, b
     if (populate) {
         m_data.set(static_cast<std::uint32_t>(0xFFFF00FF), m_data.size());
     }
+    residency::track(this);
 }
 
 kestrel::graphics::texture::texture(const math::size &size, bool populate)
@@ -46,6 +49,14 @@ kestrel::graphics::texture::texture(const math::size &size, bool populate)
     if (populate) {
         m_data.set(static_cast<std::uint32_t>(0xFFFF00FF), m_data.size());
     }
+    residency::track(this);
+}
+
+// MARK: - Destruction
+
+kestrel::graphics::texture::~texture()
+{
+    residency::untrack(this);
 }
 
 // MARK: - Accessors
@@ -57,20 +68,35 @@ auto kestrel::graphics::texture::size() const -> math::size
 
 auto kestrel::graphics::texture::data() const -> const data::block&
 {
+    m_last_access = residency::next_access();
+    if (m_released && m_reload) {
+        m_data = m_reload();
+        m_released = false;
+        residency::did_reload(const_cast<texture *>(this));
+    }
     return m_data;
 }
 
 auto kestrel::graphics::texture::raw_data_ptr() const -> const void *
 {
-    return m_data.get<void *>();
+    return data().get<void *>();
 }
 
 auto kestrel::graphics::texture::set_data(const data::block& data) -> void
 {
     m_data = data;
+    m_released = false;
     m_uploaded = false;
 }
 
+auto kestrel::graphics::texture::update_regions(const data::block& data, const std::vector<math::rect>& regions) -> void
+{
+    // The texture data is always replaced in full. Whether the GPU copy needs a full upload is left to the
+    // renderer specific texture, which is still pending a full upload if it has not been uploaded yet.
+    m_data = data;
+    m_released = false;
+}
+
 auto kestrel::graphics::texture::handle() const -> reference
 {
     return 0;
@@ -85,7 +111,12 @@ auto kestrel::graphics::texture::destroy() -> void
 
 auto kestrel::graphics::texture::upload_to_gpu() -> void
 {
+    if (!has_data()) {
+        return;
+    }
     m_uploaded = true;
+    m_last_access = residency::next_access();
+    residency::did_upload(this);
 }
 
 auto kestrel::graphics::texture::uploaded() const -> bool
@@ -97,6 +128,78 @@ auto kestrel::graphics::texture::uploaded() const -> bool
 
 auto kestrel::graphics::texture::color(double x, double y) const -> graphics::color
 {
-    auto value = m_data.get<std::uint32_t>(static_cast<std::uint32_t>((y * m_size.width()) + x) << 2);
-    return graphics::color(value);
+    const auto& pixels = data();
+    auto offset = static_cast<std::uint32_t>((y * m_size.width()) + x) << 2;
+    if (offset + 4 > pixels.size()) {
+        return graphics::color::clear_color();
+    }
+    return graphics::color(pixels.get<std::uint32_t>(offset));
+}
+
+// MARK: - Residency
+
+auto kestrel::graphics::texture::set_residency_policy(residency_policy policy, const reload_function& reload) -> void
+{
+    if (policy == residency_policy::reload_on_demand && !reload) {
+        policy = residency_policy::keep;
+    }
+    m_residency = policy;
+    m_reload = reload;
+
+    if (m_uploaded && m_residency == residency_policy::drop_after_upload) {
+        release_cpu_data();
+    }
+}
+
+auto kestrel::graphics::texture::residency() const -> residency_policy
+{
+    return m_residency;
+}
+
+auto kestrel::graphics::texture::release_cpu_data() -> bool
+{
+    if (!m_uploaded || m_released || m_residency == residency_policy::keep) {
+        return false;
+    }
+    m_data = data::block();
+    m_released = true;
+    return true;
+}
+
+auto kestrel::graphics::texture::is_cpu_resident() const -> bool
+{
+    return !m_released;
+}
+
+auto kestrel::graphics::texture::has_data() const -> bool
+{
+    return !m_released || m_reload;
+}
+
+auto kestrel::graphics::texture::last_access() const -> std::uint64_t
+{
+    return m_last_access;
+}
+
+auto kestrel::graphics::texture::set_source(const std::string &source) -> void
+{
+    m_source = source;
+}
+
+auto kestrel::graphics::texture::source() const -> const std::string&
+{
+    return m_source;
+}
+
+auto kestrel::graphics::texture::cpu_bytes() const -> std::size_t
+{
+    return m_released ? 0 : m_data.size();
+}
+
+auto kestrel::graphics::texture::gpu_bytes() const -> std::size_t
+{
+    if (!m_uploaded) {
+        return 0;
+    }
+    return static_cast<std::size_t>(m_size.width()) * static_cast<std::size_t>(m_size.height()) * 4;
 }
\ No newline at end of file
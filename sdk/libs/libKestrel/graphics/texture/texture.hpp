@@ -22,10 +22,14 @@
 
 #include <memory>
 #include <vector>
+#include <string>
+#include <functional>
 #include <type_traits>
 #include <libKestrel/math/size.hpp>
+#include <libKestrel/math/rect.hpp>
 #include <libData/block.hpp>
 #include <libKestrel/graphics/types/color.hpp>
+#include <libKestrel/graphics/texture/residency.hpp>
 
 namespace kestrel::graphics
 {
@@ -33,19 +37,31 @@ namespace kestrel::graphics
     {
     public:
         typedef std::uint64_t reference;
+        typedef std::function<auto()->data::block> reload_function;
 
         texture(std::uint32_t width, std::uint32_t height, const data::block& data);
         texture(const math::size& size, const data::block& data);
         texture(std::uint32_t width, std::uint32_t height, bool populate = false);
         explicit texture(const math::size& size, bool populate = false);
 
-        ~texture() = default;
+        virtual ~texture();
 
         [[nodiscard]] auto size() const -> math::size;
+
+        /**
+         * The CPU-side pixel data of the texture. If the data has been released under a reload_on_demand policy, it
+         * is reproduced before being returned.
+         */
         [[nodiscard]] auto data() const -> const data::block&;
         [[nodiscard]] auto raw_data_ptr() const -> const void *;
 
         virtual auto set_data(const data::block& data) -> void;
+
+        /**
+         * Replace the texture data, informing the texture that only the pixels inside the specified regions have
+         * changed. Textures that are already resident on the GPU only need to transfer those regions.
+         */
+        virtual auto update_regions(const data::block& data, const std::vector<math::rect>& regions) -> void;
         virtual auto handle() const -> reference;
         virtual auto destroy() -> void;
 
@@ -54,10 +70,47 @@ namespace kestrel::graphics
         virtual auto upload_to_gpu() -> void;
         [[nodiscard]] virtual auto uploaded() const -> bool;
 
+        /**
+         * Set the residency policy for the CPU-side pixel data. A reload_on_demand policy without a reload function
+         * can not reproduce its data, and so is treated as keep. A drop_after_upload policy uses the reload function,
+         * if one is given, to reproduce its data when it must be uploaded again.
+         */
+        auto set_residency_policy(residency_policy policy, const reload_function& reload = {}) -> void;
+        [[nodiscard]] auto residency() const -> residency_policy;
+
+        /**
+         * Release the CPU-side pixel data if the texture is on the GPU and its policy allows it.
+         */
+        auto release_cpu_data() -> bool;
+        [[nodiscard]] auto is_cpu_resident() const -> bool;
+
+        /**
+         * The pixel data is resident, or can be reproduced. Textures whose data has been released without a means of
+         * reproducing it can not be uploaded again.
+         */
+        [[nodiscard]] auto has_data() const -> bool;
+        [[nodiscard]] auto last_access() const -> std::uint64_t;
+
+        /**
+         * A description of the resource that the texture was produced from, used when reporting memory usage.
+         */
+        auto set_source(const std::string& source) -> void;
+        [[nodiscard]] auto source() const -> const std::string&;
+
+        [[nodiscard]] auto cpu_bytes() const -> std::size_t;
+        [[nodiscard]] auto gpu_bytes() const -> std::size_t;
+
     protected:
         bool m_uploaded { false };
         math::size m_size;
-        data::block m_data;
+        mutable data::block m_data;
+
+    private:
+        residency_policy m_residency { residency_policy::keep };
+        reload_function m_reload;
+        std::string m_source;
+        mutable bool m_released { false };
+        mutable std::uint64_t m_last_access { 0 };
 
     };
 }
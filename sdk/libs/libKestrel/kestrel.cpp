@@ -30,6 +30,7 @@
 #include <libKestrel/sound/audio_manager.hpp>
 #include <libKestrel/sandbox/file/files.hpp>
 #include <libKestrel/lua/support/vector.hpp>
+#include <libKestrel/lua/runtime/chunk_cache.hpp>
 #include <libResourceCore/manager.hpp>
 #include <libKestrel/shared/shared_library_manager.hpp>
 #include <libToolbox/font/manager.hpp>
@@ -130,6 +131,7 @@ namespace kestrel
 
         // Configure the audio manager
         try {
+            sound::manager::shared_manager().set_output_path(s_kestrel_session.base_configuration.audio.output_path);
             sound::manager::shared_manager().set_api(s_kestrel_session.base_configuration.audio.desired_api);
         }
         catch (const incompatible_driver_exception& e) {
@@ -202,6 +204,14 @@ namespace kestrel::renderer
         }
 
         async::execute_tasks();
+
+        // Collect garbage in whatever remains of the frame, so that the automatic collector rarely needs to run
+        // inside update and render blocks.
+        if (render_required) {
+            s_kestrel_session.runtime->gc().step([] {
+                return renderer::target_frame_time() > renderer::time_since_last_frame();
+            });
+        }
     }
 }
 
@@ -308,6 +318,7 @@ auto kestrel::start(const configuration& cfg) -> result
     // Setup the absolute basics...
     s_kestrel_session.base_configuration = cfg;
     s_kestrel_session.runtime = std::make_shared<lua::runtime>();
+    lua::chunk_cache::shared_cache().set_directory(cfg.scripting.chunk_cache_directory);
 
     // Prepare the sandbox...
     auto& files = sandbox::files::shared_files();
@@ -390,6 +401,8 @@ auto kestrel::audio_driver_name() -> std::string
     switch (s_kestrel_session.base_configuration.audio.desired_api) {
         case sound::api::core_audio:    return "CoreAudio";
         case sound::api::openal:        return "OpenAL";
+        case sound::api::null:          return "Null";
+        case sound::api::software:      return "Software";
         case sound::api::none:          return "None";
     }
 }
@@ -0,0 +1,187 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+extern "C" {
+#   include "LuaJIT/src/lua.h"
+#   include "LuaJIT/src/lauxlib.h"
+}
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <filesystem>
+#include <libHashing/xxhash/xxhash.hpp>
+#include <libKestrel/lua/runtime/chunk_cache.hpp>
+#include <libKestrel/clock/clock.hpp>
+
+// MARK: - Writer
+
+static auto chunk_writer(lua_State *L, const void *ptr, std::size_t size, void *data) -> int
+{
+    reinterpret_cast<std::string *>(data)->append(reinterpret_cast<const char *>(ptr), size);
+    return 0;
+}
+
+// MARK: - Construction
+
+kestrel::lua::chunk_cache::chunk_cache(std::size_t budget)
+    : m_chunks(budget)
+{
+}
+
+auto kestrel::lua::chunk_cache::shared_cache() -> chunk_cache&
+{
+    static chunk_cache cache;
+    return cache;
+}
+
+auto kestrel::lua::chunk_cache::hash(const std::string &source) -> hash_value
+{
+    return static_cast<hash_value>(hashing::xxh64(source.c_str(), source.size()));
+}
+
+// MARK: - Loading
+
+auto kestrel::lua::chunk_cache::load(lua_State *L, const std::string &source) -> int
+{
+    auto hash = chunk_cache::hash(source);
+    auto now = rtc::clock::global().current();
+
+    // Bytecode is rejected by LuaJIT if it was produced by an incompatible build, in which case the source is
+    // compiled again and replaces the cached chunk.
+    if (auto bytecode = m_chunks.fetch(hash, now)) {
+        if (luaL_loadbuffer(L, bytecode->data(), bytecode->size(), source.c_str()) == LUA_OK) {
+            return LUA_OK;
+        }
+        lua_pop(L, 1);
+    }
+    else if (auto stored = read_chunk(hash)) {
+        if (luaL_loadbuffer(L, stored->data(), stored->size(), source.c_str()) == LUA_OK) {
+            m_disk_hits++;
+            m_chunks.insert(hash, *stored, stored->size(), now);
+            return LUA_OK;
+        }
+        lua_pop(L, 1);
+    }
+
+    auto result = luaL_loadstring(L, source.c_str());
+    if (result != LUA_OK) {
+        return result;
+    }
+
+    std::string bytecode;
+    if (lua_dump(L, chunk_writer, &bytecode) == 0 && !bytecode.empty()) {
+        m_compiled++;
+        write_chunk(hash, bytecode);
+        m_chunks.insert(hash, bytecode, bytecode.size(), now);
+    }
+    return LUA_OK;
+}
+
+// MARK: - Persistence
+
+auto kestrel::lua::chunk_cache::set_directory(const std::string &path) -> void
+{
+    m_directory = path;
+    if (!m_directory.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(m_directory, error);
+    }
+}
+
+auto kestrel::lua::chunk_cache::directory() const -> const std::string&
+{
+    return m_directory;
+}
+
+auto kestrel::lua::chunk_cache::chunk_path(hash_value hash) const -> std::string
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.ljbc", static_cast<unsigned long long>(hash));
+    return m_directory + "/" + name;
+}
+
+auto kestrel::lua::chunk_cache::read_chunk(hash_value hash) const -> std::optional<std::string>
+{
+    if (m_directory.empty()) {
+        return {};
+    }
+
+    std::ifstream file(chunk_path(hash), std::ios::binary);
+    if (!file.is_open()) {
+        return {};
+    }
+
+    std::string bytecode { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    if (bytecode.empty()) {
+        return {};
+    }
+    return bytecode;
+}
+
+auto kestrel::lua::chunk_cache::write_chunk(hash_value hash, const std::string &bytecode) const -> void
+{
+    if (m_directory.empty()) {
+        return;
+    }
+
+    // Failing to persist a chunk only costs a compile in a later session, so errors are ignored.
+    std::ofstream file(chunk_path(hash), std::ios::binary | std::ios::trunc);
+    if (file.is_open()) {
+        file.write(bytecode.data(), static_cast<std::streamsize>(bytecode.size()));
+    }
+}
+
+// MARK: - Budget & Statistics
+
+auto kestrel::lua::chunk_cache::budget() const -> std::size_t
+{
+    return m_chunks.budget();
+}
+
+auto kestrel::lua::chunk_cache::set_budget(std::size_t bytes) -> void
+{
+    m_chunks.set_budget(bytes);
+}
+
+auto kestrel::lua::chunk_cache::stats() const -> statistics
+{
+    auto chunks = m_chunks.stats();
+    statistics result;
+    result.hits = chunks.hits;
+    result.misses = chunks.misses;
+    result.disk_hits = m_disk_hits;
+    result.compiled = m_compiled;
+    result.entries = chunks.entries;
+    result.bytes = chunks.bytes;
+    return result;
+}
+
+auto kestrel::lua::chunk_cache::reset_statistics() -> void
+{
+    m_chunks.reset_statistics();
+    m_disk_hits = 0;
+    m_compiled = 0;
+}
+
+auto kestrel::lua::chunk_cache::clear() -> void
+{
+    m_chunks.clear();
+}
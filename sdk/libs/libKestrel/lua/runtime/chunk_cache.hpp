@@ -0,0 +1,92 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <optional>
+#include <libKestrel/cache/lru_cache.hpp>
+
+struct lua_State;
+
+namespace kestrel::lua
+{
+    /**
+     * Caches compiled Lua chunks as LuaJIT bytecode, so that a source script is only parsed the first time it is
+     * run. Chunks are keyed by a hash of their source, which means that re-entering a scene or re-running the same
+     * console input reuses the compiled chunk, while a modified script is always compiled afresh. When a directory
+     * is set, compiled chunks are also written to disk so that later sessions can skip parsing.
+     */
+    class chunk_cache
+    {
+    public:
+        typedef std::uint64_t hash_value;
+
+        struct statistics
+        {
+            std::uint64_t hits { 0 };
+            std::uint64_t misses { 0 };
+            std::uint64_t disk_hits { 0 };
+            std::uint64_t compiled { 0 };
+            std::size_t entries { 0 };
+            std::size_t bytes { 0 };
+        };
+
+        static constexpr std::size_t default_budget = 8 * 1024 * 1024;
+
+        explicit chunk_cache(std::size_t budget = default_budget);
+
+        static auto shared_cache() -> chunk_cache&;
+
+        [[nodiscard]] static auto hash(const std::string& source) -> hash_value;
+
+        /**
+         * Push the function for the specified source onto the Lua stack, compiling the source only if a compiled
+         * chunk is not already cached. Returns the status of the load, leaving the error message on the stack if
+         * the source could not be compiled.
+         */
+        auto load(lua_State *L, const std::string& source) -> int;
+
+        /**
+         * Set the directory in which compiled chunks are persisted. An empty path keeps chunks in memory only.
+         */
+        auto set_directory(const std::string& path) -> void;
+        [[nodiscard]] auto directory() const -> const std::string&;
+
+        [[nodiscard]] auto budget() const -> std::size_t;
+        auto set_budget(std::size_t bytes) -> void;
+
+        [[nodiscard]] auto stats() const -> statistics;
+        auto reset_statistics() -> void;
+        auto clear() -> void;
+
+    private:
+        [[nodiscard]] auto chunk_path(hash_value hash) const -> std::string;
+        [[nodiscard]] auto read_chunk(hash_value hash) const -> std::optional<std::string>;
+        auto write_chunk(hash_value hash, const std::string& bytecode) const -> void;
+
+    private:
+        cache::lru_cache<hash_value, std::string> m_chunks;
+        std::string m_directory;
+        std::uint64_t m_disk_hits { 0 };
+        std::uint64_t m_compiled { 0 };
+    };
+}
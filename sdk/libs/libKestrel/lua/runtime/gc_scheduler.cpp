@@ -0,0 +1,164 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+extern "C" {
+#   include "LuaJIT/src/lua.h"
+}
+
+#include <chrono>
+#include <libKestrel/lua/runtime/gc_scheduler.hpp>
+
+// MARK: - Construction
+
+kestrel::lua::gc_scheduler::gc_scheduler(lua_State *L)
+{
+    attach(L);
+}
+
+auto kestrel::lua::gc_scheduler::attach(lua_State *L) -> void
+{
+    m_state = L;
+    apply();
+}
+
+// MARK: - Configuration
+
+auto kestrel::lua::gc_scheduler::apply() -> void
+{
+    if (!m_state) {
+        return;
+    }
+
+    lua_gc(m_state, LUA_GCSETPAUSE, m_pause);
+    lua_gc(m_state, LUA_GCSETSTEPMUL, m_step_multiplier);
+
+    // Taking a step or completing a cycle lowers the collection threshold again, so the collector needs to be
+    // stopped after each of them as well.
+    lua_gc(m_state, m_automatic ? LUA_GCRESTART : LUA_GCSTOP, 0);
+}
+
+auto kestrel::lua::gc_scheduler::set_automatic(bool automatic) -> void
+{
+    m_automatic = automatic;
+    apply();
+}
+
+auto kestrel::lua::gc_scheduler::automatic() const -> bool
+{
+    return m_automatic;
+}
+
+auto kestrel::lua::gc_scheduler::set_pause(std::int32_t pause) -> void
+{
+    m_pause = pause;
+    apply();
+}
+
+auto kestrel::lua::gc_scheduler::pause() const -> std::int32_t
+{
+    return m_pause;
+}
+
+auto kestrel::lua::gc_scheduler::set_step_multiplier(std::int32_t multiplier) -> void
+{
+    m_step_multiplier = multiplier;
+    apply();
+}
+
+auto kestrel::lua::gc_scheduler::step_multiplier() const -> std::int32_t
+{
+    return m_step_multiplier;
+}
+
+auto kestrel::lua::gc_scheduler::set_step_size(std::int32_t kb) -> void
+{
+    m_step_size = kb;
+}
+
+auto kestrel::lua::gc_scheduler::step_size() const -> std::int32_t
+{
+    return m_step_size;
+}
+
+auto kestrel::lua::gc_scheduler::set_memory_ceiling(std::size_t kb) -> void
+{
+    m_memory_ceiling_kb = kb;
+}
+
+auto kestrel::lua::gc_scheduler::memory_ceiling() const -> std::size_t
+{
+    return m_memory_ceiling_kb;
+}
+
+// MARK: - Collection
+
+auto kestrel::lua::gc_scheduler::step(const time_available_function &time_available) -> void
+{
+    statistics frame;
+    if (!m_state) {
+        m_last_frame = frame;
+        return;
+    }
+
+    // Without the automatic collector nothing else bounds the heap, so once it passes the ceiling keep stepping
+    // until the cycle completes, whatever time is left in the frame.
+    frame.forced = !m_automatic && memory_kb() > m_memory_ceiling_kb;
+
+    auto start = std::chrono::steady_clock::now();
+    do {
+        frame.steps++;
+        if (lua_gc(m_state, LUA_GCSTEP, m_step_size) != 0) {
+            frame.cycles++;
+            break;
+        }
+    } while (frame.forced || (time_available && time_available()));
+
+    if (!m_automatic) {
+        lua_gc(m_state, LUA_GCSTOP, 0);
+    }
+
+    frame.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    frame.memory_kb = memory_kb();
+    m_last_frame = frame;
+}
+
+auto kestrel::lua::gc_scheduler::collect() -> void
+{
+    if (!m_state) {
+        return;
+    }
+
+    lua_gc(m_state, LUA_GCCOLLECT, 0);
+    if (!m_automatic) {
+        lua_gc(m_state, LUA_GCSTOP, 0);
+    }
+}
+
+// MARK: - Statistics
+
+auto kestrel::lua::gc_scheduler::memory_kb() const -> std::size_t
+{
+    return m_state ? static_cast<std::size_t>(lua_gc(m_state, LUA_GCCOUNT, 0)) : 0;
+}
+
+auto kestrel::lua::gc_scheduler::last_frame_statistics() const -> statistics
+{
+    return m_last_frame;
+}
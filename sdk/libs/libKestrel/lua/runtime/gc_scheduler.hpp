@@ -0,0 +1,113 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+struct lua_State;
+
+namespace kestrel::lua
+{
+    /**
+     * Schedules the incremental garbage collector of a Lua state into the idle time at the end of each frame.
+     *
+     * Steps are taken between frames for as long as time remains in the frame, and at least one step is always
+     * taken each frame so that collection keeps pace with allocation even when frames have no idle time.
+     *
+     * The automatic collector remains enabled with a raised pause, so that it only runs inside update or render
+     * blocks when the idle time steps have fallen behind, such as during scene loads or long frames. LuaJIT has no
+     * emergency collection, so this is what bounds the heap. If the automatic collector is disabled, the memory
+     * ceiling acts as a safety valve instead: once the heap passes it, the next frame steps until a full cycle has
+     * completed, regardless of the time available.
+     */
+    class gc_scheduler
+    {
+    public:
+        typedef std::function<auto()->bool> time_available_function;
+
+        struct statistics
+        {
+            std::uint32_t steps { 0 };
+            std::uint32_t cycles { 0 };
+            double time { 0 };
+            std::size_t memory_kb { 0 };
+            bool forced { false };
+        };
+
+        static constexpr std::int32_t default_pause { 400 };
+        static constexpr std::int32_t default_step_multiplier { 200 };
+        static constexpr std::int32_t default_step_size { 16 };
+        static constexpr std::size_t default_memory_ceiling_kb { 256 * 1024 };
+
+        explicit gc_scheduler(lua_State *L = nullptr);
+
+        auto attach(lua_State *L) -> void;
+
+        /**
+         * Take incremental collection steps for as long as time is available, stopping early if a collection cycle
+         * completes. The time spent is reported as the statistics of the frame.
+         */
+        auto step(const time_available_function& time_available) -> void;
+
+        /**
+         * Run a full collection cycle, leaving the automatic collector in its configured state.
+         */
+        auto collect() -> void;
+
+        auto set_automatic(bool automatic) -> void;
+        [[nodiscard]] auto automatic() const -> bool;
+
+        auto set_pause(std::int32_t pause) -> void;
+        [[nodiscard]] auto pause() const -> std::int32_t;
+
+        auto set_step_multiplier(std::int32_t multiplier) -> void;
+        [[nodiscard]] auto step_multiplier() const -> std::int32_t;
+
+        /**
+         * The amount of allocation, in kilobytes, that each step is asked to account for.
+         */
+        auto set_step_size(std::int32_t kb) -> void;
+        [[nodiscard]] auto step_size() const -> std::int32_t;
+
+        /**
+         * The heap size, in kilobytes, beyond which a full collection cycle is forced at the next frame when the
+         * automatic collector is disabled.
+         */
+        auto set_memory_ceiling(std::size_t kb) -> void;
+        [[nodiscard]] auto memory_ceiling() const -> std::size_t;
+
+        [[nodiscard]] auto memory_kb() const -> std::size_t;
+        [[nodiscard]] auto last_frame_statistics() const -> statistics;
+
+    private:
+        auto apply() -> void;
+
+    private:
+        lua_State *m_state { nullptr };
+        bool m_automatic { true };
+        std::int32_t m_pause { default_pause };
+        std::int32_t m_step_multiplier { default_step_multiplier };
+        std::int32_t m_step_size { default_step_size };
+        std::size_t m_memory_ceiling_kb { default_memory_ceiling_kb };
+        statistics m_last_frame;
+    };
+}
@@ -0,0 +1,137 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <libKestrel/lua/runtime/lua_api.hpp>
+#include <libKestrel/lua/runtime/chunk_cache.hpp>
+#include <libKestrel/kestrel.hpp>
+
+// MARK: - Script Cache API
+
+auto kestrel::lua::chunk_cache_api::api::hits() -> std::uint64_t
+{
+    return chunk_cache::shared_cache().stats().hits;
+}
+
+auto kestrel::lua::chunk_cache_api::api::misses() -> std::uint64_t
+{
+    return chunk_cache::shared_cache().stats().misses;
+}
+
+auto kestrel::lua::chunk_cache_api::api::disk_hits() -> std::uint64_t
+{
+    return chunk_cache::shared_cache().stats().disk_hits;
+}
+
+auto kestrel::lua::chunk_cache_api::api::compiled() -> std::uint64_t
+{
+    return chunk_cache::shared_cache().stats().compiled;
+}
+
+auto kestrel::lua::chunk_cache_api::api::entry_count() -> std::size_t
+{
+    return chunk_cache::shared_cache().stats().entries;
+}
+
+auto kestrel::lua::chunk_cache_api::api::bytes_in_use() -> std::size_t
+{
+    return chunk_cache::shared_cache().stats().bytes;
+}
+
+auto kestrel::lua::chunk_cache_api::api::reset_statistics() -> void
+{
+    chunk_cache::shared_cache().reset_statistics();
+}
+
+auto kestrel::lua::chunk_cache_api::api::clear() -> void
+{
+    chunk_cache::shared_cache().clear();
+}
+
+// MARK: - Garbage Collector API
+
+auto kestrel::lua::gc_api::api::automatic() -> bool
+{
+    return kestrel::lua_runtime()->gc().automatic();
+}
+
+auto kestrel::lua::gc_api::api::set_automatic(bool automatic) -> void
+{
+    kestrel::lua_runtime()->gc().set_automatic(automatic);
+}
+
+auto kestrel::lua::gc_api::api::pause() -> std::int32_t
+{
+    return kestrel::lua_runtime()->gc().pause();
+}
+
+auto kestrel::lua::gc_api::api::set_pause(std::int32_t pause) -> void
+{
+    kestrel::lua_runtime()->gc().set_pause(pause);
+}
+
+auto kestrel::lua::gc_api::api::step_multiplier() -> std::int32_t
+{
+    return kestrel::lua_runtime()->gc().step_multiplier();
+}
+
+auto kestrel::lua::gc_api::api::set_step_multiplier(std::int32_t multiplier) -> void
+{
+    kestrel::lua_runtime()->gc().set_step_multiplier(multiplier);
+}
+
+auto kestrel::lua::gc_api::api::step_size() -> std::int32_t
+{
+    return kestrel::lua_runtime()->gc().step_size();
+}
+
+auto kestrel::lua::gc_api::api::set_step_size(std::int32_t kb) -> void
+{
+    kestrel::lua_runtime()->gc().set_step_size(kb);
+}
+
+auto kestrel::lua::gc_api::api::memory_ceiling() -> std::size_t
+{
+    return kestrel::lua_runtime()->gc().memory_ceiling();
+}
+
+auto kestrel::lua::gc_api::api::set_memory_ceiling(std::size_t kb) -> void
+{
+    kestrel::lua_runtime()->gc().set_memory_ceiling(kb);
+}
+
+auto kestrel::lua::gc_api::api::memory_in_use() -> std::size_t
+{
+    return kestrel::lua_runtime()->gc().memory_kb();
+}
+
+auto kestrel::lua::gc_api::api::last_frame_time() -> double
+{
+    return kestrel::lua_runtime()->gc().last_frame_statistics().time;
+}
+
+auto kestrel::lua::gc_api::api::last_frame_steps() -> std::uint32_t
+{
+    return kestrel::lua_runtime()->gc().last_frame_statistics().steps;
+}
+
+auto kestrel::lua::gc_api::api::last_frame_cycles() -> std::uint32_t
+{
+    return kestrel::lua_runtime()->gc().last_frame_statistics().cycles;
+}
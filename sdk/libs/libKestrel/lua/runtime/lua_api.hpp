@@ -0,0 +1,64 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <libKestrel/lua/runtime/runtime.hpp>
+#include <libKestrel/lua/scripting.hpp>
+
+namespace kestrel::lua::chunk_cache_api
+{
+    namespace lua_api(ScriptCache, Available_0_9) api
+    {
+        has_lua_api;
+
+        lua_getter(hits, Available_0_9) auto hits() -> std::uint64_t;
+        lua_getter(misses, Available_0_9) auto misses() -> std::uint64_t;
+        lua_getter(diskHits, Available_0_9) auto disk_hits() -> std::uint64_t;
+        lua_getter(compiled, Available_0_9) auto compiled() -> std::uint64_t;
+        lua_getter(entryCount, Available_0_9) auto entry_count() -> std::size_t;
+        lua_getter(bytesInUse, Available_0_9) auto bytes_in_use() -> std::size_t;
+        lua_function(resetStatistics, Available_0_9) auto reset_statistics() -> void;
+        lua_function(clear, Available_0_9) auto clear() -> void;
+    }
+}
+
+namespace kestrel::lua::gc_api
+{
+    namespace lua_api(GarbageCollector, Available_0_9) api
+    {
+        has_lua_api;
+
+        lua_getter(automatic, Available_0_9) auto automatic() -> bool;
+        lua_function(setAutomatic, Available_0_9) auto set_automatic(bool automatic) -> void;
+        lua_getter(pause, Available_0_9) auto pause() -> std::int32_t;
+        lua_function(setPause, Available_0_9) auto set_pause(std::int32_t pause) -> void;
+        lua_getter(stepMultiplier, Available_0_9) auto step_multiplier() -> std::int32_t;
+        lua_function(setStepMultiplier, Available_0_9) auto set_step_multiplier(std::int32_t multiplier) -> void;
+        lua_getter(stepSize, Available_0_9) auto step_size() -> std::int32_t;
+        lua_function(setStepSize, Available_0_9) auto set_step_size(std::int32_t kb) -> void;
+        lua_getter(memoryCeiling, Available_0_9) auto memory_ceiling() -> std::size_t;
+        lua_function(setMemoryCeiling, Available_0_9) auto set_memory_ceiling(std::size_t kb) -> void;
+        lua_getter(memoryInUse, Available_0_9) auto memory_in_use() -> std::size_t;
+        lua_getter(lastFrameTime, Available_0_9) auto last_frame_time() -> double;
+        lua_getter(lastFrameSteps, Available_0_9) auto last_frame_steps() -> std::uint32_t;
+        lua_getter(lastFrameCycles, Available_0_9) auto last_frame_cycles() -> std::uint32_t;
+    }
+}
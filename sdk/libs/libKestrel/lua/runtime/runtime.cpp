@@ -22,6 +22,7 @@
 #include <libKestrel/exceptions/lua_runtime_exception.hpp>
 #include <libKestrel/lua/runtime/runtime.hpp>
 #include <libKestrel/lua/runtime/stack.hpp>
+#include <libKestrel/lua/runtime/chunk_cache.hpp>
 #include <libKestrel/lua/script.hpp>
 #include <libResourceCore/structure/instance.hpp>
 #include <libKestrel/device/console.hpp>
@@ -74,6 +75,7 @@ auto kestrel::lua::runtime::prepare_lua_runtime() -> void
     m_state = luaL_newstate();
     luaL_openlibs(m_state);
     install_internal_lua_overrides();
+    m_gc.attach(m_state);
 }
 
 auto kestrel::lua::runtime::install_internal_lua_overrides() const -> void
@@ -100,16 +102,6 @@ auto kestrel::lua::runtime::error_string() const -> std::string
     return m_stack->pop_string();
 }
 
-// MARK: - Reader
-
-static auto lua_runtime_reader(lua_State *L, void *data, size_t *size) -> const char *
-{
-    auto script = reinterpret_cast<kestrel::lua::script *>(data);
-    auto chunk = script->read_next_chunk();
-    *size = chunk.size;
-    return reinterpret_cast<const char *>(chunk.ptr);
-}
-
 // MARK: - Lua Interaction
 
 auto kestrel::lua::runtime::null() const -> luabridge::LuaRef
@@ -142,11 +134,14 @@ auto kestrel::lua::runtime::run(resource_core::identifier id, const std::string&
     int result = LUA_OK;
 
     if (script.format() == script::format::bytecode) {
+        // Load the bytecode directly from the script, rather than consuming it as a stream, so that the same script
+        // can be run more than once.
         auto chunk_name = "@LuaS:#" + std::to_string(id) + ":" + name;
-        result = lua_load(m_state, lua_runtime_reader, const_cast<lua::script *>(&script), chunk_name.c_str());
+        auto bytecode = reinterpret_cast<const char *>(script.bytecode());
+        result = luaL_loadbuffer(m_state, bytecode, script.bytecode_size(), chunk_name.c_str());
     }
     else {
-        result = luaL_loadstring(m_state, script.code().c_str());
+        result = chunk_cache::shared_cache().load(m_state, script.code());
     }
 
     if (result != LUA_OK) {
@@ -159,8 +154,7 @@ auto kestrel::lua::runtime::run(resource_core::identifier id, const std::string&
 
 auto kestrel::lua::runtime::run(resource_core::identifier id, const std::string& name, const std::string& script) -> void
 {
-    // TODO: Move this load so that it only happens once.
-    if (luaL_loadstring(m_state, script.c_str()) != LUA_OK) {
+    if (chunk_cache::shared_cache().load(m_state, script) != LUA_OK) {
         auto reason = error_string();
         throw lua_runtime_exception(reason);
     }
@@ -229,5 +223,10 @@ auto kestrel::lua::runtime::global_namespace() const -> luabridge::Namespace
 
 auto kestrel::lua::runtime::purge() -> void
 {
-    lua_gc(m_state, LUA_GCCOLLECT, 0);
+    m_gc.collect();
+}
+
+auto kestrel::lua::runtime::gc() -> gc_scheduler&
+{
+    return m_gc;
 }
\ No newline at end of file
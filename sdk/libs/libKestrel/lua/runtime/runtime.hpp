@@ -36,6 +36,7 @@ extern "C" {
 
 #include <libResourceCore/structure/instance.hpp>
 #include <libKestrel/lua/runtime/stack.hpp>
+#include <libKestrel/lua/runtime/gc_scheduler.hpp>
 
 class environment;
 
@@ -65,6 +66,7 @@ namespace kestrel::lua
 
         auto dump() -> void;
         auto purge() -> void;
+        auto gc() -> gc_scheduler&;
 
         [[nodiscard]] auto null() const -> luabridge::LuaRef;
         [[nodiscard]] auto table() const -> luabridge::LuaRef;
@@ -81,6 +83,7 @@ namespace kestrel::lua
     private:
         lua_State *m_state { nullptr };
         std::shared_ptr<lua::stack> m_stack;
+        gc_scheduler m_gc;
     };
 
 
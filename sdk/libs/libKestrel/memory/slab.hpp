@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <cassert>
+#include <array>
 
 namespace kestrel::memory
 {
@@ -36,20 +37,18 @@ namespace kestrel::memory
             // TODO: Investigate memory alignment here?
             m_queue.item_stack_base = new reference[C];
             m_queue.allocated_base = new reference[C];
-            m_queue.next_item = m_queue.item_stack_base;
-            for (std::size_t n = 0; n < C; ++n) {
-                *m_queue.next_item++ = n;
-            }
-            
-            m_queue.item_stack_top = --m_queue.next_item;
-            m_queue.allocated_ptr = m_queue.allocated_base;
-            m_queue.allocated = 0;
+            m_queue.allocated_index = new reference[C]();
+            purge();
         }
 
+        slab(const slab&) = delete;
+        slab(slab&&) = delete;
+
         ~slab()
         {
-            delete m_queue.item_stack_base;
-            delete m_queue.allocated_base;
+            delete[] m_queue.item_stack_base;
+            delete[] m_queue.allocated_base;
+            delete[] m_queue.allocated_index;
         }
 
         [[nodiscard]] inline auto allocated() const -> std::size_t { return m_queue.allocated; }
@@ -61,6 +60,11 @@ namespace kestrel::memory
             return m_pool[item];
         }
 
+        inline auto operator[](reference item) const noexcept -> const T&
+        {
+            return m_pool[item];
+        }
+
         inline auto first() noexcept -> T&
         {
             return m_pool[*m_queue.allocated_base];
@@ -78,18 +82,37 @@ namespace kestrel::memory
 
         inline auto purge() -> void
         {
+            // Restock the free stack, so that every item in the pool is available for request again.
             m_queue.next_item = m_queue.item_stack_base;
+            for (std::size_t n = 0; n < C; ++n) {
+                *m_queue.next_item++ = n;
+            }
+
+            m_queue.item_stack_top = --m_queue.next_item;
             m_queue.allocated_ptr = m_queue.allocated_base;
             m_queue.allocated = 0;
         }
 
+        inline auto is_allocated(reference item) const noexcept -> bool
+        {
+            auto idx = m_queue.allocated_index[item];
+            return (idx < m_queue.allocated) && (m_queue.allocated_base[idx] == item);
+        }
+
         inline auto release(reference item) -> void
         {
-            if (m_queue.next_item >= m_queue.item_stack_top || m_queue.allocated == 0) {
+            if (m_queue.next_item >= m_queue.item_stack_top || m_queue.allocated == 0 || !is_allocated(item)) {
                 return;
             }
+
+            // Swap the last allocated item in to the slot being vacated, so that the allocated list
+            // remains dense and continues to describe exactly the live items.
+            auto idx = m_queue.allocated_index[item];
+            auto last = *--m_queue.allocated_ptr;
+            m_queue.allocated_base[idx] = last;
+            m_queue.allocated_index[last] = idx;
+
             *++m_queue.next_item = item;
-            m_queue.allocated_ptr--;
             m_queue.allocated--;
         }
 
@@ -98,9 +121,11 @@ namespace kestrel::memory
             // Do not check for exceptions here, as this code is likely going to be _VERY HOT_.
             // We should apply assertions to test this in debug to find edge cases.
             assert(!depleted());
+            auto item = *m_queue.next_item--;
+            m_queue.allocated_index[item] = m_queue.allocated;
+            *m_queue.allocated_ptr++ = item;
             m_queue.allocated++;
-            *m_queue.allocated_ptr++ = *m_queue.next_item;
-            return *m_queue.next_item--;
+            return item;
         }
 
         inline auto get(reference item) noexcept -> T&
@@ -108,11 +133,26 @@ namespace kestrel::memory
             return m_pool[item];
         }
 
+        inline auto get(reference item) const noexcept -> const T&
+        {
+            return m_pool[item];
+        }
+
         inline auto get_allocated(std::uint64_t item) noexcept -> T&
         {
             return m_pool[m_queue.allocated_base[item]];
         }
 
+        inline auto get_allocated(std::uint64_t item) const noexcept -> const T&
+        {
+            return m_pool[m_queue.allocated_base[item]];
+        }
+
+        inline auto allocated_reference(std::uint64_t item) const noexcept -> reference
+        {
+            return m_queue.allocated_base[item];
+        }
+
         inline auto available() noexcept -> bool
         {
             return true;
@@ -127,6 +167,7 @@ namespace kestrel::memory
             reference *next_item { nullptr };
             reference *allocated_base { nullptr };
             reference *allocated_ptr { nullptr };
+            reference *allocated_index { nullptr };
             std::size_t allocated { 0 };
         } m_queue;
 
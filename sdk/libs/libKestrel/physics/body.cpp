@@ -29,8 +29,10 @@ static std::uint64_t s_next_body_id = 1;
 // MARK: - Construction
 
 kestrel::physics::body::body(std::weak_ptr<physics::world> world, identifier id)
-    : m_world(std::move(world)), m_id(id == 0 ? s_next_body_id++ : id)
+    : m_world(std::move(world)), m_id(id == 0 ? s_next_body_id++ : id),
+      m_detached_kinematics(std::make_unique<physics::kinematics>())
 {
+    m_kinematics = m_detached_kinematics.get();
     m_last_update = rtc::clock::global().current();
 }
 
@@ -46,90 +48,133 @@ auto kestrel::physics::body::force_id_change(identifier id) -> void
     m_id = id;
 }
 
+// MARK: - Kinematic State
+
+auto kestrel::physics::body::attach_kinematics(physics::kinematics *store, kinematics::slot slot) -> void
+{
+    if (!store || store == m_kinematics) {
+        return;
+    }
+
+    store->copy(slot, *m_kinematics, m_slot);
+    store->active[slot] = (m_collision_type != 0) ? 1.f : 0.f;
+    m_kinematics = store;
+    m_slot = slot;
+    m_detached_kinematics.reset();
+}
+
+auto kestrel::physics::body::detach_kinematics() -> void
+{
+    if (m_detached_kinematics) {
+        return;
+    }
+
+    auto detached = std::make_unique<physics::kinematics>();
+    detached->copy(0, *m_kinematics, m_slot);
+    m_kinematics->reset(m_slot);
+
+    m_detached_kinematics = std::move(detached);
+    m_kinematics = m_detached_kinematics.get();
+    m_slot = 0;
+}
+
 // MARK: - Inertia
 
 auto kestrel::physics::body::has_inertia() const -> bool
 {
-    return m_has_inertia;
+    return m_kinematics->inertia[m_slot] != 0;
 }
 
 auto kestrel::physics::body::set_inertia(bool f) -> void
 {
-    m_has_inertia = f;
+    m_kinematics->inertia[m_slot] = f ? 1 : 0;
 }
 
 // MARK: - Current Heading
 
 auto kestrel::physics::body::heading() const -> math::angle
 {
-    return m_velocity.angle();
+    return velocity().angle();
 }
 
 auto kestrel::physics::body::counter_heading() const -> math::angle
 {
-    return m_velocity.angle().opposite();
+    return velocity().angle().opposite();
 }
 
 auto kestrel::physics::body::on_counter_heading() const -> bool
 {
-    return m_rotation.is_opposing(m_velocity.angle(), m_rotation_speed);
+    return rotation().is_opposing(velocity().angle(), rotation_speed());
 }
 
 // MARK: - Positioning
 
 auto kestrel::physics::body::position() const -> math::point
 {
-    return m_position;
+    return { m_kinematics->position_x[m_slot], m_kinematics->position_y[m_slot] };
 }
 
 auto kestrel::physics::body::set_position(const math::point& position) -> void
 {
-    m_position = position;
-    m_hitbox.set_offset(m_position);
+    set_position_value(position);
+    m_hitbox.set_offset(position);
+}
+
+auto kestrel::physics::body::set_position_value(const math::point &position) -> void
+{
+    m_kinematics->position_x[m_slot] = position.x();
+    m_kinematics->position_y[m_slot] = position.y();
 }
 
 // MARK: - Velocity
 
 auto kestrel::physics::body::velocity() const -> math::point
 {
-    return m_velocity;
+    return { m_kinematics->velocity_x[m_slot], m_kinematics->velocity_y[m_slot] };
 }
 
 auto kestrel::physics::body::set_velocity(const math::point& velocity) -> void
 {
-    m_velocity = velocity;
+    set_velocity_value(velocity);
+}
+
+auto kestrel::physics::body::set_velocity_value(const math::point &velocity) -> void
+{
+    m_kinematics->velocity_x[m_slot] = velocity.x();
+    m_kinematics->velocity_y[m_slot] = velocity.y();
 }
 
 // MARK: - Speed
 
 auto kestrel::physics::body::speed() const -> double
 {
-    return m_current_speed;
+    return m_kinematics->speed[m_slot];
 }
 
 auto kestrel::physics::body::maximum_speed() const -> double
 {
-    return m_maximum_speed;
+    return m_kinematics->maximum_speed[m_slot];
 }
 
 auto kestrel::physics::body::set_maximum_speed(double speed) -> void
 {
-    m_maximum_speed = speed * 60.0;
+    m_kinematics->maximum_speed[m_slot] = speed * 60.0;
 }
 
 auto kestrel::physics::body::reduce_speed(double speed) -> void
 {
-    if (m_has_inertia) {
-        auto velocity = m_velocity.angle().vector(m_current_speed - speed);
+    auto& current_speed = m_kinematics->speed[m_slot];
+    if (has_inertia()) {
+        auto velocity = this->velocity().angle().vector(current_speed - speed);
         if (velocity.magnitude() <= 0) {
             velocity = math::point(0);
         }
-        m_velocity = velocity;
-        m_current_speed = m_velocity.magnitude();
+        set_velocity_value(velocity);
+        current_speed = velocity.magnitude();
     }
     else {
-        m_current_speed = std::max(m_current_speed - speed, 0.0);
-        m_velocity = m_rotation.vector(m_current_speed);
+        current_speed = std::max(current_speed - speed, 0.0);
+        set_velocity_value(rotation().vector(current_speed));
     }
 }
 
@@ -168,6 +213,7 @@ auto kestrel::physics::body::collision_type() const -> std::uint32_t
 auto kestrel::physics::body::set_collision_type(std::uint32_t type) -> void
 {
     m_collision_type = type;
+    m_kinematics->active[m_slot] = (type != 0) ? 1.f : 0.f;
 }
 
 auto kestrel::physics::body::reject_collisions_from_type(std::uint32_t type) -> void
@@ -227,20 +273,22 @@ auto kestrel::physics::body::all_collisions() const -> lua::vector<lua_reference
 auto kestrel::physics::body::simulate_force(const math::point &velocity, const math::point &force, bool ignore_maximum) -> math::point
 {
     auto new_velocity = velocity;
+    auto& current_speed = m_kinematics->speed[m_slot];
+    const auto maximum_speed = m_kinematics->maximum_speed[m_slot];
 
-    if (m_has_inertia) {
+    if (has_inertia()) {
         new_velocity = new_velocity + force;
-        if (!ignore_maximum && (new_velocity.magnitude() > m_maximum_speed)) {
-            new_velocity = new_velocity.angle().vector(m_maximum_speed);
+        if (!ignore_maximum && (new_velocity.magnitude() > maximum_speed)) {
+            new_velocity = new_velocity.angle().vector(maximum_speed);
         }
     }
     else if (!ignore_maximum) {
-        m_current_speed = std::min(m_current_speed + force.magnitude(), m_maximum_speed);
-        m_velocity = m_rotation.vector(m_current_speed);
+        current_speed = std::min(current_speed + force.magnitude(), maximum_speed);
+        set_velocity_value(rotation().vector(current_speed));
     }
     else {
-        m_current_speed += force.magnitude();
-        m_velocity = m_rotation.vector(m_current_speed);
+        current_speed += force.magnitude();
+        set_velocity_value(rotation().vector(current_speed));
     }
 
     return new_velocity;
@@ -248,110 +296,105 @@ auto kestrel::physics::body::simulate_force(const math::point &velocity, const m
 
 auto kestrel::physics::body::apply_force(const math::point& force, bool ignore_maximum) -> void
 {
-    if (m_has_inertia) {
-        auto velocity = m_velocity + force;
-        if (!ignore_maximum && (velocity.magnitude() > m_maximum_speed)) {
-            velocity = velocity.angle().vector(m_maximum_speed);
+    auto& current_speed = m_kinematics->speed[m_slot];
+    const auto maximum_speed = m_kinematics->maximum_speed[m_slot];
+
+    if (has_inertia()) {
+        auto velocity = this->velocity() + force;
+        if (!ignore_maximum && (velocity.magnitude() > maximum_speed)) {
+            velocity = velocity.angle().vector(maximum_speed);
         }
-        m_velocity = velocity;
-        m_current_speed = m_velocity.magnitude();
+        set_velocity_value(velocity);
+        current_speed = velocity.magnitude();
     }
     else if (!ignore_maximum) {
-        m_current_speed = std::min(m_current_speed + force.magnitude(), m_maximum_speed);
-        m_velocity = m_rotation.vector(m_current_speed);
+        current_speed = std::min(current_speed + force.magnitude(), maximum_speed);
+        set_velocity_value(rotation().vector(current_speed));
     }
     else {
-        m_current_speed += force.magnitude();
-        m_velocity = m_rotation.vector(m_current_speed);
+        current_speed += force.magnitude();
+        set_velocity_value(rotation().vector(current_speed));
     }
 }
 
 auto kestrel::physics::body::inverse_force() const -> math::point
 {
-     return m_rotation.opposite().vector(m_acceleration);
+     return rotation().opposite().vector(acceleration());
 }
 
 auto kestrel::physics::body::force() const -> math::point
 {
-    return m_rotation.vector(m_acceleration);
+    return rotation().vector(acceleration());
 }
 
 auto kestrel::physics::body::force_value(double value) const -> math::point
 {
-    return m_rotation.vector(value);
+    return rotation().vector(value);
 }
 
 // MARK: - Acceleration
 
 auto kestrel::physics::body::acceleration() const -> double
 {
-    return m_acceleration;
+    return m_kinematics->acceleration[m_slot];
 }
 
 auto kestrel::physics::body::set_acceleration(double accel) -> void
 {
-    m_acceleration = accel * 60.0;
+    m_kinematics->acceleration[m_slot] = accel * 60.0;
 }
 
 // MARK: - Rotation
 
 auto kestrel::physics::body::rotation() const -> math::angle
 {
-    return m_rotation;
+    return math::angle(m_kinematics->rotation[m_slot]);
 }
 
 auto kestrel::physics::body::set_rotation(const math::angle &rotation) -> void
 {
-    m_rotation = rotation;
+    m_kinematics->rotation[m_slot] = rotation.degrees();
 }
 
 auto kestrel::physics::body::rotation_speed() const -> math::angular_difference
 {
-    return m_rotation_speed;
+    return math::angular_difference(m_kinematics->rotation_speed[m_slot]);
 }
 
 auto kestrel::physics::body::set_rotation_speed(const math::angular_difference& speed) -> void
 {
-    m_rotation_speed = speed * 60;
+    m_kinematics->rotation_speed[m_slot] = (speed * 60).phi();
 }
 
 auto kestrel::physics::body::rotate_clockwise() -> void
 {
-    m_rotation_action = 1;
+    m_kinematics->rotation_action[m_slot] = 1;
 }
 
 auto kestrel::physics::body::rotate_counter_clockwise() -> void
 {
-    m_rotation_action = -1;
+    m_kinematics->rotation_action[m_slot] = -1;
 }
 
 // MARK: - Halting
 
 auto kestrel::physics::body::halt() -> void
 {
-    m_current_speed = 0;
-    m_velocity = math::point(0);
+    m_kinematics->speed[m_slot] = 0;
+    set_velocity_value(math::point(0));
 }
 
 // MARK: - Updating / Tick
 
 auto kestrel::physics::body::update(const rtc::clock::duration& delta) -> void
 {
-    // Update the current rotation
-    if (m_rotation_action > 0) {
-        m_rotation = m_rotation + math::angular_difference(m_rotation_speed * delta.count());
-    }
-    else if (m_rotation_action < 0) {
-        m_rotation = m_rotation - math::angular_difference(m_rotation_speed * delta.count());
-    }
-    m_rotation_action = 0;
-
-    if (!m_has_inertia) {
-        m_velocity = m_rotation.vector(m_current_speed);
-    }
+    m_kinematics->integrate(m_slot, static_cast<float>(delta.count()));
+    sync_hitbox();
+}
 
-    m_position = m_position + (m_velocity * delta.count());
-    m_hitbox.set_offset(m_position);
+auto kestrel::physics::body::sync_hitbox() -> void
+{
+    m_hitbox.set_offset(position());
 }
 
 // MARK: - Destruction
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <memory>
 #include <unordered_set>
 #include <unordered_map>
 #include <libKestrel/math/point.hpp>
@@ -29,6 +30,7 @@
 #include <libKestrel/lua/scripting.hpp>
 #include <libKestrel/lua/support/vector.hpp>
 #include <libKestrel/physics/hitbox.hpp>
+#include <libKestrel/physics/kinematics.hpp>
 #include <libKestrel/clock/clock.hpp>
 
 namespace kestrel::physics
@@ -101,6 +103,10 @@ namespace kestrel::physics
         lua_setter(info, Available_0_8) auto set_info(luabridge::LuaRef ref) -> void;
 
         auto update(const rtc::clock::duration& delta) -> void;
+        auto sync_hitbox() -> void;
+
+        auto attach_kinematics(physics::kinematics *store, kinematics::slot slot) -> void;
+        auto detach_kinematics() -> void;
 
         auto destroy() -> void;
         auto migrate_to_world(std::weak_ptr<physics::world> new_world) -> void;
@@ -121,14 +127,11 @@ namespace kestrel::physics
         physics::hitbox m_hitbox;
         rtc::clock::time m_last_update;
         luabridge::LuaRef m_info { nullptr };
-        bool m_has_inertia { true };
-        math::point m_position;
-        math::point m_velocity;
-        math::angle m_rotation;
-        double m_current_speed { 0 };
-        math::angular_difference m_rotation_speed;
-        double m_maximum_speed { 0 };
-        double m_acceleration { 0 };
-        std::int8_t m_rotation_action { 0 };
+        std::unique_ptr<physics::kinematics> m_detached_kinematics;
+        physics::kinematics *m_kinematics { nullptr };
+        kinematics::slot m_slot { 0 };
+
+        auto set_position_value(const math::point& position) -> void;
+        auto set_velocity_value(const math::point& velocity) -> void;
     };
 }
\ No newline at end of file
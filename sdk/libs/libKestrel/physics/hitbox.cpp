@@ -19,6 +19,7 @@
 // SOFTWARE.
 
 #include <stdexcept>
+#include <algorithm>
 #include <libKestrel/physics/hitbox.hpp>
 #include <libKestrel/physics/collisions.hpp>
 
@@ -26,7 +27,9 @@
 
 kestrel::physics::hitbox::hitbox(const math::vec2 &origin, double radius)
     : m_type(type::circle), m_origin(origin), m_radius(radius)
-{}
+{
+    rebuild_scaled_triangles();
+}
 
 kestrel::physics::hitbox::hitbox(const math::rect &rect)
     : m_type(type::rect), m_origin(rect.origin()), m_size(rect.size())
@@ -44,6 +47,7 @@ kestrel::physics::hitbox::hitbox(const math::triangulated_polygon &poly)
         radius = std::max(radius, tri.c.magnitude());
     }
     m_radius = radius;
+    rebuild_scaled_triangles();
 }
 
 // MARK: - Accessors
@@ -83,6 +87,22 @@ auto kestrel::physics::hitbox::polygon() const -> math::triangulated_polygon
     return m_polygon;
 }
 
+auto kestrel::physics::hitbox::bounds() const -> math::rect
+{
+    return { m_offset, size() };
+}
+
+auto kestrel::physics::hitbox::broadphase_bounds() const -> math::rect
+{
+    if (m_type == type::rect) {
+        return { m_offset, size() * m_scale };
+    }
+
+    // Polygons and circles are centered on the offset, so construct a square that encloses the scaled radius.
+    auto radius = static_cast<float>(m_scaled_radius);
+    return { m_offset - math::point(radius), math::size(radius * 2) };
+}
+
 auto kestrel::physics::hitbox::set_lod(enum lod lod) -> void
 {
     m_lod = lod;
@@ -91,6 +111,7 @@ auto kestrel::physics::hitbox::set_lod(enum lod lod) -> void
 auto kestrel::physics::hitbox::set_offset(const math::point &offset) -> void
 {
     m_offset = offset;
+    rebuild_world_triangles();
 }
 
 auto kestrel::physics::hitbox::scale_factor() const -> math::size
@@ -100,18 +121,55 @@ auto kestrel::physics::hitbox::scale_factor() const -> math::size
 
 auto kestrel::physics::hitbox::set_scale_factor(const math::size &size) -> void
 {
-    m_scale = size;
+    if (m_scale != size) {
+        m_scale = size;
+        rebuild_scaled_triangles();
+    }
+}
+
+// MARK: - Collision Triangles
+
+auto kestrel::physics::hitbox::rebuild_scaled_triangles() -> void
+{
+    // Scaling the polygon is expensive, so it is only done when the polygon or scale changes. The triangles
+    // are stored relative to the center of the polygon, ready to be moved to the current offset.
+    m_scaled_triangles.clear();
+    m_scaled_radius = m_radius * std::max(m_scale.width(), m_scale.height());
+
+    if (m_type == type::polygon) {
+        auto scaled = m_polygon * m_scale;
+        m_scaled_triangles.reserve(scaled.triangle_count());
+        for (auto n = 0; n < scaled.triangle_count(); ++n) {
+            m_scaled_triangles.emplace_back(scaled.triangle_at(n) - scaled.center());
+        }
+    }
+
+    rebuild_world_triangles();
+}
+
+auto kestrel::physics::hitbox::rebuild_world_triangles() -> void
+{
+    // Reuse the existing storage, so that moving the hitbox each frame does not allocate.
+    m_world_triangles.resize(m_scaled_triangles.size());
+    for (auto n = 0; n < m_scaled_triangles.size(); ++n) {
+        m_world_triangles[n] = m_scaled_triangles[n] + m_offset;
+    }
 }
 
 // MARK: - Collision Checking
 
+auto kestrel::physics::hitbox::is_collision_testable() const -> bool
+{
+    return (m_type == type::polygon);
+}
+
 auto kestrel::physics::hitbox::collision_test(const hitbox &hb) const -> bool
 {
     // TODO: Handle the varying LODs...
     if (m_type == type::polygon && hb.m_type == type::polygon) {
         auto distance = m_offset.distance_to(hb.m_offset);
-        if (distance < m_radius + hb.m_radius) {
-            return collision_test(m_polygon * m_scale, m_offset, hb.m_polygon * hb.m_scale, hb.m_offset);
+        if (distance < m_scaled_radius + hb.m_scaled_radius) {
+            return collision_test(m_world_triangles, hb.m_world_triangles);
         }
         return false;
     }
@@ -123,20 +181,14 @@ auto kestrel::physics::hitbox::collision_test(const hitbox &hb) const -> bool
     }
 }
 
-auto kestrel::physics::hitbox::collision_test(const math::triangulated_polygon &a, const math::point& offset_a, const math::triangulated_polygon &b, const math::point& offset_b) -> bool
+auto kestrel::physics::hitbox::collision_test(const std::vector<math::triangle>& a, const std::vector<math::triangle>& b) -> bool
 {
-    // TODO: This is a major bottleneck currently.
-    for (auto i = 0; i < a.triangle_count(); ++i) {
-        auto t1 = a.triangle_at(i) - a.center() + offset_a;
-        for (auto j = 0; j < b.triangle_count(); ++j) {
-            auto t2 = b.triangle_at(j) - b.center() + offset_b;
+    for (const auto& t1 : a) {
+        for (const auto& t2 : b) {
             if (collisions::test(t1, t2)) {
                 return true;
             }
-//            if (t1.intersects(t2)) {
-//                return true;
-//            }
         }
     }
     return false;
-}
\ No newline at end of file
+}
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <vector>
 #include <libKestrel/physics/lod.hpp>
 #include <libKestrel/math/vec2.hpp>
 #include <libKestrel/math/rect.hpp>
@@ -50,6 +51,13 @@ namespace kestrel::physics
         [[nodiscard]] auto center() const -> math::point;
         [[nodiscard]] auto size() const -> math::size;
         [[nodiscard]] auto polygon() const -> math::triangulated_polygon;
+        [[nodiscard]] auto bounds() const -> math::rect;
+
+        /**
+         * The scaled, world-space rect that encloses the whole hitbox, used to index the hitbox in the broadphase.
+         * Polygons and circles are centered on the offset, rather than having their origin at it.
+         */
+        [[nodiscard]] auto broadphase_bounds() const -> math::rect;
 
         auto set_lod(enum lod lod) -> void;
         auto set_offset(const math::point& offset) -> void;
@@ -57,10 +65,18 @@ namespace kestrel::physics
         [[nodiscard]] auto scale_factor() const -> math::size;
         auto set_scale_factor(const math::size& size) -> void;
 
+        /**
+         * Only polygon hitboxes can currently be tested against one another. Testing any other pairing of valid
+         * hitboxes throws.
+         */
+        [[nodiscard]] auto is_collision_testable() const -> bool;
         [[nodiscard]] auto collision_test(const hitbox& hb) const -> bool;
 
     private:
-        [[nodiscard]] static auto collision_test(const math::triangulated_polygon& a, const math::point& offset_a, const math::triangulated_polygon& b, const math::point& offset_b) -> bool;
+        [[nodiscard]] static auto collision_test(const std::vector<math::triangle>& a, const std::vector<math::triangle>& b) -> bool;
+
+        auto rebuild_scaled_triangles() -> void;
+        auto rebuild_world_triangles() -> void;
 
     private:
         enum lod m_lod { medium };
@@ -71,6 +87,9 @@ namespace kestrel::physics
         math::vec2 m_size;
         math::size m_scale { 1 };
         math::triangulated_polygon m_polygon;
+        double m_scaled_radius { 0 };
+        std::vector<math::triangle> m_scaled_triangles;
+        std::vector<math::triangle> m_world_triangles;
 
     };
 }
\ No newline at end of file
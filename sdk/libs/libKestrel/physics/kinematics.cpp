@@ -0,0 +1,165 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <libKestrel/physics/kinematics.hpp>
+#include <libKestrel/math/angle.hpp>
+#include <libKestrel/math/angular_difference.hpp>
+#include <libKestrel/math/point.hpp>
+#include <libKestrel/util/availability.hpp>
+
+#if TARGET_INTEL && defined(__AVX__)
+#   include <immintrin.h>
+#endif
+
+// MARK: - Construction
+
+kestrel::physics::kinematics::kinematics(std::size_t capacity)
+    : position_x(capacity, 0), position_y(capacity, 0),
+      velocity_x(capacity, 0), velocity_y(capacity, 0),
+      rotation(capacity, 0), rotation_speed(capacity, 0), rotation_action(capacity, 0),
+      active(capacity, 0),
+      speed(capacity, 0), maximum_speed(capacity, 0), acceleration(capacity, 0),
+      inertia(capacity, 1)
+{}
+
+// MARK: - Accessors
+
+auto kestrel::physics::kinematics::capacity() const -> std::size_t
+{
+    return active.size();
+}
+
+// MARK: - Slot Management
+
+auto kestrel::physics::kinematics::reset(slot s) -> void
+{
+    position_x[s] = position_y[s] = 0;
+    velocity_x[s] = velocity_y[s] = 0;
+    rotation[s] = rotation_speed[s] = rotation_action[s] = 0;
+    active[s] = 0;
+    speed[s] = maximum_speed[s] = acceleration[s] = 0;
+    inertia[s] = 1;
+}
+
+auto kestrel::physics::kinematics::copy(slot s, const kinematics& source, slot source_slot) -> void
+{
+    position_x[s] = source.position_x[source_slot];
+    position_y[s] = source.position_y[source_slot];
+    velocity_x[s] = source.velocity_x[source_slot];
+    velocity_y[s] = source.velocity_y[source_slot];
+    rotation[s] = source.rotation[source_slot];
+    rotation_speed[s] = source.rotation_speed[source_slot];
+    rotation_action[s] = source.rotation_action[source_slot];
+    active[s] = source.active[source_slot];
+    speed[s] = source.speed[source_slot];
+    maximum_speed[s] = source.maximum_speed[source_slot];
+    acceleration[s] = source.acceleration[source_slot];
+    inertia[s] = source.inertia[source_slot];
+}
+
+// MARK: - Integration
+
+auto kestrel::physics::kinematics::integrate(slot s, float dt) -> void
+{
+    if (rotation_action[s] > 0) {
+        rotation[s] = (math::angle(rotation[s]) + math::angular_difference(rotation_speed[s] * dt)).degrees();
+    }
+    else if (rotation_action[s] < 0) {
+        rotation[s] = (math::angle(rotation[s]) - math::angular_difference(rotation_speed[s] * dt)).degrees();
+    }
+    rotation_action[s] = 0;
+
+    if (!inertia[s]) {
+        auto v = math::angle(rotation[s]).vector(static_cast<float>(speed[s]));
+        velocity_x[s] = v.x();
+        velocity_y[s] = v.y();
+    }
+
+    position_x[s] = position_x[s] + (velocity_x[s] * dt);
+    position_y[s] = position_y[s] + (velocity_y[s] * dt);
+}
+
+auto kestrel::physics::kinematics::integrate(slot begin, slot end, float dt) -> void
+{
+    if (begin >= end) {
+        return;
+    }
+
+    integrate_rotation(begin, end, dt);
+    integrate_heading(begin, end);
+    integrate_position(begin, end, dt);
+}
+
+auto kestrel::physics::kinematics::integrate_rotation(slot begin, slot end, float dt) -> void
+{
+    // Rotation is rare enough that it is handled per slot, as it has to be normalised exactly as math::angle
+    // would do it to keep results identical to the reference implementation.
+    for (auto s = begin; s < end; ++s) {
+        if (active[s] == 0) {
+            continue;
+        }
+
+        if (rotation_action[s] != 0) {
+            auto phi = rotation_speed[s] * dt;
+            auto theta = (rotation_action[s] > 0) ? (rotation[s] + phi) : (rotation[s] - phi);
+            rotation[s] = math::angle(theta).degrees();
+            rotation_action[s] = 0;
+        }
+    }
+}
+
+auto kestrel::physics::kinematics::integrate_heading(slot begin, slot end) -> void
+{
+    // Bodies without inertia always travel in the direction that they are facing.
+    for (auto s = begin; s < end; ++s) {
+        if (active[s] != 0 && !inertia[s]) {
+            auto v = math::angle(rotation[s]).vector(static_cast<float>(speed[s]));
+            velocity_x[s] = v.x();
+            velocity_y[s] = v.y();
+        }
+    }
+}
+
+auto kestrel::physics::kinematics::integrate_position(slot begin, slot end, float dt) -> void
+{
+    // Inactive slots are scaled by a delta of zero, which leaves them in place without a branch.
+    auto s = begin;
+
+#if TARGET_INTEL && defined(__AVX__)
+    const auto delta = _mm256_set1_ps(dt);
+    for (; s + 8 <= end; s += 8) {
+        auto scaled_delta = _mm256_mul_ps(delta, _mm256_loadu_ps(&active[s]));
+
+        auto x = _mm256_loadu_ps(&position_x[s]);
+        auto vx = _mm256_loadu_ps(&velocity_x[s]);
+        _mm256_storeu_ps(&position_x[s], _mm256_add_ps(x, _mm256_mul_ps(vx, scaled_delta)));
+
+        auto y = _mm256_loadu_ps(&position_y[s]);
+        auto vy = _mm256_loadu_ps(&velocity_y[s]);
+        _mm256_storeu_ps(&position_y[s], _mm256_add_ps(y, _mm256_mul_ps(vy, scaled_delta)));
+    }
+#endif
+
+    for (; s < end; ++s) {
+        auto scaled_delta = dt * active[s];
+        position_x[s] = position_x[s] + (velocity_x[s] * scaled_delta);
+        position_y[s] = position_y[s] + (velocity_y[s] * scaled_delta);
+    }
+}
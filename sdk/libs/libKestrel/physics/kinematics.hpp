@@ -0,0 +1,74 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace kestrel::physics
+{
+    /**
+     * Structure-of-arrays storage for the hot kinematic state of physics bodies.
+     *
+     * Bodies that belong to a world keep their state in the world's store, with each body occupying the slot
+     * that matches its identifier, so that integration can walk contiguous arrays. Bodies that are not in a
+     * world keep their state in a private store with a single slot.
+     */
+    struct kinematics
+    {
+        typedef std::size_t slot;
+
+        explicit kinematics(std::size_t capacity = 1);
+
+        [[nodiscard]] auto capacity() const -> std::size_t;
+
+        auto reset(slot s) -> void;
+        auto copy(slot s, const kinematics& source, slot source_slot) -> void;
+
+        /**
+         * Integrate a single slot. This is the reference implementation that the batched kernel must match.
+         */
+        auto integrate(slot s, float dt) -> void;
+
+        /**
+         * Integrate all active slots in the range [begin, end). Inactive slots are left untouched.
+         */
+        auto integrate(slot begin, slot end, float dt) -> void;
+
+        std::vector<float> position_x;
+        std::vector<float> position_y;
+        std::vector<float> velocity_x;
+        std::vector<float> velocity_y;
+        std::vector<float> rotation;
+        std::vector<float> rotation_speed;
+        std::vector<float> rotation_action;
+        std::vector<float> active;
+        std::vector<double> speed;
+        std::vector<double> maximum_speed;
+        std::vector<double> acceleration;
+        std::vector<std::uint8_t> inertia;
+
+    private:
+        auto integrate_rotation(slot begin, slot end, float dt) -> void;
+        auto integrate_heading(slot begin, slot end) -> void;
+        auto integrate_position(slot begin, slot end, float dt) -> void;
+    };
+}
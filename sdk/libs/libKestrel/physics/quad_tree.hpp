@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <type_traits>
 #include <array>
+#include <vector>
 #include <libKestrel/math/rect.hpp>
 
 namespace kestrel::physics
@@ -90,15 +91,46 @@ namespace kestrel::physics
         auto retrieve(const math::rect& rect) const -> std::vector<std::pair<math::rect, T>>
         {
             std::vector<std::pair<math::rect, T>> result;
-            auto idx = index(rect);
-            if (idx != -1 && m_nodes[0]) {
-                auto node_result = m_nodes[idx]->retrieve(rect);
-                result.insert(result.end(), node_result.begin(), node_result.end());
-            }
-            result.insert(result.end(), m_objects.begin(), m_objects.end());
+            retrieve(rect, result);
             return result;
         }
 
+        /**
+         * Retrieve the candidates for the specified rect in to a caller owned buffer. The buffer is cleared first,
+         * but retains its capacity, so reusing it across queries avoids any allocation once it has grown.
+         */
+        auto retrieve(const math::rect& rect, std::vector<std::pair<math::rect, T>>& result) const -> void
+        {
+            result.clear();
+            visit(rect, [&] (const math::rect& bounds, const T& object) {
+                result.emplace_back(bounds, object);
+            });
+        }
+
+        /**
+         * Visit each of the candidates for the specified rect, without allocating or recursing. Candidates are
+         * visited deepest node first, matching the order produced by retrieve().
+         */
+        template<typename F>
+        auto visit(const math::rect& rect, F&& visitor) const -> void
+        {
+            std::array<const quad_tree<T, M, L> *, L + 1> path {};
+            std::size_t depth = 0;
+
+            const auto *node = this;
+            while (node && depth < path.size()) {
+                path[depth++] = node;
+                auto idx = node->index(rect);
+                node = (idx != -1 && node->m_nodes[0]) ? node->m_nodes[idx] : nullptr;
+            }
+
+            while (depth > 0) {
+                for (const auto& object : path[--depth]->m_objects) {
+                    visitor(object.first, object.second);
+                }
+            }
+        }
+
     private:
         auto split() -> void
         {
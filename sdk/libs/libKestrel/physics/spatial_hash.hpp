@@ -0,0 +1,373 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <array>
+#include <algorithm>
+#include <libKestrel/math/rect.hpp>
+#include <libKestrel/memory/slab.hpp>
+
+namespace kestrel::physics
+{
+    /**
+     * A persistent broadphase that buckets objects in to a uniform grid of cells.
+     *
+     * Objects keep their place in the grid between frames, and are only relinked when their bounds move
+     * in to a different set of cells. All storage comes from preallocated slabs, so steady state updates and
+     * queries perform no heap allocation.
+     *
+     * Objects that would cover more than max_linked_cells cells, or that cannot be linked because every cell link is
+     * in use, are instead kept in a separate oversized list that is tested by every query.
+     *
+     * T is the object stored against each proxy, C the maximum number of proxies, L the maximum number of
+     * cell links shared between all proxies and B the number of hash buckets (must be a power of two.)
+     */
+    template<typename T, std::size_t C, std::size_t L = C * 4, std::size_t B = 16384>
+    struct spatial_hash
+    {
+        static_assert((B & (B - 1)) == 0, "Bucket count must be a power of two.");
+
+        typedef std::uint64_t proxy;
+        static constexpr proxy null_proxy = std::numeric_limits<proxy>::max();
+        static constexpr std::int64_t max_linked_cells = 64;
+
+        explicit spatial_hash(float cell_size = 128.f)
+            : m_cell_size(cell_size), m_inverse_cell_size(1.f / cell_size)
+        {
+            m_buckets.fill(null_link);
+        }
+
+        spatial_hash(const spatial_hash&) = delete;
+        spatial_hash(spatial_hash&&) = delete;
+
+        [[nodiscard]] auto count() const -> std::size_t
+        {
+            return m_proxies.allocated();
+        }
+
+        [[nodiscard]] auto cell_size() const -> float
+        {
+            return m_cell_size;
+        }
+
+        [[nodiscard]] auto oversized_count() const -> std::size_t
+        {
+            return m_oversized_count;
+        }
+
+        auto clear() -> void
+        {
+            m_proxies.purge();
+            m_links.purge();
+            m_buckets.fill(null_link);
+            m_oversized = null_proxy;
+            m_oversized_count = 0;
+        }
+
+        auto insert(const math::rect& bounds, T object) -> proxy
+        {
+            auto ref = m_proxies.request();
+            auto& p = m_proxies.get(ref);
+            p.object = object;
+            p.first_link = null_link;
+            p.oversized = false;
+            set_bounds(p, bounds);
+            p.cells = cells(p.bounds);
+            link(ref, p);
+            return ref;
+        }
+
+        /**
+         * Update the bounds of the specified proxy. The proxy is only relinked in to the grid if the set of cells
+         * that it covers has changed. Returns true if the proxy was relinked.
+         */
+        auto update(proxy ref, const math::rect& bounds) -> bool
+        {
+            auto& p = m_proxies.get(ref);
+            set_bounds(p, bounds);
+
+            auto new_cells = cells(p.bounds);
+            if (new_cells == p.cells) {
+                return false;
+            }
+
+            unlink(ref, p);
+            p.cells = new_cells;
+            link(ref, p);
+            return true;
+        }
+
+        auto remove(proxy ref) -> void
+        {
+            if (ref == null_proxy || !m_proxies.is_allocated(ref)) {
+                return;
+            }
+            unlink(ref, m_proxies.get(ref));
+            m_proxies.release(ref);
+        }
+
+        [[nodiscard]] auto object(proxy ref) const -> const T&
+        {
+            return m_proxies.get(ref).object;
+        }
+
+        /**
+         * Visit every object whose bounds overlap the specified rect. Each object is visited exactly once, even
+         * if it spans several of the cells covered by the query.
+         */
+        template<typename F>
+        auto query(const math::rect& bounds, F&& visitor) const -> void
+        {
+            extent q { bounds.x(), bounds.y(), bounds.max_x(), bounds.max_y() };
+            auto query_cells = cells(q);
+
+            // Walking the cells of a very large query costs more than testing every object directly.
+            if (cell_count(query_cells) > static_cast<std::int64_t>(std::max(B, m_proxies.allocated()))) {
+                for (std::size_t n = 0; n < m_proxies.allocated(); ++n) {
+                    const auto& p = m_proxies.get_allocated(n);
+                    if (overlaps(p.bounds, q)) {
+                        visitor(p.object);
+                    }
+                }
+                return;
+            }
+
+            for (auto o = m_oversized; o != null_proxy; o = m_proxies.get(o).next_oversized) {
+                const auto& p = m_proxies.get(o);
+                if (overlaps(p.bounds, q)) {
+                    visitor(p.object);
+                }
+            }
+
+            for (auto cy = query_cells.y0; cy <= query_cells.y1; ++cy) {
+                for (auto cx = query_cells.x0; cx <= query_cells.x1; ++cx) {
+                    for (auto l = m_buckets[bucket(cx, cy)]; l != null_link; l = m_links.get(l).next) {
+                        const auto& lk = m_links.get(l);
+                        if (lk.cx != cx || lk.cy != cy) {
+                            continue;
+                        }
+
+                        // Only report the object from the first cell that both it and the query share, which
+                        // removes duplicates without needing to track visited objects.
+                        const auto& p = m_proxies.get(lk.owner);
+                        if (cx != std::max(query_cells.x0, p.cells.x0) || cy != std::max(query_cells.y0, p.cells.y0)) {
+                            continue;
+                        }
+
+                        if (overlaps(p.bounds, q)) {
+                            visitor(p.object);
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+        typedef std::uint64_t link_ref;
+        static constexpr link_ref null_link = std::numeric_limits<link_ref>::max();
+
+        // Cell coordinates are clamped to this range, so that they can be stepped and counted without overflowing.
+        static constexpr std::int32_t cell_limit = 1 << 30;
+
+        struct extent
+        {
+            float min_x { 0 };
+            float min_y { 0 };
+            float max_x { 0 };
+            float max_y { 0 };
+        };
+
+        struct cell_range
+        {
+            std::int32_t x0 { 0 };
+            std::int32_t y0 { 0 };
+            std::int32_t x1 { -1 };
+            std::int32_t y1 { -1 };
+
+            auto operator==(const cell_range& r) const -> bool
+            {
+                return x0 == r.x0 && y0 == r.y0 && x1 == r.x1 && y1 == r.y1;
+            }
+        };
+
+        struct proxy_record
+        {
+            T object {};
+            extent bounds;
+            cell_range cells;
+            link_ref first_link { null_link };
+            bool oversized { false };
+            proxy prev_oversized { null_proxy };
+            proxy next_oversized { null_proxy };
+        };
+
+        struct link_record
+        {
+            proxy owner { null_proxy };
+            std::int32_t cx { 0 };
+            std::int32_t cy { 0 };
+            link_ref prev { null_link };
+            link_ref next { null_link };
+            link_ref next_owned { null_link };
+        };
+
+        float m_cell_size { 128.f };
+        float m_inverse_cell_size { 1.f / 128.f };
+        memory::slab<proxy_record, C> m_proxies;
+        memory::slab<link_record, L> m_links;
+        std::array<link_ref, B> m_buckets;
+        proxy m_oversized { null_proxy };
+        std::size_t m_oversized_count { 0 };
+
+        static inline auto set_bounds(proxy_record& p, const math::rect& r) -> void
+        {
+            p.bounds = { r.x(), r.y(), r.max_x(), r.max_y() };
+        }
+
+        static inline auto overlaps(const extent& a, const extent& b) -> bool
+        {
+            return (a.min_x <= b.max_x) && (b.min_x <= a.max_x) && (a.min_y <= b.max_y) && (b.min_y <= a.max_y);
+        }
+
+        static inline auto bucket(std::int32_t cx, std::int32_t cy) -> std::size_t
+        {
+            auto h = (static_cast<std::uint32_t>(cx) * 73856093u) ^ (static_cast<std::uint32_t>(cy) * 19349663u);
+            return h & (B - 1);
+        }
+
+        static inline auto cell_count(const cell_range& r) -> std::int64_t
+        {
+            if (r.x1 < r.x0 || r.y1 < r.y0) {
+                return 0;
+            }
+            return (static_cast<std::int64_t>(r.x1) - r.x0 + 1) * (static_cast<std::int64_t>(r.y1) - r.y0 + 1);
+        }
+
+        /**
+         * Convert a coordinate to a cell, clamped to the supported range. NaN is given the fallback cell, which
+         * is the outermost cell in the direction of the edge being converted.
+         */
+        [[nodiscard]] inline auto cell(float v, std::int32_t fallback) const -> std::int32_t
+        {
+            auto c = std::floor(v * m_inverse_cell_size);
+            if (std::isnan(c)) {
+                return fallback;
+            }
+            return static_cast<std::int32_t>(std::clamp(c, static_cast<float>(-cell_limit), static_cast<float>(cell_limit)));
+        }
+
+        [[nodiscard]] inline auto cells(const extent& b) const -> cell_range
+        {
+            return {
+                cell(b.min_x, -cell_limit),
+                cell(b.min_y, -cell_limit),
+                cell(b.max_x, cell_limit),
+                cell(b.max_y, cell_limit)
+            };
+        }
+
+        auto link(proxy ref, proxy_record& p) -> void
+        {
+            if (cell_count(p.cells) > max_linked_cells || m_links.remaining() < static_cast<std::size_t>(cell_count(p.cells))) {
+                link_oversized(ref, p);
+                return;
+            }
+
+            for (auto cy = p.cells.y0; cy <= p.cells.y1; ++cy) {
+                for (auto cx = p.cells.x0; cx <= p.cells.x1; ++cx) {
+                    auto l = m_links.request();
+                    auto& lk = m_links.get(l);
+                    auto& head = m_buckets[bucket(cx, cy)];
+
+                    lk.owner = ref;
+                    lk.cx = cx;
+                    lk.cy = cy;
+                    lk.prev = null_link;
+                    lk.next = head;
+                    if (head != null_link) {
+                        m_links.get(head).prev = l;
+                    }
+                    head = l;
+
+                    lk.next_owned = p.first_link;
+                    p.first_link = l;
+                }
+            }
+        }
+
+        auto link_oversized(proxy ref, proxy_record& p) -> void
+        {
+            p.oversized = true;
+            p.prev_oversized = null_proxy;
+            p.next_oversized = m_oversized;
+            if (m_oversized != null_proxy) {
+                m_proxies.get(m_oversized).prev_oversized = ref;
+            }
+            m_oversized = ref;
+            m_oversized_count++;
+        }
+
+        auto unlink(proxy ref, proxy_record& p) -> void
+        {
+            if (p.oversized) {
+                if (p.prev_oversized != null_proxy) {
+                    m_proxies.get(p.prev_oversized).next_oversized = p.next_oversized;
+                }
+                else {
+                    m_oversized = p.next_oversized;
+                }
+
+                if (p.next_oversized != null_proxy) {
+                    m_proxies.get(p.next_oversized).prev_oversized = p.prev_oversized;
+                }
+
+                p.oversized = false;
+                p.prev_oversized = null_proxy;
+                p.next_oversized = null_proxy;
+                m_oversized_count--;
+                return;
+            }
+
+            auto l = p.first_link;
+            while (l != null_link) {
+                auto& lk = m_links.get(l);
+                if (lk.prev != null_link) {
+                    m_links.get(lk.prev).next = lk.next;
+                }
+                else {
+                    m_buckets[bucket(lk.cx, lk.cy)] = lk.next;
+                }
+
+                if (lk.next != null_link) {
+                    m_links.get(lk.next).prev = lk.prev;
+                }
+
+                auto next = lk.next_owned;
+                m_links.release(l);
+                l = next;
+            }
+            p.first_link = null_link;
+        }
+    };
+}
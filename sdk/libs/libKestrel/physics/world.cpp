@@ -20,19 +20,24 @@
 
 #include <libKestrel/kestrel.hpp>
 #include <libKestrel/physics/world.hpp>
-#include <libKestrel/physics/quad_tree.hpp>
 
 // MARK: - Construction
 
-kestrel::physics::world::world()
-    : m_collision_tree(0, math::rect(math::point(0), kestrel::session().size()))
-{}
+kestrel::physics::world::world() = default;
 
 // MARK: - Destruction
 
 kestrel::physics::world::~world()
 {
     m_destroyed =  true;
+
+    // Any bodies that outlive the world need to take their kinematic state with them.
+    for (std::size_t n = 0; n < m_bodies.allocated(); ++n) {
+        auto& body = m_bodies.get_allocated(n);
+        if (body.ref.get()) {
+            body.ref->detach_kinematics();
+        }
+    }
 }
 
 // MARK: - Physics Bodies Management
@@ -42,6 +47,8 @@ auto kestrel::physics::world::create_physics_body() -> body::lua_reference
     auto id = m_bodies.request();
     auto& body = m_bodies[id];
     body.ref = { new physics::body(shared_from_this(), id) };
+    body.proxy = broadphase::null_proxy;
+    attach_to_kinematics(body.ref, id);
     return body.ref;
 }
 
@@ -50,7 +57,9 @@ auto kestrel::physics::world::add_physics_body(const body::lua_reference& ref) -
     if (ref.get() && ref->collision_type() > 0) {
         auto id = m_bodies.request();
         m_bodies[id].ref = ref;
+        m_bodies[id].proxy = broadphase::null_proxy;
         ref->force_id_change(id);
+        attach_to_kinematics(ref, id);
     }
 }
 
@@ -63,8 +72,11 @@ auto kestrel::physics::world::destroy_physics_body(body *ref) -> void
     auto& body = m_bodies[ref->id()];
     if (body.ref.use_count() > 0 && body.ref.get() == ref) {
         // This is actually the correct reference, and not chance.
+        remove_from_broadphase(body);
+        ref->detach_kinematics();
         body.ref = { nullptr };
         m_bodies.release(ref->id());
+        detach_from_kinematics(ref->id());
     }
 }
 
@@ -82,57 +94,175 @@ auto kestrel::physics::world::get_physics_body(body *ref) -> body::lua_reference
 
 auto kestrel::physics::world::purge_all_bodies() -> void
 {
-    if (m_bodies.allocated() > 0) {
-        for (auto ref = m_bodies.begin(); ref <= m_bodies.end(); ++ref) {
-            auto body = m_bodies.get(ref);
-            if (body.ref.get()) {
-                body.ref->migrate_to_world({});
-            }
-            m_bodies.release(ref);
+    // Work backwards through the allocated bodies, as migrating a body out of the world releases it.
+    for (auto n = m_bodies.allocated(); n > 0; --n) {
+        auto body = m_bodies.get_allocated(n - 1);
+        if (body.ref.get()) {
+            body.ref->migrate_to_world({});
         }
     }
+    m_bodies.purge();
+    m_broadphase.clear();
+    m_slot_low = arena_count;
+    m_slot_high = 0;
+    m_slot_range_dirty = false;
+}
+
+auto kestrel::physics::world::attach_to_kinematics(const body::lua_reference& ref, body::identifier id) -> void
+{
+    ref->attach_kinematics(&m_kinematics, id);
+    m_slot_low = std::min<kinematics::slot>(m_slot_low, id);
+    m_slot_high = std::max<kinematics::slot>(m_slot_high, id);
+}
+
+auto kestrel::physics::world::detach_from_kinematics(body::identifier id) -> void
+{
+    // Only releasing a slot at either end of the range can shrink it. The range is recomputed once, on the next
+    // update, rather than each time a body is destroyed.
+    if (id == m_slot_low || id == m_slot_high) {
+        m_slot_range_dirty = true;
+    }
+}
+
+auto kestrel::physics::world::recompute_slot_range() -> void
+{
+    m_slot_low = arena_count;
+    m_slot_high = 0;
+    for (std::size_t n = 0; n < m_bodies.allocated(); ++n) {
+        auto id = m_bodies.allocated_reference(n);
+        m_slot_low = std::min<kinematics::slot>(m_slot_low, id);
+        m_slot_high = std::max<kinematics::slot>(m_slot_high, id);
+    }
+    m_slot_range_dirty = false;
+}
+
+auto kestrel::physics::world::remove_from_broadphase(fast_body& body) -> void
+{
+    if (body.proxy != broadphase::null_proxy) {
+        m_broadphase.remove(body.proxy);
+        body.proxy = broadphase::null_proxy;
+    }
+}
+
+// MARK: - Threading
+
+auto kestrel::physics::world::thread_count() const -> std::size_t
+{
+    return m_workers ? m_workers->thread_count() : 1;
+}
+
+auto kestrel::physics::world::set_thread_count(std::size_t count) -> void
+{
+    if (count == thread_count()) {
+        return;
+    }
+
+    m_workers.reset();
+    if (count > 1) {
+        m_workers = std::make_unique<task::worker_pool>(count);
+    }
+}
+
+auto kestrel::physics::world::chunk_count() const -> std::size_t
+{
+    return m_workers ? m_workers->thread_count() * chunks_per_thread : 1;
+}
+
+auto kestrel::physics::world::parallel_for(std::size_t count, const task::worker_pool::chunk_block& block) -> void
+{
+    if (m_workers) {
+        m_workers->parallel_for(count, chunk_count(), block);
+    }
+    else if (count > 0) {
+        block(0, 0, count);
+    }
 }
 
 // MARK: - Updates
 
 auto kestrel::physics::world::update(const rtc::clock::duration& delta) -> void
 {
-    if (m_bodies.allocated() == 0) {
+    const auto count = m_bodies.allocated();
+    if (count == 0) {
         return;
     }
 
-    // Iterate through all bodies, and add them to a quad tree in order to test collisions.
-    m_collision_tree.clear();
-    for (std::uint64_t n = 0; n < m_bodies.allocated(); ++n) {
-        auto& body = m_bodies.get_allocated(n);
-        if (body.ref.get() == nullptr || body.ref->collision_type() == 0) {
-            continue;
-        }
+    // Integrate all bodies. The kinematic state of every body in the world lives in a single store, so this
+    // is a batched pass over the range of slots that are in use. Slots belonging to inactive bodies are left
+    // untouched by the kernel.
+    if (m_slot_range_dirty) {
+        recompute_slot_range();
+    }
 
-        body.ref->update(delta);
-        if (body.ref->hitbox().is_valid()) {
-            math::rect bounds(body.ref->position(), body.ref->hitbox().size());
-            m_collision_tree.insert(bounds, body.ref->id());
-        }
+    if (m_slot_low <= m_slot_high) {
+        const auto dt = static_cast<float>(delta.count());
+        parallel_for(m_slot_high - m_slot_low + 1, [this, dt] (std::size_t, std::size_t begin, std::size_t end) {
+            m_kinematics.integrate(m_slot_low + begin, m_slot_low + end, dt);
+        });
     }
 
-    // Work through the tree and determine collisions.
-    for (std::uint64_t n = 0; n < m_bodies.allocated(); ++n) {
+    parallel_for(count, [this] (std::size_t, std::size_t begin, std::size_t end) {
+        for (auto n = begin; n < end; ++n) {
+            auto& body = m_bodies.get_allocated(n);
+            if (body.ref.get() && body.ref->collision_type() != 0) {
+                body.ref->sync_hitbox();
+            }
+        }
+    });
+
+    // Keep the broadphase in step with the bodies. Bodies are only relinked in the broadphase when they move
+    // in to a different set of cells. Hitboxes that can not be collision tested are kept out of the broadphase, so
+    // that the parallel queries below never encounter a pairing that would throw on a worker thread.
+    for (std::uint64_t n = 0; n < count; ++n) {
         auto& body = m_bodies.get_allocated(n);
-        if (body.ref.get() == nullptr || body.ref->collision_type() == 0 || !body.ref->hitbox().is_valid()) {
+        if (body.ref.get() == nullptr || body.ref->collision_type() == 0 || !body.ref->hitbox().is_collision_testable()) {
+            remove_from_broadphase(body);
             continue;
         }
 
-
+        if (body.proxy == broadphase::null_proxy) {
+            body.proxy = m_broadphase.insert(body.ref->hitbox().broadphase_bounds(), body.ref->id());
+        }
+        else {
+            m_broadphase.update(body.proxy, body.ref->hitbox().broadphase_bounds());
+        }
         body.ref->reset_collisions();
+    }
+
+    // Query the broadphase for each body, and test each candidate pair exactly once. The pair is only handled
+    // by the body with the lower id. Each chunk records its collisions separately, as Lua references must
+    // only be touched from the main thread.
+    m_chunk_collisions.resize(chunk_count());
+    for (auto& collisions : m_chunk_collisions) {
+        collisions.clear();
+    }
 
-        math::rect bounds(body.ref->position(), body.ref->hitbox().size());
-        auto objects = m_collision_tree.retrieve(bounds);
-        for (const auto& collision_candidate : objects) {
-            auto candidate_body = m_bodies[collision_candidate.second];
-            if ((body.ref.get() != candidate_body.ref.get()) && body.ref->hitbox().collision_test(candidate_body.ref->hitbox())) {
-                body.ref->add_detected_collision(candidate_body.ref);
+    parallel_for(count, [this] (std::size_t chunk, std::size_t begin, std::size_t end) {
+        auto& collisions = m_chunk_collisions[chunk];
+        for (auto n = begin; n < end; ++n) {
+            const auto& body = m_bodies.get_allocated(n);
+            if (body.ref.get() == nullptr || body.proxy == broadphase::null_proxy) {
+                continue;
             }
+
+            const auto id = body.ref->id();
+            const auto& hitbox = body.ref->hitbox();
+            m_broadphase.query(hitbox.broadphase_bounds(), [&] (std::uint64_t candidate_id) {
+                if (candidate_id > id && hitbox.collision_test(m_bodies[candidate_id].ref->hitbox())) {
+                    collisions.emplace_back(id, candidate_id);
+                }
+            });
+        }
+    });
+
+    // Chunks cover the bodies in order, so merging them in chunk order produces exactly the same sequence of
+    // collisions as a single threaded pass would.
+    for (const auto& collisions : m_chunk_collisions) {
+        for (const auto& pair : collisions) {
+            auto& a = m_bodies[pair.first];
+            auto& b = m_bodies[pair.second];
+            a.ref->add_detected_collision(b.ref);
+            b.ref->add_detected_collision(a.ref);
         }
     }
-}
\ No newline at end of file
+}
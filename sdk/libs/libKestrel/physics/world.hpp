@@ -21,9 +21,12 @@
 #pragma once
 
 #include <vector>
+#include <memory>
 #include <libKestrel/physics/body.hpp>
-#include <libKestrel/physics/quad_tree.hpp>
+#include <libKestrel/physics/kinematics.hpp>
+#include <libKestrel/physics/spatial_hash.hpp>
 #include <libKestrel/memory/slab.hpp>
+#include <libKestrel/task/worker_pool.hpp>
 
 namespace kestrel::physics
 {
@@ -42,18 +45,38 @@ namespace kestrel::physics
 
         auto update(const rtc::clock::duration& delta) -> void;
 
+        [[nodiscard]] auto thread_count() const -> std::size_t;
+        auto set_thread_count(std::size_t count) -> void;
+
     private:
         static constexpr std::size_t arena_count = 50'000;
+        static constexpr float broadphase_cell_size = 128.f;
+        static constexpr std::size_t chunks_per_thread = 4;
+
+        typedef physics::spatial_hash<std::uint64_t, arena_count> broadphase;
 
         struct fast_body {
             body::lua_reference ref;
-            std::int64_t x;
-            std::int64_t y;
-            std::int64_t radius;
+            broadphase::proxy proxy { broadphase::null_proxy };
         };
 
+        typedef std::pair<body::identifier, body::identifier> collision_pair;
+
+        auto remove_from_broadphase(fast_body& body) -> void;
+        auto attach_to_kinematics(const body::lua_reference& ref, body::identifier id) -> void;
+        auto detach_from_kinematics(body::identifier id) -> void;
+        auto recompute_slot_range() -> void;
+        [[nodiscard]] auto chunk_count() const -> std::size_t;
+        auto parallel_for(std::size_t count, const task::worker_pool::chunk_block& block) -> void;
+
         bool m_destroyed { false };
         memory::slab<fast_body, arena_count> m_bodies;
-        physics::quad_tree<std::uint64_t, 5, 20> m_collision_tree;
+        physics::kinematics m_kinematics { arena_count };
+        kinematics::slot m_slot_low { arena_count };
+        kinematics::slot m_slot_high { 0 };
+        bool m_slot_range_dirty { false };
+        broadphase m_broadphase { broadphase_cell_size };
+        std::unique_ptr<task::worker_pool> m_workers;
+        std::vector<std::vector<collision_pair>> m_chunk_collisions;
     };
 }
\ No newline at end of file
@@ -100,4 +100,15 @@ auto kestrel::resource::key::operator==(const key &rhs) const -> bool
 
     // Finally, match the ID
     return m_id == rhs.m_id;
+}
+
+// MARK: - Hashing
+
+auto kestrel::resource::key::hasher::operator()(const key &k) const -> std::size_t
+{
+    auto hash = std::hash<resource_core::identifier>()(k.m_id.value_or(0));
+    if (k.m_type.has_value()) {
+        hash ^= std::hash<std::string>()(k.m_type.value()) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
 }
\ No newline at end of file
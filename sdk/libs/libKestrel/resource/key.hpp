@@ -40,6 +40,16 @@ namespace kestrel::resource
 
         auto operator==(const key& rhs) const -> bool;
 
+        /**
+         * Hashes a key for use in hashed containers. The container is deliberately excluded, as keys in
+         * different containers can still compare equal (e.g. the universal container), and so equal keys must
+         * always produce the same hash.
+         */
+        struct hasher
+        {
+            auto operator()(const key& k) const -> std::size_t;
+        };
+
     private:
         std::optional<resource_core::identifier> m_id;
         std::optional<std::string> m_type;
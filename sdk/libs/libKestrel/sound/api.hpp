@@ -28,6 +28,8 @@ namespace kestrel::sound
     {
         none lua_case(None, Available_0_8),
         core_audio lua_case(CoreAudio, Available_0_8),
-        openal lua_case(OpenAL, Available_0_8)
+        openal lua_case(OpenAL, Available_0_8),
+        null lua_case(Null, Available_0_9),
+        software lua_case(Software, Available_0_9)
     };
 }
\ No newline at end of file
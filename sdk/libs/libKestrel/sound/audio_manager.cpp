@@ -44,6 +44,8 @@ auto kestrel::sound::manager::set_api(enum api api) -> void
     m_core_audio.reset();
 #endif
     m_openal.reset();
+    m_null.reset();
+    m_software.reset();
 
     // Assign the player...
     m_api = api;
@@ -62,6 +64,23 @@ auto kestrel::sound::manager::set_api(enum api api) -> void
             m_openal->configure();
             break;
         }
+        case api::null: {
+            m_null = std::make_shared<null::player>();
+            m_null->configure();
+            break;
+        }
+        case api::software: {
+            m_software = std::make_shared<software::player>();
+            if (!m_output_path.empty()) {
+                m_software->set_output(std::make_unique<mixer::wav_output>(m_output_path, m_software->sample_rate()));
+            }
+            m_software->set_master_gain(m_master_gain);
+            for (auto category : { category::effects, category::music, category::interface }) {
+                m_software->set_category_gain(category, category_gain(category));
+            }
+            m_software->configure();
+            break;
+        }
         case api::none: {
             break;
         }
@@ -73,20 +92,70 @@ auto kestrel::sound::manager::current_api() const -> enum api
     return m_api;
 }
 
+auto kestrel::sound::manager::set_output_path(const std::string& path) -> void
+{
+    m_output_path = path;
+}
+
+auto kestrel::sound::manager::software_player() const -> std::shared_ptr<sound::software::player>
+{
+    return m_software;
+}
+
+// MARK: - Volume
+
+auto kestrel::sound::manager::set_master_gain(float gain) -> void
+{
+    m_master_gain = std::max(0.f, gain);
+    if (m_software) {
+        m_software->set_master_gain(m_master_gain);
+    }
+}
+
+auto kestrel::sound::manager::master_gain() const -> float
+{
+    return m_master_gain;
+}
+
+auto kestrel::sound::manager::set_category_gain(enum category category, float gain) -> void
+{
+    m_category_gain[static_cast<std::size_t>(category)] = std::max(0.f, gain);
+    if (m_software) {
+        m_software->set_category_gain(category, category_gain(category));
+    }
+}
+
+auto kestrel::sound::manager::category_gain(enum category category) const -> float
+{
+    return m_category_gain[static_cast<std::size_t>(category)];
+}
+
 // MARK: - Playback
 
 auto kestrel::sound::manager::play_item(std::shared_ptr<player_item> item, std::function<auto()->void> completion) -> playback_session_ref
+{
+    auto priority = item ? item->priority() : player_item::default_priority;
+    return play_item(std::move(item), priority, std::move(completion));
+}
+
+auto kestrel::sound::manager::play_item(std::shared_ptr<player_item> item, std::int32_t priority, std::function<auto()->void> completion) -> playback_session_ref
 {
     switch (m_api) {
         case api::core_audio:
 #if TARGET_MACOS
-            return m_core_audio->play(std::move(item), std::move(completion));
+            return m_core_audio->play(std::move(item), priority, std::move(completion));
 #else
             return 0;
 #endif
 
         case api::openal:
-            return m_openal->play(std::move(item), std::move(completion));
+            return m_openal->play(std::move(item), priority, std::move(completion));
+
+        case api::null:
+            return m_null->play(std::move(item), priority, std::move(completion));
+
+        case api::software:
+            return m_software->play(std::move(item), priority, std::move(completion));
 
         default:
             return 0;
@@ -106,6 +175,12 @@ auto kestrel::sound::manager::stop_item(const playback_session_ref& ref) -> void
         case api::openal:
             return m_openal->stop(ref);
 
+        case api::null:
+            return m_null->stop(ref);
+
+        case api::software:
+            return m_software->stop(ref);
+
         default:
             return;
     }
@@ -126,6 +201,14 @@ auto kestrel::sound::manager::finish_item(const playback_session_ref &ref) -> vo
             m_openal->stop(ref);
             break;
 
+        case api::null:
+            m_null->stop(ref);
+            break;
+
+        case api::software:
+            m_software->stop(ref);
+            break;
+
         default:
             return;
     }
@@ -149,6 +232,14 @@ auto kestrel::sound::manager::tick() -> void
             m_openal->check_completion();
             break;
 
+        case api::null:
+            m_null->check_completion();
+            break;
+
+        case api::software:
+            m_software->check_completion();
+            break;
+
         default:
             break;
     }
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <vector>
 #include <complex>
@@ -32,6 +33,8 @@
 #   include <libKestrel/sound/player/core_audio_player.hpp>
 #endif
 #include <libKestrel/sound/player/openal_player.hpp>
+#include <libKestrel/sound/player/null_player.hpp>
+#include <libKestrel/sound/player/software_player.hpp>
 #include <libKestrel/sound/player/player_item.hpp>
 
 namespace kestrel::sound
@@ -49,7 +52,28 @@ namespace kestrel::sound
         auto set_api(enum api api) -> void;
         [[nodiscard]] auto current_api() const -> enum api;
 
+        /**
+         * When set, the software mixer writes its output to a WAV file at the specified path rather than discarding it.
+         */
+        auto set_output_path(const std::string& path) -> void;
+        [[nodiscard]] auto software_player() const -> std::shared_ptr<sound::software::player>;
+
+        /**
+         * Volume controls for the mixer. These are retained by the manager and applied by the software mixer whenever
+         * it is the active API, including when it is selected after the volume has been set.
+         */
+        auto set_master_gain(float gain) -> void;
+        [[nodiscard]] auto master_gain() const -> float;
+        auto set_category_gain(enum category category, float gain) -> void;
+        [[nodiscard]] auto category_gain(enum category category) const -> float;
+
         auto play_item(std::shared_ptr<player_item> item, std::function<auto()->void> completion) -> playback_session_ref;
+
+        /**
+         * Play the item with a priority that overrides the priority of the item itself, for items that are shared by
+         * several owners.
+         */
+        auto play_item(std::shared_ptr<player_item> item, std::int32_t priority, std::function<auto()->void> completion) -> playback_session_ref;
         auto stop_item(const playback_session_ref& ref) -> void;
 
         auto finish_item(const playback_session_ref& ref) -> void;
@@ -61,6 +85,11 @@ namespace kestrel::sound
         std::shared_ptr<sound::core_audio::player> m_core_audio;
 #endif
         std::shared_ptr<sound::openal::player> m_openal;
+        std::shared_ptr<sound::null::player> m_null;
+        std::shared_ptr<sound::software::player> m_software;
+        std::string m_output_path;
+        float m_master_gain { 1.f };
+        std::array<float, 3> m_category_gain { 1.f, 1.f, 1.f };
         api m_api { api::none };
 
         manager() = default;
@@ -18,6 +18,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
 #include <libKestrel/sound/codec/ima4.hpp>
 
 // MARK: - IMA4 LUTs
@@ -39,66 +40,55 @@ static constexpr std::int32_t ima4_step_table[89] = {
     15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
 };
 
+// MARK: - Packet Decoding
+
+static inline auto decode_nibble(std::uint8_t nibble, std::int32_t& predictor, std::int32_t& step_index) -> std::int16_t
+{
+    auto step = ima4_step_table[step_index];
+    step_index = std::min(88, std::max(0, step_index + ima4_index_table[nibble]));
+
+    auto diff = step >> 3;
+    if (nibble & 4) diff += step;
+    if (nibble & 2) diff += (step >> 1);
+    if (nibble & 1) diff += (step >> 2);
+    predictor += (nibble & 8) ? -diff : diff;
+    predictor = std::min<std::int32_t>(INT16_MAX, std::max<std::int32_t>(INT16_MIN, predictor));
+    return static_cast<std::int16_t>(predictor);
+}
+
+auto kestrel::sound::codec::ima4::decode_packet(const std::uint8_t *packet, std::int16_t *out) -> void
+{
+    // The preamble is big endian, holding the initial predictor in the upper 9 bits and the step index in the lower 7.
+    auto preamble = static_cast<std::uint16_t>((packet[0] << 8) | packet[1]);
+    auto predictor = static_cast<std::int32_t>(static_cast<std::int16_t>(preamble & 0xFF80));
+    auto step_index = std::min<std::int32_t>(88, preamble & 0x007F);
+
+    for (std::size_t i = 2; i < bytes_per_packet; ++i) {
+        auto data = packet[i];
+        *out++ = decode_nibble(data & 0xF, predictor, step_index);
+        *out++ = decode_nibble(data >> 4, predictor, step_index);
+    }
+}
+
 // MARK: - Decoder
 
-auto kestrel::sound::codec::ima4::decode(const descriptor& descriptor, data::reader& r) -> std::shared_ptr<player_item>
+auto kestrel::sound::codec::ima4::decode(const descriptor& descriptor, const std::uint8_t *data, std::size_t size) -> std::shared_ptr<player_item>
 {
     // TODO: This is reallying on hard-coded constants and really shouldn't.
     // Determine the best way to calculate this values in the future.
     auto adjusted_descriptor = descriptor;
-    adjusted_descriptor.bytes_per_packet = 34;
-    adjusted_descriptor.frames_per_packet = 64;
+    adjusted_descriptor.bytes_per_packet = bytes_per_packet;
+    adjusted_descriptor.frames_per_packet = frames_per_packet;
     adjusted_descriptor.bytes_per_frame = 0;
+    adjusted_descriptor.packet_count = std::min<std::uint32_t>(descriptor.packet_count, size / bytes_per_packet);
 
     auto item = std::make_shared<player_item>(adjusted_descriptor);
-    item->allocate_buffer((adjusted_descriptor.packet_count * (adjusted_descriptor.bytes_per_packet - 2)) << 2);
+    item->allocate_buffer(adjusted_descriptor.packet_count * frames_per_packet * sizeof(std::int16_t));
 
-    // Prepare to read and parse the IMA4 data and decode it to LPCM 16
+    // Decode each of the packets straight from the resource data into the LPCM 16 buffer of the item.
     auto out = reinterpret_cast<std::int16_t *>(item->internal_buffer_pointer());
-
-    // Iterate through all the expected packets and decode them.
     for (std::uint32_t n = 0; n < adjusted_descriptor.packet_count; ++n) {
-        auto preamble = r.read_short();
-        auto packet = r.read_data(adjusted_descriptor.bytes_per_packet - 2);
-
-        auto predictor = (std::int32_t)((std::int16_t)(preamble & 0xFF80));
-        auto step_index = (std::int8_t)(preamble & 0x007F);
-        auto step = ima4_step_table[step_index];
-        std::uint8_t nibble = 0;
-        std::int32_t diff = 0;
-
-        for (std::uint32_t i = 0; i < packet.size(); ++i) {
-            std::uint8_t data = packet.get<std::uint8_t>(i);
-
-            nibble = data & 0xF;
-            step_index = (std::int8_t)std::min(88, std::max(0, step_index + ima4_index_table[(unsigned)nibble]));
-            std::uint8_t sign = nibble & 8;
-            std::uint8_t delta = nibble & 7;
-            diff = (std::int32_t)(step >> 3);
-            if (delta & 4) diff += step;
-            if (delta & 2) diff += (step >> 1);
-            if (delta & 1) diff += (step >> 2);
-            if (sign) predictor -= diff;
-            else predictor += diff;
-            predictor = std::min(INT16_MAX, std::max(INT16_MIN, predictor));
-            *out++ = (std::int16_t)predictor;
-            step = ima4_step_table[step_index];
-
-            nibble = (data >> 4) & 0xF;
-            step_index = (std::int8_t)std::min(88, std::max(0, step_index + ima4_index_table[(unsigned)nibble]));
-            sign = nibble & 8;
-            delta = nibble & 7;
-            diff = (std::int32_t)(step >> 3);
-            if (delta & 4) diff += step;
-            if (delta & 2) diff += (step >> 1);
-            if (delta & 1) diff += (step >> 2);
-            if (sign) predictor -= diff;
-            else predictor += diff;
-            predictor = std::min(INT16_MAX, std::max(INT16_MIN, predictor));
-            *out++ = (std::int16_t)predictor;
-            step = ima4_step_table[step_index];
-
-        }
+        decode_packet(data + n * bytes_per_packet, out + n * frames_per_packet);
     }
 
     item->set_bytes_per_packet(128);
@@ -109,4 +99,13 @@ auto kestrel::sound::codec::ima4::decode(const descriptor& descriptor, data::rea
     item->set_format_flags(0x4);
 
     return item;
-}
\ No newline at end of file
+}
+
+auto kestrel::sound::codec::ima4::decode(const descriptor& descriptor, data::reader& r) -> std::shared_ptr<player_item>
+{
+    auto data = static_cast<const std::uint8_t *>(r.data()->get<void *>()) + r.position();
+    auto size = static_cast<std::size_t>(r.size() - r.position());
+    auto item = decode(descriptor, data, size);
+    r.move(static_cast<std::int64_t>(std::min<std::size_t>(size, descriptor.packet_count * bytes_per_packet)));
+    return item;
+}
@@ -21,11 +21,24 @@
 #pragma once
 
 #include <memory>
+#include <cstdint>
 #include <libData/reader.hpp>
 #include <libKestrel/sound/codec/audio_codec_descriptor.hpp>
 #include <libKestrel/sound/player/player_item.hpp>
 
 namespace kestrel::sound::codec::ima4
 {
+    constexpr std::size_t bytes_per_packet = 34;
+    constexpr std::size_t frames_per_packet = 64;
+
+    /**
+     * Decode a single 34 byte packet into 64 signed 16-bit samples.
+     */
+    auto decode_packet(const std::uint8_t *packet, std::int16_t *out) -> void;
+
+    /**
+     * Decode the packets directly from memory. Packets beyond the end of the data are ignored.
+     */
+    auto decode(const sound::codec::descriptor& descriptor, const std::uint8_t *data, std::size_t size) -> std::shared_ptr<sound::player_item>;
     auto decode(const sound::codec::descriptor& descriptor, data::reader& r) -> std::shared_ptr<sound::player_item>;
 }
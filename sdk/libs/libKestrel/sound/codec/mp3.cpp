@@ -27,29 +27,89 @@
 #include <minimp3/minimp3.h>
 #include <minimp3/minimp3_ex.h>
 
+// MARK: - Decoder
+
+namespace
+{
+    /**
+     * Decodes MP3 frames on demand, rather than decoding the entire file up front.
+     */
+    class mp3_decoder : public kestrel::sound::decoder
+    {
+    public:
+        explicit mp3_decoder(const std::string& path)
+            : m_decoder(std::make_unique<mp3dec_ex_t>())
+        {
+            m_open = (mp3dec_ex_open(m_decoder.get(), path.c_str(), MP3D_SEEK_TO_SAMPLE) == 0);
+            if (m_open) {
+                m_descriptor.channels = m_decoder->info.channels;
+                m_descriptor.bit_width = 16;
+                m_descriptor.sample_rate = m_decoder->info.hz;
+            }
+        }
+
+        ~mp3_decoder() override
+        {
+            if (m_open) {
+                mp3dec_ex_close(m_decoder.get());
+            }
+        }
+
+        [[nodiscard]] auto is_open() const -> bool
+        {
+            return m_open;
+        }
+
+        [[nodiscard]] auto descriptor() const -> kestrel::sound::codec::descriptor override
+        {
+            return m_descriptor;
+        }
+
+        auto read(std::int16_t *samples, std::size_t count) -> std::size_t override
+        {
+            return m_open ? mp3dec_ex_read(m_decoder.get(), samples, count) : 0;
+        }
+
+        auto rewind() -> void override
+        {
+            if (m_open) {
+                mp3dec_ex_seek(m_decoder.get(), 0);
+            }
+        }
+
+    private:
+        std::unique_ptr<mp3dec_ex_t> m_decoder;
+        kestrel::sound::codec::descriptor m_descriptor;
+        bool m_open { false };
+    };
+}
+
 // MARK: - Construction
 
 kestrel::sound::codec::mp3::mp3(const std::string& file_path)
     : m_path(file_path)
 {
-    mp3dec_t mp3d;
-    mp3dec_file_info_t info;
-    if (mp3dec_load(&mp3d, file_path.c_str(), &info, nullptr, nullptr)) {
-        // TODO: Handle error case...
-        return;
-    }
-
-    descriptor descriptor;
-    descriptor.channels = info.channels;
-    descriptor.bit_width = 16;
-    descriptor.sample_rate = info.hz;
-
     if (sound::manager::shared_manager().current_api() == sound::api::core_audio) {
         m_item = std::make_shared<sound::player_item>(m_path);
+        return;
     }
-    else {
-        m_item = std::make_shared<sound::player_item>(descriptor, info.buffer, (info.samples << 1));
+
+    // The file is decoded in the background, a chunk at a time, as it plays. Each playback opens its own decoder so
+    // that overlapping playbacks of the file do not disturb one another.
+    mp3_decoder decoder(file_path);
+    if (!decoder.is_open()) {
+        // TODO: Handle error case...
+        return;
     }
+    m_item = std::make_shared<sound::player_item>(decoder.descriptor(), [path = m_path] () -> std::unique_ptr<sound::decoder> {
+        auto decoder = std::make_unique<mp3_decoder>(path);
+        if (!decoder->is_open()) {
+            return nullptr;
+        }
+        return decoder;
+    });
+    m_item->set_priority(sound::player_item::music_priority);
+    m_item->set_category(sound::category::music);
 }
 
 // MARK: - Playback
@@ -18,13 +18,19 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <cstring>
+#include <algorithm>
+#include <thread>
 #include <stdexcept>
+#include <unordered_set>
 #include <libData/reader.hpp>
 #include <libKestrel/sound/legacy/macintosh/sound.hpp>
 #include <libKestrel/cache/cache.hpp>
+#include <libKestrel/resource/key.hpp>
 #include <libKestrel/sound/audio_manager.hpp>
 #include <libKestrel/sound/codec/audio_codec_descriptor.hpp>
 #include <libKestrel/sound/codec/ima4.hpp>
+#include <libKestrel/task/worker_pool.hpp>
 #include <libKestrel/kestrel.hpp>
 
 // MARK: - Constants
@@ -159,17 +165,53 @@ struct extended_sound_header
     std::uint16_t sample_size;
 };
 
+// MARK: - Helpers
+
+static auto copy_remaining_data(data::reader& r, const std::shared_ptr<kestrel::sound::player_item>& item) -> void
+{
+    auto size = static_cast<std::uint32_t>(r.size() - r.position());
+    item->allocate_buffer(size);
+    std::memcpy(item->internal_buffer_pointer(), static_cast<const std::uint8_t *>(r.data()->get<void *>()) + r.position(), size);
+    r.move(size);
+}
+
+static auto memory_cost(const std::shared_ptr<kestrel::sound::player_item>& item) -> std::size_t
+{
+    return item ? std::max<std::size_t>(item->buffer_size(), kestrel::cache::default_asset_cost) : kestrel::cache::default_asset_cost;
+}
+
+static auto decode_workers() -> kestrel::task::worker_pool&
+{
+    static kestrel::task::worker_pool s_workers(std::max(1U, std::thread::hardware_concurrency()));
+    return s_workers;
+}
+
 // MARK: - Construction
 
 kestrel::sound::legacy::macintosh::quicktime::sound::sound(const resource::descriptor::lua_reference& ref)
 {
-    if (auto res = ref->with_type(resource_type::code)->load()) {
-        parse(res->data());
+    // Share the samples of the resource if they have already been decoded.
+    auto descriptor = ref->with_type(resource_type::code);
+    if (auto asset = cache::fetch(descriptor)) {
+        m_item = std::any_cast<lua_reference>(asset.value())->m_item;
+        m_priority = m_item ? m_item->priority() : player_item::default_priority;
+        return;
+    }
+
+    if (auto res = descriptor->load()) {
+        m_item = decode(res->data(), manager::shared_manager().current_api());
+        m_priority = m_item ? m_item->priority() : player_item::default_priority;
         return;
     }
     throw std::logic_error("Bad resource reference encountered: Unable to load resource.");
 }
 
+kestrel::sound::legacy::macintosh::quicktime::sound::sound(std::shared_ptr<player_item> item)
+    : m_item(std::move(item))
+{
+    m_priority = m_item ? m_item->priority() : player_item::default_priority;
+}
+
 auto kestrel::sound::legacy::macintosh::quicktime::sound::load(const resource::descriptor::lua_reference& ref) -> lua_reference
 {
     // Attempt to de-cache asset
@@ -179,17 +221,48 @@ auto kestrel::sound::legacy::macintosh::quicktime::sound::load(const resource::d
     }
 
     auto snd = lua_reference(new sound(ref));
-    cache::add(ref->with_type(resource_type::code), snd);
+    cache::add(ref->with_type(resource_type::code), snd, memory_cost(snd->m_item));
     return snd;
 }
 
+auto kestrel::sound::legacy::macintosh::quicktime::sound::preload(const lua::vector<resource::descriptor::lua_reference>& refs) -> void
+{
+    // Resources are loaded on the calling thread, as only the decoding of the samples is safe to perform in parallel.
+    std::vector<resource::descriptor::lua_reference> descriptors;
+    std::vector<data::block> blocks;
+    std::unordered_set<resource::key, resource::key::hasher> seen;
+    for (auto i = 0; i < refs.size(); ++i) {
+        auto descriptor = refs.at(i)->with_type(resource_type::code);
+        if (!seen.emplace(resource::key(*descriptor.get())).second || cache::fetch(descriptor).has_value()) {
+            continue;
+        }
+
+        if (auto res = descriptor->load()) {
+            descriptors.emplace_back(descriptor);
+            blocks.emplace_back(res->data());
+        }
+    }
+
+    // The API determines the sample format, so it is read here rather than by each of the workers.
+    auto target_api = manager::shared_manager().current_api();
+    std::vector<std::shared_ptr<player_item>> items(blocks.size());
+    decode_workers().parallel_for(blocks.size(), blocks.size(), [&] (std::size_t, std::size_t begin, std::size_t end) {
+        for (auto n = begin; n < end; ++n) {
+            items[n] = decode(blocks[n], target_api);
+        }
+    });
+
+    for (std::size_t n = 0; n < items.size(); ++n) {
+        cache::add(descriptors[n], lua_reference(new sound(items[n])), memory_cost(items[n]));
+    }
+}
 
 // MARK: - Playback
 
 auto kestrel::sound::legacy::macintosh::quicktime::sound::play() -> void
 {
     if (m_item != nullptr) {
-        m_item_reference = manager::shared_manager().play_item(m_item, [&] {
+        m_item_reference = manager::shared_manager().play_item(m_item, m_priority, [&] {
             this->m_item_reference = 0;
         });
     }
@@ -198,7 +271,7 @@ auto kestrel::sound::legacy::macintosh::quicktime::sound::play() -> void
 auto kestrel::sound::legacy::macintosh::quicktime::sound::playWithCallback(const luabridge::LuaRef& ref) -> void
 {
     if (m_item != nullptr) {
-        m_item_reference = manager::shared_manager().play_item(m_item, [&, ref] {
+        m_item_reference = manager::shared_manager().play_item(m_item, m_priority, [&, ref] {
             this->m_item_reference = 0;
             ref();
         });
@@ -212,11 +285,23 @@ auto kestrel::sound::legacy::macintosh::quicktime::sound::stop() -> void
     }
 }
 
+auto kestrel::sound::legacy::macintosh::quicktime::sound::priority() const -> std::int32_t
+{
+    return m_priority;
+}
+
+auto kestrel::sound::legacy::macintosh::quicktime::sound::set_priority(std::int32_t priority) -> void
+{
+    // The item may be shared with other sounds of the same resource, so the priority is only held by this sound.
+    m_priority = priority;
+}
+
 // MARK: - Sound Resource Parsing
 
-auto kestrel::sound::legacy::macintosh::quicktime::sound::parse(const data::block &data) -> bool
+auto kestrel::sound::legacy::macintosh::quicktime::sound::decode(const data::block &data, enum api target_api) -> std::shared_ptr<player_item>
 {
     codec::descriptor descriptor;
+    std::shared_ptr<player_item> item;
     data::reader r(&data);
     auto sound_format = r.read_signed_short();
 
@@ -237,7 +322,7 @@ auto kestrel::sound::legacy::macintosh::quicktime::sound::parse(const data::bloc
          || list.command_part.cmd != (data_offset_flag + buffer_cmd)
         ) {
             // TODO: Throw an error here.
-            return false;
+            return nullptr;
         }
     }
     else if (sound_format == second_sound_format) {
@@ -251,12 +336,12 @@ auto kestrel::sound::legacy::macintosh::quicktime::sound::parse(const data::bloc
 
         if (list.command_count != 1 || list.command_part.cmd != (data_offset_flag + buffer_cmd)) {
             // TODO: Throw an error here.
-            return false;
+            return nullptr;
         }
     }
     else {
         // TODO: Throw an error here.
-        return false;
+        return nullptr;
     }
 
     sound_header header;
@@ -317,7 +402,7 @@ auto kestrel::sound::legacy::macintosh::quicktime::sound::parse(const data::bloc
         descriptor.packet_count = cmp.frame_count;
     }
     else {
-        return false;
+        return nullptr;
     }
 
     descriptor.sample_rate = static_cast<std::uint32_t>(static_cast<double>(header.sample_rate_fixed) * 1.0 / static_cast<double>(1 << 16));
@@ -335,12 +420,8 @@ auto kestrel::sound::legacy::macintosh::quicktime::sound::parse(const data::bloc
        descriptor.frames_per_packet = 1;
        descriptor.bytes_per_packet = descriptor.bytes_per_frame * descriptor.frames_per_packet;
 
-        m_item = std::make_shared<player_item>(descriptor);
-        m_item->allocate_buffer(r.size() - r.position());
-        auto ptr = reinterpret_cast<std::uint8_t *>(m_item->internal_buffer_pointer());
-        for (int i = 0; i < m_item->buffer_size(); ++i) {
-            *ptr++ = r.read_byte();
-        }
+        item = std::make_shared<player_item>(descriptor);
+        copy_remaining_data(r, item);
     }
     else if (descriptor.format_id == sound_format_ima4) {
         // TODO: Do not hard code this, but work out the conversions...
@@ -351,18 +432,14 @@ auto kestrel::sound::legacy::macintosh::quicktime::sound::parse(const data::bloc
         descriptor.channels = 1;
         descriptor.bit_width = 0;
 
-        switch (manager::shared_manager().current_api()) {
+        switch (target_api) {
             case api::core_audio: {
-                m_item = std::make_shared<player_item>(descriptor);
-                m_item->allocate_buffer(r.size() - r.position());
-                auto ptr = reinterpret_cast<std::uint8_t *>(m_item->internal_buffer_pointer());
-                for (int i = 0; i < m_item->buffer_size(); ++i) {
-                    *ptr++ = r.read_byte();
-                }
+                item = std::make_shared<player_item>(descriptor);
+                copy_remaining_data(r, item);
                 break;
             }
             default: {
-                m_item = codec::ima4::decode(descriptor, r);
+                item = codec::ima4::decode(descriptor, r);
                 break;
             }
         }
@@ -371,10 +448,12 @@ auto kestrel::sound::legacy::macintosh::quicktime::sound::parse(const data::bloc
         // TODO: Handle this correctly...
     }
 
-    m_item->set_format(descriptor.format_id);
-    m_item->set_format_flags(descriptor.format_flags);
+    if (item) {
+        item->set_format(descriptor.format_id);
+        item->set_format_flags(descriptor.format_flags);
+    }
 
-    return true;
+    return item;
 }
 
 // MARK: - Accessors
@@ -20,11 +20,13 @@
 
 #pragma once
 
+#include <libKestrel/sound/api.hpp>
 #include <libKestrel/sound/player/player_item.hpp>
 #include <libKestrel/resource/descriptor.hpp>
 #include <libKestrel/resource/macro.hpp>
 #include <libKestrel/lua/runtime/runtime.hpp>
 #include <libKestrel/lua/scripting.hpp>
+#include <libKestrel/lua/support/vector.hpp>
 
 namespace kestrel::sound::legacy::macintosh::quicktime
 {
@@ -37,14 +39,31 @@ namespace kestrel::sound::legacy::macintosh::quicktime
         lua_constructor(Available_0_8) explicit sound(const resource::descriptor::lua_reference& ref);
 
         lua_function(load, Available_0_8) static auto load(const resource::descriptor::lua_reference& ref) -> lua_reference;
+
+        /**
+         * Decode each of the referenced sounds in parallel, and add them to the asset cache, so that they are ready to
+         * play without delay. This is intended to be called while a scene is loading.
+         */
+        lua_function(preload, Available_0_9) static auto preload(const lua::vector<resource::descriptor::lua_reference>& refs) -> void;
         lua_function(play, Available_0_8) auto play() -> void;
         lua_function(playWithCompletion, Available_0_8) auto playWithCallback(const luabridge::LuaRef& ref) -> void;
         lua_function(stop, Available_0_8) auto stop() -> void;
 
+        lua_getter(priority, Available_0_9) [[nodiscard]] auto priority() const -> std::int32_t;
+        lua_setter(priority, Available_0_9) auto set_priority(std::int32_t priority) -> void;
+
     private:
         std::shared_ptr<player_item> m_item {};
         std::uint64_t m_item_reference { 0 };
-        auto parse(const data::block& data) -> bool;
+        std::int32_t m_priority { player_item::default_priority };
+
+        explicit sound(std::shared_ptr<player_item> item);
+
+        /**
+         * Decode the 'snd ' resource data into samples suitable for the specified audio API. This does not touch any
+         * shared state, and so may be called from any thread.
+         */
+        static auto decode(const data::block& data, enum api target_api) -> std::shared_ptr<player_item>;
     };
 
 };
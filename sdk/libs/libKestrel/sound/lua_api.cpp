@@ -0,0 +1,64 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <libKestrel/sound/lua_api.hpp>
+#include <libKestrel/sound/audio_manager.hpp>
+
+// MARK: - Mixer API
+
+auto kestrel::sound::mixer_api::api::master_volume() -> float
+{
+    return manager::shared_manager().master_gain();
+}
+
+auto kestrel::sound::mixer_api::api::set_master_volume(float volume) -> void
+{
+    manager::shared_manager().set_master_gain(volume);
+}
+
+auto kestrel::sound::mixer_api::api::effects_volume() -> float
+{
+    return manager::shared_manager().category_gain(category::effects);
+}
+
+auto kestrel::sound::mixer_api::api::set_effects_volume(float volume) -> void
+{
+    manager::shared_manager().set_category_gain(category::effects, volume);
+}
+
+auto kestrel::sound::mixer_api::api::music_volume() -> float
+{
+    return manager::shared_manager().category_gain(category::music);
+}
+
+auto kestrel::sound::mixer_api::api::set_music_volume(float volume) -> void
+{
+    manager::shared_manager().set_category_gain(category::music, volume);
+}
+
+auto kestrel::sound::mixer_api::api::interface_volume() -> float
+{
+    return manager::shared_manager().category_gain(category::interface);
+}
+
+auto kestrel::sound::mixer_api::api::set_interface_volume(float volume) -> void
+{
+    manager::shared_manager().set_category_gain(category::interface, volume);
+}
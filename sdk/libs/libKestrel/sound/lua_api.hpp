@@ -0,0 +1,41 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <libKestrel/lua/runtime/runtime.hpp>
+#include <libKestrel/lua/scripting.hpp>
+
+namespace kestrel::sound::mixer_api
+{
+    namespace lua_api(Audio.Mixer, Available_0_9) api
+    {
+        has_lua_api;
+
+        lua_getter(masterVolume, Available_0_9) auto master_volume() -> float;
+        lua_function(setMasterVolume, Available_0_9) auto set_master_volume(float volume) -> void;
+        lua_getter(effectsVolume, Available_0_9) auto effects_volume() -> float;
+        lua_function(setEffectsVolume, Available_0_9) auto set_effects_volume(float volume) -> void;
+        lua_getter(musicVolume, Available_0_9) auto music_volume() -> float;
+        lua_function(setMusicVolume, Available_0_9) auto set_music_volume(float volume) -> void;
+        lua_getter(interfaceVolume, Available_0_9) auto interface_volume() -> float;
+        lua_function(setInterfaceVolume, Available_0_9) auto set_interface_volume(float volume) -> void;
+    }
+}
@@ -0,0 +1,175 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <cmath>
+#include <algorithm>
+#include <libKestrel/sound/mixer/kernels.hpp>
+#include <libKestrel/util/availability.hpp>
+
+#if TARGET_INTEL && (defined(__GNUC__) || defined(__clang__))
+#   define MIXER_SSE2       true
+#   include <emmintrin.h>
+#else
+#   define MIXER_SSE2       false
+#endif
+
+#if TARGET_ARM && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#   define MIXER_NEON       true
+#   include <arm_neon.h>
+#else
+#   define MIXER_NEON       false
+#endif
+
+// MARK: - Scalar Reference
+
+static auto scalar_mix_mono(float *bus, const float *src, std::size_t frames, float left, float right) -> void
+{
+    for (std::size_t n = 0; n < frames; ++n) {
+        bus[(n << 1) + 0] += src[n] * left;
+        bus[(n << 1) + 1] += src[n] * right;
+    }
+}
+
+static auto scalar_mix_stereo(float *bus, const float *src, std::size_t frames, float left, float right) -> void
+{
+    for (std::size_t n = 0; n < frames; ++n) {
+        bus[(n << 1) + 0] += src[(n << 1) + 0] * left;
+        bus[(n << 1) + 1] += src[(n << 1) + 1] * right;
+    }
+}
+
+static auto scalar_to_int16(std::int16_t *dst, const float *src, std::size_t count) -> void
+{
+    for (std::size_t n = 0; n < count; ++n) {
+        auto sample = std::clamp(src[n], -1.f, 1.f) * 32767.f;
+        dst[n] = static_cast<std::int16_t>(std::lrintf(sample));
+    }
+}
+
+// MARK: - SSE2
+
+#if MIXER_SSE2
+static auto sse2_mix_mono(float *bus, const float *src, std::size_t frames, float left, float right) -> void
+{
+    const auto gain = _mm_setr_ps(left, right, left, right);
+    std::size_t n = 0;
+    for (; n + 4 <= frames; n += 4) {
+        auto s = _mm_loadu_ps(src + n);
+        auto lo = _mm_mul_ps(_mm_unpacklo_ps(s, s), gain);
+        auto hi = _mm_mul_ps(_mm_unpackhi_ps(s, s), gain);
+        _mm_storeu_ps(bus + (n << 1) + 0, _mm_add_ps(_mm_loadu_ps(bus + (n << 1) + 0), lo));
+        _mm_storeu_ps(bus + (n << 1) + 4, _mm_add_ps(_mm_loadu_ps(bus + (n << 1) + 4), hi));
+    }
+    scalar_mix_mono(bus + (n << 1), src + n, frames - n, left, right);
+}
+
+static auto sse2_mix_stereo(float *bus, const float *src, std::size_t frames, float left, float right) -> void
+{
+    const auto gain = _mm_setr_ps(left, right, left, right);
+    std::size_t n = 0;
+    for (; n + 2 <= frames; n += 2) {
+        auto s = _mm_mul_ps(_mm_loadu_ps(src + (n << 1)), gain);
+        _mm_storeu_ps(bus + (n << 1), _mm_add_ps(_mm_loadu_ps(bus + (n << 1)), s));
+    }
+    scalar_mix_stereo(bus + (n << 1), src + (n << 1), frames - n, left, right);
+}
+
+static auto sse2_to_int16(std::int16_t *dst, const float *src, std::size_t count) -> void
+{
+    // The default rounding mode is round to nearest even, which matches lrintf in the reference.
+    const auto lower = _mm_set1_ps(-1.f);
+    const auto upper = _mm_set1_ps(1.f);
+    const auto scale = _mm_set1_ps(32767.f);
+    std::size_t n = 0;
+    for (; n + 8 <= count; n += 8) {
+        auto a = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + n + 0), lower), upper), scale);
+        auto b = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + n + 4), lower), upper), scale);
+        auto packed = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + n), packed);
+    }
+    scalar_to_int16(dst + n, src + n, count - n);
+}
+#endif
+
+// MARK: - NEON
+
+#if MIXER_NEON
+static auto neon_mix_mono(float *bus, const float *src, std::size_t frames, float left, float right) -> void
+{
+    const float gains[4] = { left, right, left, right };
+    const auto gain = vld1q_f32(gains);
+    std::size_t n = 0;
+    for (; n + 4 <= frames; n += 4) {
+        auto s = vld1q_f32(src + n);
+        auto lo = vmulq_f32(vzip1q_f32(s, s), gain);
+        auto hi = vmulq_f32(vzip2q_f32(s, s), gain);
+        vst1q_f32(bus + (n << 1) + 0, vaddq_f32(vld1q_f32(bus + (n << 1) + 0), lo));
+        vst1q_f32(bus + (n << 1) + 4, vaddq_f32(vld1q_f32(bus + (n << 1) + 4), hi));
+    }
+    scalar_mix_mono(bus + (n << 1), src + n, frames - n, left, right);
+}
+
+static auto neon_mix_stereo(float *bus, const float *src, std::size_t frames, float left, float right) -> void
+{
+    const float gains[4] = { left, right, left, right };
+    const auto gain = vld1q_f32(gains);
+    std::size_t n = 0;
+    for (; n + 2 <= frames; n += 2) {
+        auto s = vmulq_f32(vld1q_f32(src + (n << 1)), gain);
+        vst1q_f32(bus + (n << 1), vaddq_f32(vld1q_f32(bus + (n << 1)), s));
+    }
+    scalar_mix_stereo(bus + (n << 1), src + (n << 1), frames - n, left, right);
+}
+
+static auto neon_to_int16(std::int16_t *dst, const float *src, std::size_t count) -> void
+{
+    const auto lower = vdupq_n_f32(-1.f);
+    const auto upper = vdupq_n_f32(1.f);
+    const auto scale = vdupq_n_f32(32767.f);
+    std::size_t n = 0;
+    for (; n + 8 <= count; n += 8) {
+        auto a = vmulq_f32(vminq_f32(vmaxq_f32(vld1q_f32(src + n + 0), lower), upper), scale);
+        auto b = vmulq_f32(vminq_f32(vmaxq_f32(vld1q_f32(src + n + 4), lower), upper), scale);
+        auto packed = vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(a)), vqmovn_s32(vcvtnq_s32_f32(b)));
+        vst1q_s16(dst + n, packed);
+    }
+    scalar_to_int16(dst + n, src + n, count - n);
+}
+#endif
+
+// MARK: - Kernel Tables
+
+auto kestrel::sound::mixer::reference_kernels() -> const struct kernels&
+{
+    static const struct kernels s_kernels { "scalar", scalar_mix_mono, scalar_mix_stereo, scalar_to_int16 };
+    return s_kernels;
+}
+
+auto kestrel::sound::mixer::native_kernels() -> const struct kernels&
+{
+#if MIXER_SSE2
+    static const struct kernels s_kernels { "sse2", sse2_mix_mono, sse2_mix_stereo, sse2_to_int16 };
+    return s_kernels;
+#elif MIXER_NEON
+    static const struct kernels s_kernels { "neon", neon_mix_mono, neon_mix_stereo, neon_to_int16 };
+    return s_kernels;
+#else
+    return reference_kernels();
+#endif
+}
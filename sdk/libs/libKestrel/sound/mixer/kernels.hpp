@@ -0,0 +1,63 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace kestrel::sound::mixer
+{
+    /**
+     * The inner loops of the software mixer. The mix bus is always interleaved stereo floating point.
+     */
+    struct kernels
+    {
+        typedef void(*mix_function)(float *bus, const float *src, std::size_t frames, float left, float right);
+        typedef void(*convert_function)(std::int16_t *dst, const float *src, std::size_t count);
+
+        const char *name { "scalar" };
+
+        /**
+         * Add each frame of a mono source to both channels of the bus, scaled by the gain of each channel.
+         */
+        mix_function mix_mono { nullptr };
+
+        /**
+         * Add each frame of a stereo source to the bus, scaled by the gain of each channel.
+         */
+        mix_function mix_stereo { nullptr };
+
+        /**
+         * Clamp each sample to [-1, 1] and convert it to signed 16-bit, rounding to the nearest value.
+         */
+        convert_function to_int16 { nullptr };
+    };
+
+    /**
+     * The portable kernels that all other kernels conform to.
+     */
+    [[nodiscard]] auto reference_kernels() -> const struct kernels&;
+
+    /**
+     * The SSE2 or NEON kernels when the build targets an architecture that guarantees them, or the reference kernels
+     * otherwise.
+     */
+    [[nodiscard]] auto native_kernels() -> const struct kernels&;
+}
@@ -0,0 +1,112 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <libKestrel/sound/mixer/output.hpp>
+
+// MARK: - Helpers
+
+namespace
+{
+    constexpr std::uint16_t channels = 2;
+    constexpr std::uint16_t bits_per_sample = 16;
+    constexpr std::uint32_t header_size = 44;
+
+    auto write_le(std::ofstream& file, std::uint32_t value, std::size_t size) -> void
+    {
+        for (std::size_t n = 0; n < size; ++n) {
+            file.put(static_cast<char>((value >> (n * 8)) & 0xFF));
+        }
+    }
+}
+
+// MARK: - Null Output
+
+auto kestrel::sound::mixer::null_output::write(const std::int16_t *, std::size_t frames) -> void
+{
+    m_frames_written += frames;
+}
+
+// MARK: - WAV Output
+
+kestrel::sound::mixer::wav_output::wav_output(const std::string& path, std::uint32_t sample_rate)
+    : m_file(path, std::ios::binary | std::ios::trunc), m_sample_rate(sample_rate)
+{
+    if (m_file.is_open()) {
+        write_header();
+    }
+}
+
+kestrel::sound::mixer::wav_output::~wav_output()
+{
+    close();
+}
+
+auto kestrel::sound::mixer::wav_output::is_open() const -> bool
+{
+    return m_file.is_open();
+}
+
+auto kestrel::sound::mixer::wav_output::write_header() -> void
+{
+    auto data_size = static_cast<std::uint32_t>(m_frames_written * channels * (bits_per_sample / 8));
+
+    m_file.seekp(0);
+    m_file.write("RIFF", 4);
+    write_le(m_file, header_size - 8 + data_size, 4);
+    m_file.write("WAVE", 4);
+
+    m_file.write("fmt ", 4);
+    write_le(m_file, 16, 4);
+    write_le(m_file, 1, 2);
+    write_le(m_file, channels, 2);
+    write_le(m_file, m_sample_rate, 4);
+    write_le(m_file, m_sample_rate * channels * (bits_per_sample / 8), 4);
+    write_le(m_file, channels * (bits_per_sample / 8), 2);
+    write_le(m_file, bits_per_sample, 2);
+
+    m_file.write("data", 4);
+    write_le(m_file, data_size, 4);
+}
+
+auto kestrel::sound::mixer::wav_output::write(const std::int16_t *samples, std::size_t frames) -> void
+{
+    if (!m_file.is_open()) {
+        return;
+    }
+
+    // WAV data is little endian regardless of the host, so assemble the bytes explicitly and write them at once.
+    m_bytes.resize(frames * channels * 2);
+    for (std::size_t n = 0; n < frames * channels; ++n) {
+        auto sample = static_cast<std::uint16_t>(samples[n]);
+        m_bytes[(n << 1) + 0] = static_cast<char>(sample & 0xFF);
+        m_bytes[(n << 1) + 1] = static_cast<char>(sample >> 8);
+    }
+    m_file.write(m_bytes.data(), static_cast<std::streamsize>(m_bytes.size()));
+    m_frames_written += frames;
+}
+
+auto kestrel::sound::mixer::wav_output::close() -> void
+{
+    if (!m_file.is_open()) {
+        return;
+    }
+
+    write_header();
+    m_file.close();
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+
+namespace kestrel::sound::mixer
+{
+    /**
+     * The destination of the mixed audio. Samples are delivered as interleaved signed 16-bit stereo frames.
+     */
+    class output
+    {
+    public:
+        virtual ~output() = default;
+
+        virtual auto write(const std::int16_t *samples, std::size_t frames) -> void = 0;
+
+        [[nodiscard]] auto frames_written() const -> std::uint64_t { return m_frames_written; }
+
+    protected:
+        std::uint64_t m_frames_written { 0 };
+    };
+
+    /**
+     * Discards the mixed audio. Used when there is no audio device, or when only the cost of mixing is of interest.
+     */
+    class null_output : public output
+    {
+    public:
+        auto write(const std::int16_t *samples, std::size_t frames) -> void override;
+    };
+
+    /**
+     * Writes the mixed audio to a 16-bit stereo PCM WAV file.
+     */
+    class wav_output : public output
+    {
+    public:
+        wav_output(const std::string& path, std::uint32_t sample_rate);
+        ~wav_output() override;
+
+        [[nodiscard]] auto is_open() const -> bool;
+
+        auto write(const std::int16_t *samples, std::size_t frames) -> void override;
+
+        /**
+         * Finalise the sizes recorded in the header, and close the file.
+         */
+        auto close() -> void;
+
+    private:
+        std::ofstream m_file;
+        std::uint32_t m_sample_rate { 0 };
+        std::vector<char> m_bytes;
+
+        auto write_header() -> void;
+    };
+}
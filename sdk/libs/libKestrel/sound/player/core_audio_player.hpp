@@ -47,7 +47,8 @@ namespace kestrel::sound::core_audio
     class player : public sound::player<playback_session_info>
     {
     public:
-        auto play(std::shared_ptr<player_item> item, std::function<auto()->void> finished) -> playback_session_ref override;
+        using sound::player<playback_session_info>::play;
+        auto play(std::shared_ptr<player_item> item, std::int32_t priority, std::function<auto()->void> finished) -> playback_session_ref override;
         auto stop(const playback_session_ref& ref) -> void override;
 
         auto acquire_player_info() -> playback_session_info override;
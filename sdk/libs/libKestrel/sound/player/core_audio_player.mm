@@ -93,9 +93,9 @@ auto kestrel::sound::core_audio::player::configure_playback_session(std::shared_
 }
 // MARK: - Playback
 
-auto kestrel::sound::core_audio::player::play(std::shared_ptr<player_item> item, std::function<auto()->void> finished) -> playback_session_ref
+auto kestrel::sound::core_audio::player::play(std::shared_ptr<player_item> item, std::int32_t priority, std::function<auto()->void> finished) -> playback_session_ref
 {
-    const auto& ref = sound::player<playback_session_info>::play(item, finished);
+    const auto& ref = sound::player<playback_session_info>::play(item, priority, finished);
     const auto& session = sound::player<playback_session_info>::playback_session(ref);
 
     // Invoke the audio within Core Audio. We need to setup the finishing callback to notify the engine that audio
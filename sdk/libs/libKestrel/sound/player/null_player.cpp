@@ -0,0 +1,78 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <libKestrel/sound/player/null_player.hpp>
+#include <libKestrel/sound/stream/stream.hpp>
+
+// MARK: - Playback Session
+
+auto kestrel::sound::null::player::acquire_player_info() -> playback_session_info
+{
+    return {};
+}
+
+auto kestrel::sound::null::player::configure_playback_session(std::shared_ptr<sound::playback_session<playback_session_info>> session) -> void
+{
+    if (session->stream) {
+        session->stream->start();
+    }
+}
+
+// MARK: - Playback Management
+
+auto kestrel::sound::null::player::check_completion() -> void
+{
+    for (const auto& session : playback_sessions()) {
+        if (session == nullptr || session->finished_playing) {
+            continue;
+        }
+
+        if (!session->item->is_stream_item()) {
+            session->info.consumed_bytes += session->item->buffer_size();
+            session->finish();
+            continue;
+        }
+
+        auto stream = session->stream;
+        if (!stream) {
+            session->finish();
+            continue;
+        }
+
+        while (auto chunk = stream->acquire()) {
+            session->info.consumed_bytes += chunk->size();
+            stream->release(chunk);
+        }
+
+        if (stream->finished()) {
+            session->finish();
+        }
+    }
+
+    sound::player<playback_session_info>::check_completion();
+}
+
+auto kestrel::sound::null::player::stop(const playback_session_ref& ref) -> void
+{
+    const auto& session = playback_session(ref);
+    if (session && session->stream) {
+        session->stream->stop();
+    }
+    sound::player<playback_session_info>::stop(ref);
+}
@@ -0,0 +1,45 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <cstdint>
+#include <libKestrel/sound/player/player.hpp>
+
+namespace kestrel::sound::null
+{
+    struct playback_session_info
+    {
+        std::uint64_t consumed_bytes { 0 };
+    };
+
+    /**
+     * A player that produces no output. Sessions consume their audio as quickly as it becomes available, which makes
+     * the player suitable for headless runs and for exercising streamed items without an audio device.
+     */
+    class player : public sound::player<playback_session_info>
+    {
+    public:
+        auto check_completion() -> void override;
+        auto stop(const playback_session_ref& ref) -> void override;
+
+        auto acquire_player_info() -> playback_session_info override;
+        auto configure_playback_session(std::shared_ptr<sound::playback_session<playback_session_info>> session) -> void override;
+    };
+}
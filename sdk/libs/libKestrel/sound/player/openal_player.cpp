@@ -147,9 +147,52 @@ auto kestrel::sound::openal::player::configure() -> void
         return;
     }
 
+    // Generate the pool of sources up front. Devices may support fewer sources than requested, in which case the
+    // pool is limited to as many as could be generated.
+    for (std::size_t i = 0; i < max_voices; ++i) {
+        ALuint source = 0;
+        if (!openal_do(alGenSources, 1, &source)) {
+            break;
+        }
+        openal_do(alSourcef, source, AL_PITCH, 1);
+        openal_do(alSourcef, source, AL_GAIN, 1.0f);
+        openal_do(alSource3f, source, AL_POSITION, 0, 0, 0);
+        openal_do(alSource3f, source, AL_VELOCITY, 0, 0, 0);
+        openal_do(alSourcei, source, AL_LOOPING, AL_FALSE);
+        m_sources.emplace_back(source);
+    }
+    m_voices.resize(m_sources.size());
+
     m_configured = true;
 }
 
+kestrel::sound::openal::player::~player()
+{
+    if (!m_configured) {
+        return;
+    }
+
+    for (const auto& session : playback_sessions()) {
+        if (session) {
+            release_session(session);
+        }
+    }
+
+    openal_do(alDeleteSources, static_cast<ALsizei>(m_sources.size()), m_sources.data());
+    for (const auto& it : m_buffers) {
+        openal_do(alDeleteBuffers, 1, &it.second.buffer);
+    }
+
+    alcMakeContextCurrent(nullptr);
+    alcDestroyContext(m_context);
+    alcCloseDevice(m_device);
+}
+
+auto kestrel::sound::openal::player::voices() const -> const voice_pool&
+{
+    return m_voices;
+}
+
 // MARK: - Playback Session
 
 auto kestrel::sound::openal::player::acquire_player_info() -> playback_session_info
@@ -176,21 +219,150 @@ auto kestrel::sound::openal::player::configure_playback_session(std::shared_ptr<
         return;
     }
 
-    openal_do(alGenBuffers, 1, &session->info.handle);
-    openal_do(alBufferData,
-              session->info.handle,
-              session->info.format,
-              session->item->internal_buffer_pointer(),
-              session->item->buffer_size(),
-              session->item->sample_rate());
+    if (session->item->is_stream_item() && !session->stream) {
+        return;
+    }
+
+    if (!acquire_voice(session)) {
+        return;
+    }
+
+    if (session->stream) {
+        // Streamed items are played through a queue of buffers, one for each chunk of the stream. Only the first
+        // chunk needs to be decoded before playback can begin.
+        auto stream = session->stream;
+        session->info.stream_buffers.resize(stream->chunk_count());
+        openal_do(alGenBuffers, static_cast<ALsizei>(session->info.stream_buffers.size()), session->info.stream_buffers.data());
+        session->info.free_stream_buffers = session->info.stream_buffers;
+        stream->start();
+        service_stream(session, true);
+    }
+    else {
+        session->info.handle = buffer_for(session->item, session->info.format);
+        openal_do(alSourcei, session->info.source, AL_BUFFER, session->info.handle);
+    }
+}
+
+// MARK: - Voices
+
+auto kestrel::sound::openal::player::acquire_voice(const std::shared_ptr<sound::playback_session<playback_session_info>>& session) -> bool
+{
+    auto allocation = m_voices.acquire(session->ref, session->priority);
+    if (!allocation.has_value()) {
+        return false;
+    }
+
+    if (allocation->stolen_from != 0) {
+        // The session that previously owned the voice is stopped now, and finished on the next tick.
+        if (auto previous = playback_session(allocation->stolen_from)) {
+            release_session(previous);
+        }
+    }
+
+    session->info.has_voice = true;
+    session->info.voice = allocation->index;
+    session->info.source = m_sources[allocation->index];
+    return true;
+}
+
+auto kestrel::sound::openal::player::release_session(const std::shared_ptr<sound::playback_session<playback_session_info>>& session) -> void
+{
+    auto& info = session->info;
+    if (session->stream) {
+        session->stream->stop();
+    }
+
+    if (info.has_voice) {
+        openal_do(alSourceStop, info.source);
+        openal_do(alSourcei, info.source, AL_BUFFER, 0);
 
-    auto err = openal_do(alGenSources, 1, &session->info.source);
-    openal_do(alSourcef, session->info.source, AL_PITCH, 1);
-    openal_do(alSourcef, session->info.source, AL_GAIN, 1.0f);
-    openal_do(alSource3f, session->info.source, AL_POSITION, 0, 0, 0);
-    openal_do(alSource3f, session->info.source, AL_VELOCITY, 0, 0, 0);
-    openal_do(alSourcei, session->info.source, AL_LOOPING, AL_FALSE);
-    openal_do(alSourcei, session->info.source, AL_BUFFER, session->info.handle);
+        // A stolen voice already belongs to another session.
+        if (m_voices.owner(info.voice) == session->ref) {
+            m_voices.release(info.voice);
+        }
+        info.has_voice = false;
+        info.source = 0;
+    }
+
+    if (!info.stream_buffers.empty()) {
+        openal_do(alDeleteBuffers, static_cast<ALsizei>(info.stream_buffers.size()), info.stream_buffers.data());
+        info.stream_buffers.clear();
+        info.free_stream_buffers.clear();
+    }
+}
+
+// MARK: - Buffers
+
+auto kestrel::sound::openal::player::buffer_for(const std::shared_ptr<sound::player_item>& item, ALenum format) -> ALuint
+{
+    auto data = item->internal_buffer_pointer();
+    auto size = item->buffer_size();
+
+    auto it = m_buffers.find(item.get());
+    if (it != m_buffers.end() && !it->second.item.expired() && it->second.data == data && it->second.size == size) {
+        return it->second.buffer;
+    }
+
+    if (it == m_buffers.end()) {
+        discard_expired_buffers();
+
+        cached_buffer buffer;
+        openal_do(alGenBuffers, 1, &buffer.buffer);
+        it = m_buffers.emplace(item.get(), buffer).first;
+    }
+
+    // Either a new item, or the address of an item that has since been released has been reused.
+    it->second.item = item;
+    it->second.data = data;
+    it->second.size = size;
+    openal_do(alBufferData, it->second.buffer, format, data, static_cast<ALsizei>(size), static_cast<ALsizei>(item->sample_rate()));
+    return it->second.buffer;
+}
+
+auto kestrel::sound::openal::player::discard_expired_buffers() -> void
+{
+    // Sessions hold a reference to their item, so the buffer of an expired item can no longer be attached to a source.
+    for (auto it = m_buffers.begin(); it != m_buffers.end();) {
+        if (it->second.item.expired()) {
+            openal_do(alDeleteBuffers, 1, &it->second.buffer);
+            it = m_buffers.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+// MARK: - Streaming
+
+auto kestrel::sound::openal::player::service_stream(const std::shared_ptr<sound::playback_session<playback_session_info>>& session, bool wait) -> void
+{
+    auto stream = session->stream;
+    auto& info = session->info;
+
+    ALint processed = 0;
+    openal_do(alGetSourcei, info.source, AL_BUFFERS_PROCESSED, &processed);
+    while (processed-- > 0) {
+        ALuint buffer = 0;
+        openal_do(alSourceUnqueueBuffers, info.source, 1, &buffer);
+        info.free_stream_buffers.emplace_back(buffer);
+    }
+
+    // OpenAL copies the samples into the buffer, so each chunk can be returned to the stream as soon as it has
+    // been queued.
+    while (!info.free_stream_buffers.empty()) {
+        auto chunk = stream->acquire(wait);
+        if (!chunk) {
+            break;
+        }
+        wait = false;
+
+        auto buffer = info.free_stream_buffers.back();
+        info.free_stream_buffers.pop_back();
+        openal_do(alBufferData, buffer, info.format, chunk->data(), static_cast<ALsizei>(chunk->size()), static_cast<ALsizei>(session->item->sample_rate()));
+        stream->release(chunk);
+        openal_do(alSourceQueueBuffers, info.source, 1, &buffer);
+    }
 }
 
 // MARK: - Playback Management
@@ -199,12 +371,40 @@ auto kestrel::sound::openal::player::check_completion() -> void
 {
     auto sessions = sound::player<playback_session_info>::playback_sessions();
     for (auto& session : sessions) {
-        if (session == nullptr) {
+        if (session == nullptr || session->finished_playing) {
             continue;
         }
+
+        // Sessions that were stopped, had their voice stolen or never received one are complete.
+        if (!session->info.has_voice) {
+            release_session(session);
+            session->finish();
+            continue;
+        }
+
         ALint state;
         openal_do(alGetSourcei, session->info.source, AL_SOURCE_STATE, &state);
+
+        if (session->stream) {
+            service_stream(session);
+
+            ALint queued = 0;
+            openal_do(alGetSourcei, session->info.source, AL_BUFFERS_QUEUED, &queued);
+            if (state != AL_PLAYING) {
+                if (queued > 0) {
+                    // The source ran out of queued buffers before the stream could refill them, so resume it.
+                    openal_do(alSourcePlay, session->info.source);
+                }
+                else if (session->stream->finished()) {
+                    release_session(session);
+                    session->finish();
+                }
+            }
+            continue;
+        }
+
         if (state != AL_PLAYING) {
+            release_session(session);
             session->finish();
         }
     }
@@ -213,16 +413,18 @@ auto kestrel::sound::openal::player::check_completion() -> void
     kestrel::sound::player<playback_session_info>::check_completion();
 }
 
-auto kestrel::sound::openal::player::play(std::shared_ptr<sound::player_item> item, std::function<auto()->void> finished) -> playback_session_ref
+auto kestrel::sound::openal::player::play(std::shared_ptr<sound::player_item> item, std::int32_t priority, std::function<auto()->void> finished) -> playback_session_ref
 {
     if (!m_configured) {
         return 0;
     }
 
-    const auto& ref = sound::player<playback_session_info>::play(item, finished);
+    const auto& ref = sound::player<playback_session_info>::play(item, priority, finished);
     const auto& session = sound::player<playback_session_info>::playback_session(ref);
 
-    openal_do(alSourcePlay, session->info.source);
+    if (session->info.has_voice) {
+        openal_do(alSourcePlay, session->info.source);
+    }
 
     return ref;
 }
@@ -235,7 +437,7 @@ auto kestrel::sound::openal::player::stop(const playback_session_ref& ref) -> vo
 
     const auto& session = sound::player<playback_session_info>::playback_session(ref);
     if (session) {
-        openal_do(alSourceStop, session->info.source);
+        release_session(session);
         session->ref = 0;
     }
-}
\ No newline at end of file
+}
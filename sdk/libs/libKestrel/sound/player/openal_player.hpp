@@ -30,7 +30,9 @@
 #   include <AL/alc.h>
 #endif
 
+#include <unordered_map>
 #include <libKestrel/sound/player/player.hpp>
+#include <libKestrel/sound/player/voice_pool.hpp>
 
 namespace kestrel::sound::openal
 {
@@ -40,26 +42,70 @@ namespace kestrel::sound::openal
         ALuint handle { 0 };
         ALuint source { 0 };
         ALenum format { AL_FORMAT_MONO8 };
+        bool has_voice { false };
+        voice_pool::voice voice { 0 };
+        std::vector<ALuint> stream_buffers;
+        std::vector<ALuint> free_stream_buffers;
     };
 
     class player : public sound::player<playback_session_info>
     {
+    public:
+        static constexpr std::size_t max_voices { 32 };
+
     private:
+        struct cached_buffer
+        {
+            std::weak_ptr<sound::player_item> item;
+            ALuint buffer { 0 };
+            const void *data { nullptr };
+            std::uint32_t size { 0 };
+        };
+
         ALCcontext *m_context { nullptr };
         ALCdevice *m_device { nullptr };
         ALCboolean m_context_current { false };
         bool m_configured { false };
+        std::vector<ALuint> m_sources;
+        voice_pool m_voices;
+        std::unordered_map<const sound::player_item *, cached_buffer> m_buffers;
 
     public:
+        ~player();
+
         auto configure() -> void override;
 
         auto check_completion() -> void override;
-        auto play(std::shared_ptr<sound::player_item> item, std::function<auto()->void> finished) -> playback_session_ref override;
+        using sound::player<playback_session_info>::play;
+        auto play(std::shared_ptr<sound::player_item> item, std::int32_t priority, std::function<auto()->void> finished) -> playback_session_ref override;
         auto stop(const playback_session_ref& ref) -> void override;
 
         auto acquire_player_info() -> playback_session_info override;
         auto configure_playback_session(std::shared_ptr<sound::playback_session<playback_session_info>> session) -> void override;
 
+        [[nodiscard]] auto voices() const -> const voice_pool&;
+
+    private:
+        /**
+         * Bind a source from the pool to the session, stealing one from a lower priority session if necessary.
+         */
+        auto acquire_voice(const std::shared_ptr<sound::playback_session<playback_session_info>>& session) -> bool;
+        auto release_session(const std::shared_ptr<sound::playback_session<playback_session_info>>& session) -> void;
+
+        /**
+         * The buffer holding the samples of the item. Items are uploaded once, the first time they are played, and the
+         * buffer is reused for every subsequent play.
+         */
+        auto buffer_for(const std::shared_ptr<sound::player_item>& item, ALenum format) -> ALuint;
+        auto discard_expired_buffers() -> void;
+
+        /**
+         * Return the buffers that the source has finished playing to the stream, and queue newly decoded chunks
+         * into any free buffers.
+         */
+        static auto service_stream(const std::shared_ptr<sound::playback_session<playback_session_info>>& session, bool wait = false) -> void;
+
+    public:
         static auto check_errors(const std::string& filename, std::uint_fast32_t line) -> bool;
         static auto check_errors(const std::string& filename, std::uint_fast32_t line, ALCdevice *dev) -> bool;
 
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
 #include <functional>
@@ -37,10 +38,22 @@ namespace kestrel::sound
         std::shared_ptr<sound::player_item> item;
         std::function<auto()->void> playback_finished;
         player_info info;
+        std::int32_t priority;
         bool finished_playing;
 
-        playback_session(playback_session_ref ref, std::shared_ptr<sound::player_item> item, player_info info, std::function<auto()->void> playback_finished)
-            : ref(ref), item(std::move(item)), info(std::move(info)), playback_finished(std::move(playback_finished)), finished_playing(false) {}
+        /**
+         * Streamed items are decoded through a stream that belongs to the session, so that several sessions playing
+         * the same item at once each decode it from their own position.
+         */
+        std::shared_ptr<sound::stream> stream;
+
+        playback_session(playback_session_ref ref, std::shared_ptr<sound::player_item> item, player_info info, std::int32_t priority, std::function<auto()->void> playback_finished)
+            : ref(ref), item(std::move(item)), info(std::move(info)), priority(priority), playback_finished(std::move(playback_finished)), finished_playing(false)
+        {
+            if (this->item && this->item->is_stream_item()) {
+                stream = this->item->make_stream();
+            }
+        }
 
         auto finish() -> void
         {
@@ -66,15 +79,19 @@ namespace kestrel::sound
 
         virtual auto check_completion() -> void
         {
-            std::remove_if(m_playback_sessions.begin(), m_playback_sessions.end(), [] (std::shared_ptr<sound::playback_session<player_info>> item) {
+            m_playback_sessions.erase(std::remove_if(m_playback_sessions.begin(), m_playback_sessions.end(), [] (const std::shared_ptr<sound::playback_session<player_info>>& item) {
                 return (item == nullptr || item->finished_playing);
-            });
+            }), m_playback_sessions.end());
         }
 
-        virtual auto play(std::shared_ptr<sound::player_item> item, std::function<auto()->void> finished) -> playback_session_ref
+        /**
+         * Play the item with the specified priority. The priority belongs to the session rather than the item, as
+         * items may be shared by several sounds that each have their own priority.
+         */
+        virtual auto play(std::shared_ptr<sound::player_item> item, std::int32_t priority, std::function<auto()->void> finished) -> playback_session_ref
         {
             auto session = std::make_shared<sound::playback_session<player_info>>(
-                next_session_ref(), std::move(item), std::move(acquire_player_info()), std::move(finished)
+                next_session_ref(), std::move(item), std::move(acquire_player_info()), priority, std::move(finished)
             );
 
             session->finished_playing = false;
@@ -84,6 +101,12 @@ namespace kestrel::sound
             return session->ref;
         }
 
+        auto play(std::shared_ptr<sound::player_item> item, std::function<auto()->void> finished) -> playback_session_ref
+        {
+            auto priority = item ? item->priority() : player_item::default_priority;
+            return play(std::move(item), priority, std::move(finished));
+        }
+
         virtual auto stop(const playback_session_ref& ref) -> void
         {
             const auto& session = playback_session(ref);
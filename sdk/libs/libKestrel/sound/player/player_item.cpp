@@ -58,6 +58,13 @@ kestrel::sound::player_item::player_item(const codec::descriptor &codec, void *b
 
 }
 
+kestrel::sound::player_item::player_item(const codec::descriptor& codec, decoder_factory factory)
+    : player_item(codec)
+{
+    m_decoder_factory = std::move(factory);
+    m_buffer_size = 0;
+}
+
 // MARK: - Destruction
 
 kestrel::sound::player_item::~player_item()
@@ -96,6 +103,21 @@ auto kestrel::sound::player_item::is_file_item() const -> bool
     return m_is_file;
 }
 
+auto kestrel::sound::player_item::is_stream_item() const -> bool
+{
+    return m_decoder_factory != nullptr;
+}
+
+auto kestrel::sound::player_item::make_stream() const -> std::shared_ptr<sound::stream>
+{
+    if (!m_decoder_factory) {
+        return nullptr;
+    }
+
+    auto decoder = m_decoder_factory();
+    return decoder ? std::make_shared<sound::stream>(std::move(decoder)) : nullptr;
+}
+
 auto kestrel::sound::player_item::file_path() const -> std::string
 {
     return m_file_path;
@@ -146,6 +168,16 @@ auto kestrel::sound::player_item::format_flags() const -> std::uint32_t
     return m_format_flags;
 }
 
+auto kestrel::sound::player_item::priority() const -> std::int32_t
+{
+    return m_priority;
+}
+
+auto kestrel::sound::player_item::category() const -> enum category
+{
+    return m_category;
+}
+
 // MARK: - Setters
 
 auto kestrel::sound::player_item::set_sample_rate(std::uint32_t sample_rate) -> void
@@ -193,3 +225,13 @@ auto kestrel::sound::player_item::set_format_flags(std::uint32_t format_flags) -
     m_format_flags = format_flags;
 }
 
+auto kestrel::sound::player_item::set_priority(std::int32_t priority) -> void
+{
+    m_priority = priority;
+}
+
+auto kestrel::sound::player_item::set_category(enum category category) -> void
+{
+    m_category = category;
+}
+
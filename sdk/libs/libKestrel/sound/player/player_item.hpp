@@ -22,17 +22,42 @@
 
 #include <memory>
 #include <string>
+#include <functional>
 #include <libKestrel/sound/codec/audio_codec_descriptor.hpp>
+#include <libKestrel/sound/stream/stream.hpp>
 
 namespace kestrel::sound
 {
+    /**
+     * The group an item belongs to, so that the volume of each group can be controlled independently.
+     */
+    enum class category : std::uint8_t
+    {
+        effects, music, interface
+    };
+
     class player_item
     {
     public:
+        typedef std::function<auto()->std::unique_ptr<sound::decoder>> decoder_factory;
+
+        /**
+         * When every voice of a player is in use, items of a lower priority are stopped to make room for items of
+         * an equal or higher priority.
+         */
+        static constexpr std::int32_t default_priority { 0 };
+        static constexpr std::int32_t music_priority { 1000 };
+
         explicit player_item(std::string file_path);
         explicit player_item(const codec::descriptor& codec);
         player_item(const codec::descriptor& codec, void *buffer, std::uint32_t buffer_size);
 
+        /**
+         * An item that is decoded incrementally as it plays, rather than being held in memory in its entirety. Each
+         * playback of the item decodes through its own stream, so the factory must produce a new decoder on each call.
+         */
+        player_item(const codec::descriptor& codec, decoder_factory factory);
+
         player_item(const player_item& item) = default;
         player_item(player_item&& item) = default;
 
@@ -42,6 +67,8 @@ namespace kestrel::sound
         auto internal_buffer_pointer() -> void *;
 
         [[nodiscard]] auto is_file_item() const -> bool;
+        [[nodiscard]] auto is_stream_item() const -> bool;
+        [[nodiscard]] auto make_stream() const -> std::shared_ptr<sound::stream>;
         [[nodiscard]] auto file_path() const -> std::string;
         [[nodiscard]] auto sample_rate() const -> std::uint32_t;
         [[nodiscard]] auto buffer_size() const -> std::uint32_t;
@@ -52,6 +79,8 @@ namespace kestrel::sound
         [[nodiscard]] auto bit_width() const -> std::uint8_t;
         [[nodiscard]] auto format() const -> std::uint32_t;
         [[nodiscard]] auto format_flags() const -> std::uint32_t;
+        [[nodiscard]] auto priority() const -> std::int32_t;
+        [[nodiscard]] auto category() const -> enum category;
 
         auto set_sample_rate(std::uint32_t sample_rate) -> void;
         auto set_buffer_size(std::uint32_t buffer_size) -> void;
@@ -62,10 +91,13 @@ namespace kestrel::sound
         auto set_bit_width(std::uint8_t bit_width) -> void;
         auto set_format(std::uint32_t format) -> void;
         auto set_format_flags(std::uint32_t format_flags) -> void;
+        auto set_priority(std::int32_t priority) -> void;
+        auto set_category(enum category category) -> void;
 
     private:
         bool m_is_file { false };
         std::string m_file_path;
+        decoder_factory m_decoder_factory;
         void *m_buffer { nullptr };
         std::uint32_t m_sample_rate { 0 };
         std::uint32_t m_buffer_size { 0 };
@@ -76,6 +108,8 @@ namespace kestrel::sound
         std::uint8_t m_bit_width { 0 };
         std::uint32_t m_format_flags { 0 };
         std::uint32_t m_format_id { 0 };
+        std::int32_t m_priority { default_priority };
+        enum category m_category { category::effects };
     };
 
 }
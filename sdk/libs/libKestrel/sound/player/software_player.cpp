@@ -0,0 +1,355 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <cstring>
+#include <algorithm>
+#include <libKestrel/sound/player/software_player.hpp>
+
+// MARK: - Construction
+
+kestrel::sound::software::player::player(std::uint32_t sample_rate, std::size_t voices)
+    : m_sample_rate(sample_rate),
+      m_voices(voices),
+      m_output(std::make_unique<mixer::null_output>()),
+      m_kernels(&mixer::native_kernels()),
+      m_bus(block_frames * 2),
+      m_source(block_frames * 2),
+      m_pcm(block_frames * 2),
+      m_last_tick(std::chrono::steady_clock::now())
+{}
+
+kestrel::sound::software::player::~player()
+{
+    for (const auto& session : playback_sessions()) {
+        if (session) {
+            release_session(session);
+        }
+    }
+}
+
+auto kestrel::sound::software::player::configure() -> void
+{
+    m_last_tick = std::chrono::steady_clock::now();
+    m_pending_frames = 0;
+}
+
+// MARK: - Accessors
+
+auto kestrel::sound::software::player::sample_rate() const -> std::uint32_t
+{
+    return m_sample_rate;
+}
+
+auto kestrel::sound::software::player::voices() const -> const voice_pool&
+{
+    return m_voices;
+}
+
+auto kestrel::sound::software::player::set_output(std::unique_ptr<mixer::output> output) -> void
+{
+    m_output = output ? std::move(output) : std::make_unique<mixer::null_output>();
+}
+
+auto kestrel::sound::software::player::output() const -> mixer::output *
+{
+    return m_output.get();
+}
+
+auto kestrel::sound::software::player::set_kernels(const mixer::kernels& kernels) -> void
+{
+    m_kernels = &kernels;
+}
+
+auto kestrel::sound::software::player::set_master_gain(float gain) -> void
+{
+    m_master_gain = std::max(0.f, gain);
+}
+
+auto kestrel::sound::software::player::master_gain() const -> float
+{
+    return m_master_gain;
+}
+
+auto kestrel::sound::software::player::set_category_gain(enum category category, float gain) -> void
+{
+    m_category_gain[static_cast<std::size_t>(category)] = std::max(0.f, gain);
+}
+
+auto kestrel::sound::software::player::category_gain(enum category category) const -> float
+{
+    return m_category_gain[static_cast<std::size_t>(category)];
+}
+
+auto kestrel::sound::software::player::stats() const -> const statistics&
+{
+    return m_stats;
+}
+
+auto kestrel::sound::software::player::reset_statistics() -> void
+{
+    m_stats = {};
+}
+
+// MARK: - Playback Session
+
+auto kestrel::sound::software::player::acquire_player_info() -> playback_session_info
+{
+    return {};
+}
+
+auto kestrel::sound::software::player::configure_playback_session(std::shared_ptr<sound::playback_session<playback_session_info>> session) -> void
+{
+    auto& item = *session->item;
+    auto& info = session->info;
+
+    if (item.channels() < 1 || item.channels() > 2) {
+        return;
+    }
+
+    if (item.is_stream_item()) {
+        if (item.bit_width() != 16 || !session->stream) {
+            return;
+        }
+        info.stream = session->stream.get();
+    }
+    else if (item.bit_width() == 8 || item.bit_width() == 16) {
+        info.data = static_cast<const std::uint8_t *>(item.internal_buffer_pointer());
+        info.frame_count = item.buffer_size() / (item.channels() * (item.bit_width() >> 3));
+    }
+    else {
+        return;
+    }
+
+    auto allocation = m_voices.acquire(session->ref, session->priority);
+    if (!allocation.has_value()) {
+        return;
+    }
+
+    if (allocation->stolen_from != 0) {
+        // The session that previously owned the voice is silenced now, and finished on the next render.
+        if (auto previous = playback_session(allocation->stolen_from)) {
+            release_session(previous);
+        }
+    }
+
+    info.has_voice = true;
+    info.voice = allocation->index;
+    info.channels = item.channels();
+    info.bit_width = item.bit_width();
+    info.step = (item.sample_rate() > 0) ? static_cast<double>(item.sample_rate()) / m_sample_rate : 1.0;
+
+    if (info.stream) {
+        info.stream->start();
+    }
+}
+
+auto kestrel::sound::software::player::release_session(const std::shared_ptr<sound::playback_session<playback_session_info>>& session) -> void
+{
+    auto& info = session->info;
+    if (info.stream) {
+        info.stream->release(info.chunk);
+        info.stream->stop();
+        info.chunk = nullptr;
+    }
+
+    if (info.has_voice) {
+        // A stolen voice already belongs to another session.
+        if (m_voices.owner(info.voice) == session->ref) {
+            m_voices.release(info.voice);
+        }
+        info.has_voice = false;
+    }
+}
+
+// MARK: - Mixing
+
+auto kestrel::sound::software::player::fetch(sound::playback_session<playback_session_info>& session, std::array<float, 2>& frame) -> fetch_result
+{
+    auto& info = session.info;
+
+    if (info.stream) {
+        if (info.chunk && info.chunk_frame >= info.chunk->count / info.channels) {
+            info.stream->release(info.chunk);
+            info.chunk = nullptr;
+        }
+
+        if (!info.chunk) {
+            info.chunk = info.stream->acquire();
+            info.chunk_frame = 0;
+            if (!info.chunk) {
+                return info.stream->finished() ? fetch_result::end : fetch_result::stall;
+            }
+        }
+
+        auto samples = info.chunk->samples.data() + info.chunk_frame * info.channels;
+        for (std::uint8_t c = 0; c < info.channels; ++c) {
+            frame[c] = static_cast<float>(samples[c]) * (1.f / 32768.f);
+        }
+        info.chunk_frame++;
+        return fetch_result::frame;
+    }
+
+    if (info.frame >= info.frame_count) {
+        return fetch_result::end;
+    }
+
+    if (info.bit_width == 8) {
+        // 8-bit samples are unsigned, centred on 128.
+        auto samples = info.data + info.frame * info.channels;
+        for (std::uint8_t c = 0; c < info.channels; ++c) {
+            frame[c] = static_cast<float>(static_cast<int>(samples[c]) - 128) * (1.f / 128.f);
+        }
+    }
+    else {
+        auto samples = info.data + (info.frame * info.channels * sizeof(std::int16_t));
+        for (std::uint8_t c = 0; c < info.channels; ++c) {
+            std::int16_t sample;
+            std::memcpy(&sample, samples + c * sizeof(std::int16_t), sizeof(sample));
+            frame[c] = static_cast<float>(sample) * (1.f / 32768.f);
+        }
+    }
+    info.frame++;
+    return fetch_result::frame;
+}
+
+auto kestrel::sound::software::player::mix_session(const std::shared_ptr<sound::playback_session<playback_session_info>>& session, std::size_t frames) -> void
+{
+    auto& info = session->info;
+    const auto channels = info.channels;
+    auto source = m_source.data();
+
+    std::size_t produced = 0;
+    std::array<float, 2> frame {};
+    auto result = fetch_result::frame;
+
+    if (!info.primed) {
+        // Start with both ends of the interpolation on the first frame, which delays the output by one source frame.
+        if ((result = fetch(*session, info.next)) == fetch_result::frame) {
+            info.previous = info.next;
+            info.fraction = 0;
+            info.primed = true;
+        }
+    }
+
+    while (result == fetch_result::frame && produced < frames) {
+        while (info.fraction >= 1.0) {
+            if ((result = fetch(*session, frame)) != fetch_result::frame) {
+                break;
+            }
+            info.previous = info.next;
+            info.next = frame;
+            info.fraction -= 1.0;
+        }
+
+        if (result != fetch_result::frame) {
+            break;
+        }
+
+        auto t = static_cast<float>(info.fraction);
+        for (std::uint8_t c = 0; c < channels; ++c) {
+            source[produced * channels + c] = info.previous[c] + (info.next[c] - info.previous[c]) * t;
+        }
+        info.fraction += info.step;
+        produced++;
+    }
+
+    if (result == fetch_result::end) {
+        info.ended = true;
+    }
+    else if (result == fetch_result::stall) {
+        m_stats.underruns++;
+    }
+
+    if (produced > 0) {
+        auto gain = m_master_gain * category_gain(session->item->category());
+        if (channels == 1) {
+            m_kernels->mix_mono(m_bus.data(), source, produced, gain, gain);
+        }
+        else {
+            m_kernels->mix_stereo(m_bus.data(), source, produced, gain, gain);
+        }
+        m_stats.voice_frames += produced;
+    }
+}
+
+auto kestrel::sound::software::player::render_block(std::size_t frames) -> void
+{
+    std::fill_n(m_bus.begin(), frames * 2, 0.f);
+
+    for (const auto& session : playback_sessions()) {
+        if (session && session->info.has_voice && !session->info.ended && !session->finished_playing) {
+            mix_session(session, frames);
+        }
+    }
+
+    m_kernels->to_int16(m_pcm.data(), m_bus.data(), frames * 2);
+    m_output->write(m_pcm.data(), frames);
+    m_stats.frames += frames;
+}
+
+auto kestrel::sound::software::player::render(std::size_t frames) -> void
+{
+    auto start = std::chrono::steady_clock::now();
+    while (frames > 0) {
+        auto count = std::min(frames, block_frames);
+        render_block(count);
+        frames -= count;
+    }
+    m_stats.mix_time += std::chrono::steady_clock::now() - start;
+
+    for (const auto& session : playback_sessions()) {
+        if (session == nullptr || session->finished_playing) {
+            continue;
+        }
+
+        // Sessions that ended, were stopped, had their voice stolen or never received one are complete.
+        if (!session->info.has_voice || session->info.ended) {
+            release_session(session);
+            session->finish();
+        }
+    }
+}
+
+// MARK: - Playback Management
+
+auto kestrel::sound::software::player::check_completion() -> void
+{
+    // Mix as much audio as real time has passed since the last tick. Long stalls, such as loading, are not caught up
+    // on beyond a quarter of a second.
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration<double>(now - m_last_tick).count();
+    m_last_tick = now;
+
+    m_pending_frames = std::min(m_pending_frames + elapsed * m_sample_rate, m_sample_rate / 4.0);
+    auto frames = static_cast<std::size_t>(m_pending_frames);
+    m_pending_frames -= static_cast<double>(frames);
+    render(frames);
+
+    // Go through each of the sessions, and discard the completed ones.
+    sound::player<playback_session_info>::check_completion();
+}
+
+auto kestrel::sound::software::player::stop(const playback_session_ref& ref) -> void
+{
+    const auto& session = playback_session(ref);
+    if (session) {
+        release_session(session);
+        session->ref = 0;
+    }
+}
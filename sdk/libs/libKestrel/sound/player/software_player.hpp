@@ -0,0 +1,131 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <libKestrel/sound/player/player.hpp>
+#include <libKestrel/sound/player/voice_pool.hpp>
+#include <libKestrel/sound/mixer/kernels.hpp>
+#include <libKestrel/sound/mixer/output.hpp>
+
+namespace kestrel::sound::software
+{
+    struct playback_session_info
+    {
+        bool has_voice { false };
+        voice_pool::voice voice { 0 };
+        bool ended { false };
+
+        // The source samples, cached from the item when the session is configured.
+        sound::stream *stream { nullptr };
+        const std::uint8_t *data { nullptr };
+        std::uint64_t frame_count { 0 };
+        std::uint8_t channels { 0 };
+        std::uint8_t bit_width { 0 };
+
+        // Position within the source.
+        std::uint64_t frame { 0 };
+        const sound::stream::chunk *chunk { nullptr };
+        std::size_t chunk_frame { 0 };
+
+        // Linear resampling state. The output lies between the previous and next source frames.
+        bool primed { false };
+        double step { 1.0 };
+        double fraction { 0.0 };
+        std::array<float, 2> previous {};
+        std::array<float, 2> next {};
+    };
+
+    /**
+     * Mixes every playing item into a single floating point stereo bus, resampling each item to the output rate, and
+     * delivers the result to an output. Without an audio device to pace it, the player mixes as much audio as real
+     * time has elapsed each time it is ticked.
+     */
+    class player : public sound::player<playback_session_info>
+    {
+    public:
+        static constexpr std::uint32_t default_sample_rate { 44100 };
+        static constexpr std::size_t default_voices { 32 };
+        static constexpr std::size_t block_frames { 1024 };
+
+        struct statistics
+        {
+            std::uint64_t frames { 0 };
+            std::uint64_t voice_frames { 0 };
+            std::uint64_t underruns { 0 };
+            std::chrono::duration<double> mix_time { 0 };
+        };
+
+        explicit player(std::uint32_t sample_rate = default_sample_rate, std::size_t voices = default_voices);
+        ~player();
+
+        auto configure() -> void override;
+
+        auto check_completion() -> void override;
+        auto stop(const playback_session_ref& ref) -> void override;
+
+        auto acquire_player_info() -> playback_session_info override;
+        auto configure_playback_session(std::shared_ptr<sound::playback_session<playback_session_info>> session) -> void override;
+
+        [[nodiscard]] auto sample_rate() const -> std::uint32_t;
+        [[nodiscard]] auto voices() const -> const voice_pool&;
+
+        auto set_output(std::unique_ptr<mixer::output> output) -> void;
+        [[nodiscard]] auto output() const -> mixer::output *;
+
+        auto set_kernels(const mixer::kernels& kernels) -> void;
+
+        auto set_master_gain(float gain) -> void;
+        [[nodiscard]] auto master_gain() const -> float;
+        auto set_category_gain(enum category category, float gain) -> void;
+        [[nodiscard]] auto category_gain(enum category category) const -> float;
+
+        /**
+         * Mix the specified number of frames and deliver them to the output. Items that reach their end are finished.
+         */
+        auto render(std::size_t frames) -> void;
+
+        [[nodiscard]] auto stats() const -> const statistics&;
+        auto reset_statistics() -> void;
+
+    private:
+        enum class fetch_result { frame, stall, end };
+
+        std::uint32_t m_sample_rate { default_sample_rate };
+        voice_pool m_voices;
+        std::unique_ptr<mixer::output> m_output;
+        const mixer::kernels *m_kernels { nullptr };
+        float m_master_gain { 1.f };
+        std::array<float, 3> m_category_gain { 1.f, 1.f, 1.f };
+        std::vector<float> m_bus;
+        std::vector<float> m_source;
+        std::vector<std::int16_t> m_pcm;
+        std::chrono::steady_clock::time_point m_last_tick;
+        double m_pending_frames { 0 };
+        statistics m_stats;
+
+        auto render_block(std::size_t frames) -> void;
+        auto mix_session(const std::shared_ptr<sound::playback_session<playback_session_info>>& session, std::size_t frames) -> void;
+        auto release_session(const std::shared_ptr<sound::playback_session<playback_session_info>>& session) -> void;
+        static auto fetch(sound::playback_session<playback_session_info>& session, std::array<float, 2>& frame) -> fetch_result;
+    };
+}
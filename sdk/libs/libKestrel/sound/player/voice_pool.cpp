@@ -0,0 +1,106 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <libKestrel/sound/player/voice_pool.hpp>
+
+// MARK: - Construction
+
+kestrel::sound::voice_pool::voice_pool(std::size_t count)
+    : m_slots(count)
+{}
+
+auto kestrel::sound::voice_pool::resize(std::size_t count) -> void
+{
+    m_slots.assign(count, {});
+}
+
+// MARK: - Accessors
+
+auto kestrel::sound::voice_pool::size() const -> std::size_t
+{
+    return m_slots.size();
+}
+
+auto kestrel::sound::voice_pool::active() const -> std::size_t
+{
+    std::size_t count = 0;
+    for (const auto& slot : m_slots) {
+        count += (slot.owner != 0) ? 1 : 0;
+    }
+    return count;
+}
+
+auto kestrel::sound::voice_pool::owner(voice index) const -> playback_session_ref
+{
+    return (index < m_slots.size()) ? m_slots[index].owner : 0;
+}
+
+auto kestrel::sound::voice_pool::stats() const -> const statistics&
+{
+    return m_stats;
+}
+
+// MARK: - Allocation
+
+auto kestrel::sound::voice_pool::acquire(playback_session_ref ref, std::int32_t priority) -> std::optional<allocation>
+{
+    std::optional<voice> candidate;
+    for (voice index = 0; index < m_slots.size(); ++index) {
+        const auto& slot = m_slots[index];
+        if (slot.owner == 0) {
+            candidate = index;
+            break;
+        }
+
+        if (slot.priority > priority) {
+            continue;
+        }
+
+        if (!candidate.has_value()
+            || slot.priority < m_slots[*candidate].priority
+            || (slot.priority == m_slots[*candidate].priority && slot.started < m_slots[*candidate].started))
+        {
+            candidate = index;
+        }
+    }
+
+    if (!candidate.has_value()) {
+        m_stats.rejected++;
+        return {};
+    }
+
+    auto& slot = m_slots[*candidate];
+    allocation result { *candidate, slot.owner };
+    if (slot.owner != 0) {
+        m_stats.stolen++;
+    }
+    m_stats.acquired++;
+
+    slot.owner = ref;
+    slot.priority = priority;
+    slot.started = ++m_clock;
+    return result;
+}
+
+auto kestrel::sound::voice_pool::release(voice index) -> void
+{
+    if (index < m_slots.size()) {
+        m_slots[index] = {};
+    }
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <libKestrel/sound/player/player.hpp>
+
+namespace kestrel::sound
+{
+    /**
+     * Tracks the ownership of a fixed set of voices (output sources). When every voice is in use, a new request steals
+     * the voice with the lowest priority, preferring the oldest when priorities are equal, provided its priority does
+     * not exceed that of the request.
+     */
+    class voice_pool
+    {
+    public:
+        typedef std::size_t voice;
+
+        struct allocation
+        {
+            voice index { 0 };
+            playback_session_ref stolen_from { 0 };
+        };
+
+        struct statistics
+        {
+            std::uint64_t acquired { 0 };
+            std::uint64_t stolen { 0 };
+            std::uint64_t rejected { 0 };
+        };
+
+        explicit voice_pool(std::size_t count = 0);
+
+        auto resize(std::size_t count) -> void;
+
+        [[nodiscard]] auto size() const -> std::size_t;
+        [[nodiscard]] auto active() const -> std::size_t;
+        [[nodiscard]] auto owner(voice index) const -> playback_session_ref;
+        [[nodiscard]] auto stats() const -> const statistics&;
+
+        /**
+         * Assign a voice to the specified session. If the voice had to be taken from another session, the reference
+         * of that session is reported so that it can be stopped. Returns nothing if no voice could be assigned.
+         */
+        auto acquire(playback_session_ref ref, std::int32_t priority) -> std::optional<allocation>;
+        auto release(voice index) -> void;
+
+    private:
+        struct slot
+        {
+            playback_session_ref owner { 0 };
+            std::int32_t priority { 0 };
+            std::uint64_t started { 0 };
+        };
+
+        std::vector<slot> m_slots;
+        std::uint64_t m_clock { 0 };
+        statistics m_stats;
+    };
+}
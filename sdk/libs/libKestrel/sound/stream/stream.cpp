@@ -0,0 +1,184 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <libKestrel/sound/stream/stream.hpp>
+
+// MARK: - Construction
+
+kestrel::sound::stream::stream(std::unique_ptr<sound::decoder> decoder, std::size_t chunk_count, std::size_t chunk_samples)
+    : m_decoder(std::move(decoder)), m_chunks(std::max<std::size_t>(chunk_count, 2))
+{
+    // Keep each chunk a whole number of frames, so that channels never become misaligned between chunks.
+    std::size_t channels = std::max<std::uint32_t>(1, m_decoder->descriptor().channels);
+    chunk_samples = std::max(channels, chunk_samples - (chunk_samples % channels));
+    for (auto& c : m_chunks) {
+        c.samples.resize(chunk_samples);
+    }
+}
+
+kestrel::sound::stream::~stream()
+{
+    stop();
+}
+
+// MARK: - Accessors
+
+auto kestrel::sound::stream::descriptor() const -> codec::descriptor
+{
+    return m_decoder->descriptor();
+}
+
+auto kestrel::sound::stream::chunk_count() const -> std::size_t
+{
+    return m_chunks.size();
+}
+
+auto kestrel::sound::stream::decoded_samples() const -> std::uint64_t
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_decoded_samples;
+}
+
+auto kestrel::sound::stream::underruns() const -> std::uint64_t
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_underruns;
+}
+
+// MARK: - Decoding
+
+auto kestrel::sound::stream::start() -> void
+{
+    stop();
+
+    m_decoder->rewind();
+    m_read = 0;
+    m_write = 0;
+    m_ready = 0;
+    m_in_use = 0;
+    m_decoded_samples = 0;
+    m_end_of_audio = false;
+    m_running = true;
+    m_thread = std::thread(&stream::decode, this);
+}
+
+auto kestrel::sound::stream::stop() -> void
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_running = false;
+    }
+    m_condition.notify_all();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+auto kestrel::sound::stream::decode() -> void
+{
+    while (true) {
+        std::size_t index = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_condition.wait(lock, [&] {
+                return !m_running || (m_ready + m_in_use) < m_chunks.size();
+            });
+            if (!m_running) {
+                return;
+            }
+            index = m_write;
+        }
+
+        // The chunk at the write position is not visible to the consumer until it is published below, so it can be
+        // filled without holding the lock.
+        auto& c = m_chunks[index];
+        std::size_t filled = 0;
+        while (filled < c.samples.size()) {
+            auto count = m_decoder->read(c.samples.data() + filled, c.samples.size() - filled);
+            if (count == 0) {
+                break;
+            }
+            filled += count;
+        }
+
+        auto end_of_audio = (filled < c.samples.size());
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            if (filled > 0) {
+                c.count = filled;
+                m_write = (m_write + 1) % m_chunks.size();
+                m_ready++;
+                m_decoded_samples += filled;
+            }
+            m_end_of_audio = end_of_audio;
+        }
+        m_condition.notify_all();
+
+        if (end_of_audio) {
+            return;
+        }
+    }
+}
+
+// MARK: - Consumption
+
+auto kestrel::sound::stream::acquire(bool wait) -> const chunk *
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    if (wait) {
+        m_condition.wait(lock, [&] {
+            return m_ready > 0 || m_end_of_audio || !m_running;
+        });
+    }
+
+    if (m_ready == 0) {
+        if (m_running && !m_end_of_audio) {
+            m_underruns++;
+        }
+        return nullptr;
+    }
+
+    auto c = &m_chunks[m_read];
+    m_read = (m_read + 1) % m_chunks.size();
+    m_ready--;
+    m_in_use++;
+    return c;
+}
+
+auto kestrel::sound::stream::release(const chunk *c) -> void
+{
+    if (!c) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_in_use--;
+    }
+    m_condition.notify_all();
+}
+
+auto kestrel::sound::stream::finished() const -> bool
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_end_of_audio && m_ready == 0 && m_in_use == 0;
+}
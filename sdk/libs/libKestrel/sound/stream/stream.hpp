@@ -0,0 +1,122 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <condition_variable>
+#include <libKestrel/sound/codec/audio_codec_descriptor.hpp>
+
+namespace kestrel::sound
+{
+    /**
+     * A source of 16-bit interleaved PCM samples that is decoded incrementally.
+     */
+    class decoder
+    {
+    public:
+        virtual ~decoder() = default;
+
+        [[nodiscard]] virtual auto descriptor() const -> codec::descriptor = 0;
+
+        /**
+         * Decode up to the specified number of samples, returning the number of samples produced. A return value of
+         * zero indicates the end of the audio.
+         */
+        virtual auto read(std::int16_t *samples, std::size_t count) -> std::size_t = 0;
+
+        /**
+         * Return to the start of the audio.
+         */
+        virtual auto rewind() -> void = 0;
+    };
+
+    /**
+     * Decodes audio ahead of playback on a background thread into a small, fixed ring of PCM chunks. The audio backend
+     * acquires each chunk in turn, hands it to the output device and then releases it, at which point the decoder is
+     * free to refill it. Memory use is bounded by the size of the ring, regardless of the length of the audio.
+     */
+    class stream
+    {
+    public:
+        struct chunk
+        {
+            std::vector<std::int16_t> samples;
+            std::size_t count { 0 };
+
+            [[nodiscard]] inline auto data() const -> const void * { return samples.data(); }
+            [[nodiscard]] inline auto size() const -> std::uint32_t { return static_cast<std::uint32_t>(count * sizeof(std::int16_t)); }
+        };
+
+        static constexpr std::size_t default_chunk_count { 4 };
+        static constexpr std::size_t default_chunk_samples { 16 * 1024 };
+
+        explicit stream(std::unique_ptr<sound::decoder> decoder,
+                        std::size_t chunk_count = default_chunk_count,
+                        std::size_t chunk_samples = default_chunk_samples);
+        ~stream();
+
+        [[nodiscard]] auto descriptor() const -> codec::descriptor;
+        [[nodiscard]] auto chunk_count() const -> std::size_t;
+
+        /**
+         * Start decoding from the beginning of the audio, abandoning any decoding already in progress.
+         */
+        auto start() -> void;
+        auto stop() -> void;
+
+        /**
+         * Take the next decoded chunk, or null if none is ready. When waiting, this blocks until a chunk has been
+         * decoded or the end of the audio is reached. Chunks must be released in the order they were acquired.
+         */
+        auto acquire(bool wait = false) -> const chunk *;
+        auto release(const chunk *c) -> void;
+
+        /**
+         * The decoder has reached the end of the audio and every decoded chunk has been consumed.
+         */
+        [[nodiscard]] auto finished() const -> bool;
+
+        [[nodiscard]] auto decoded_samples() const -> std::uint64_t;
+        [[nodiscard]] auto underruns() const -> std::uint64_t;
+
+    private:
+        auto decode() -> void;
+
+    private:
+        std::unique_ptr<sound::decoder> m_decoder;
+        std::vector<chunk> m_chunks;
+        mutable std::mutex m_lock;
+        std::condition_variable m_condition;
+        std::thread m_thread;
+        std::size_t m_read { 0 };
+        std::size_t m_write { 0 };
+        std::size_t m_ready { 0 };
+        std::size_t m_in_use { 0 };
+        bool m_running { false };
+        bool m_end_of_audio { true };
+        std::uint64_t m_decoded_samples { 0 };
+        std::uint64_t m_underruns { 0 };
+    };
+}
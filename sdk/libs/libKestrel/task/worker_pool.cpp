@@ -0,0 +1,149 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <libKestrel/task/worker_pool.hpp>
+
+// MARK: - Construction
+
+kestrel::task::worker_pool::worker_pool(std::size_t thread_count)
+{
+    // The calling thread always takes part in the work, so only spawn the additional threads.
+    for (std::size_t n = 1; n < thread_count; ++n) {
+        m_threads.emplace_back([this] { worker_main(); });
+    }
+}
+
+// MARK: - Destruction
+
+kestrel::task::worker_pool::~worker_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+// MARK: - Accessors
+
+auto kestrel::task::worker_pool::thread_count() const -> std::size_t
+{
+    return m_threads.size() + 1;
+}
+
+// MARK: - Execution
+
+auto kestrel::task::worker_pool::parallel_for(std::size_t count, std::size_t chunks, const chunk_block& block) -> void
+{
+    if (count == 0) {
+        return;
+    }
+
+    chunks = std::clamp<std::size_t>(chunks, 1, count);
+    auto chunk_size = (count + chunks - 1) / chunks;
+    chunks = (count + chunk_size - 1) / chunk_size;
+
+    if (m_threads.empty() || chunks == 1) {
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            block(chunk, chunk * chunk_size, std::min(count, (chunk + 1) * chunk_size));
+        }
+        return;
+    }
+
+    std::uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_job = { &block, count, chunk_size, chunks };
+        m_next_chunk = 0;
+        m_pending_chunks = chunks;
+        m_exception = nullptr;
+        generation = ++m_generation;
+    }
+    m_wake.notify_all();
+
+    execute_chunks(generation);
+
+    std::exception_ptr exception;
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_done.wait(lock, [this] { return m_pending_chunks == 0; });
+        exception = m_exception;
+        m_job = {};
+    }
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+auto kestrel::task::worker_pool::execute_chunks(std::uint64_t generation) -> void
+{
+    while (true) {
+        struct job job;
+        std::size_t chunk = 0;
+        {
+            // Chunks are claimed under the lock, so that a late waking worker can never pick up a chunk that
+            // belongs to a job other than the one it was woken for.
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (m_generation != generation || m_next_chunk >= m_job.chunk_count) {
+                return;
+            }
+            chunk = m_next_chunk++;
+            job = m_job;
+        }
+
+        try {
+            auto begin = chunk * job.chunk_size;
+            (*job.block)(chunk, begin, std::min(job.count, begin + job.chunk_size));
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (!m_exception) {
+                m_exception = std::current_exception();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (--m_pending_chunks == 0) {
+            m_done.notify_all();
+        }
+    }
+}
+
+auto kestrel::task::worker_pool::worker_main() -> void
+{
+    std::uint64_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_wake.wait(lock, [&] { return m_stopping || m_generation != seen_generation; });
+            if (m_stopping) {
+                return;
+            }
+            seen_generation = m_generation;
+        }
+        execute_chunks(seen_generation);
+    }
+}
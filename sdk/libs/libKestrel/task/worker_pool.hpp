@@ -0,0 +1,85 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <vector>
+
+namespace kestrel::task
+{
+    /**
+     * The `kestrel::task::worker_pool` class owns a set of persistent worker threads that can be used to split
+     * a range of work in to chunks and execute them in parallel. The calling thread participates in the work,
+     * and blocks until every chunk has been completed.
+     */
+    class worker_pool
+    {
+    public:
+        typedef std::function<auto(std::size_t, std::size_t, std::size_t)->void> chunk_block;
+
+        explicit worker_pool(std::size_t thread_count);
+        ~worker_pool();
+
+        worker_pool(const worker_pool&) = delete;
+        worker_pool &operator=(const worker_pool&) = delete;
+        worker_pool(worker_pool&&) = delete;
+        worker_pool &operator=(worker_pool&&) = delete;
+
+        /**
+         * The total number of threads that work is spread across, including the calling thread.
+         */
+        [[nodiscard]] auto thread_count() const -> std::size_t;
+
+        /**
+         * Split the range [0, count) in to the specified number of chunks, and execute the block once for
+         * each chunk with the chunk index, and the beginning and end of the chunk. Any exception raised by
+         * a chunk is rethrown on the calling thread once all chunks have finished.
+         */
+        auto parallel_for(std::size_t count, std::size_t chunks, const chunk_block& block) -> void;
+
+    private:
+        struct job
+        {
+            const chunk_block *block { nullptr };
+            std::size_t count { 0 };
+            std::size_t chunk_size { 0 };
+            std::size_t chunk_count { 0 };
+        };
+
+        std::vector<std::thread> m_threads;
+        std::mutex m_lock;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        std::uint64_t m_generation { 0 };
+        bool m_stopping { false };
+        struct job m_job;
+        std::size_t m_next_chunk { 0 };
+        std::size_t m_pending_chunks { 0 };
+        std::exception_ptr m_exception;
+
+        auto worker_main() -> void;
+        auto execute_chunks(std::uint64_t generation) -> void;
+    };
+}
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <limits>
+#include <algorithm>
 #include <libKestrel/ui/entity/scene_entity.hpp>
 #include <libKestrel/ui/entity/text_entity.hpp>
 #include <libKestrel/ui/entity/line_entity.hpp>
@@ -275,6 +277,11 @@ auto kestrel::ui::scene_entity::hidden() const -> bool
     return m_hidden;
 }
 
+auto kestrel::ui::scene_entity::draw_layer() const -> std::int32_t
+{
+    return m_draw_layer;
+}
+
 // MARK: - Setters
 
 auto kestrel::ui::scene_entity::set_position(const math::point& v) -> void
@@ -405,6 +412,11 @@ auto kestrel::ui::scene_entity::set_hidden(bool hidden) -> void
     m_hidden = hidden;
 }
 
+auto kestrel::ui::scene_entity::set_draw_layer(std::int32_t layer) -> void
+{
+    m_draw_layer = std::clamp(layer, -1, static_cast<std::int32_t>(std::numeric_limits<std::uint16_t>::max()));
+}
+
 // MARK: - Child Entity Management
 
 auto kestrel::ui::scene_entity::add_entity(const lua_reference & child) -> void
@@ -599,6 +611,12 @@ auto kestrel::ui::scene_entity::draw() -> void
         constrain_frame(m_animator->frame());
     }
 
+    auto previous_layer = renderer::draw_layer();
+    auto previous_order = renderer::draw_layer_order();
+    if (m_draw_layer >= 0) {
+        renderer::set_draw_layer(static_cast<std::uint16_t>(m_draw_layer), renderer::layer_order::sorted);
+    }
+
     m_entity->draw();
 
     if (m_next_frame_on_draw && !m_animator.get()) {
@@ -616,6 +634,10 @@ auto kestrel::ui::scene_entity::draw() -> void
             child.cast<line_entity::lua_reference>()->draw();
         }
     }
+
+    if (m_draw_layer >= 0) {
+        renderer::set_draw_layer(previous_layer, previous_order);
+    }
 }
 
 // MARK: - Mouse Events
@@ -126,6 +126,14 @@ namespace kestrel::ui
         lua_setter(alpha, Available_0_8) auto set_alpha(double v) -> void;
         lua_getter(blend, Available_0_8) [[nodiscard]] auto blend_mode() const -> std::int32_t;
         lua_setter(blend, Available_0_8) auto set_blend_mode(std::int32_t v) -> void;
+
+        /**
+         * The sorted layer that the entity and its children are recorded into when deferred drawing is enabled, so
+         * that entities sharing a texture, shader and blend mode can be drawn together. A negative layer leaves the
+         * entity in whichever layer is current when it is drawn.
+         */
+        lua_getter(drawLayer, Available_0_9) [[nodiscard]] auto draw_layer() const -> std::int32_t;
+        lua_setter(drawLayer, Available_0_9) auto set_draw_layer(std::int32_t layer) -> void;
         lua_function(draw, Available_0_8) auto draw() -> void;
 
         // MARK: - Clipping
@@ -188,6 +196,7 @@ namespace kestrel::ui
         math::rect m_parent_bounds { 0, 0, 0, 0 };
         std::int32_t m_frame_count { 1 };
         std::int32_t m_frame { 0 };
+        std::int32_t m_draw_layer { -1 };
         bool m_next_frame_on_draw { false };
         bool m_loops { false };
         bool m_mouse_over { false };
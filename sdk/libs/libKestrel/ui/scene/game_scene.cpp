@@ -292,6 +292,11 @@ auto kestrel::ui::game_scene::scene_scaling_factor() const -> double
     return m_backing_scene->scaling_factor();
 }
 
+auto kestrel::ui::game_scene::physics_thread_count() const -> std::uint32_t
+{
+    return static_cast<std::uint32_t>(m_world->thread_count());
+}
+
 // MARK: - Setters
 
 auto kestrel::ui::game_scene::set_passthrough_render(bool f) -> void
@@ -356,6 +361,11 @@ auto kestrel::ui::game_scene::set_scene_scaling_factor(double factor) -> void
     m_backing_scene->set_scaling_factor(factor);
 }
 
+auto kestrel::ui::game_scene::set_physics_thread_count(std::uint32_t count) -> void
+{
+    m_world->set_thread_count(count);
+}
+
 // MARK: - Callbacks
 
 auto kestrel::ui::game_scene::on_render(const luabridge::LuaRef& block) -> void
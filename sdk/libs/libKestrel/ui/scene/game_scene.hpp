@@ -74,10 +74,12 @@ namespace kestrel::ui
         lua_getter(disableUserInput, Available_0_8) [[nodiscard]] auto disable_user_input() const -> bool;
         lua_getter(sceneBoundingFrame, Available_0_9) [[nodiscard]] auto scene_bounding_frame() const -> math::rect;
         lua_getter(sceneScalingFactor, Available_0_9) [[nodiscard]] auto scene_scaling_factor() const -> double;
+        lua_getter(physicsThreadCount, Available_0_9) [[nodiscard]] auto physics_thread_count() const -> std::uint32_t;
 
         lua_setter(passthroughRender, Available_0_8) auto set_passthrough_render(bool f) -> void;
         lua_setter(sceneBoundingFrame, Available_0_9) auto set_scene_bounding_frame(const math::rect& frame) -> void;
         lua_setter(sceneScalingFactor, Available_0_9) auto set_scene_scaling_factor(double factor) -> void;
+        lua_setter(physicsThreadCount, Available_0_9) auto set_physics_thread_count(std::uint32_t count) -> void;
 
         lua_function(render, Available_0_8) auto on_render(const luabridge::LuaRef& block) -> void;
         lua_function(update, Available_0_8) auto on_update(const luabridge::LuaRef& block) -> void;
@@ -20,7 +20,7 @@
 
 #pragma once
 
-#include <string>
+#include <string_view>
 
 namespace lexer::condition
 {
@@ -42,7 +42,7 @@ namespace lexer::condition
          * @param __Chk     The string to test.
          * @return          The result of the test. True if the character matches against the noted character set.
          */
-        static auto contains(const std::string& __Chk) -> bool
+        static auto contains(std::string_view __Chk) -> bool
         {
             for (const auto __ch : __Chk) {
                 auto condition = (__ch >= '0' && __ch <= '9');
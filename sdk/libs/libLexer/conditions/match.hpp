@@ -20,7 +20,7 @@
 
 #pragma once
 
-#include <string>
+#include <string_view>
 
 namespace lexer::condition
 {
@@ -36,9 +36,9 @@ namespace lexer::condition
          * @param __Chk     The string to check. It should be just one character long.
          * @return          The result of the test. True if the string equals the character.
          */
-        static auto yes(const std::string& __Chk) -> bool
+        static auto yes(std::string_view __Chk) -> bool
         {
-            return __Chk == std::string(1, c);
+            return __Chk.size() == 1 && __Chk.front() == c;
         }
 
         /**
@@ -46,7 +46,7 @@ namespace lexer::condition
          * @param __Chk     The string to check. It should be just one character long.
          * @return          The result of the test. True if the string does not equal the character.
          */
-        static auto no(const std::string& __Chk) -> bool
+        static auto no(std::string_view __Chk) -> bool
         {
             return !yes(__Chk);
         }
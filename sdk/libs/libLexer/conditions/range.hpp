@@ -20,9 +20,9 @@
 
 #pragma once
 
-#include <string>
+#include <string_view>
 
-namespace kdl::lexer::condition
+namespace lexer::condition
 {
     /**
      * Template condition for the lexer. Checks to see if a character is in the range specified between lc and uc.
@@ -38,7 +38,7 @@ namespace kdl::lexer::condition
          * @param __Chk     The character to check.
          * @return          The result of the test. True if the character falls between the lower and upper bounds.
          */
-        static auto contains(const std::string& __Chk) -> bool
+        static auto contains(std::string_view __Chk) -> bool
         {
             for (const auto __ch : __Chk) {
                 if (__ch < lc || __ch > uc) {
@@ -54,7 +54,7 @@ namespace kdl::lexer::condition
          * @param __Chk     The character to check.
          * @return          The result of the test. True if the character falls outside of the lower and upper bounds.
          */
-        static auto not_contains(const std::string& __Chk) -> bool
+        static auto not_contains(std::string_view __Chk) -> bool
         {
             return !contains(__Chk);
         }
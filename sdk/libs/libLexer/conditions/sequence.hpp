@@ -20,8 +20,7 @@
 
 #pragma once
 
-#include <string>
-#include <vector>
+#include <string_view>
 
 namespace lexer::condition
 {
@@ -39,10 +38,13 @@ namespace lexer::condition
          * @return          The result of the test. True if the string contains the same sequence of characters as the
          *                  condition.
          */
-        static auto yes(const std::string& __Chk) -> bool
+        static auto yes(std::string_view __Chk) -> bool
         {
-            std::vector<char> v = { tC, ttC... };
-            for (auto i = 0; i < v.size(); ++i) {
+            constexpr char v[] = { tC, ttC... };
+            if (__Chk.size() < sizeof(v)) {
+                return false;
+            }
+            for (std::size_t i = 0; i < sizeof(v); ++i) {
                 if (__Chk[i] != v[i]) {
                     return false;
                 }
@@ -57,7 +59,7 @@ namespace lexer::condition
          * @return          The result of the test. True if the string does not contain the same sequence of characters
          *                  as the condition.
          */
-        static auto no(const std::string& __Chk) -> bool
+        static auto no(std::string_view __Chk) -> bool
         {
             return !yes(__Chk);
         }
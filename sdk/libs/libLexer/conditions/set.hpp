@@ -20,8 +20,7 @@
 
 #pragma once
 
-#include <string>
-#include <vector>
+#include <string_view>
 
 namespace lexer::condition
 {
@@ -38,11 +37,10 @@ namespace lexer::condition
          * @param __Chk     The character to test.
          * @return          The result of the test. True if the defined list of characters contains __Chk.
          */
-        static auto contains(const std::string& __Chk) -> bool
+        static auto contains(std::string_view __Chk) -> bool
         {
-            std::vector<char> v = { tC, ttC... };
             for (const auto __ch : __Chk) {
-                if (std::find(v.begin(), v.end(), __ch) == v.end()) {
+                if (!((__ch == tC) || ... || (__ch == ttC))) {
                     return false;
                 }
             }
@@ -54,7 +52,7 @@ namespace lexer::condition
          * @param __Chk     The character to test.
          * @return          The result of the test. True if the defined list of characters does not contain __Chk.
          */
-        static auto not_contains(const std::string& __Chk) -> bool
+        static auto not_contains(std::string_view __Chk) -> bool
         {
             return !contains(__Chk);
         }
@@ -33,7 +33,7 @@ namespace lexer
             : m_reason(std::move(reason)), m_lexeme(0)
         {}
 
-        exception(std::string reason, lexeme lx)
+        exception(std::string reason, ::lexer::lexeme lx)
             : m_reason(std::move(reason)), m_lexeme(std::move(lx))
         {};
 
@@ -42,13 +42,13 @@ namespace lexer
             return m_reason;
         }
 
-        [[nodiscard]] auto lexeme() const -> lexeme
+        [[nodiscard]] auto lexeme() const -> ::lexer::lexeme
         {
             return m_lexeme;
         }
 
     private:
         std::string m_reason;
-        struct lexeme m_lexeme;
+        ::lexer::lexeme m_lexeme;
     };
 }
\ No newline at end of file
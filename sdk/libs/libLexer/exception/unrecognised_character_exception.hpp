@@ -29,16 +29,16 @@ namespace lexer
     class unrecognised_character_exception : public std::exception
     {
     public:
-        explicit unrecognised_character_exception(lexeme lx)
+        explicit unrecognised_character_exception(::lexer::lexeme lx)
             : m_lexeme(std::move(lx))
         {};
 
-        [[nodiscard]] auto lexeme() const -> lexeme
+        [[nodiscard]] auto lexeme() const -> ::lexer::lexeme
         {
             return m_lexeme;
         }
 
     private:
-        struct lexeme m_lexeme;
+        ::lexer::lexeme m_lexeme;
     };
 }
\ No newline at end of file
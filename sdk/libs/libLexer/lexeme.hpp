@@ -22,11 +22,13 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 
 #include <libFoundation/system/filesystem/file.hpp>
 #include <libLexer/lexeme_type.hpp>
+#include <libLexer/symbol_table.hpp>
 
 namespace lexer
 {
@@ -34,22 +36,33 @@ namespace lexer
      * The lexer::lexeme structure represents a single token/lexeme within a source file. It has
      * the source text value, the position of it within the file, and the owning file from which it
      * came.
+     *
+     * Lexemes produced by the lexer do not copy their text. Identifiers, keywords and symbols are
+     * interned in the shared symbol table, and all other lexemes are views onto the contents of the
+     * source file, which they keep alive. Copying a lexeme never copies its text.
      */
     struct lexeme
     {
     public:
+        /**
+         * Constructs an empty lexeme, with no text and no source location.
+         */
+        lexeme()
+            : m_pos(0), m_offset(0), m_line(0), m_type(any)
+        {}
+
         /**
          * Constructs a new lexeme.
          * @param text The source text value from which this lexeme is being created.
          * @param type The lexical type that the token is
          */
-        lexeme(const std::string& text, enum lexeme_type type)
-            : m_text(text), m_type(type), m_owner({}), m_pos(0), m_offset(0), m_line(0)
+        lexeme(std::string_view text, enum lexeme_type type)
+            : lexeme(std::make_shared<const std::string>(text), type, 0, 0, 0, {})
         {
         }
 
         explicit lexeme(std::int64_t value)
-            : m_text(std::to_string(value)), m_type(integer), m_pos(0), m_offset(0), m_line(0), m_owner({})
+            : lexeme(std::make_shared<const std::string>(std::to_string(value)), integer, 0, 0, 0, {})
         {}
 
         /**
@@ -61,9 +74,38 @@ namespace lexer
          * @param line The line that the token was found.
          * @param owner The file from which the token originated.
          */
-        lexeme(const std::string& text, enum lexeme_type type, std::size_t pos, std::size_t offset, std::size_t line, std::weak_ptr<foundation::filesystem::file> owner)
-            : m_text(std::move(text)), m_type(type), m_pos(pos), m_offset(offset), m_line(line), m_owner(owner)
+        lexeme(std::string_view text, enum lexeme_type type, std::size_t pos, std::size_t offset, std::size_t line, std::weak_ptr<foundation::filesystem::file> owner)
+            : lexeme(std::make_shared<const std::string>(text), type, pos, offset, line, std::move(owner))
+        {
+        }
+
+        /**
+         * Constructs a new lexeme whose text is a view onto the contents of the file it originated
+         * from. The lexeme retains the file so that the view remains valid.
+         * @param text A view onto the contents of the owning file.
+         * @param type The lexical type that the token is
+         * @param pos The absolute position of the token within the source file.
+         * @param offset The position of the token upon the current line.
+         * @param line The line that the token was found.
+         * @param owner The file from which the token originated.
+         */
+        static auto source(std::string_view text, enum lexeme_type type, std::size_t pos, std::size_t offset, std::size_t line, const std::shared_ptr<foundation::filesystem::file>& owner) -> lexeme
+        {
+            return { text, owner, owner, type, pos, offset, line };
+        }
+
+        /**
+         * Constructs a new lexeme whose text is interned in the shared symbol table.
+         * @param text The text of the symbol.
+         * @param type The lexical type that the token is
+         * @param pos The absolute position of the token within the source file.
+         * @param offset The position of the token upon the current line.
+         * @param line The line that the token was found.
+         * @param owner The file from which the token originated.
+         */
+        static auto symbol(std::string_view text, enum lexeme_type type, std::size_t pos, std::size_t offset, std::size_t line, std::weak_ptr<foundation::filesystem::file> owner) -> lexeme
         {
+            return { symbol_table::shared_table().intern(text), nullptr, std::move(owner), type, pos, offset, line };
         }
 
         /**
@@ -101,7 +143,9 @@ namespace lexer
 
         [[nodiscard]] auto is(const lexeme& lx) const -> bool
         {
-            return (lx.m_text == m_text) && (lx.m_type == m_type);
+            // Interned text can be compared by address before falling back to the characters.
+            auto same_text = (lx.m_text.data() == m_text.data() && lx.m_text.size() == m_text.size()) || (lx.m_text == m_text);
+            return same_text && (lx.m_type == m_type);
         }
 
         /**
@@ -188,6 +232,15 @@ namespace lexer
          * @return A string
          */
         [[nodiscard]] auto text() const -> std::string
+        {
+            return std::string(m_text);
+        }
+
+        /**
+         * The textual value of the lexeme, without copying it.
+         * @return A view that remains valid for as long as the lexeme, or any copy of it, exists.
+         */
+        [[nodiscard]] auto view() const -> std::string_view
         {
             return m_text;
         }
@@ -228,25 +281,36 @@ namespace lexer
             }
             else if (m_text.size() >= 2 && m_text[0] == '-') {
                // Negative decimal
-               return static_cast<T>(std::stoll(m_text, nullptr, 10));
+               return static_cast<T>(std::stoll(std::string(m_text), nullptr, 10));
             }
             else if (m_text.size() >= 3 && (m_text.substr(0, 2) == "0x" || m_text.substr(0, 2) == "0X")) {
                // Hex
-               return static_cast<T>(std::stoull(m_text.substr(2), nullptr, 16));
+               return static_cast<T>(std::stoull(std::string(m_text.substr(2)), nullptr, 16));
             }
             else {
                // Decimal
-               return static_cast<T>(std::stoull(m_text, nullptr, 10));
+               return static_cast<T>(std::stoull(std::string(m_text), nullptr, 10));
             }
         }
 
+    private:
+        lexeme(std::string_view text, std::shared_ptr<const void> storage, std::weak_ptr<foundation::filesystem::file> owner, enum lexeme_type type, std::size_t pos, std::size_t offset, std::size_t line)
+            : m_owner(std::move(owner)), m_storage(std::move(storage)), m_text(text), m_pos(pos), m_offset(offset), m_line(line), m_type(type)
+        {
+        }
+
+        lexeme(const std::shared_ptr<const std::string>& text, enum lexeme_type type, std::size_t pos, std::size_t offset, std::size_t line, std::weak_ptr<foundation::filesystem::file> owner)
+            : lexeme(*text, text, std::move(owner), type, pos, offset, line)
+        {
+        }
+
     private:
         std::weak_ptr<foundation::filesystem::file> m_owner;
-        std::string m_text;
+        std::shared_ptr<const void> m_storage;
+        std::string_view m_text;
         std::size_t m_pos;
         std::size_t m_offset;
         std::size_t m_line;
-        std::string m_documentation;
         enum lexeme_type m_type;
     };
 };
\ No newline at end of file
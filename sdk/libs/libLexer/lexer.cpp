@@ -34,12 +34,12 @@
 // MARK: - Constructor
 
 lexer::lexer::lexer(const std::shared_ptr<foundation::filesystem::file>& source)
-    : m_source(source)
+    : m_source(source), m_contents(source->contents())
 {
 }
 
 lexer::lexer::lexer(const std::string& str)
-    : m_source(std::make_shared<foundation::filesystem::file>("", str))
+    : m_source(std::make_shared<foundation::filesystem::file>("", str)), m_contents(m_source->contents())
 {
 }
 
@@ -54,16 +54,26 @@ auto lexer::lexer::set_comment_style(enum comment_style style) -> void
 
 auto lexer::lexer::add_keyword(const std::string &keyword) -> void
 {
-    m_keywords.insert(keyword);
+    m_keywords.insert(symbol_table::shared_table().intern(keyword));
 }
 
 // MARK: - Lexical Analysis
 
 auto lexer::lexer::analyze() -> lexical_result
 {
-    if (!m_lexemes.empty()) {
-        return lexical_result(m_lexemes);
-    }
+    std::vector<lexeme> lexemes;
+    m_pos = 0;
+    m_offset = 0;
+    m_line = 1;
+
+    // Identifiers, keywords and symbols are interned, whilst literals and documentation reference
+    // the source directly. Neither copies the text of the lexeme.
+    auto symbol = [&] (std::string_view text, enum lexeme_type type) {
+        lexemes.emplace_back(lexeme::symbol(text, type, m_pos, m_offset, m_line, m_source));
+    };
+    auto source = [&] (std::string_view text, enum lexeme_type type) {
+        lexemes.emplace_back(lexeme::source(text, type, m_pos, m_offset, m_line, m_source));
+    };
 
     // Loop through the source code as long as there are characters available to consume.
     while (available()) {
@@ -88,7 +98,7 @@ auto lexer::lexer::analyze() -> lexical_result
         if (test_if(condition::sequence<'/', '/', '/'>::yes, 0, 3) && m_comment_style == comment_style::CXX) {
             // Documentation comment
             consume_while(condition::match<'\n'>::no);
-            m_lexemes.emplace_back(m_slice, lexeme_type::documentation, m_pos, m_offset, m_line, m_source);
+            source(m_slice, lexeme_type::documentation);
             continue;
         }
         else if (test_if(condition::sequence<'/', '/'>::yes, 0, 2) && m_comment_style == comment_style::CXX) {
@@ -98,7 +108,7 @@ auto lexer::lexer::analyze() -> lexical_result
         else if (test_if(condition::sequence<'-', '-', '-'>::yes, 0, 3) && m_comment_style == comment_style::LUA) {
             // Documentation comment
             consume_while(condition::match<'\n'>::no);
-            m_lexemes.emplace_back(m_slice, lexeme_type::documentation, m_pos, m_offset, m_line, m_source);
+            source(m_slice, lexeme_type::documentation);
             continue;
         }
         else if (test_if(condition::sequence<'-', '-'>::yes, 0, 2) && m_comment_style == comment_style::LUA) {
@@ -112,7 +122,7 @@ auto lexer::lexer::analyze() -> lexical_result
             // The string continues until a corresponding '"' is found.
             advance();
             consume_while(condition::match<'"'>::no);
-            m_lexemes.emplace_back(m_slice, lexeme_type::string, m_pos, m_offset, m_line, m_source);
+            source(m_slice, lexeme_type::string);
             advance();
         }
         else if (test_if(condition::match<'\''>::yes)) {
@@ -120,130 +130,126 @@ auto lexer::lexer::analyze() -> lexical_result
             // The string continues until a corresponding ' is found.
             advance();
             consume_while(condition::match<'\''>::no);
-            m_lexemes.emplace_back(m_slice, lexeme_type::string, m_pos, m_offset, m_line, m_source);
+            source(m_slice, lexeme_type::string);
             advance();
         }
         else if (test_if(condition::match<'0'>::yes) && test_if(condition::set<'x', 'X'>::contains, 1)) {
-            // We're looking at a hexadecimal number
+            // We're looking at a hexadecimal number. The prefix is normalised to a lowercase 'x', which only
+            // requires a copy of the text when the source uses an uppercase one.
+            auto start = m_pos;
             advance(2);
             consume_while(condition::hexadecimal_set::contains);
-            m_lexemes.emplace_back("0x" + m_slice, lexeme_type::integer, m_pos, m_offset, m_line, m_source);
+            auto number_text = m_contents.substr(start, m_pos - start);
+            if (number_text[1] == 'x') {
+                source(number_text, lexeme_type::integer);
+            }
+            else {
+                lexemes.emplace_back("0x" + std::string(m_slice), lexeme_type::integer, m_pos, m_offset, m_line, m_source);
+            }
         }
         else if (test_if(condition::decimal_set::contains) || (test_if(condition::match<'-'>::yes) && test_if(condition::decimal_set::contains, 1))) {
             // We're looking at a number
-            auto negative = test_if(condition::match<'-'>::yes);
-            if (negative) {
+            auto start = m_pos;
+            if (test_if(condition::match<'-'>::yes)) {
                 advance();
             }
 
             consume_while(condition::decimal_set::contains);
-            auto number_text = m_slice;
-            if (negative) {
-                number_text.insert(0, 1, '-');
-            }
-
-            m_lexemes.emplace_back(number_text, lexeme_type::integer, m_pos, m_offset, m_line, m_source);
+            source(m_contents.substr(start, m_pos - start), lexeme_type::integer);
         }
         else if (test_if(condition::identifier_set::limited_contains)) {
             consume_while(condition::identifier_set::contains);
 
-            if (m_keywords.contains(m_slice)) {
-                m_lexemes.emplace_back(m_slice, lexeme_type::keyword, m_pos, m_offset, m_line, m_source);
-            }
-            else {
-                // Check if we have a documentation comment to attach to the identifier.
-                lexeme lx(m_slice, lexeme_type::identifier, m_pos, m_offset, m_line, m_source);
-                m_lexemes.emplace_back(std::move(lx));
-            }
+            symbol(m_slice, m_keywords.contains(m_slice) ? lexeme_type::keyword : lexeme_type::identifier);
         }
 
         // Symbols
         else if (test_if(condition::match<';'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::semi, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::semi);
         }
         else if (test_if(condition::match<'{'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::l_brace, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::l_brace);
         }
         else if (test_if(condition::match<'}'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::r_brace, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::r_brace);
         }
         else if (test_if(condition::match<'['>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::l_bracket, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::l_bracket);
         }
         else if (test_if(condition::match<']'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::r_bracket, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::r_bracket);
         }
         else if (test_if(condition::match<'('>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::l_paren, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::l_paren);
         }
         else if (test_if(condition::match<')'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::r_paren, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::r_paren);
         }
         else if (test_if(condition::sequence<'<', '<'>::yes, 0, 2)) {
-            m_lexemes.emplace_back(read(0, 2), lexeme_type::left_shift, m_pos, m_offset, m_line, m_source);
+            symbol(read(0, 2), lexeme_type::left_shift);
         }
         else if (test_if(condition::sequence<'>', '>'>::yes, 0, 2)) {
-            m_lexemes.emplace_back(read(0, 2), lexeme_type::right_shift, m_pos, m_offset, m_line, m_source);
+            symbol(read(0, 2), lexeme_type::right_shift);
         }
         else if (test_if(condition::match<'<'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::l_angle, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::l_angle);
         }
         else if (test_if(condition::match<'>'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::r_angle, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::r_angle);
         }
         else if (test_if(condition::match<'='>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::equals, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::equals);
         }
         else if (test_if(condition::match<'+'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::plus, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::plus);
         }
         else if (test_if(condition::match<'-'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::minus, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::minus);
         }
         else if (test_if(condition::match<'*'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::star, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::star);
         }
         else if (test_if(condition::match<'/'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::slash, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::slash);
         }
         else if (test_if(condition::match<'&'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::amp, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::amp);
         }
         else if (test_if(condition::match<'.'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::dot, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::dot);
         }
         else if (test_if(condition::match<','>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::comma, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::comma);
         }
         else if (test_if(condition::match<'|'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::pipe, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::pipe);
         }
         else if (test_if(condition::match<'^'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::carat, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::carat);
         }
         else if (test_if(condition::match<':'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::colon, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::colon);
         }
         else if (test_if(condition::match<'!'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::exclaim, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::exclaim);
         }
         else if (test_if(condition::match<'@'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::at, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::at);
         }
         else if (test_if(condition::match<'#'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::hash, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::hash);
         }
         else if (test_if(condition::match<'?'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::question, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::question);
         }
         else if (test_if(condition::match<'%'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::percent, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::percent);
         }
         else if (test_if(condition::match<'~'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::tilde, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::tilde);
         }
         else if (test_if(condition::match<'$'>::yes)) {
-            m_lexemes.emplace_back(read(), lexeme_type::dollar, m_pos, m_offset, m_line, m_source);
+            symbol(read(), lexeme_type::dollar);
         }
 
         // Unrecognised character encountered
@@ -252,7 +258,7 @@ auto lexer::lexer::analyze() -> lexical_result
         }
     }
 
-    return lexical_result(m_lexemes);
+    return lexical_result(std::move(lexemes));
 }
 
 // MARK: - Private Lexer
@@ -264,7 +270,7 @@ auto lexer::lexer::dummy(long offset) const -> lexeme
 
 auto lexer::lexer::length() const -> std::size_t
 {
-    return m_source->string_contents().size();
+    return m_contents.size();
 }
 
 auto lexer::lexer::advance(long offset) -> void
@@ -280,31 +286,32 @@ auto lexer::lexer::available(long offset, std::size_t length) const -> bool
     return (end <= this->length());
 }
 
-auto lexer::lexer::peek(long offset, std::size_t length) const -> std::string
+auto lexer::lexer::peek(long offset, std::size_t length) const -> std::string_view
 {
     if (!available(offset, length)) {
         throw exception("Failed to peek " + std::to_string(length) + " characters from source.", dummy(offset));
     }
-    return m_source->string_contents().substr(m_pos + offset, length);
+    return m_contents.substr(m_pos + offset, length);
 }
 
-auto lexer::lexer::read(long offset, std::size_t length) -> std::string
+auto lexer::lexer::read(long offset, std::size_t length) -> std::string_view
 {
     auto str = peek(offset, length);
     advance(offset + std::int32_t(length));
     return str;
 }
 
-auto lexer::lexer::test_if(const std::function<auto(const std::string&) -> bool>& fn, long offset, std::size_t length) const -> bool
+auto lexer::lexer::test_if(condition_function fn, long offset, std::size_t length) const -> bool
 {
     return available(offset, length) && fn(peek(offset, length));
 }
 
-auto lexer::lexer::consume_while(const std::function<auto(const std::string&) -> bool>& fn, std::size_t size) -> bool
+auto lexer::lexer::consume_while(condition_function fn, std::size_t size) -> bool
 {
-    m_slice.clear();
+    auto start = m_pos;
     while (available(0, size) && fn(peek(0, size))) {
-        m_slice += read(0, size);
+        advance(static_cast<long>(size));
     }
+    m_slice = m_contents.substr(start, m_pos - start);
     return !m_slice.empty();
 }
@@ -22,9 +22,9 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <type_traits>
-#include <functional>
 #include <unordered_set>
 
 #include <libFoundation/system/filesystem/file.hpp>
@@ -38,6 +38,7 @@ namespace lexer
     {
     public:
         typedef foundation::stream<lexeme> lexical_result;
+        typedef auto(*condition_function)(std::string_view) -> bool;
 
         enum class comment_style { none, LUA, CXX };
 
@@ -54,19 +55,20 @@ namespace lexer
         auto set_comment_style(enum comment_style style) -> void;
 
         /**
-         * Perform lexical analysis on the source file.
+         * Perform lexical analysis on the source file. The lexer does not retain the lexemes that it
+         * produces, they are moved directly into the result.
          * @return A vector of lexemes that were the result of lexical analysis.
          */
         auto analyze() -> lexical_result;
 
     private:
         std::shared_ptr<foundation::filesystem::file> m_source;
+        std::string_view m_contents;
         std::size_t m_line { 1 };
         std::size_t m_offset { 0 };
         std::size_t m_pos { 0 };
-        std::string m_slice;
-        std::vector<lexeme> m_lexemes;
-        std::unordered_set<std::string> m_keywords;
+        std::string_view m_slice;
+        std::unordered_set<std::string_view> m_keywords;
         enum comment_style m_comment_style { comment_style::CXX };
 
         /**
@@ -99,17 +101,17 @@ namespace lexer
          * Peek a string from the source without advancing the current position.
          * @param offset The offset from the current position.
          * @param length The number of characters required.
-         * @return A string.
+         * @return A view onto the source.
          */
-        [[nodiscard]] auto peek(long offset = 0, std::size_t length = 1) const -> std::string;
+        [[nodiscard]] auto peek(long offset = 0, std::size_t length = 1) const -> std::string_view;
 
         /**
          * Read a string from the source advancing the current position, to the end of the read string.
          * @param offset The offset from the current position.
          * @param length The number of characters required.
-         * @return A string.
+         * @return A view onto the source.
          */
-        auto read(long offset = 0, std::size_t length = 1) -> std::string;
+        auto read(long offset = 0, std::size_t length = 1) -> std::string_view;
 
         /**
          * Test if the specified string from the source, is validated by the provided test function.
@@ -118,14 +120,15 @@ namespace lexer
          * @param length The number of characters required.
          * @return true if the string was validated.
          */
-        auto test_if(const std::function<auto(const std::string&) -> bool>& fn, long offset = 0, std::size_t length = 1) const -> bool;
+        auto test_if(condition_function fn, long offset = 0, std::size_t length = 1) const -> bool;
 
         /**
          * Consume characters from the source, whilst those characters are validated by the test function.
+         * The consumed characters are available as a view onto the source in m_slice.
          * @param fn Test function to validate each character.
          * @return true if any characters were matched.
          */
-        auto consume_while(const std::function<auto(const std::string&) -> bool>& fn, std::size_t size = 1) -> bool;
+        auto consume_while(condition_function fn, std::size_t size = 1) -> bool;
     };
 
 };
@@ -0,0 +1,53 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <mutex>
+#include <libLexer/symbol_table.hpp>
+
+// MARK: - Construction
+
+auto lexer::symbol_table::shared_table() -> symbol_table&
+{
+    static symbol_table table;
+    return table;
+}
+
+// MARK: - Interning
+
+auto lexer::symbol_table::intern(std::string_view text) -> std::string_view
+{
+    {
+        std::shared_lock lock(m_lock);
+        if (auto it = m_symbols.find(text); it != m_symbols.end()) {
+            return *it;
+        }
+    }
+
+    // Symbols are stored in the nodes of the set, which are never relocated, so the
+    // returned view remains valid as further symbols are added.
+    std::unique_lock lock(m_lock);
+    return *m_symbols.emplace(text).first;
+}
+
+auto lexer::symbol_table::size() const -> std::size_t
+{
+    std::shared_lock lock(m_lock);
+    return m_symbols.size();
+}
@@ -0,0 +1,66 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <shared_mutex>
+#include <functional>
+#include <unordered_set>
+
+namespace lexer
+{
+    /**
+     * The lexer::symbol_table interns identifier and keyword text. Every lexeme that refers to
+     * the same symbol shares a single copy of its text, which lives for the remainder of the
+     * process. This allows identifier lexemes to be copied without allocating and compared by
+     * address.
+     */
+    class symbol_table
+    {
+    public:
+        static auto shared_table() -> symbol_table&;
+
+        /**
+         * Intern the specified text, returning a view onto the table's copy of it.
+         * @param text The text to intern.
+         * @return A view that remains valid for the lifetime of the table.
+         */
+        auto intern(std::string_view text) -> std::string_view;
+
+        /**
+         * The number of unique symbols that have been interned.
+         */
+        [[nodiscard]] auto size() const -> std::size_t;
+
+    private:
+        struct hash
+        {
+            using is_transparent = void;
+            auto operator()(std::string_view text) const -> std::size_t { return std::hash<std::string_view>()(text); }
+        };
+
+        symbol_table() = default;
+
+        mutable std::shared_mutex m_lock;
+        std::unordered_set<std::string, hash, std::equal_to<>> m_symbols;
+    };
+}
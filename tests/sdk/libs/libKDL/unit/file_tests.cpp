@@ -0,0 +1,124 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <random>
+#include <iterator>
+#include <fstream>
+#include <filesystem>
+#include <libTesting/testing.hpp>
+#include <libKDL/unit/file.hpp>
+#include <libResourceCore/file.hpp>
+
+// MARK: - Helpers
+
+namespace
+{
+    constexpr std::size_t project_file_count = 200;
+
+    /**
+     * A synthetic project of one type definition followed by the specified number of files, each
+     * declaring a single resource. The project is written to a unique temporary directory, which is
+     * removed when the project is destroyed.
+     */
+    struct synthetic_project
+    {
+        explicit synthetic_project(std::size_t file_count)
+            : root(std::filesystem::temp_directory_path() / ("kdl_unit_file_tests_" + std::to_string(std::random_device()())))
+        {
+            std::filesystem::create_directories(root);
+            paths.reserve(file_count + 1);
+
+            auto type_path = root / "counter.kdl";
+            std::ofstream(type_path)
+                << "type Counter : \"cntr\" {\n"
+                << "    template {\n"
+                << "        HWRD Value;\n"
+                << "    };\n"
+                << "    @synthesize field(\"Value\");\n"
+                << "};\n";
+            paths.emplace_back(type_path.string());
+
+            for (std::size_t n = 0; n < file_count; ++n) {
+                auto path = root / ("resource_" + std::to_string(n) + ".kdl");
+                std::ofstream(path)
+                    << "declare Counter {\n"
+                    << "    new(#" << (128 + n) << ", \"Counter " << n << "\") {\n"
+                    << "        Value = " << n << ";\n"
+                    << "    };\n"
+                    << "};\n";
+                paths.emplace_back(path.string());
+            }
+        }
+
+        ~synthetic_project()
+        {
+            std::error_code error;
+            std::filesystem::remove_all(root, error);
+        }
+
+        std::filesystem::path root;
+        std::vector<std::string> paths;
+    };
+
+    auto resource_count(resource_core::file& output) -> std::size_t
+    {
+        std::size_t count = 0;
+        for (const auto& type_hash : output.types()) {
+            const auto& type = const_cast<struct resource_core::type *>(output.type(type_hash));
+            count += std::distance(type->begin(), type->end());
+        }
+        return count;
+    }
+}
+
+// MARK: - Tests
+
+TEST(kdl_unitFile_importingManyFiles_emitsEachResourceOnce)
+{
+    synthetic_project project(project_file_count);
+
+    resource_core::file output;
+    kdl::sema::context context;
+    kdl::unit::file session(output, context, false);
+
+    for (const auto& path : project.paths) {
+        session.import_file(path, {});
+    }
+
+    test::equal(context.resources.size(), project_file_count);
+    test::equal(resource_count(output), project_file_count);
+}
+
+TEST(kdl_unitFile_importingManyFiles_benchmark)
+{
+    synthetic_project project(project_file_count);
+
+    resource_core::file output;
+    kdl::sema::context context;
+    kdl::unit::file session(output, context, false);
+
+    test::measure([&] {
+        for (const auto& path : project.paths) {
+            session.import_file(path, {});
+        }
+    });
+
+    test::equal(resource_count(output), project_file_count);
+}
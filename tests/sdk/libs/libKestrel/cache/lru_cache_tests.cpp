@@ -0,0 +1,142 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <string>
+#include <libTesting/testing.hpp>
+#include <libKestrel/cache/lru_cache.hpp>
+
+using namespace kestrel;
+
+// MARK: - Helpers
+
+namespace
+{
+    typedef cache::lru_cache<std::string, int> string_cache;
+
+    auto now() -> rtc::clock::time
+    {
+        return rtc::clock::time(std::chrono::seconds(1000));
+    }
+
+    /**
+     * Every key shares a single hash, so that lookups have to be resolved by equality.
+     */
+    struct colliding_hash
+    {
+        auto operator()(const std::string&) const -> std::size_t
+        {
+            return 0;
+        }
+    };
+}
+
+// MARK: - Lookup
+
+TEST(lru_cache_fetch_returnsInsertedValueAndCountsHitsAndMisses)
+{
+    string_cache cache(1024);
+    cache.insert("a", 1, 8, now());
+    cache.insert("b", 2, 8, now());
+
+    auto a = cache.fetch("a", now());
+    test::is_true(a != nullptr);
+    test::equal(*a, 1);
+    test::is_true(cache.fetch("c", now()) == nullptr);
+
+    auto stats = cache.stats();
+    test::equal(stats.hits, std::uint64_t(1));
+    test::equal(stats.misses, std::uint64_t(1));
+    test::equal(stats.entries, std::size_t(2));
+    test::equal(stats.bytes, std::size_t(16));
+    test::equal(stats.hit_rate(), 0.5);
+}
+
+TEST(lru_cache_insert_existingKeyReplacesValueAndCost)
+{
+    string_cache cache(1024);
+    cache.insert("a", 1, 8, now());
+    cache.insert("a", 2, 32, now());
+
+    test::equal(cache.size(), std::size_t(1));
+    test::equal(cache.bytes(), std::size_t(32));
+    test::equal(*cache.fetch("a", now()), 2);
+}
+
+TEST(lru_cache_fetch_resolvesCollidingHashesByEquality)
+{
+    cache::lru_cache<std::string, int, colliding_hash> cache(1024);
+    cache.insert("a", 1, 1, now());
+    cache.insert("b", 2, 1, now());
+    cache.insert("c", 3, 1, now());
+
+    test::equal(*cache.fetch("a", now()), 1);
+    test::equal(*cache.fetch("b", now()), 2);
+    test::equal(*cache.fetch("c", now()), 3);
+}
+
+// MARK: - Eviction
+
+TEST(lru_cache_insert_overBudgetEvictsLeastRecentlyUsed)
+{
+    string_cache cache(24);
+    cache.insert("a", 1, 8, now());
+    cache.insert("b", 2, 8, now());
+    cache.insert("c", 3, 8, now());
+
+    // Touch "a" so that "b" becomes the least recently used entry.
+    cache.fetch("a", now());
+    cache.insert("d", 4, 8, now());
+
+    test::is_true(cache.fetch("a", now()) != nullptr);
+    test::is_true(cache.fetch("b", now()) == nullptr);
+    test::is_true(cache.fetch("c", now()) != nullptr);
+    test::is_true(cache.fetch("d", now()) != nullptr);
+
+    auto stats = cache.stats();
+    test::equal(stats.evictions, std::uint64_t(1));
+    test::equal(stats.evicted_bytes, std::uint64_t(8));
+    test::equal(stats.bytes, std::size_t(24));
+}
+
+TEST(lru_cache_setBudget_evictsDownToNewBudget)
+{
+    string_cache cache(1024);
+    cache.insert("a", 1, 100, now());
+    cache.insert("b", 2, 100, now());
+    cache.insert("c", 3, 100, now());
+
+    cache.set_budget(150);
+
+    test::equal(cache.size(), std::size_t(1));
+    test::is_true(cache.fetch("c", now()) != nullptr);
+}
+
+TEST(lru_cache_evictUnusedSince_removesOnlyStaleEntries)
+{
+    string_cache cache(1024);
+    cache.insert("old", 1, 8, now() - std::chrono::minutes(5));
+    cache.insert("new", 2, 8, now());
+
+    cache.evict_unused_since(now() - std::chrono::minutes(2));
+
+    test::equal(cache.size(), std::size_t(1));
+    test::is_true(cache.fetch("new", now()) != nullptr);
+    test::is_true(cache.fetch("old", now()) == nullptr);
+}
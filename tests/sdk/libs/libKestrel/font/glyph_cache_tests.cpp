@@ -0,0 +1,231 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <array>
+#include <string>
+#include <vector>
+#include <libTesting/testing.hpp>
+#include <libKestrel/font/glyph_cache.hpp>
+
+using namespace kestrel;
+
+// MARK: - Helpers
+
+namespace
+{
+    constexpr std::uint32_t glyph_width = 12;
+    constexpr std::uint32_t glyph_rows = 16;
+    constexpr std::size_t paragraph_length = 10'000;
+    constexpr std::uint32_t paragraph_width = 640;
+
+    struct raster
+    {
+        std::array<std::uint8_t, glyph_width * glyph_rows> coverage {};
+
+        [[nodiscard]] auto bitmap() const -> font::glyph_cache::bitmap
+        {
+            font::glyph_cache::bitmap bmp;
+            bmp.top = static_cast<std::int32_t>(glyph_rows);
+            bmp.width = glyph_width;
+            bmp.rows = glyph_rows;
+            bmp.pitch = static_cast<std::int32_t>(glyph_width);
+            bmp.coverage = coverage.data();
+            return bmp;
+        }
+    };
+
+    /**
+     * Stand in for FreeType, producing supersampled coverage of an ellipse whose size depends on the character.
+     */
+    auto rasterize(char c) -> raster
+    {
+        raster result;
+        const auto radius = 3.f + static_cast<float>(c % 4);
+        for (std::uint32_t y = 0; y < glyph_rows; ++y) {
+            for (std::uint32_t x = 0; x < glyph_width; ++x) {
+                auto samples = 0;
+                for (auto sy = 0; sy < 4; ++sy) {
+                    for (auto sx = 0; sx < 4; ++sx) {
+                        auto dx = (static_cast<float>(x) + (static_cast<float>(sx) + 0.5f) / 4.f) - (glyph_width / 2.f);
+                        auto dy = (static_cast<float>(y) + (static_cast<float>(sy) + 0.5f) / 4.f) - (glyph_rows / 2.f);
+                        samples += (dx * dx + dy * dy * 0.5f) <= radius * radius ? 1 : 0;
+                    }
+                }
+                result.coverage[(y * glyph_width) + x] = static_cast<std::uint8_t>(samples * 255 / 16);
+            }
+        }
+        return result;
+    }
+
+    auto paragraph() -> std::string
+    {
+        const std::string words = "the quick brown fox jumps over the lazy dog while kestrels hover above ";
+        std::string text;
+        while (text.size() < paragraph_length) {
+            text += words;
+        }
+        text.resize(paragraph_length);
+        return text;
+    }
+
+    auto blit(std::vector<std::uint32_t>& buffer, std::size_t index, const std::uint8_t *coverage, std::int32_t pitch) -> void
+    {
+        const auto columns = paragraph_width / glyph_width;
+        const auto x = static_cast<std::uint32_t>(index % columns) * glyph_width;
+        const auto y = static_cast<std::uint32_t>(index / columns) * glyph_rows;
+        for (std::uint32_t row = 0; row < glyph_rows; ++row) {
+            for (std::uint32_t column = 0; column < glyph_width; ++column) {
+                auto alpha = static_cast<std::uint32_t>(coverage[(row * pitch) + column]);
+                if (alpha) {
+                    buffer[((y + row) * paragraph_width) + x + column] = 0x00FFFFFFU | (alpha << 24U);
+                }
+            }
+        }
+    }
+
+    auto paragraph_buffer() -> std::vector<std::uint32_t>
+    {
+        const auto lines = (paragraph_length / (paragraph_width / glyph_width)) + 1;
+        return std::vector<std::uint32_t>(lines * glyph_rows * paragraph_width, 0);
+    }
+
+    auto glyph_key(char c) -> font::glyph_cache::key
+    {
+        font::glyph_cache::key key;
+        key.face = 1;
+        key.size = 11;
+        key.dpi = 100;
+        key.glyph = static_cast<std::uint32_t>(c);
+        return key;
+    }
+}
+
+// MARK: - Lookup
+
+TEST(glyph_cache_find_countsHitsAndMisses)
+{
+    font::glyph_cache cache;
+    auto a = rasterize('a');
+
+    test::is_true(cache.find(glyph_key('a')) == nullptr);
+    cache.insert(glyph_key('a'), a.bitmap());
+    test::is_true(cache.find(glyph_key('a')) != nullptr);
+    test::is_true(cache.find(glyph_key('b')) == nullptr);
+
+    auto stats = cache.stats();
+    test::equal(stats.hits, std::uint64_t(1));
+    test::equal(stats.misses, std::uint64_t(2));
+    test::equal(stats.entries, std::size_t(1));
+}
+
+TEST(glyph_cache_find_keysIncludeSizeAndResolution)
+{
+    font::glyph_cache cache;
+    auto a = rasterize('a');
+    cache.insert(glyph_key('a'), a.bitmap());
+
+    auto larger = glyph_key('a');
+    larger.size = 12;
+    auto sharper = glyph_key('a');
+    sharper.dpi = 200;
+
+    test::is_true(cache.find(larger) == nullptr);
+    test::is_true(cache.find(sharper) == nullptr);
+}
+
+TEST(glyph_cache_insert_copiesCoverageIntoAtlas)
+{
+    font::glyph_cache cache;
+    auto a = rasterize('a');
+    auto b = rasterize('b');
+    cache.insert(glyph_key('a'), a.bitmap());
+    auto glyph = cache.insert(glyph_key('b'), b.bitmap());
+
+    test::is_true(glyph != nullptr);
+    test::equal(glyph->width, glyph_width);
+    test::equal(glyph->rows, glyph_rows);
+
+    auto coverage = cache.coverage(*glyph);
+    auto matches = true;
+    for (std::uint32_t y = 0; y < glyph_rows; ++y) {
+        for (std::uint32_t x = 0; x < glyph_width; ++x) {
+            matches &= coverage[(y * cache.atlas_width()) + x] == b.coverage[(y * glyph_width) + x];
+        }
+    }
+    test::is_true(matches);
+}
+
+TEST(glyph_cache_insert_resetsAtlasWhenFull)
+{
+    font::glyph_cache cache(32, 32);
+    auto a = rasterize('a');
+
+    // Only two glyphs fit across and one down, so the third insertion starts a new atlas.
+    cache.insert(glyph_key('a'), a.bitmap());
+    cache.insert(glyph_key('b'), a.bitmap());
+    test::equal(cache.stats().atlas_resets, std::uint64_t(0));
+
+    cache.insert(glyph_key('c'), a.bitmap());
+    test::equal(cache.stats().atlas_resets, std::uint64_t(1));
+    test::equal(cache.stats().entries, std::size_t(1));
+    test::is_true(cache.find(glyph_key('a')) == nullptr);
+    test::is_true(cache.find(glyph_key('c')) != nullptr);
+}
+
+TEST(glyph_cache_insert_rejectsGlyphsLargerThanAtlas)
+{
+    font::glyph_cache cache(8, 8);
+    auto a = rasterize('a');
+    test::is_true(cache.insert(glyph_key('a'), a.bitmap()) == nullptr);
+    test::equal(cache.stats().entries, std::size_t(0));
+}
+
+// MARK: - Benchmarks
+
+TEST(glyph_cache_uncachedParagraph_benchmark)
+{
+    auto text = paragraph();
+    auto buffer = paragraph_buffer();
+    test::measure([&] {
+        for (std::size_t n = 0; n < text.size(); ++n) {
+            auto glyph = rasterize(text[n]);
+            blit(buffer, n, glyph.coverage.data(), static_cast<std::int32_t>(glyph_width));
+        }
+    });
+}
+
+TEST(glyph_cache_cachedParagraph_benchmark)
+{
+    font::glyph_cache cache;
+    auto text = paragraph();
+    auto buffer = paragraph_buffer();
+    test::measure([&] {
+        for (std::size_t n = 0; n < text.size(); ++n) {
+            auto key = glyph_key(text[n]);
+            auto glyph = cache.find(key);
+            if (!glyph) {
+                auto raster = rasterize(text[n]);
+                glyph = cache.insert(key, raster.bitmap());
+            }
+            blit(buffer, n, cache.coverage(*glyph), static_cast<std::int32_t>(cache.atlas_width()));
+        }
+    });
+    test::is_true(cache.stats().hit_rate() > 0.99);
+}
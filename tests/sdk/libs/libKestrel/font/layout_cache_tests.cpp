@@ -0,0 +1,99 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <libTesting/testing.hpp>
+#include <libKestrel/font/layout_cache.hpp>
+
+using namespace kestrel;
+
+// MARK: - Helpers
+
+namespace
+{
+    auto layout_key(const std::wstring& text) -> font::layout_key
+    {
+        font::layout_key key;
+        key.text = text;
+        key.face = 7;
+        key.size = 11;
+        key.dpi = 100;
+        key.max_width = 200;
+        key.max_height = 9999;
+        return key;
+    }
+
+    auto layout_run(const std::wstring& text) -> std::shared_ptr<font::layout_run>
+    {
+        auto run = std::make_shared<font::layout_run>();
+        run->key = layout_key(text);
+        for (auto n = 0; n < text.size(); ++n) {
+            run->characters.push_back({ text[n], false, false, n * 6.0, 0, 6.0 });
+        }
+        run->bounding_size = math::size(static_cast<float>(text.size() * 6), 16);
+        return run;
+    }
+}
+
+// MARK: - Keys
+
+TEST(layout_cache_key_sameSettingIgnoresText)
+{
+    auto a = layout_key(L"Hello");
+    auto b = layout_key(L"Hello, World");
+    test::is_false(a == b);
+    test::is_true(a.same_setting(b));
+
+    b.max_width = 100;
+    test::is_false(a.same_setting(b));
+}
+
+// MARK: - Lookup
+
+TEST(layout_cache_find_returnsRunForIdenticalTextAndSetting)
+{
+    font::layout_cache cache;
+    cache.insert(layout_run(L"Static label"));
+
+    auto run = cache.find(layout_key(L"Static label"));
+    test::is_true(run != nullptr);
+    test::equal(run->characters.size(), std::size_t(12));
+
+    auto resized = layout_key(L"Static label");
+    resized.size = 12;
+    test::is_true(cache.find(resized) == nullptr);
+    test::is_true(cache.find(layout_key(L"Static label!")) == nullptr);
+
+    test::equal(cache.stats().hits, std::uint64_t(1));
+    test::equal(cache.stats().misses, std::uint64_t(2));
+}
+
+TEST(layout_cache_insert_evictsLeastRecentlyUsedRunsOverBudget)
+{
+    auto first = layout_run(L"first");
+    font::layout_cache cache(first->estimated_memory_size() * 2);
+    cache.insert(first);
+    cache.insert(layout_run(L"other"));
+    cache.find(first->key);
+    cache.insert(layout_run(L"third"));
+
+    test::is_true(cache.find(first->key) != nullptr);
+    test::is_true(cache.find(layout_key(L"other")) == nullptr);
+    test::is_true(cache.find(layout_key(L"third")) != nullptr);
+}
@@ -0,0 +1,185 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <random>
+#include <vector>
+#include <libTesting/testing.hpp>
+#include <libKestrel/graphics/canvas/compositing.hpp>
+#include <libKestrel/graphics/canvas/rgba_buffer.hpp>
+
+using namespace kestrel;
+
+// MARK: - Helpers
+
+namespace
+{
+    using graphics::compositing::instruction_set;
+
+    constexpr std::size_t kernel_test_length = 1027;
+    constexpr float benchmark_dimension = 1024;
+    constexpr int benchmark_iterations = 20;
+
+    auto instruction_sets() -> std::vector<instruction_set>
+    {
+        std::vector<instruction_set> result;
+        for (auto isa : { instruction_set::scalar, instruction_set::sse41, instruction_set::avx2, instruction_set::neon }) {
+            if (graphics::compositing::supported(isa)) {
+                result.emplace_back(isa);
+            }
+        }
+        return result;
+    }
+
+    auto random_pixels(std::size_t count, std::uint32_t seed) -> std::vector<graphics::color::value>
+    {
+        std::mt19937 rng(seed);
+        std::vector<graphics::color::value> pixels(count);
+        for (auto& pixel : pixels) {
+            pixel = rng();
+        }
+        return pixels;
+    }
+
+    /**
+     * Measure the operation against a 1024x1024 buffer using the specified instruction set.
+     */
+    template<typename F>
+    auto measure_with(instruction_set isa, F&& f) -> void
+    {
+        const auto& previous = graphics::compositing::active();
+        test::is_true(graphics::compositing::select(isa));
+
+        graphics::rgba_buffer buffer({ benchmark_dimension, benchmark_dimension });
+        test::measure([&] {
+            for (auto n = 0; n < benchmark_iterations; ++n) {
+                f(buffer);
+            }
+        });
+        graphics::compositing::select(previous.isa);
+    }
+}
+
+// MARK: - Kernel Conformance
+
+TEST(compositing_blendColor_matchesScalarReference)
+{
+    auto source = random_pixels(kernel_test_length, 1);
+    for (auto isa : instruction_sets()) {
+        for (graphics::color::value c : { 0x00000000u, 0xFFFFFFFFu, 0x80402010u, 0x01FF00FFu }) {
+            // Offset by one pixel to ensure unaligned destinations are handled.
+            auto expected = source;
+            auto actual = source;
+            graphics::compositing::kernels_for(instruction_set::scalar).blend_color(expected.data() + 1, c, kernel_test_length - 1);
+            graphics::compositing::kernels_for(isa).blend_color(actual.data() + 1, c, kernel_test_length - 1);
+            test::is_true(expected == actual);
+        }
+    }
+}
+
+TEST(compositing_blendRun_matchesScalarReference)
+{
+    auto source = random_pixels(kernel_test_length, 2);
+    auto top = random_pixels(kernel_test_length, 3);
+    for (auto isa : instruction_sets()) {
+        auto expected = source;
+        auto actual = source;
+        graphics::compositing::kernels_for(instruction_set::scalar).blend_run(expected.data() + 1, top.data() + 2, kernel_test_length - 2);
+        graphics::compositing::kernels_for(isa).blend_run(actual.data() + 1, top.data() + 2, kernel_test_length - 2);
+        test::is_true(expected == actual);
+    }
+}
+
+TEST(compositing_fillCopyAndMask_matchScalarReference)
+{
+    auto source = random_pixels(kernel_test_length, 4);
+    auto mask = random_pixels(kernel_test_length, 5);
+    for (auto isa : instruction_sets()) {
+        const auto& scalar = graphics::compositing::kernels_for(instruction_set::scalar);
+        const auto& kernels = graphics::compositing::kernels_for(isa);
+
+        auto expected = source;
+        auto actual = source;
+        scalar.mask(expected.data() + 3, mask.data(), kernel_test_length - 3);
+        kernels.mask(actual.data() + 3, mask.data(), kernel_test_length - 3);
+        test::is_true(expected == actual);
+
+        scalar.fill(expected.data() + 1, 0xDEADBEEF, kernel_test_length - 2);
+        kernels.fill(actual.data() + 1, 0xDEADBEEF, kernel_test_length - 2);
+        test::is_true(expected == actual);
+
+        scalar.copy(expected.data(), mask.data() + 1, kernel_test_length - 1);
+        kernels.copy(actual.data(), mask.data() + 1, kernel_test_length - 1);
+        test::is_true(expected == actual);
+    }
+}
+
+TEST(compositing_select_rejectsUnsupportedInstructionSets)
+{
+    auto best = graphics::compositing::best_instruction_set();
+    test::is_true(graphics::compositing::supported(best));
+    test::is_true(graphics::compositing::active().isa == best);
+
+    for (auto isa : { instruction_set::sse41, instruction_set::avx2, instruction_set::neon }) {
+        if (!graphics::compositing::supported(isa)) {
+            test::is_false(graphics::compositing::select(isa));
+            test::is_true(graphics::compositing::kernels_for(isa).isa == instruction_set::scalar);
+        }
+    }
+    test::is_true(graphics::compositing::active().isa == best);
+}
+
+// MARK: - Benchmarks
+
+TEST(compositing_fillRect_benchmark)
+{
+    auto color = graphics::color(0x80FF4020);
+    for (auto isa : instruction_sets()) {
+        measure_with(isa, [&] (graphics::rgba_buffer& buffer) {
+            buffer.fill_rect(color, { 0, 0, benchmark_dimension, benchmark_dimension });
+        });
+    }
+}
+
+TEST(compositing_applyRun_benchmark)
+{
+    auto pixels = random_pixels(static_cast<std::size_t>(benchmark_dimension), 6);
+    std::vector<graphics::color> run;
+    for (auto pixel : pixels) {
+        run.emplace_back(pixel);
+    }
+
+    for (auto isa : instruction_sets()) {
+        measure_with(isa, [&] (graphics::rgba_buffer& buffer) {
+            for (std::uint64_t y = 0; y < static_cast<std::uint64_t>(benchmark_dimension); ++y) {
+                buffer.apply_run(run, 0, y);
+            }
+        });
+    }
+}
+
+TEST(compositing_applyMask_benchmark)
+{
+    graphics::rgba_buffer mask(random_pixels(static_cast<std::size_t>(benchmark_dimension * benchmark_dimension), 7), { benchmark_dimension, benchmark_dimension });
+    for (auto isa : instruction_sets()) {
+        measure_with(isa, [&] (graphics::rgba_buffer& buffer) {
+            buffer.apply_mask(mask);
+        });
+    }
+}
@@ -0,0 +1,184 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <array>
+#include <libTesting/testing.hpp>
+#include <libKestrel/graphics/renderer/common/draw_buffer.hpp>
+
+using namespace kestrel;
+
+// MARK: - Helpers
+
+namespace
+{
+    constexpr std::size_t draw_buffer_quad_count = 10'000;
+
+    /**
+     * The size of the vertex format before attachments were moved to their own stream. Each vertex carried a
+     * position, color, 8 attachments, texture coordinate, texture index and padding.
+     */
+    constexpr std::size_t legacy_vertex_size = (4 + 4 + 8 * 4 + 2 + 1 + 1) * sizeof(float);
+
+    auto push_quad(renderer::draw_buffer& buffer, float x, float y) -> void
+    {
+        buffer.push_quad(math::vec2(x, y), math::vec2(16, 16), math::rect(math::point(0), math::size(1)), 1.f, 0.f);
+    }
+
+    auto attachments(float value) -> std::array<math::vec4, renderer::attachments_per_quad>
+    {
+        std::array<math::vec4, renderer::attachments_per_quad> result;
+        result.fill(math::vec4(0, 0, 0, 0));
+        result[0] = math::vec4(value, value, value, value);
+        return result;
+    }
+}
+
+// MARK: - Vertex Format
+
+TEST(draw_buffer_vertexStream_isSmallerThanLegacyFormat)
+{
+    renderer::draw_buffer buffer(draw_buffer_quad_count * renderer::vertices_per_quad);
+    for (std::size_t n = 0; n < draw_buffer_quad_count; ++n) {
+        push_quad(buffer, static_cast<float>(n), 0);
+    }
+
+    // Quads were previously drawn as a list of 6 vertices.
+    const auto legacy_bytes = draw_buffer_quad_count * 6 * legacy_vertex_size;
+    test::equal(sizeof(renderer::vertex), std::size_t(24));
+    test::equal(buffer.data_size(), draw_buffer_quad_count * renderer::vertices_per_quad * sizeof(renderer::vertex));
+    test::is_true(buffer.data_size() * 10 < legacy_bytes);
+    test::is_false(buffer.has_attachments());
+}
+
+TEST(draw_buffer_pushQuad_indexedGeometryMatchesTriangleList)
+{
+    const math::vec2 p(10, 20);
+    const math::vec2 s(30, 40);
+    const math::rect uv(math::point(0.25, 0.5), math::size(0.25, 0.5));
+
+    renderer::draw_buffer buffer(renderer::vertices_per_quad * 4);
+    buffer.push_quad(p, s, uv, 0.5f, 2.f);
+    buffer.push_quad(p, s, uv, 0.5f, 2.f);
+
+    // The triangle list that was previously pushed for each quad.
+    const float triangles[6][4] = {
+        { 10, 60, 0.25, 1.0 },
+        { 40, 60, 0.50, 1.0 },
+        { 40, 20, 0.50, 0.5 },
+        { 10, 60, 0.25, 1.0 },
+        { 10, 20, 0.25, 0.5 },
+        { 40, 20, 0.50, 0.5 },
+    };
+
+    auto vertices = reinterpret_cast<const renderer::vertex *>(buffer.data());
+    auto indices = renderer::draw_buffer::quad_indices(buffer.quad_count());
+    test::equal(buffer.count(), 2 * renderer::vertices_per_quad);
+    test::equal(buffer.index_count(), indices.size());
+    test::equal(indices.size(), std::size_t(12));
+
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+        const auto& expected = triangles[i % 6];
+        const auto& v = vertices[indices[i]];
+        test::equal(indices[i] / renderer::vertices_per_quad, std::uint32_t(i / 6));
+        test::equal(v.position.x, expected[0]);
+        test::equal(v.position.y, expected[1]);
+        test::equal(v.tex_coord.x, expected[2]);
+        test::equal(v.tex_coord.y, expected[3]);
+        test::equal(v.texture, 2.f);
+        test::equal(v.color, renderer::pack_color(1, 1, 1, 0.5f));
+    }
+}
+
+TEST(draw_buffer_packColor_roundTripsComponents)
+{
+    auto color = renderer::pack_color(1.f, 0.f, 0.5f, 0.25f);
+    test::equal(color & 0xFF, std::uint32_t(255));
+    test::equal((color >> 8) & 0xFF, std::uint32_t(0));
+    test::equal((color >> 16) & 0xFF, std::uint32_t(128));
+    test::equal((color >> 24) & 0xFF, std::uint32_t(64));
+}
+
+// MARK: - Attachments
+
+TEST(draw_buffer_pushAttachments_emptyAttachmentsAreNotStreamed)
+{
+    renderer::draw_buffer buffer(60);
+    buffer.push_attachments(attachments(0));
+    push_quad(buffer, 0, 0);
+    buffer.push_attachments(attachments(0));
+    push_quad(buffer, 1, 0);
+
+    test::is_false(buffer.has_attachments());
+    test::equal(buffer.attachment_data_size(), std::size_t(0));
+}
+
+TEST(draw_buffer_pushAttachments_backfillsEarlierQuads)
+{
+    renderer::draw_buffer buffer(60);
+    buffer.push_attachments(attachments(0));
+    push_quad(buffer, 0, 0);
+    buffer.push_attachments(attachments(0));
+    push_quad(buffer, 1, 0);
+    buffer.push_attachments(attachments(3));
+    push_quad(buffer, 2, 0);
+
+    test::is_true(buffer.has_attachments());
+    test::equal(buffer.attachment_data_size(), 3 * sizeof(renderer::quad_attachments));
+
+    auto stream = reinterpret_cast<const renderer::quad_attachments *>(buffer.attachment_data());
+    test::equal(stream[0].values[0].x, 0.f);
+    test::equal(stream[1].values[0].x, 0.f);
+    test::equal(stream[2].values[0].x, 3.f);
+    test::equal(stream[2].values[0].w, 3.f);
+}
+
+TEST(draw_buffer_reset_clearsAttachmentStream)
+{
+    renderer::draw_buffer buffer(60);
+    buffer.push_attachments(attachments(1));
+    push_quad(buffer, 0, 0);
+    buffer.reset();
+
+    test::is_false(buffer.has_attachments());
+    test::is_true(buffer.is_empty());
+}
+
+// MARK: - External Storage
+
+TEST(draw_buffer_setVertexStorage_writesIntoExternalStorage)
+{
+    std::array<renderer::vertex, renderer::vertices_per_quad * 2> storage {};
+
+    renderer::draw_buffer buffer(60);
+    buffer.set_vertex_storage(storage.data(), storage.size());
+    push_quad(buffer, 5, 0);
+
+    test::is_true(buffer.uses_external_storage());
+    test::is_true(buffer.data() == storage.data());
+    test::equal(storage[3].position.x, 5.f);
+
+    push_quad(buffer, 6, 0);
+    test::is_true(buffer.is_full());
+
+    buffer.clear();
+    buffer.set_vertex_storage(nullptr, 0);
+    test::is_false(buffer.uses_external_storage());
+    test::is_false(buffer.is_full());
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <libTesting/testing.hpp>
+#include <libKestrel/graphics/renderer/common/draw_queue.hpp>
+
+using namespace kestrel;
+
+// MARK: - Helpers
+
+namespace
+{
+    auto push_quad(renderer::draw_queue& queue, enum renderer::blending mode, float x) -> void
+    {
+        math::rect frame(math::point(x, 0), math::size(16, 16));
+        math::rect uv(math::point(0), math::size(1));
+        queue.push_quad(nullptr, frame, uv, mode, 1.f, 1.f, nullptr, {});
+    }
+
+    auto blend_changes(const renderer::draw_queue& queue) -> std::size_t
+    {
+        std::size_t changes = 0;
+        const auto& commands = queue.commands();
+        for (std::size_t n = 1; n < commands.size(); ++n) {
+            if (commands[n].blend != commands[n - 1].blend) {
+                changes++;
+            }
+        }
+        return changes;
+    }
+}
+
+// MARK: - Ordering
+
+TEST(draw_queue_painterLayer_preservesSubmissionOrder)
+{
+    renderer::draw_queue queue;
+    push_quad(queue, renderer::blending::light, 0);
+    push_quad(queue, renderer::blending::normal, 1);
+    push_quad(queue, renderer::blending::light, 2);
+    queue.sort();
+
+    test::equal(queue.commands()[0].frame.origin().x(), 0.f);
+    test::equal(queue.commands()[1].frame.origin().x(), 1.f);
+    test::equal(queue.commands()[2].frame.origin().x(), 2.f);
+}
+
+TEST(draw_queue_sortedLayer_groupsCommandsByBlendMode)
+{
+    renderer::draw_queue queue;
+    queue.set_layer(0, renderer::layer_order::sorted);
+    for (auto n = 0; n < 10; ++n) {
+        push_quad(queue, (n % 2) ? renderer::blending::light : renderer::blending::normal, static_cast<float>(n));
+    }
+
+    test::equal(blend_changes(queue), std::size_t(9));
+    queue.sort();
+    test::equal(blend_changes(queue), std::size_t(1));
+
+    // Commands sharing a state keep the order they were submitted in.
+    test::equal(queue.commands()[0].frame.origin().x(), 0.f);
+    test::equal(queue.commands()[1].frame.origin().x(), 2.f);
+}
+
+TEST(draw_queue_layers_areDrawnInAscendingOrder)
+{
+    renderer::draw_queue queue;
+    queue.set_layer(2, renderer::layer_order::sorted);
+    push_quad(queue, renderer::blending::normal, 0);
+    queue.set_layer(1);
+    push_quad(queue, renderer::blending::light, 1);
+    queue.set_layer(2, renderer::layer_order::sorted);
+    push_quad(queue, renderer::blending::light, 2);
+    queue.sort();
+
+    test::equal(queue.commands()[0].key.layer, std::uint16_t(1));
+    test::equal(queue.commands()[0].frame.origin().x(), 1.f);
+    test::equal(queue.commands()[1].key.layer, std::uint16_t(2));
+    test::equal(queue.commands()[2].key.layer, std::uint16_t(2));
+}
+
+TEST(draw_queue_sort_movesEachCommandIntact)
+{
+    renderer::draw_queue queue;
+    for (auto frame = 0; frame < 2; ++frame) {
+        queue.set_layer(0, renderer::layer_order::sorted);
+        for (auto n = 0; n < 64; ++n) {
+            math::rect bounds(math::point(static_cast<float>(n), 0), math::size(16, 16));
+            math::rect uv(math::point(0), math::size(1));
+            auto mode = (n % 3) ? renderer::blending::light : renderer::blending::normal;
+            queue.push_quad(nullptr, bounds, uv, mode, static_cast<float>(n), 1.f, nullptr, {});
+        }
+        queue.sort();
+
+        test::equal(queue.size(), std::size_t(64));
+        test::equal(blend_changes(queue), std::size_t(1));
+        for (const auto& command : queue.commands()) {
+            test::equal(command.alpha, command.frame.origin().x());
+        }
+        queue.clear();
+    }
+}
+
+TEST(draw_queue_clear_resetsLayerAndCommands)
+{
+    renderer::draw_queue queue;
+    queue.set_layer(3, renderer::layer_order::sorted);
+    push_quad(queue, renderer::blending::normal, 0);
+    queue.clear();
+
+    test::is_true(queue.is_empty());
+    test::equal(queue.layer(), std::uint16_t(0));
+    test::is_true(queue.order() == renderer::layer_order::painters);
+}
@@ -0,0 +1,155 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <libTesting/testing.hpp>
+#include <libKestrel/graphics/canvas/rgba_buffer.hpp>
+#include <libKestrel/graphics/canvas/compositing.hpp>
+
+using namespace kestrel;
+
+// MARK: - Dirty Regions
+
+TEST(rgba_buffer_construction_hasNoDirtyRegions)
+{
+    graphics::rgba_buffer buffer({ 64, 64 });
+    test::is_false(buffer.has_dirty_regions());
+}
+
+TEST(rgba_buffer_fillRect_tracksSingleMergedRegion)
+{
+    graphics::rgba_buffer buffer({ 64, 64 });
+    buffer.fill_rect(graphics::color::red_color(), { 4, 8, 10, 6 });
+
+    test::equal(buffer.dirty_regions().size(), std::size_t(1));
+    test::is_true(buffer.dirty_regions().front() == math::rect(4, 8, 10, 6));
+}
+
+TEST(rgba_buffer_applyRun_tracksDisjointRunsSeparately)
+{
+    graphics::rgba_buffer buffer({ 64, 64 });
+    buffer.apply_run(graphics::color::red_color(), 0, 4, 0);
+    buffer.apply_run(graphics::color::red_color(), 32, 40, 20);
+
+    test::equal(buffer.dirty_regions().size(), std::size_t(2));
+    test::is_true(buffer.dirty_regions()[0] == math::rect(0, 0, 4, 1));
+    test::is_true(buffer.dirty_regions()[1] == math::rect(32, 20, 8, 1));
+}
+
+TEST(rgba_buffer_markDirty_mergesAdjacentAndClipsToBuffer)
+{
+    graphics::rgba_buffer buffer({ 64, 64 });
+    buffer.mark_dirty({ 0, 0, 10, 10 });
+    buffer.mark_dirty({ 10, 0, 10, 10 });
+    buffer.mark_dirty({ 60, 60, 10, 10 });
+
+    test::equal(buffer.dirty_regions().size(), std::size_t(2));
+    test::is_true(buffer.dirty_regions()[0] == math::rect(0, 0, 20, 10));
+    test::is_true(buffer.dirty_regions()[1] == math::rect(60, 60, 4, 4));
+
+    // A region that bridges both existing regions absorbs them.
+    buffer.mark_dirty({ 15, 5, 50, 56 });
+    test::equal(buffer.dirty_regions().size(), std::size_t(1));
+    test::is_true(buffer.dirty_regions().front() == math::rect(0, 0, 64, 64));
+}
+
+TEST(rgba_buffer_markDirty_collapsesWhenRegionLimitExceeded)
+{
+    graphics::rgba_buffer buffer({ 256, 256 });
+    for (std::size_t n = 0; n <= graphics::rgba_buffer::max_dirty_regions; ++n) {
+        buffer.draw_pixel(graphics::color::red_color(), { static_cast<float>(n * 4), static_cast<float>(n * 4) });
+    }
+
+    auto last = static_cast<float>(graphics::rgba_buffer::max_dirty_regions * 4);
+    test::equal(buffer.dirty_regions().size(), std::size_t(1));
+    test::is_true(buffer.dirty_regions().front() == math::rect(0, 0, last + 1, last + 1));
+}
+
+TEST(rgba_buffer_clearDirtyRegions_removesAllRegions)
+{
+    graphics::rgba_buffer buffer({ 64, 64 });
+    buffer.clear(graphics::color::red_color());
+    test::is_true(buffer.has_dirty_regions());
+    test::is_true(buffer.dirty_regions().front() == math::rect(0, 0, 64, 64));
+
+    buffer.clear_dirty_regions();
+    test::is_false(buffer.has_dirty_regions());
+}
+
+TEST(rgba_buffer_clearRect_onlyWritesInsideRect)
+{
+    graphics::rgba_buffer buffer({ 16, 16 });
+    buffer.clear_rect(graphics::color::red_color(), { 3, 2, 5, 4 });
+
+    test::equal(buffer.color({ 2, 2 }).rgba.value, graphics::color::value(0));
+    test::equal(buffer.color({ 3, 2 }).rgba.value, graphics::color::red_color().rgba.value);
+    test::equal(buffer.color({ 8, 2 }).rgba.value, graphics::color::value(0));
+    test::is_true(buffer.dirty_regions().front() == math::rect(3, 2, 5, 4));
+}
+
+// MARK: - Blitting
+
+TEST(rgba_buffer_blit_unscaledSourceIsClippedToBuffer)
+{
+    // A 4x2 source stored with a stride of 6 pixels.
+    std::vector<graphics::color::value> source(12, 0);
+    for (graphics::color::value n = 0; n < source.size(); ++n) {
+        source[n] = 0xFF000000 | (n * 0x10);
+    }
+
+    graphics::rgba_buffer buffer({ 8, 8 });
+    buffer.blit(source.data(), { 4, 2 }, 6, { -1, 6, 4, 2 });
+
+    test::equal(buffer.dirty_regions().size(), std::size_t(1));
+    test::is_true(buffer.dirty_regions().front() == math::rect(0, 6, 3, 2));
+    test::equal(buffer.color({ 0, 6 }).rgba.value, graphics::compositing::blend(0, source[1]));
+    test::equal(buffer.color({ 2, 7 }).rgba.value, graphics::compositing::blend(0, source[9]));
+    test::equal(buffer.color({ 3, 7 }).rgba.value, graphics::color::value(0));
+}
+
+TEST(rgba_buffer_blit_nearestScalingRepeatsSourcePixels)
+{
+    std::vector<graphics::color::value> source { 0xFF0000FF, 0xFF00FF00, 0xFFFF0000, 0xFFFFFFFF };
+
+    graphics::rgba_buffer buffer({ 8, 8 });
+    buffer.blit(source.data(), { 2, 2 }, 2, { 0, 0, 4, 4 });
+
+    test::equal(buffer.color({ 1, 1 }).rgba.value, graphics::compositing::blend(0, source[0]));
+    test::equal(buffer.color({ 2, 1 }).rgba.value, graphics::compositing::blend(0, source[1]));
+    test::equal(buffer.color({ 1, 2 }).rgba.value, graphics::compositing::blend(0, source[2]));
+    test::equal(buffer.color({ 3, 3 }).rgba.value, graphics::compositing::blend(0, source[3]));
+    test::is_true(buffer.dirty_regions().front() == math::rect(0, 0, 4, 4));
+}
+
+TEST(rgba_buffer_blit_linearScalingInterpolatesBetweenPixels)
+{
+    std::vector<graphics::color::value> source { 0xFF000000, 0xFF0000FF };
+
+    graphics::rgba_buffer buffer({ 8, 8 });
+    buffer.blit(source.data(), { 2, 1 }, 2, { 0, 0, 8, 1 }, graphics::rgba_buffer::scale_filter::linear);
+
+    // The outer pixels take the source values, while the inner pixels rise steadily between them.
+    auto red = [&] (float x) { return buffer.color({ x, 0 }).rgba.value & 0xFF; };
+    test::equal(red(0), graphics::compositing::blend(0, source[0]) & 0xFF);
+    test::equal(red(7), graphics::compositing::blend(0, source[1]) & 0xFF);
+    for (auto x = 1; x < 8; ++x) {
+        test::is_true(red(static_cast<float>(x)) >= red(static_cast<float>(x - 1)));
+    }
+    test::is_true(red(3) > red(0) && red(3) < red(7));
+}
@@ -0,0 +1,240 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <random>
+#include <vector>
+#include <libTesting/testing.hpp>
+#include <libKestrel/graphics/texture/texture.hpp>
+#include <libKestrel/graphics/texture/atlas.hpp>
+
+using namespace kestrel;
+
+// MARK: - Helpers
+
+namespace
+{
+    auto make_atlas(std::uint32_t page_size, std::uint32_t page_limit, std::uint32_t max_dimension = 256) -> graphics::texture_atlas
+    {
+        return graphics::texture_atlas([] (const math::size& size, const data::block& data) {
+            return std::make_shared<graphics::texture>(size, data);
+        }, page_size, page_limit, max_dimension);
+    }
+
+    auto make_texture(std::uint32_t width, std::uint32_t height, std::uint32_t value) -> std::shared_ptr<graphics::texture>
+    {
+        data::block block(static_cast<std::size_t>(width) * height * 4);
+        block.set(value, block.size());
+        return std::make_shared<graphics::texture>(math::size(static_cast<float>(width), static_cast<float>(height)), block);
+    }
+
+    auto pixel_rect(const graphics::texture_atlas::placement& p, std::uint32_t page_size) -> math::rect
+    {
+        auto scale = static_cast<float>(page_size);
+        return { p.frame.x() * scale, p.frame.y() * scale, p.frame.width() * scale, p.frame.height() * scale };
+    }
+
+    auto overlaps(const math::rect& a, const math::rect& b) -> bool
+    {
+        return a.x() < b.x() + b.width() && b.x() < a.x() + a.width()
+            && a.y() < b.y() + b.height() && b.y() < a.y() + a.height();
+    }
+}
+
+// MARK: - Packing
+
+TEST(texture_atlas_resolve_packsEnrolledTexturesIntoSharedPage)
+{
+    auto atlas = make_atlas(128, 1);
+    auto a = make_texture(32, 16, 0xFF0000FF);
+    auto b = make_texture(16, 32, 0xFF00FF00);
+    atlas.enroll(a);
+    atlas.enroll(b);
+
+    auto pa = atlas.resolve(a);
+    auto pb = atlas.resolve(b);
+    test::is_true(pa != nullptr);
+    test::is_true(pb != nullptr);
+    test::is_true(pa->page == pb->page);
+    test::is_false(overlaps(pixel_rect(*pa, 128), pixel_rect(*pb, 128)));
+
+    // The pixels only reach the page texture once committed.
+    atlas.commit();
+    auto page = pa->page->data().get<std::uint32_t *>();
+    auto rect = pixel_rect(*pb, 128);
+    auto origin = static_cast<std::size_t>(rect.y()) * 128 + static_cast<std::size_t>(rect.x());
+    test::equal(page[origin], 0xFF00FF00U);
+    test::equal(page[origin + 15 + (31 * 128)], 0xFF00FF00U);
+
+    test::equal(atlas.stats().packed, 2ULL);
+    test::is_true(atlas.resolve(a) == pa);
+    test::equal(atlas.stats().hits, 1ULL);
+}
+
+TEST(texture_atlas_resolve_extrudesEdgeTexelsIntoBorder)
+{
+    auto atlas = make_atlas(64, 1);
+    data::block block(2 * 2 * 4);
+    auto texels = block.get<std::uint32_t *>();
+    texels[0] = 0xFF000001;
+    texels[1] = 0xFF000002;
+    texels[2] = 0xFF000003;
+    texels[3] = 0xFF000004;
+    auto tex = std::make_shared<graphics::texture>(math::size(2.f, 2.f), block);
+    atlas.enroll(tex);
+
+    auto p = atlas.resolve(tex);
+    test::is_true(p != nullptr);
+    atlas.commit();
+
+    // Each texel just outside the frame should repeat the nearest texel inside it, including at the corners.
+    auto page = p->page->data().get<std::uint32_t *>();
+    auto rect = pixel_rect(*p, 64);
+    auto at = [&] (std::int32_t x, std::int32_t y) {
+        return page[static_cast<std::size_t>(static_cast<std::int32_t>(rect.y()) + y) * 64 + static_cast<std::size_t>(static_cast<std::int32_t>(rect.x()) + x)];
+    };
+    test::equal(at(-1, -1), 0xFF000001U);
+    test::equal(at(0, -1), 0xFF000001U);
+    test::equal(at(2, -1), 0xFF000002U);
+    test::equal(at(-1, 1), 0xFF000003U);
+    test::equal(at(2, 1), 0xFF000004U);
+    test::equal(at(1, 2), 0xFF000004U);
+    test::equal(at(2, 2), 0xFF000004U);
+}
+
+TEST(texture_atlas_resolve_ignoresUnenrolledAndOversizedTextures)
+{
+    auto atlas = make_atlas(128, 1, 64);
+    auto unenrolled = make_texture(16, 16, 0xFFFFFFFF);
+    auto oversized = make_texture(65, 16, 0xFFFFFFFF);
+    atlas.enroll(oversized);
+
+    test::is_true(atlas.resolve(unenrolled) == nullptr);
+    test::is_true(atlas.resolve(oversized) == nullptr);
+    test::is_false(atlas.is_enrolled(oversized.get()));
+    test::equal(atlas.stats().rejected, 1ULL);
+    test::equal(atlas.stats().pages, static_cast<std::size_t>(0));
+}
+
+TEST(texture_atlas_placement_mapsTextureCoordinatesIntoPage)
+{
+    graphics::texture_atlas::placement p;
+    p.frame = { 0.5f, 0.25f, 0.25f, 0.125f };
+
+    auto whole = p.map({ 0.f, 0.f, 1.f, 1.f });
+    test::equal(whole.x(), 0.5f);
+    test::equal(whole.y(), 0.25f);
+    test::equal(whole.width(), 0.25f);
+    test::equal(whole.height(), 0.125f);
+
+    // Flipped sprites use a negative height, which must remain relative to the placement.
+    auto flipped = p.map({ 0.5f, 1.f, 0.5f, -1.f });
+    test::equal(flipped.x(), 0.625f);
+    test::equal(flipped.y(), 0.375f);
+    test::equal(flipped.width(), 0.125f);
+    test::equal(flipped.height(), -0.125f);
+}
+
+TEST(texture_atlas_resolve_packsMixedSizesWithoutOverlap)
+{
+    constexpr std::uint32_t page_size = 512;
+    auto atlas = make_atlas(page_size, 1, 64);
+
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<std::uint32_t> dimension(4, 64);
+    std::vector<std::shared_ptr<graphics::texture>> textures;
+    std::vector<math::rect> frames;
+    float packed_area = 0;
+    for (auto i = 0; i < 400; ++i) {
+        auto tex = make_texture(dimension(rng), dimension(rng), 0xFFFFFFFF);
+        atlas.enroll(tex);
+        if (auto p = atlas.resolve(tex)) {
+            auto frame = pixel_rect(*p, page_size);
+            test::is_true(frame.x() >= 0 && frame.y() >= 0);
+            test::is_true(frame.x() + frame.width() <= page_size && frame.y() + frame.height() <= page_size);
+            for (const auto& other : frames) {
+                test::is_false(overlaps(frame, other));
+            }
+            frames.emplace_back(frame);
+            packed_area += frame.width() * frame.height();
+        }
+        textures.emplace_back(tex);
+    }
+
+    // The skyline packer should fill most of the page before running out of space.
+    test::is_true(packed_area / static_cast<float>(page_size * page_size) > 0.75f);
+}
+
+// MARK: - Eviction
+
+TEST(texture_atlas_resolve_evictsLeastRecentlyUsedPageOutsideCurrentFrame)
+{
+    auto atlas = make_atlas(64, 2);
+    std::vector<std::shared_ptr<graphics::texture>> textures;
+    for (auto i = 0; i < 3; ++i) {
+        textures.emplace_back(make_texture(40, 40, 0xFF000000 | i));
+        atlas.enroll(textures.back());
+    }
+
+    test::is_true(atlas.resolve(textures[0]) != nullptr);
+    atlas.next_frame();
+    test::is_true(atlas.resolve(textures[1]) != nullptr);
+
+    // Both pages are full, and the second page is in use by the current frame.
+    test::is_true(atlas.resolve(textures[2]) != nullptr);
+    test::equal(atlas.stats().evictions, 1ULL);
+    test::equal(atlas.stats().entries, static_cast<std::size_t>(2));
+
+    // Every page has now been drawn from during this frame, so nothing else can be evicted until the next frame.
+    test::is_true(atlas.resolve(textures[0]) == nullptr);
+    atlas.next_frame();
+    test::is_true(atlas.resolve(textures[0]) != nullptr);
+    test::equal(atlas.stats().evictions, 2ULL);
+}
+
+TEST(texture_atlas_resolve_reclaimsPagesOfDestroyedTextures)
+{
+    auto atlas = make_atlas(64, 1);
+    auto first = make_texture(40, 40, 0xFFFFFFFF);
+    atlas.enroll(first);
+    test::is_true(atlas.resolve(first) != nullptr);
+    first.reset();
+    atlas.next_frame();
+
+    auto second = make_texture(40, 40, 0xFFFFFFFF);
+    atlas.enroll(second);
+    test::is_true(atlas.resolve(second) != nullptr);
+    test::equal(atlas.stats().evictions, 0ULL);
+    test::equal(atlas.stats().entries, static_cast<std::size_t>(1));
+}
+
+// MARK: - Clearing
+
+TEST(texture_atlas_clear_forgetsEnrolledTextures)
+{
+    auto atlas = make_atlas(64, 1);
+    auto tex = make_texture(16, 16, 0xFFFFFFFF);
+    atlas.enroll(tex);
+    test::is_true(atlas.resolve(tex) != nullptr);
+
+    atlas.clear();
+    test::is_false(atlas.is_enrolled(tex.get()));
+    test::is_true(atlas.resolve(tex) == nullptr);
+    test::equal(atlas.stats().pages, static_cast<std::size_t>(0));
+}
@@ -0,0 +1,245 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <libTesting/testing.hpp>
+#include <libKestrel/graphics/texture/texture.hpp>
+#include <libKestrel/graphics/texture/residency.hpp>
+
+using namespace kestrel;
+
+// MARK: - Helpers
+
+namespace
+{
+    constexpr std::size_t texture_bytes = 16 * 16 * 4;
+
+    auto pixels(std::uint32_t value) -> data::block
+    {
+        data::block block(texture_bytes);
+        block.set(value, block.size());
+        return block;
+    }
+
+    auto find_source(const graphics::residency::report& report, const std::string& source) -> const graphics::residency::source_usage *
+    {
+        auto it = std::find_if(report.sources.begin(), report.sources.end(), [&] (const auto& usage) {
+            return usage.source == source;
+        });
+        return (it == report.sources.end()) ? nullptr : &(*it);
+    }
+}
+
+// MARK: - Policies
+
+TEST(texture_residency_keep_retainsDataAfterUpload)
+{
+    graphics::texture tex({ 16, 16 }, pixels(0xFF00FF00));
+    tex.upload_to_gpu();
+
+    test::is_true(tex.is_cpu_resident());
+    test::equal(tex.cpu_bytes(), texture_bytes);
+    test::equal(tex.gpu_bytes(), texture_bytes);
+}
+
+TEST(texture_residency_dropAfterUpload_releasesDataOnUpload)
+{
+    graphics::texture tex({ 16, 16 }, pixels(0xFF00FF00));
+    tex.set_residency_policy(graphics::residency_policy::drop_after_upload);
+    test::equal(tex.cpu_bytes(), texture_bytes);
+
+    tex.upload_to_gpu();
+    test::is_false(tex.is_cpu_resident());
+    test::equal(tex.cpu_bytes(), std::size_t(0));
+    test::equal(tex.gpu_bytes(), texture_bytes);
+}
+
+TEST(texture_residency_reloadOnDemand_reproducesReleasedData)
+{
+    int reloads = 0;
+    graphics::texture tex({ 16, 16 }, pixels(0xFF0000FF));
+    tex.set_residency_policy(graphics::residency_policy::reload_on_demand, [&] {
+        reloads++;
+        return pixels(0xFF0000FF);
+    });
+    tex.upload_to_gpu();
+
+    test::is_true(tex.release_cpu_data());
+    test::equal(tex.cpu_bytes(), std::size_t(0));
+
+    test::equal(tex.color(3, 3).color_value(), graphics::color::value(0xFF0000FF));
+    test::equal(reloads, 1);
+    test::is_true(tex.is_cpu_resident());
+}
+
+TEST(texture_residency_dropAfterUpload_reloadsDataForSecondUpload)
+{
+    int reloads = 0;
+    graphics::texture tex({ 16, 16 }, pixels(0xFF0000FF));
+    tex.set_residency_policy(graphics::residency_policy::drop_after_upload, [&] {
+        reloads++;
+        return pixels(0xFF0000FF);
+    });
+    tex.upload_to_gpu();
+    test::is_false(tex.is_cpu_resident());
+    test::is_true(tex.has_data());
+
+    test::equal(tex.data().size(), texture_bytes);
+    test::equal(reloads, 1);
+
+    tex.upload_to_gpu();
+    test::is_false(tex.is_cpu_resident());
+}
+
+TEST(texture_residency_dropAfterUploadWithoutReloader_refusesSecondUpload)
+{
+    graphics::texture tex({ 16, 16 }, pixels(0xFF0000FF));
+    tex.set_residency_policy(graphics::residency_policy::drop_after_upload);
+    tex.upload_to_gpu();
+    test::is_false(tex.has_data());
+
+    auto releases = graphics::residency::memory_report().releases;
+    auto access = tex.last_access();
+    tex.upload_to_gpu();
+
+    test::equal(tex.last_access(), access);
+    test::equal(graphics::residency::memory_report().releases, releases);
+}
+
+TEST(texture_residency_reloadOnDemandWithoutReloader_fallsBackToKeep)
+{
+    graphics::texture tex({ 16, 16 }, pixels(0));
+    tex.set_residency_policy(graphics::residency_policy::reload_on_demand);
+    tex.upload_to_gpu();
+
+    test::is_true(tex.residency() == graphics::residency_policy::keep);
+    test::is_false(tex.release_cpu_data());
+}
+
+// MARK: - Budget
+
+TEST(texture_residency_budget_releasesLeastRecentlyUsedFirst)
+{
+    auto previous_budget = graphics::residency::budget();
+    graphics::residency::set_budget(texture_bytes * 2);
+
+    auto reload = [] { return pixels(0); };
+    graphics::texture a({ 16, 16 }, pixels(0));
+    graphics::texture b({ 16, 16 }, pixels(0));
+    graphics::texture c({ 16, 16 }, pixels(0));
+    for (auto tex : { &a, &b, &c }) {
+        tex->set_residency_policy(graphics::residency_policy::reload_on_demand, reload);
+    }
+
+    a.upload_to_gpu();
+    b.upload_to_gpu();
+    (void)a.data();
+    graphics::residency::next_frame();
+    c.upload_to_gpu();
+
+    // The third upload exceeds the budget, so the least recently accessed texture is released.
+    test::is_true(a.is_cpu_resident());
+    test::is_false(b.is_cpu_resident());
+    test::is_true(c.is_cpu_resident());
+
+    graphics::residency::set_budget(previous_budget);
+}
+
+TEST(texture_residency_budget_countsEveryResidentTexture)
+{
+    auto previous_budget = graphics::residency::budget();
+    graphics::residency::set_budget(texture_bytes * 2);
+
+    auto reload = [] { return pixels(0); };
+    graphics::texture kept({ 16, 16 }, pixels(0));
+    graphics::texture a({ 16, 16 }, pixels(0));
+    graphics::texture b({ 16, 16 }, pixels(0));
+    a.set_residency_policy(graphics::residency_policy::reload_on_demand, reload);
+    b.set_residency_policy(graphics::residency_policy::reload_on_demand, reload);
+
+    kept.upload_to_gpu();
+    a.upload_to_gpu();
+    graphics::residency::next_frame();
+    b.upload_to_gpu();
+
+    // The kept texture can not be released, but its data still counts against the budget.
+    test::is_true(kept.is_cpu_resident());
+    test::is_false(a.is_cpu_resident());
+    test::is_true(b.is_cpu_resident());
+
+    graphics::residency::set_budget(previous_budget);
+}
+
+TEST(texture_residency_budget_neverReleasesTextureAccessedThisFrame)
+{
+    auto previous_budget = graphics::residency::budget();
+    graphics::residency::set_budget(texture_bytes / 2);
+
+    int reloads = 0;
+    graphics::texture tex({ 16, 16 }, pixels(0xFF0000FF));
+    tex.set_residency_policy(graphics::residency_policy::reload_on_demand, [&] {
+        reloads++;
+        return pixels(0xFF0000FF);
+    });
+
+    // A texture larger than the budget is still resident once uploaded, and once reloaded.
+    tex.upload_to_gpu();
+    test::is_true(tex.is_cpu_resident());
+
+    graphics::residency::next_frame();
+    test::is_true(tex.release_cpu_data());
+    test::equal(tex.color(3, 3).color_value(), graphics::color::value(0xFF0000FF));
+    test::is_true(tex.is_cpu_resident());
+    test::equal(reloads, 1);
+
+    // In the next frame it is no longer in use, and is released to meet the budget.
+    graphics::residency::next_frame();
+    graphics::residency::enforce_budget();
+    test::is_false(tex.is_cpu_resident());
+
+    graphics::residency::set_budget(previous_budget);
+}
+
+// MARK: - Reporting
+
+TEST(texture_residency_memoryReport_groupsUsageBySource)
+{
+    graphics::texture a({ 16, 16 }, pixels(0));
+    graphics::texture b({ 16, 16 }, pixels(0));
+    graphics::texture c({ 16, 16 }, pixels(0));
+    a.set_source("PICT #128 Residency Test");
+    b.set_source("PICT #128 Residency Test");
+    c.set_source("cicn #129 Residency Test");
+    b.set_residency_policy(graphics::residency_policy::drop_after_upload);
+    b.upload_to_gpu();
+
+    auto report = graphics::residency::memory_report();
+    auto pict = find_source(report, "PICT #128 Residency Test");
+    auto cicn = find_source(report, "cicn #129 Residency Test");
+
+    test::is_true(pict != nullptr);
+    test::is_true(cicn != nullptr);
+    test::equal(pict->textures, std::size_t(2));
+    test::equal(pict->cpu_bytes, texture_bytes);
+    test::equal(pict->gpu_bytes, texture_bytes);
+    test::equal(cicn->cpu_bytes, texture_bytes);
+    test::equal(cicn->gpu_bytes, std::size_t(0));
+    test::is_false(graphics::residency::format_report(report).empty());
+}
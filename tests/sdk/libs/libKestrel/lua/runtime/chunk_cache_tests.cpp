@@ -0,0 +1,130 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+extern "C" {
+#   include "LuaJIT/src/lua.h"
+#   include "LuaJIT/src/lauxlib.h"
+#   include "LuaJIT/src/lualib.h"
+}
+
+#include <filesystem>
+#include <libTesting/testing.hpp>
+#include <libKestrel/lua/runtime/chunk_cache.hpp>
+
+using namespace kestrel;
+
+// MARK: - Helpers
+
+namespace
+{
+    struct state
+    {
+        lua_State *L { luaL_newstate() };
+
+        state() { luaL_openlibs(L); }
+        ~state() { lua_close(L); }
+
+        auto run(lua::chunk_cache& cache, const std::string& source) const -> bool
+        {
+            return cache.load(L, source) == LUA_OK && lua_pcall(L, 0, 0, 0) == LUA_OK;
+        }
+
+        [[nodiscard]] auto global_number(const char *name) const -> lua_Number
+        {
+            lua_getglobal(L, name);
+            auto value = lua_tonumber(L, -1);
+            lua_pop(L, 1);
+            return value;
+        }
+    };
+
+    auto temporary_directory(const std::string& name) -> std::string
+    {
+        auto path = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove_all(path);
+        return path.string();
+    }
+}
+
+// MARK: - Memory
+
+TEST(lua_chunk_cache_load_compilesSourceOnlyOnce)
+{
+    lua::chunk_cache cache;
+    state lua;
+
+    test::is_true(lua.run(cache, "counter = (counter or 0) + 1"));
+    test::is_true(lua.run(cache, "counter = (counter or 0) + 1"));
+
+    test::equal(lua.global_number("counter"), 2.0);
+    test::equal(cache.stats().compiled, 1ULL);
+    test::equal(cache.stats().hits, 1ULL);
+    test::equal(cache.stats().misses, 1ULL);
+    test::equal(cache.stats().entries, static_cast<std::size_t>(1));
+}
+
+TEST(lua_chunk_cache_load_keysChunksBySource)
+{
+    lua::chunk_cache cache;
+    state lua;
+
+    test::is_true(lua.run(cache, "value = 1"));
+    test::is_true(lua.run(cache, "value = 2"));
+
+    test::equal(lua.global_number("value"), 2.0);
+    test::equal(cache.stats().compiled, 2ULL);
+    test::equal(cache.stats().entries, static_cast<std::size_t>(2));
+}
+
+TEST(lua_chunk_cache_load_doesNotCacheSyntaxErrors)
+{
+    lua::chunk_cache cache;
+    state lua;
+
+    test::is_false(cache.load(lua.L, "value = ") == LUA_OK);
+    test::is_true(lua_isstring(lua.L, -1) != 0);
+    test::equal(cache.stats().entries, static_cast<std::size_t>(0));
+}
+
+// MARK: - Persistence
+
+TEST(lua_chunk_cache_load_reusesChunksPersistedByEarlierSession)
+{
+    auto directory = temporary_directory("kestrel-chunk-cache-tests");
+
+    {
+        lua::chunk_cache cache;
+        cache.set_directory(directory);
+        state lua;
+        test::is_true(lua.run(cache, "persisted = 42"));
+        test::equal(cache.stats().compiled, 1ULL);
+    }
+
+    lua::chunk_cache cache;
+    cache.set_directory(directory);
+    state lua;
+    test::is_true(lua.run(cache, "persisted = 42"));
+
+    test::equal(lua.global_number("persisted"), 42.0);
+    test::equal(cache.stats().compiled, 0ULL);
+    test::equal(cache.stats().disk_hits, 1ULL);
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,139 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+extern "C" {
+#   include "LuaJIT/src/lua.h"
+#   include "LuaJIT/src/lauxlib.h"
+#   include "LuaJIT/src/lualib.h"
+}
+
+#include <libTesting/testing.hpp>
+#include <libKestrel/lua/runtime/gc_scheduler.hpp>
+
+using namespace kestrel;
+
+// MARK: - Helpers
+
+namespace
+{
+    struct state
+    {
+        lua_State *L { luaL_newstate() };
+
+        state() { luaL_openlibs(L); }
+        ~state() { lua_close(L); }
+
+        auto make_garbage() const -> void
+        {
+            luaL_dostring(L, "for i = 1, 20000 do local t = { i, tostring(i) } end");
+        }
+    };
+}
+
+// MARK: - Stepping
+
+TEST(lua_gc_scheduler_step_takesOneStepWithoutIdleTime)
+{
+    state lua;
+    lua::gc_scheduler gc(lua.L);
+    lua.make_garbage();
+
+    gc.step([] { return false; });
+
+    test::equal(gc.last_frame_statistics().steps, 1U);
+    test::is_true(gc.last_frame_statistics().time >= 0.0);
+}
+
+TEST(lua_gc_scheduler_step_completesCycleWhenTimeAvailable)
+{
+    state lua;
+    lua::gc_scheduler gc(lua.L);
+    gc.collect();
+    lua.make_garbage();
+    auto before = gc.memory_kb();
+
+    gc.step([] { return true; });
+
+    test::equal(gc.last_frame_statistics().cycles, 1U);
+    test::is_true(gc.last_frame_statistics().memory_kb < before);
+}
+
+TEST(lua_gc_scheduler_disabledAutomaticCollector_doesNotCollectDuringScripts)
+{
+    state lua;
+    lua::gc_scheduler gc(lua.L);
+    gc.set_automatic(false);
+    gc.collect();
+    auto baseline = gc.memory_kb();
+
+    // With the automatic collector stopped, garbage accumulates until the scheduler is stepped.
+    lua.make_garbage();
+    lua.make_garbage();
+    auto accumulated = gc.memory_kb();
+    test::is_true(accumulated > baseline);
+
+    gc.collect();
+    test::is_true(gc.memory_kb() < accumulated);
+}
+
+TEST(lua_gc_scheduler_automaticCollector_isEnabledByDefault)
+{
+    state lua;
+    lua::gc_scheduler gc(lua.L);
+
+    test::is_true(gc.automatic());
+    test::equal(gc.pause(), lua::gc_scheduler::default_pause);
+}
+
+TEST(lua_gc_scheduler_step_completesCycleWhenPastMemoryCeiling)
+{
+    state lua;
+    lua::gc_scheduler gc(lua.L);
+    gc.set_automatic(false);
+    gc.collect();
+    lua.make_garbage();
+    gc.set_memory_ceiling(gc.memory_kb() - 1);
+
+    gc.step([] { return false; });
+
+    test::is_true(gc.last_frame_statistics().forced);
+    test::equal(gc.last_frame_statistics().cycles, 1U);
+}
+
+// MARK: - Tuning
+
+TEST(lua_gc_scheduler_tuning_retainsConfiguredValues)
+{
+    state lua;
+    lua::gc_scheduler gc(lua.L);
+    gc.set_pause(150);
+    gc.set_step_multiplier(400);
+    gc.set_step_size(64);
+    gc.set_automatic(true);
+
+    test::equal(gc.pause(), 150);
+    test::equal(gc.step_multiplier(), 400);
+    test::equal(gc.step_size(), 64);
+    test::is_true(gc.automatic());
+
+    // The previous value reported by Lua confirms that the setting was applied to the state.
+    test::equal(lua_gc(lua.L, LUA_GCSETPAUSE, 200), 150);
+    test::equal(lua_gc(lua.L, LUA_GCSETSTEPMUL, 200), 400);
+}
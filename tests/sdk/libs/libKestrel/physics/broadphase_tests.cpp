@@ -0,0 +1,263 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+#include <libTesting/testing.hpp>
+#include <libKestrel/physics/quad_tree.hpp>
+#include <libKestrel/physics/spatial_hash.hpp>
+
+using namespace kestrel;
+
+// MARK: - Helpers
+
+namespace
+{
+    constexpr std::size_t benchmark_capacity = 50'000;
+    constexpr float benchmark_world_size = 16384.f;
+    constexpr float benchmark_body_size = 48.f;
+    constexpr std::size_t benchmark_frames = 10;
+
+    typedef physics::spatial_hash<std::uint64_t, benchmark_capacity> benchmark_hash;
+    typedef physics::quad_tree<std::uint64_t, 5, 20> benchmark_tree;
+
+    auto random_bodies(std::size_t count) -> std::vector<math::rect>
+    {
+        std::mt19937 rng(count);
+        std::uniform_real_distribution<float> position(0, benchmark_world_size - benchmark_body_size);
+        std::vector<math::rect> bodies;
+        bodies.reserve(count);
+        for (std::size_t n = 0; n < count; ++n) {
+            bodies.emplace_back(position(rng), position(rng), benchmark_body_size, benchmark_body_size);
+        }
+        return bodies;
+    }
+
+    auto step_bodies(std::vector<math::rect>& bodies) -> void
+    {
+        for (std::size_t n = 0; n < bodies.size(); ++n) {
+            auto dx = static_cast<float>(static_cast<std::int64_t>(n % 7) - 3);
+            auto dy = static_cast<float>(static_cast<std::int64_t>(n % 5) - 2);
+            bodies[n] = bodies[n] + math::point(dx, dy);
+        }
+    }
+
+    auto benchmark_quad_tree(std::size_t count) -> void
+    {
+        auto bodies = random_bodies(count);
+        benchmark_tree tree(0, math::rect(0, 0, benchmark_world_size, benchmark_world_size));
+
+        test::measure([&] {
+            std::size_t candidates = 0;
+            for (std::size_t frame = 0; frame < benchmark_frames; ++frame) {
+                step_bodies(bodies);
+                tree.clear();
+                for (std::size_t n = 0; n < bodies.size(); ++n) {
+                    tree.insert(bodies[n], n);
+                }
+                for (const auto& bounds : bodies) {
+                    candidates += tree.retrieve(bounds).size();
+                }
+            }
+            test::is_true(candidates >= count * benchmark_frames);
+        });
+    }
+
+    auto benchmark_spatial_hash(std::size_t count) -> void
+    {
+        auto bodies = random_bodies(count);
+        auto hash = std::make_unique<benchmark_hash>(128.f);
+        std::vector<benchmark_hash::proxy> proxies;
+        proxies.reserve(count);
+        for (std::size_t n = 0; n < bodies.size(); ++n) {
+            proxies.emplace_back(hash->insert(bodies[n], n));
+        }
+
+        test::measure([&] {
+            std::size_t candidates = 0;
+            for (std::size_t frame = 0; frame < benchmark_frames; ++frame) {
+                step_bodies(bodies);
+                for (std::size_t n = 0; n < bodies.size(); ++n) {
+                    hash->update(proxies[n], bodies[n]);
+                }
+                for (const auto& bounds : bodies) {
+                    hash->query(bounds, [&] (std::uint64_t) { ++candidates; });
+                }
+            }
+            test::is_true(candidates >= count * benchmark_frames);
+        });
+    }
+}
+
+// MARK: - Quad Tree
+
+TEST(quad_tree_retrieveIntoBuffer_matchesRetrieve)
+{
+    auto bodies = random_bodies(1'000);
+    benchmark_tree tree(0, math::rect(0, 0, benchmark_world_size, benchmark_world_size));
+    for (std::size_t n = 0; n < bodies.size(); ++n) {
+        tree.insert(bodies[n], n);
+    }
+
+    std::vector<std::pair<math::rect, std::uint64_t>> buffer;
+    for (const auto& bounds : bodies) {
+        auto expected = tree.retrieve(bounds);
+        tree.retrieve(bounds, buffer);
+        test::equal(buffer.size(), expected.size());
+        for (std::size_t n = 0; n < expected.size() && n < buffer.size(); ++n) {
+            test::equal(buffer[n].second, expected[n].second);
+        }
+    }
+}
+
+// MARK: - Spatial Hash
+
+TEST(spatial_hash_query_returnsOverlappingObjectsOnce)
+{
+    auto hash = std::make_unique<physics::spatial_hash<std::uint64_t, 16>>(32.f);
+    hash->insert(math::rect(0, 0, 100, 100), 1);
+    hash->insert(math::rect(200, 200, 10, 10), 2);
+    hash->insert(math::rect(90, 90, 20, 20), 3);
+
+    std::vector<std::uint64_t> found;
+    hash->query(math::rect(50, 50, 50, 50), [&] (std::uint64_t object) { found.emplace_back(object); });
+
+    test::equal(found.size(), 2);
+    test::is_true(std::find(found.begin(), found.end(), 1) != found.end());
+    test::is_true(std::find(found.begin(), found.end(), 3) != found.end());
+}
+
+TEST(spatial_hash_update_onlyRelinksWhenLeavingCells)
+{
+    auto hash = std::make_unique<physics::spatial_hash<std::uint64_t, 16>>(64.f);
+    auto proxy = hash->insert(math::rect(4, 4, 8, 8), 1);
+
+    test::is_false(hash->update(proxy, math::rect(10, 10, 8, 8)));
+    test::is_true(hash->update(proxy, math::rect(70, 10, 8, 8)));
+
+    std::size_t found = 0;
+    hash->query(math::rect(0, 0, 20, 20), [&] (std::uint64_t) { ++found; });
+    test::equal(found, 0);
+
+    hash->query(math::rect(60, 0, 20, 20), [&] (std::uint64_t) { ++found; });
+    test::equal(found, 1);
+}
+
+TEST(spatial_hash_remove_excludesObjectFromQueries)
+{
+    auto hash = std::make_unique<physics::spatial_hash<std::uint64_t, 16>>(64.f);
+    auto proxy = hash->insert(math::rect(0, 0, 200, 200), 1);
+    hash->remove(proxy);
+
+    std::size_t found = 0;
+    hash->query(math::rect(0, 0, 200, 200), [&] (std::uint64_t) { ++found; });
+    test::equal(found, 0);
+    test::equal(hash->count(), 0);
+}
+
+TEST(spatial_hash_insert_keepsOversizedObjectsOutOfGrid)
+{
+    auto hash = std::make_unique<physics::spatial_hash<std::uint64_t, 16>>(32.f);
+    auto proxy = hash->insert(math::rect(0, 0, 1000, 1000), 1);
+    hash->insert(math::rect(10, 10, 10, 10), 2);
+    test::equal(hash->oversized_count(), 1);
+
+    std::vector<std::uint64_t> found;
+    hash->query(math::rect(0, 0, 40, 40), [&] (std::uint64_t object) { found.emplace_back(object); });
+    test::equal(found.size(), 2);
+
+    found.clear();
+    hash->query(math::rect(2000, 2000, 10, 10), [&] (std::uint64_t object) { found.emplace_back(object); });
+    test::equal(found.size(), 0);
+
+    test::is_true(hash->update(proxy, math::rect(500, 500, 10, 10)));
+    test::equal(hash->oversized_count(), 0);
+
+    hash->query(math::rect(500, 500, 10, 10), [&] (std::uint64_t object) { found.emplace_back(object); });
+    test::equal(found.size(), 1);
+}
+
+TEST(spatial_hash_insert_clampsHugeAndInvalidBounds)
+{
+    auto hash = std::make_unique<physics::spatial_hash<std::uint64_t, 16>>(32.f);
+    auto nan = std::numeric_limits<float>::quiet_NaN();
+    hash->insert(math::rect(-1e30f, -1e30f, 2e30f, 2e30f), 1);
+    auto invalid = hash->insert(math::rect(nan, nan, 10, 10), 2);
+    test::equal(hash->oversized_count(), 2);
+
+    std::size_t found = 0;
+    hash->query(math::rect(0, 0, 10, 10), [&] (std::uint64_t) { ++found; });
+    test::equal(found, 1);
+
+    found = 0;
+    hash->query(math::rect(-1e30f, -1e30f, 2e30f, 2e30f), [&] (std::uint64_t) { ++found; });
+    test::equal(found, 1);
+
+    hash->remove(invalid);
+    test::equal(hash->oversized_count(), 1);
+}
+
+TEST(spatial_hash_insert_fallsBackWhenLinksDepleted)
+{
+    auto hash = std::make_unique<physics::spatial_hash<std::uint64_t, 4, 4>>(10.f);
+    for (std::uint64_t n = 0; n < 4; ++n) {
+        hash->insert(math::rect(0, 0, 15, 5), n);
+    }
+    test::equal(hash->oversized_count(), 2);
+
+    std::size_t found = 0;
+    hash->query(math::rect(12, 0, 2, 2), [&] (std::uint64_t) { ++found; });
+    test::equal(found, 4);
+}
+
+// MARK: - Broadphase Benchmarks
+
+TEST(broadphase_quadTreeRebuild_1k)
+{
+    benchmark_quad_tree(1'000);
+}
+
+TEST(broadphase_quadTreeRebuild_10k)
+{
+    benchmark_quad_tree(10'000);
+}
+
+TEST(broadphase_quadTreeRebuild_50k)
+{
+    benchmark_quad_tree(50'000);
+}
+
+TEST(broadphase_spatialHashUpdate_1k)
+{
+    benchmark_spatial_hash(1'000);
+}
+
+TEST(broadphase_spatialHashUpdate_10k)
+{
+    benchmark_spatial_hash(10'000);
+}
+
+TEST(broadphase_spatialHashUpdate_50k)
+{
+    benchmark_spatial_hash(50'000);
+}
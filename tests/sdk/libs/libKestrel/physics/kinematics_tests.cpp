@@ -0,0 +1,100 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <cmath>
+#include <random>
+#include <libTesting/testing.hpp>
+#include <libKestrel/physics/kinematics.hpp>
+
+using namespace kestrel;
+
+// MARK: - Helpers
+
+namespace
+{
+    constexpr std::size_t kinematics_body_count = 10'000;
+    constexpr float kinematics_delta = 1.f / 60.f;
+
+    auto random_kinematics() -> physics::kinematics
+    {
+        std::mt19937 rng(kinematics_body_count);
+        std::uniform_real_distribution<float> value(-500.f, 500.f);
+        std::uniform_int_distribution<int> choice(0, 3);
+
+        physics::kinematics store(kinematics_body_count);
+        for (std::size_t n = 0; n < kinematics_body_count; ++n) {
+            store.position_x[n] = value(rng);
+            store.position_y[n] = value(rng);
+            store.velocity_x[n] = value(rng);
+            store.velocity_y[n] = value(rng);
+            store.rotation[n] = std::abs(value(rng)) / 500.f * 359.f;
+            store.rotation_speed[n] = value(rng);
+            store.rotation_action[n] = static_cast<float>(choice(rng) - 1);
+            store.active[n] = choice(rng) == 0 ? 0.f : 1.f;
+            store.speed[n] = std::abs(value(rng));
+            store.inertia[n] = choice(rng) < 2 ? 1 : 0;
+        }
+        return store;
+    }
+}
+
+// MARK: - Integration
+
+TEST(kinematics_batchedIntegration_matchesPerSlotIntegration)
+{
+    auto batched = random_kinematics();
+    auto reference = random_kinematics();
+
+    batched.integrate(0, batched.capacity(), kinematics_delta);
+    for (std::size_t n = 0; n < reference.capacity(); ++n) {
+        if (reference.active[n] != 0) {
+            reference.integrate(n, kinematics_delta);
+        }
+    }
+
+    for (std::size_t n = 0; n < batched.capacity(); ++n) {
+        test::equal(batched.position_x[n], reference.position_x[n]);
+        test::equal(batched.position_y[n], reference.position_y[n]);
+        test::equal(batched.velocity_x[n], reference.velocity_x[n]);
+        test::equal(batched.velocity_y[n], reference.velocity_y[n]);
+        test::equal(batched.rotation[n], reference.rotation[n]);
+    }
+}
+
+TEST(kinematics_perSlotIntegration_benchmark)
+{
+    auto store = random_kinematics();
+    test::measure([&] {
+        for (std::size_t n = 0; n < store.capacity(); ++n) {
+            if (store.active[n] != 0) {
+                store.integrate(n, kinematics_delta);
+            }
+        }
+    });
+}
+
+TEST(kinematics_batchedIntegration_benchmark)
+{
+    auto store = random_kinematics();
+    test::measure([&] {
+        store.integrate(0, store.capacity(), kinematics_delta);
+    });
+}
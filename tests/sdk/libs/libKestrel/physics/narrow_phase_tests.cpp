@@ -0,0 +1,152 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <libTesting/testing.hpp>
+#include <libKestrel/physics/hitbox.hpp>
+#include <libKestrel/physics/collisions.hpp>
+#include <libKestrel/math/polygon.hpp>
+#include <libKestrel/math/triangulated_polygon.hpp>
+
+using namespace kestrel;
+
+// MARK: - Helpers
+
+namespace
+{
+    constexpr std::size_t narrow_phase_body_count = 300;
+    constexpr float narrow_phase_area = 400.f;
+
+    auto octagon_hitbox(float radius) -> physics::hitbox
+    {
+        std::vector<math::point> vertices;
+        for (auto n = 0; n < 8; ++n) {
+            auto theta = static_cast<float>(n) * static_cast<float>(M_PI) / 4.f;
+            vertices.emplace_back(std::cos(theta) * radius, std::sin(theta) * radius);
+        }
+        return physics::hitbox(math::triangulated_polygon(math::polygon(vertices)));
+    }
+
+    auto narrow_phase_bodies() -> std::vector<physics::hitbox>
+    {
+        std::mt19937 rng(narrow_phase_body_count);
+        std::uniform_real_distribution<float> position(0, narrow_phase_area);
+
+        std::vector<physics::hitbox> bodies;
+        for (std::size_t n = 0; n < narrow_phase_body_count; ++n) {
+            auto hb = octagon_hitbox(20.f);
+            hb.set_scale_factor(math::size(1.5f));
+            hb.set_offset(math::point(position(rng), position(rng)));
+            bodies.emplace_back(std::move(hb));
+        }
+        return bodies;
+    }
+
+    // Reproduces the narrow phase from before scaled triangles were cached: both polygons are scaled and moved
+    // in to place for every test.
+    auto rescaling_collision_test(const physics::hitbox& a, const physics::hitbox& b) -> bool
+    {
+        auto reach = (a.broadphase_bounds().width() + b.broadphase_bounds().width()) / 2.f;
+        if (a.offset().distance_to(b.offset()) >= reach) {
+            return false;
+        }
+
+        auto pa = a.polygon() * a.scale_factor();
+        auto pb = b.polygon() * b.scale_factor();
+        for (auto i = 0; i < pa.triangle_count(); ++i) {
+            auto t1 = pa.triangle_at(i) - pa.center() + a.offset();
+            for (auto j = 0; j < pb.triangle_count(); ++j) {
+                auto t2 = pb.triangle_at(j) - pb.center() + b.offset();
+                if (physics::collisions::test(t1, t2)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+}
+
+// MARK: - Narrow Phase
+
+TEST(narrow_phase_cachedTriangles_matchRescaledTriangles)
+{
+    auto bodies = narrow_phase_bodies();
+    for (std::size_t i = 0; i < bodies.size(); ++i) {
+        for (std::size_t j = i + 1; j < bodies.size(); ++j) {
+            test::equal(bodies[i].collision_test(bodies[j]), rescaling_collision_test(bodies[i], bodies[j]));
+        }
+    }
+}
+
+TEST(narrow_phase_onlyPolygonHitboxesAreCollisionTestable)
+{
+    test::is_true(octagon_hitbox(20.f).is_collision_testable());
+    test::is_false(physics::hitbox(math::rect(math::point(0, 0), math::size(16, 16))).is_collision_testable());
+    test::is_false(physics::hitbox(math::vec2(0, 0), 8).is_collision_testable());
+    test::is_false(physics::hitbox().is_collision_testable());
+}
+
+TEST(narrow_phase_rectBounds_arePositionAndUnscaledSize)
+{
+    physics::hitbox hb(math::rect(math::point(0, 0), math::size(16, 8)));
+    hb.set_scale_factor(math::size(2.f));
+    hb.set_offset(math::point(100, 50));
+
+    test::equal(hb.bounds().x(), 100.f);
+    test::equal(hb.bounds().y(), 50.f);
+    test::equal(hb.bounds().width(), 16.f);
+    test::equal(hb.bounds().height(), 8.f);
+    test::equal(hb.broadphase_bounds().width(), 32.f);
+    test::equal(hb.broadphase_bounds().height(), 16.f);
+}
+
+TEST(narrow_phase_orderedPairsWithRescaling_benchmark)
+{
+    auto bodies = narrow_phase_bodies();
+    test::measure([&] {
+        std::size_t collisions = 0;
+        for (std::size_t i = 0; i < bodies.size(); ++i) {
+            for (std::size_t j = 0; j < bodies.size(); ++j) {
+                if (i != j && rescaling_collision_test(bodies[i], bodies[j])) {
+                    ++collisions;
+                }
+            }
+        }
+        test::is_true(collisions > 0);
+    });
+}
+
+TEST(narrow_phase_uniquePairsWithCachedTriangles_benchmark)
+{
+    auto bodies = narrow_phase_bodies();
+    test::measure([&] {
+        std::size_t collisions = 0;
+        for (std::size_t i = 0; i < bodies.size(); ++i) {
+            for (std::size_t j = i + 1; j < bodies.size(); ++j) {
+                if (bodies[i].collision_test(bodies[j])) {
+                    collisions += 2;
+                }
+            }
+        }
+        test::is_true(collisions > 0);
+    });
+}
@@ -0,0 +1,133 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <random>
+#include <algorithm>
+#include <libTesting/testing.hpp>
+#include <libKestrel/sound/codec/ima4.hpp>
+
+using namespace kestrel;
+
+// MARK: - Helpers
+
+namespace
+{
+    constexpr std::int8_t index_table[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+    constexpr std::int32_t steps[89] = {
+        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88,
+        97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658,
+        724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660,
+        4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818,
+        18500, 20350, 22385, 24623, 27086, 29794, 32767
+    };
+
+    /**
+     * A straightforward IMA ADPCM decoder, following the Apple IMA4 packet layout, to check the codec against.
+     */
+    auto reference_decode(const std::uint8_t *packet) -> std::vector<std::int16_t>
+    {
+        std::vector<std::int16_t> out;
+        std::uint16_t preamble = (packet[0] << 8) | packet[1];
+        std::int32_t predictor = static_cast<std::int16_t>(preamble & 0xFF80);
+        std::int32_t index = std::min(88, preamble & 0x7F);
+
+        for (auto i = 2; i < 34; ++i) {
+            for (auto nibble : { packet[i] & 0xF, packet[i] >> 4 }) {
+                auto step = steps[index];
+                auto diff = step >> 3;
+                if (nibble & 4) diff += step;
+                if (nibble & 2) diff += step >> 1;
+                if (nibble & 1) diff += step >> 2;
+                predictor = std::clamp(predictor + ((nibble & 8) ? -diff : diff), -32768, 32767);
+                index = std::clamp(index + index_table[nibble], 0, 88);
+                out.emplace_back(static_cast<std::int16_t>(predictor));
+            }
+        }
+        return out;
+    }
+
+    auto random_packets(std::size_t count, std::uint32_t seed) -> std::vector<std::uint8_t>
+    {
+        std::mt19937 rng(seed);
+        std::vector<std::uint8_t> data(count * sound::codec::ima4::bytes_per_packet);
+        for (auto& byte : data) {
+            byte = static_cast<std::uint8_t>(rng());
+        }
+        return data;
+    }
+}
+
+// MARK: - Packets
+
+TEST(sound_ima4_decodePacket_matchesReference)
+{
+    auto data = random_packets(64, 1);
+    std::vector<std::int16_t> out(sound::codec::ima4::frames_per_packet);
+
+    for (std::size_t n = 0; n < 64; ++n) {
+        auto packet = data.data() + n * sound::codec::ima4::bytes_per_packet;
+        sound::codec::ima4::decode_packet(packet, out.data());
+        test::is_true(out == reference_decode(packet));
+    }
+}
+
+TEST(sound_ima4_decodePacket_clampsOutOfRangeStepIndex)
+{
+    auto data = random_packets(1, 2);
+    data[1] = 0x7F;
+    std::vector<std::int16_t> out(sound::codec::ima4::frames_per_packet);
+
+    sound::codec::ima4::decode_packet(data.data(), out.data());
+
+    test::is_true(out == reference_decode(data.data()));
+}
+
+// MARK: - Items
+
+TEST(sound_ima4_decode_producesLinearPCMItem)
+{
+    auto data = random_packets(10, 3);
+    sound::codec::descriptor descriptor;
+    descriptor.sample_rate = 22050;
+    descriptor.channels = 1;
+    descriptor.packet_count = 10;
+
+    auto item = sound::codec::ima4::decode(descriptor, data.data(), data.size());
+
+    test::equal(item->buffer_size(), std::uint32_t(10 * 64 * 2));
+    test::equal(item->bit_width(), std::uint8_t(16));
+    test::equal(item->sample_rate(), std::uint32_t(22050));
+
+    auto samples = static_cast<const std::int16_t *>(item->internal_buffer_pointer());
+    auto expected = reference_decode(data.data() + 9 * 34);
+    test::is_true(std::equal(expected.begin(), expected.end(), samples + 9 * 64));
+}
+
+TEST(sound_ima4_decode_ignoresPacketsBeyondData)
+{
+    auto data = random_packets(4, 4);
+    sound::codec::descriptor descriptor;
+    descriptor.channels = 1;
+    descriptor.packet_count = 100;
+
+    auto item = sound::codec::ima4::decode(descriptor, data.data(), data.size() - 1);
+
+    test::equal(item->buffer_size(), std::uint32_t(3 * 64 * 2));
+}
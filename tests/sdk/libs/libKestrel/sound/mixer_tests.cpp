@@ -0,0 +1,284 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <random>
+#include <cstdio>
+#include <filesystem>
+#include <libTesting/testing.hpp>
+#include <libKestrel/sound/mixer/kernels.hpp>
+#include <libKestrel/sound/mixer/output.hpp>
+#include <libKestrel/sound/player/software_player.hpp>
+
+using namespace kestrel;
+
+// MARK: - Helpers
+
+namespace
+{
+    constexpr std::size_t kernel_test_length = 1027;
+
+    /**
+     * Keeps every frame that is written to it, so that the mixed audio can be inspected.
+     */
+    struct capture_output : public sound::mixer::output
+    {
+        std::vector<std::int16_t> samples;
+
+        auto write(const std::int16_t *data, std::size_t frames) -> void override
+        {
+            samples.insert(samples.end(), data, data + frames * 2);
+            m_frames_written += frames;
+        }
+    };
+
+    auto random_samples(std::size_t count, std::uint32_t seed, float range = 1.f) -> std::vector<float>
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> distribution(-range, range);
+        std::vector<float> samples(count);
+        for (auto& sample : samples) {
+            sample = distribution(rng);
+        }
+        return samples;
+    }
+
+    /**
+     * A 16-bit item holding the same value in every sample.
+     */
+    auto constant_item(std::int16_t value, std::size_t frames, std::uint32_t channels, std::uint32_t sample_rate) -> std::shared_ptr<sound::player_item>
+    {
+        sound::codec::descriptor descriptor;
+        descriptor.sample_rate = sample_rate;
+        descriptor.channels = channels;
+        descriptor.bit_width = 16;
+
+        auto size = static_cast<std::uint32_t>(frames * channels * sizeof(std::int16_t));
+        auto buffer = static_cast<std::int16_t *>(malloc(size));
+        std::fill_n(buffer, frames * channels, value);
+        return std::make_shared<sound::player_item>(descriptor, buffer, size);
+    }
+
+    auto capture(sound::software::player& player) -> capture_output *
+    {
+        auto output = std::make_unique<capture_output>();
+        auto result = output.get();
+        player.set_output(std::move(output));
+        return result;
+    }
+}
+
+// MARK: - Kernel Conformance
+
+TEST(sound_mixer_kernels_matchReference)
+{
+    const auto& reference = sound::mixer::reference_kernels();
+    const auto& native = sound::mixer::native_kernels();
+
+    auto mono = random_samples(kernel_test_length, 1);
+    auto stereo = random_samples(kernel_test_length * 2, 2);
+    auto bus = random_samples(kernel_test_length * 2, 3);
+
+    auto expected = bus;
+    auto actual = bus;
+    reference.mix_mono(expected.data(), mono.data(), kernel_test_length, 0.75f, 0.25f);
+    native.mix_mono(actual.data(), mono.data(), kernel_test_length, 0.75f, 0.25f);
+    reference.mix_stereo(expected.data(), stereo.data(), kernel_test_length, 0.5f, 1.5f);
+    native.mix_stereo(actual.data(), stereo.data(), kernel_test_length, 0.5f, 1.5f);
+
+    auto max_error = 0.f;
+    for (std::size_t n = 0; n < expected.size(); ++n) {
+        max_error = std::max(max_error, std::abs(expected[n] - actual[n]));
+    }
+    test::is_true(max_error < 1e-6f);
+}
+
+TEST(sound_mixer_kernels_conversionClampsAndMatchesReference)
+{
+    auto samples = random_samples(kernel_test_length, 4, 1.5f);
+    samples[0] = 1.f;
+    samples[1] = -1.f;
+    samples[2] = 2.f;
+    samples[3] = -2.f;
+
+    std::vector<std::int16_t> expected(samples.size());
+    std::vector<std::int16_t> actual(samples.size());
+    sound::mixer::reference_kernels().to_int16(expected.data(), samples.data(), samples.size());
+    sound::mixer::native_kernels().to_int16(actual.data(), samples.data(), samples.size());
+
+    test::is_true(expected == actual);
+    test::equal(expected[0], std::int16_t(32767));
+    test::equal(expected[1], std::int16_t(-32767));
+    test::equal(expected[2], std::int16_t(32767));
+    test::equal(expected[3], std::int16_t(-32767));
+}
+
+// MARK: - Mixing
+
+TEST(sound_softwarePlayer_monoItemIsMixedToBothChannels)
+{
+    sound::software::player player(22050);
+    auto output = capture(player);
+
+    player.play(constant_item(8192, 100, 1, 22050), [] {});
+    player.render(50);
+
+    test::equal(output->samples.size(), std::size_t(100));
+    test::equal(output->samples[0], std::int16_t(8192));
+    test::equal(output->samples[1], std::int16_t(8192));
+    test::equal(output->samples[99], std::int16_t(8192));
+}
+
+TEST(sound_softwarePlayer_resamplesToOutputRate)
+{
+    sound::software::player player(44100);
+    auto output = capture(player);
+
+    auto finished = false;
+    player.play(constant_item(4096, 1000, 2, 22050), [&] { finished = true; });
+    player.render(1900);
+    test::is_false(finished);
+
+    player.render(200);
+    test::is_true(finished);
+
+    // Twice as many frames at double the sample rate, plus one frame of interpolation delay.
+    std::size_t audible = 0;
+    for (std::size_t n = 0; n < output->samples.size(); n += 2) {
+        audible += (output->samples[n] == 4096) ? 1 : 0;
+    }
+    test::is_true(audible >= 1998 && audible <= 2002);
+}
+
+TEST(sound_softwarePlayer_sumsVoicesAndAppliesCategoryGain)
+{
+    sound::software::player player(22050);
+    auto output = capture(player);
+
+    auto music = constant_item(8192, 100, 1, 22050);
+    music->set_category(sound::category::music);
+    player.set_category_gain(sound::category::music, 0.5f);
+
+    player.play(constant_item(8192, 100, 1, 22050), [] {});
+    player.play(music, [] {});
+    player.render(10);
+
+    test::equal(output->samples[0], std::int16_t(8192 + 4096));
+}
+
+TEST(sound_softwarePlayer_stealsVoicesBeyondLimit)
+{
+    sound::software::player player(22050, 2);
+    capture(player);
+
+    auto finished = 0;
+    player.play(constant_item(100, 1000, 1, 22050), [&] { finished++; });
+    player.play(constant_item(100, 1000, 1, 22050), [&] { finished++; });
+    player.play(constant_item(100, 1000, 1, 22050), [&] { finished++; });
+    player.render(10);
+
+    test::equal(finished, 1);
+    test::equal(player.voices().active(), std::size_t(2));
+    test::equal(player.voices().stats().stolen, std::uint64_t(1));
+}
+
+TEST(sound_softwarePlayer_sessionPriorityOverridesSharedItem)
+{
+    sound::software::player player(22050, 1);
+    capture(player);
+
+    auto item = constant_item(100, 1000, 1, 22050);
+    auto high_finished = false;
+    auto low_finished = false;
+    player.play(item, 10, [&] { high_finished = true; });
+    player.play(item, sound::player_item::default_priority, [&] { low_finished = true; });
+    player.render(10);
+
+    // The lower priority session is rejected rather than stealing the voice, even though both share the item.
+    test::is_false(high_finished);
+    test::is_true(low_finished);
+    test::equal(player.voices().stats().stolen, std::uint64_t(0));
+}
+
+TEST(sound_softwarePlayer_stopSilencesItem)
+{
+    sound::software::player player(22050);
+    auto output = capture(player);
+
+    auto ref = player.play(constant_item(1000, 1000, 1, 22050), [] {});
+    player.render(10);
+    player.stop(ref);
+    player.render(10);
+
+    test::equal(output->samples[0], std::int16_t(1000));
+    test::equal(output->samples[39], std::int16_t(0));
+    test::equal(player.voices().active(), std::size_t(0));
+}
+
+// MARK: - Output
+
+TEST(sound_wavOutput_writesHeaderAndSamples)
+{
+    auto path = (std::filesystem::temp_directory_path() / "kestrel_wav_output_test.wav").string();
+    {
+        sound::software::player player(22050);
+        player.set_output(std::make_unique<sound::mixer::wav_output>(path, player.sample_rate()));
+        player.play(constant_item(1000, 300, 1, 22050), [] {});
+        player.render(500);
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::filesystem::remove(path);
+
+    auto u32 = [&] (std::size_t offset) -> std::uint32_t {
+        return static_cast<std::uint8_t>(bytes[offset])
+            | (static_cast<std::uint8_t>(bytes[offset + 1]) << 8)
+            | (static_cast<std::uint8_t>(bytes[offset + 2]) << 16)
+            | (static_cast<std::uint8_t>(bytes[offset + 3]) << 24);
+    };
+
+    test::equal(bytes.size(), std::size_t(44 + 500 * 4));
+    test::is_true(std::string(bytes.data(), 4) == "RIFF");
+    test::equal(u32(4), std::uint32_t(36 + 500 * 4));
+    test::equal(u32(24), std::uint32_t(22050));
+    test::equal(u32(40), std::uint32_t(500 * 4));
+    test::equal(static_cast<std::uint8_t>(bytes[44]) | (static_cast<std::uint8_t>(bytes[45]) << 8), 1000);
+}
+
+// MARK: - Benchmarks
+
+TEST(sound_softwarePlayer_mixing_benchmark)
+{
+    constexpr std::size_t voices = 32;
+    constexpr std::size_t seconds = 10;
+
+    for (auto kernels : { &sound::mixer::reference_kernels(), &sound::mixer::native_kernels() }) {
+        sound::software::player player(44100, voices);
+        player.set_kernels(*kernels);
+        for (std::size_t n = 0; n < voices; ++n) {
+            player.play(constant_item(static_cast<std::int16_t>(n * 10), 22050 * seconds, 1 + (n & 1), 22050), [] {});
+        }
+
+        test::measure([&] {
+            player.render(44100 * seconds);
+        });
+        test::equal(player.output()->frames_written(), std::uint64_t(44100 * seconds));
+    }
+}
@@ -0,0 +1,220 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <thread>
+#include <algorithm>
+#include <libTesting/testing.hpp>
+#include <libKestrel/sound/stream/stream.hpp>
+#include <libKestrel/sound/player/null_player.hpp>
+
+using namespace kestrel;
+
+// MARK: - Helpers
+
+namespace
+{
+    /**
+     * Produces a ramp of samples, 0, 1, 2, ..., so that the order in which they arrive can be checked.
+     */
+    struct ramp_decoder : public sound::decoder
+    {
+        std::size_t length { 0 };
+        std::size_t position { 0 };
+
+        explicit ramp_decoder(std::size_t length) : length(length) {}
+
+        [[nodiscard]] auto descriptor() const -> sound::codec::descriptor override
+        {
+            sound::codec::descriptor descriptor;
+            descriptor.sample_rate = 22050;
+            descriptor.channels = 2;
+            descriptor.bit_width = 16;
+            return descriptor;
+        }
+
+        auto read(std::int16_t *samples, std::size_t count) -> std::size_t override
+        {
+            // Decode in small, uneven blocks, as a real codec would.
+            count = std::min({ count, length - position, std::size_t(1000) });
+            for (std::size_t i = 0; i < count; ++i) {
+                samples[i] = static_cast<std::int16_t>((position + i) & 0x7FFF);
+            }
+            position += count;
+            return count;
+        }
+
+        auto rewind() -> void override
+        {
+            position = 0;
+        }
+    };
+
+    auto consume(sound::stream& stream, std::size_t& held) -> std::vector<std::int16_t>
+    {
+        std::vector<std::int16_t> out;
+        while (auto chunk = stream.acquire(true)) {
+            held = std::max<std::size_t>(held, chunk->samples.size());
+            auto samples = static_cast<const std::int16_t *>(chunk->data());
+            out.insert(out.end(), samples, samples + chunk->count);
+            stream.release(chunk);
+        }
+        return out;
+    }
+
+    auto make_ramp_item(std::size_t length) -> std::shared_ptr<sound::player_item>
+    {
+        ramp_decoder decoder(length);
+        return std::make_shared<sound::player_item>(decoder.descriptor(), [length] {
+            return std::make_unique<ramp_decoder>(length);
+        });
+    }
+
+    auto is_ramp(const std::vector<std::int16_t>& samples, std::size_t length) -> bool
+    {
+        if (samples.size() != length) {
+            return false;
+        }
+        for (std::size_t i = 0; i < length; ++i) {
+            if (samples[i] != static_cast<std::int16_t>(i & 0x7FFF)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+// MARK: - Stream
+
+TEST(sound_stream_deliversAllSamplesInOrder)
+{
+    const std::size_t length = 100003;
+    sound::stream stream(std::make_unique<ramp_decoder>(length), 4, 4096);
+    stream.start();
+
+    std::size_t held = 0;
+    auto samples = consume(stream, held);
+
+    test::is_true(is_ramp(samples, length));
+    test::is_true(stream.finished());
+    test::equal(stream.decoded_samples(), std::uint64_t(length));
+    test::is_true(held <= 4096);
+}
+
+TEST(sound_stream_chunksHoldWholeFrames)
+{
+    sound::stream stream(std::make_unique<ramp_decoder>(10000), 3, 4095);
+    stream.start();
+
+    auto chunk = stream.acquire(true);
+    test::is_true(chunk != nullptr);
+    test::equal(chunk->count % 2, std::size_t(0));
+    stream.release(chunk);
+    stream.stop();
+}
+
+TEST(sound_stream_restartBeginsFromTheStart)
+{
+    const std::size_t length = 50000;
+    sound::stream stream(std::make_unique<ramp_decoder>(length), 2, 2048);
+    std::size_t held = 0;
+
+    stream.start();
+    auto chunk = stream.acquire(true);
+    stream.release(chunk);
+    stream.start();
+
+    test::is_true(is_ramp(consume(stream, held), length));
+}
+
+TEST(sound_stream_stopWhileDecoderIsBlocked)
+{
+    sound::stream stream(std::make_unique<ramp_decoder>(1000000), 2, 1024);
+    stream.start();
+    stream.stop();
+
+    test::is_false(stream.finished());
+}
+
+// MARK: - Null Player
+
+TEST(sound_nullPlayer_playsStreamToCompletion)
+{
+    const std::size_t length = 70000;
+    auto item = make_ramp_item(length);
+    sound::null::player player;
+
+    auto finished_count = 0;
+    auto ref = player.play(item, [&] { finished_count++; });
+    auto session = player.playback_session(ref);
+
+    for (auto i = 0; i < 100000 && finished_count == 0; ++i) {
+        player.check_completion();
+        std::this_thread::yield();
+    }
+    player.check_completion();
+
+    test::equal(finished_count, 1);
+    test::equal(session->info.consumed_bytes, std::uint64_t(length * sizeof(std::int16_t)));
+}
+
+TEST(sound_nullPlayer_stopEndsStreamWithoutFinishing)
+{
+    auto item = make_ramp_item(1000000);
+    sound::null::player player;
+
+    auto finished_count = 0;
+    auto ref = player.play(item, [&] { finished_count++; });
+    auto session = player.playback_session(ref);
+    player.stop(ref);
+    player.check_completion();
+
+    test::equal(finished_count, 0);
+    test::is_true(session->finished_playing);
+    test::is_true(player.playback_sessions().empty());
+}
+
+TEST(sound_nullPlayer_overlappingSessionsOfOneItemPlayIndependently)
+{
+    const std::size_t length = 70000;
+    auto item = make_ramp_item(length);
+    sound::null::player player;
+
+    auto first_finished = 0;
+    auto second_finished = 0;
+    auto first = player.play(item, [&] { first_finished++; });
+    auto first_session = player.playback_session(first);
+    auto second = player.play(item, [&] { second_finished++; });
+    auto second_session = player.playback_session(second);
+    auto third = player.play(item, [] {});
+
+    test::is_true(first_session->stream != second_session->stream);
+
+    // Stopping one session must leave the streams of the others running.
+    player.stop(third);
+    for (auto i = 0; i < 100000 && (first_finished == 0 || second_finished == 0); ++i) {
+        player.check_completion();
+        std::this_thread::yield();
+    }
+    player.check_completion();
+
+    test::equal(first_finished, 1);
+    test::equal(second_finished, 1);
+    test::equal(first_session->info.consumed_bytes, std::uint64_t(length * sizeof(std::int16_t)));
+    test::equal(second_session->info.consumed_bytes, std::uint64_t(length * sizeof(std::int16_t)));
+}
@@ -0,0 +1,96 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <libTesting/testing.hpp>
+#include <libKestrel/sound/player/voice_pool.hpp>
+
+using namespace kestrel;
+
+// MARK: - Allocation
+
+TEST(sound_voicePool_acquire_usesFreeVoicesFirst)
+{
+    sound::voice_pool pool(2);
+
+    auto a = pool.acquire(1, 0);
+    auto b = pool.acquire(2, 0);
+
+    test::is_true(a.has_value());
+    test::is_true(b.has_value());
+    test::is_true(a->index != b->index);
+    test::equal(a->stolen_from, sound::playback_session_ref(0));
+    test::equal(b->stolen_from, sound::playback_session_ref(0));
+    test::equal(pool.active(), std::size_t(2));
+}
+
+TEST(sound_voicePool_acquire_stealsLowestPriorityVoice)
+{
+    sound::voice_pool pool(3);
+    pool.acquire(1, 5);
+    auto low = pool.acquire(2, 1);
+    pool.acquire(3, 5);
+
+    auto result = pool.acquire(4, 3);
+
+    test::is_true(result.has_value());
+    test::equal(result->stolen_from, sound::playback_session_ref(2));
+    test::equal(result->index, low->index);
+    test::equal(pool.owner(result->index), sound::playback_session_ref(4));
+    test::equal(pool.stats().stolen, std::uint64_t(1));
+}
+
+TEST(sound_voicePool_acquire_stealsOldestVoiceOfEqualPriority)
+{
+    sound::voice_pool pool(2);
+    auto oldest = pool.acquire(1, 0);
+    pool.acquire(2, 0);
+
+    auto result = pool.acquire(3, 0);
+
+    test::is_true(result.has_value());
+    test::equal(result->stolen_from, sound::playback_session_ref(1));
+    test::equal(result->index, oldest->index);
+}
+
+TEST(sound_voicePool_acquire_rejectsWhenAllVoicesHaveHigherPriority)
+{
+    sound::voice_pool pool(2);
+    pool.acquire(1, sound::player_item::music_priority);
+    pool.acquire(2, 10);
+
+    auto result = pool.acquire(3, 0);
+
+    test::is_false(result.has_value());
+    test::equal(pool.stats().rejected, std::uint64_t(1));
+    test::equal(pool.owner(0), sound::playback_session_ref(1));
+    test::equal(pool.owner(1), sound::playback_session_ref(2));
+}
+
+TEST(sound_voicePool_release_makesVoiceAvailable)
+{
+    sound::voice_pool pool(1);
+    auto a = pool.acquire(1, 10);
+    pool.release(a->index);
+
+    auto b = pool.acquire(2, 0);
+
+    test::is_true(b.has_value());
+    test::equal(b->stolen_from, sound::playback_session_ref(0));
+    test::equal(pool.active(), std::size_t(1));
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <libTesting/testing.hpp>
+#include <libKestrel/task/worker_pool.hpp>
+
+using namespace kestrel;
+
+// MARK: - Parallel For
+
+TEST(worker_pool_parallelFor_visitsEveryIndexOnce)
+{
+    task::worker_pool pool(4);
+    std::vector<std::uint32_t> visits(10'000, 0);
+    pool.parallel_for(visits.size(), 16, [&] (std::size_t, std::size_t begin, std::size_t end) {
+        for (auto n = begin; n < end; ++n) {
+            visits[n]++;
+        }
+    });
+
+    for (auto count : visits) {
+        test::equal(count, 1);
+    }
+}
+
+TEST(worker_pool_parallelFor_chunksAreContiguousAndOrdered)
+{
+    task::worker_pool pool(3);
+    std::vector<std::pair<std::size_t, std::size_t>> chunks(8);
+    pool.parallel_for(100, chunks.size(), [&] (std::size_t chunk, std::size_t begin, std::size_t end) {
+        chunks[chunk] = { begin, end };
+    });
+
+    std::size_t expected_begin = 0;
+    for (const auto& chunk : chunks) {
+        test::equal(chunk.first, expected_begin);
+        expected_begin = chunk.second;
+    }
+    test::equal(expected_begin, 100);
+}
+
+TEST(worker_pool_parallelFor_rethrowsChunkExceptions)
+{
+    task::worker_pool pool(2);
+    test::does_throw<std::runtime_error>([&] {
+        pool.parallel_for(10, 4, [] (std::size_t chunk, std::size_t, std::size_t) {
+            if (chunk == 2) {
+                throw std::runtime_error("chunk failed");
+            }
+        });
+    });
+}
+
+TEST(worker_pool_singleThread_runsOnCallingThread)
+{
+    task::worker_pool pool(1);
+    test::equal(pool.thread_count(), 1);
+
+    auto caller = std::this_thread::get_id();
+    pool.parallel_for(10, 4, [&] (std::size_t, std::size_t, std::size_t) {
+        test::is_true(std::this_thread::get_id() == caller);
+    });
+}
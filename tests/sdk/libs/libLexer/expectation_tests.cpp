@@ -20,45 +20,45 @@
 
 #include <vector>
 #include <libTesting/testing.hpp>
-#include <libKDL/lexer/expect/expectation.hpp>
+#include <libLexer/expect/expectation.hpp>
 
-using namespace kdl::lexer;
+using namespace lexer;
 
 // MARK: - Tests
 
 TEST(lexer_expectation_expectType_toBeTrue)
 {
-    expectation sut(lexeme::integer);
-    test::is_true(sut.be_true()(lexeme("0", lexeme::integer)));
+    expectation sut(integer);
+    test::is_true(sut.be_true()(lexeme("0", integer)));
 }
 
 TEST(lexer_expectation_expectType_toBeFalse)
 {
-    expectation sut(lexeme::integer);
-    test::is_true(sut.be_false()(lexeme("0", lexeme::string)));
+    expectation sut(integer);
+    test::is_true(sut.be_false()(lexeme("0", string)));
 }
 
 TEST(lexer_expectation_expectValue_toBeTrue)
 {
-    expectation sut("hello");
-    test::is_true(sut.be_true()(lexeme("hello", lexeme::string)));
+    expectation sut(std::string("hello"));
+    test::is_true(sut.be_true()(lexeme("hello", string)));
 }
 
 TEST(lexer_expectation_expectValue_toBeFalse)
 {
-    expectation sut("hello");
-    test::is_true(sut.be_false()(lexeme("0", lexeme::integer)));
+    expectation sut(std::string("hello"));
+    test::is_true(sut.be_false()(lexeme("0", integer)));
 }
 
 TEST(lexer_expectation_expectTypeAndValue_toBeTrue)
 {
-    expectation sut(lexeme::string, "hello");
-    test::is_true(sut.be_true()(lexeme("hello", lexeme::string)));
+    expectation sut(string, "hello");
+    test::is_true(sut.be_true()(lexeme("hello", string)));
 }
 
 TEST(lexer_expectation_expectTypeAndValue_toBeFalse)
 {
-    expectation sut(lexeme::directive, "hello");
-    test::is_true(sut.be_false()(lexeme("hello", lexeme::string)));
-    test::is_true(sut.be_false()(lexeme("0", lexeme::directive)));
+    expectation sut(keyword, "hello");
+    test::is_true(sut.be_false()(lexeme("hello", string)));
+    test::is_true(sut.be_false()(lexeme("0", keyword)));
 }
@@ -19,20 +19,23 @@
 // SOFTWARE.
 
 #include <libTesting/testing.hpp>
-#include <libKDL/lexer/lexeme_stream.hpp>
-#include <libKDL/exception/unexpected_lexeme_exception.hpp>
+#include <libFoundation/stream/stream.hpp>
+#include <libLexer/expect/expectation.hpp>
+#include <libLexer/exception/exception.hpp>
 
-using namespace kdl::lexer;
+using namespace lexer;
+
+typedef foundation::stream<lexeme> lexeme_stream;
 
 // MARK: - Helpers
 
 static auto lexeme_sequence_stub() -> std::vector<lexeme>
 {
     std::vector<lexeme> sequence;
-    sequence.emplace_back("type", lexeme::directive);
-    sequence.emplace_back("FooBar", lexeme::identifier);
-    sequence.emplace_back(":", lexeme::colon);
-    sequence.emplace_back("fubr", lexeme::string);
+    sequence.emplace_back("type", keyword);
+    sequence.emplace_back("FooBar", identifier);
+    sequence.emplace_back(":", colon);
+    sequence.emplace_back("fubr", string);
     return sequence;
 }
 
@@ -48,7 +51,7 @@ TEST(lexer_lexemeStream_constructedCorrectly)
 TEST(lexer_lexemeStream_returnsExpectedLexemeAtIndex)
 {
     lexeme_stream stream(lexeme_sequence_stub());
-    test::is_true(stream.at(2).is(lexeme::colon, ":"));
+    test::is_true(stream.at(2).is(colon, ":"));
 }
 
 TEST(lexer_lexemeStream_reportsExpectedFinishState)
@@ -77,34 +80,34 @@ TEST(lexer_lexemeStream_consumeAdvancesExpectedNumberOfLexemes_andReturnsExpecte
 {
     lexeme_stream stream(lexeme_sequence_stub());
 
-    test::is_true(stream.peek().is(lexeme::directive, "type"));
-    auto substream = stream.consume(expectation(lexeme::directive).be_true());
-    test::is_true(stream.peek().is(lexeme::identifier, "FooBar"));
+    test::is_true(stream.peek().is(keyword, "type"));
+    auto substream = stream.consume(expectation(keyword).be_true());
+    test::is_true(stream.peek().is(identifier, "FooBar"));
 
     test::equal(substream.size(), 1);
-    test::is_true(substream.peek().is(lexeme::directive, "type"));
+    test::is_true(substream.peek().is(keyword, "type"));
 }
 
 TEST(lexer_lexemeStream_advanceUpdatesCorrectly)
 {
     lexeme_stream stream(lexeme_sequence_stub());
-    test::is_true(stream.peek().is(lexeme::directive, "type"));
+    test::is_true(stream.peek().is(keyword, "type"));
 
     stream.advance();
-    test::is_true(stream.peek().is(lexeme::identifier, "FooBar"));
+    test::is_true(stream.peek().is(identifier, "FooBar"));
 
     stream.advance(2);
-    test::is_true(stream.peek().is(lexeme::string, "fubr"));
+    test::is_true(stream.peek().is(string, "fubr"));
 }
 
 TEST(lexer_lexemeStream_pushSingleLexeme_addsToTemporaryBuffer)
 {
     lexeme_stream stream(lexeme_sequence_stub());
-    test::is_true(stream.peek().is(lexeme::directive, "type"));
+    test::is_true(stream.peek().is(keyword, "type"));
 
     stream.push(lexeme(50));
-    test::is_true(stream.peek().is(lexeme::integer, "50"));
-    test::is_true(stream.peek(1).is(lexeme::directive, "type"));
+    test::is_true(stream.peek().is(integer, "50"));
+    test::is_true(stream.peek(1).is(keyword, "type"));
     test::equal(stream.size(), 4);
 }
 
@@ -112,11 +115,11 @@ TEST(lexer_lexemeStream_pushMultipleLexemes_overwritesTemporaryBuffer)
 {
     lexeme_stream stream(lexeme_sequence_stub());
     stream.push(lexeme(50));
-    test::is_true(stream.peek(0).is(lexeme::integer, "50"));
+    test::is_true(stream.peek(0).is(integer, "50"));
 
     stream.push({ lexeme(10), lexeme(20) });
-    test::is_true(stream.peek(0).is(lexeme::integer, "10"));
-    test::is_true(stream.peek(1).is(lexeme::integer, "20"));
+    test::is_true(stream.peek(0).is(integer, "10"));
+    test::is_true(stream.peek(1).is(integer, "20"));
 }
 
 TEST(lexer_lexemeStream_advanceClearsTemporaryBuffer)
@@ -124,12 +127,12 @@ TEST(lexer_lexemeStream_advanceClearsTemporaryBuffer)
     lexeme_stream stream(lexeme_sequence_stub());
 
     stream.push({ lexeme(10), lexeme(20) });
-    test::is_true(stream.peek(0).is(lexeme::integer, "10"));
-    test::is_true(stream.peek(1).is(lexeme::integer, "20"));
+    test::is_true(stream.peek(0).is(integer, "10"));
+    test::is_true(stream.peek(1).is(integer, "20"));
 
     stream.advance(1);
-    test::is_false(stream.peek(0).is(lexeme::integer, "10"));
-    test::is_false(stream.peek(1).is(lexeme::integer, "20"));
+    test::is_false(stream.peek(0).is(integer, "10"));
+    test::is_false(stream.peek(1).is(integer, "20"));
 }
 
 TEST(lexer_lexemeStream_clearPushedLexemesUpdatesCorrectly)
@@ -137,18 +140,18 @@ TEST(lexer_lexemeStream_clearPushedLexemesUpdatesCorrectly)
     lexeme_stream stream(lexeme_sequence_stub());
 
     stream.push({ lexeme(10), lexeme(20) });
-    test::is_true(stream.peek(0).is(lexeme::integer, "10"));
-    test::is_true(stream.peek(1).is(lexeme::integer, "20"));
+    test::is_true(stream.peek(0).is(integer, "10"));
+    test::is_true(stream.peek(1).is(integer, "20"));
 
-    stream.clear_pushed_lexemes();
-    test::is_false(stream.peek(0).is(lexeme::integer, "10"));
-    test::is_false(stream.peek(1).is(lexeme::integer, "20"));
+    stream.clear_pushed_items();
+    test::is_false(stream.peek(0).is(integer, "10"));
+    test::is_false(stream.peek(1).is(integer, "20"));
 }
 
 TEST(lexer_lexemeStream_peekReturnsExpectedLexeme)
 {
     lexeme_stream stream(lexeme_sequence_stub());
-    test::is_true(stream.peek().is(lexeme::directive, "type"));
+    test::is_true(stream.peek().is(keyword, "type"));
 }
 
 TEST(lexer_lexemeStream_peekReturnsExpectedLexeme_whenOffsetGiven)
@@ -156,23 +159,23 @@ TEST(lexer_lexemeStream_peekReturnsExpectedLexeme_whenOffsetGiven)
     lexeme_stream stream(lexeme_sequence_stub());
 
     stream.push({ lexeme(10), lexeme(20) });
-    test::is_true(stream.peek().is(lexeme::integer, "10"));
-    test::is_true(stream.peek(2).is(lexeme::directive, "type"));
-    test::is_true(stream.peek(3).is(lexeme::identifier, "FooBar"));
+    test::is_true(stream.peek().is(integer, "10"));
+    test::is_true(stream.peek(2).is(keyword, "type"));
+    test::is_true(stream.peek(3).is(identifier, "FooBar"));
 }
 
 TEST(lexer_lexemeStream_readReturnsExpectedLexeme)
 {
     lexeme_stream stream(lexeme_sequence_stub());
-    test::is_true(stream.read().is(lexeme::directive, "type"));
-    test::is_true(stream.read().is(lexeme::identifier, "FooBar"));
+    test::is_true(stream.read().is(keyword, "type"));
+    test::is_true(stream.read().is(identifier, "FooBar"));
 }
 
 TEST(lexer_lexemeStream_readReturnsExpectedLexeme_whenOffsetGiven)
 {
     lexeme_stream stream(lexeme_sequence_stub());
-    test::is_true(stream.read(2).is(lexeme::colon, ":"));
-    test::is_true(stream.read().is(lexeme::string, "fubr"));
+    test::is_true(stream.read(2).is(colon, ":"));
+    test::is_true(stream.read().is(string, "fubr"));
 }
 
 TEST(lexer_lexemeStream_expect_correctlyMatchesAgainstSequenceOfLexemes)
@@ -181,18 +184,18 @@ TEST(lexer_lexemeStream_expect_correctlyMatchesAgainstSequenceOfLexemes)
 
     // 1. Match the first lexeme, purely by type.
     test::is_true(stream.expect({
-        expectation(lexeme::directive).be_true()
+        expectation(keyword).be_true()
     }));
 
     // 2. Match the first two lexemes, purely by type.
     test::is_true(stream.expect({
-        expectation(lexeme::directive).be_true(),
-        expectation(lexeme::identifier).be_true()
+        expectation(keyword).be_true(),
+        expectation(identifier).be_true()
     }));
 
     // 3. Match the first lexeme by both type and string.
     test::is_true(stream.expect({
-        expectation(lexeme::directive, "type").be_true()
+        expectation(keyword, "type").be_true()
     }));
 }
 
@@ -202,13 +205,13 @@ TEST(lexer_lexemeStream_expect_correctlyRejectsAgainstSequenceOfLexemes)
 
     // 1. Reject with the first expectation, purely by type.
     test::is_false(stream.expect({
-        expectation(lexeme::identifier).be_true()
+        expectation(identifier).be_true()
     }));
 
     // 2. Reject on the last expectation, with the first being matched.
     test::is_false(stream.expect({
-        expectation(lexeme::directive).be_true(),
-        expectation(lexeme::integer).be_true()
+        expectation(keyword).be_true(),
+        expectation(integer).be_true()
     }));
 }
 
@@ -217,9 +220,9 @@ TEST(lexer_lexemeStream_expectAny_correctlyMatchesAgainstAnExpectation)
     lexeme_stream stream(lexeme_sequence_stub());
 
     test::is_true(stream.expect_any({
-        expectation(lexeme::directive, "color").be_true(),
-        expectation(lexeme::directive, "type").be_true(),
-        expectation(lexeme::string, "hello").be_true()
+        expectation(keyword, "color").be_true(),
+        expectation(keyword, "type").be_true(),
+        expectation(string, "hello").be_true()
     }));
 }
 
@@ -228,9 +231,9 @@ TEST(lexer_lexemeStream_expectAny_correctlyRejectsAgainstAllExpectations)
     lexeme_stream stream(lexeme_sequence_stub());
 
     test::is_false(stream.expect_any({
-        expectation(lexeme::directive, "color").be_true(),
-        expectation(lexeme::string, "type").be_true(),
-        expectation(lexeme::string, "hello").be_true()
+        expectation(keyword, "color").be_true(),
+        expectation(string, "type").be_true(),
+        expectation(string, "hello").be_true()
     }));
 }
 
@@ -240,7 +243,7 @@ TEST(lexer_lexemeStream_ensure_correctlyMatchesAgainstSequenceOfLexemes)
 
     test::does_not_throw([&] {
         stream.ensure({
-            expectation(lexeme::directive, "type").be_true()
+            expectation(keyword, "type").be_true()
         });
     });
 }
@@ -248,10 +251,13 @@ TEST(lexer_lexemeStream_ensure_correctlyMatchesAgainstSequenceOfLexemes)
 TEST(lexer_lexemeStream_ensure_correctlyRejectsAgainstSequenceOfLexemes_byThrowing)
 {
     lexeme_stream stream(lexeme_sequence_stub());
-    test::does_throw<kdl::unexpected_lexeme_exception>([&] {
-        stream.ensure({
-            expectation(lexeme::identifier, "type").be_true()
-        });
+    auto expect = expectation(identifier, "type").be_true();
+    expect.on_expectation_failure([] (const lexeme& lx) {
+        throw lexer::exception("Unexpected lexeme", lx);
+    });
+
+    test::does_throw<lexer::exception>([&] {
+        stream.ensure({ expect });
     });
 }
 
@@ -262,13 +268,13 @@ TEST(lexer_lexemeStream_insertLexemes_addsLexemesToStreamPermantly_atOffset)
 
     stream.insert(std::vector<lexeme>({ lexeme(20), lexeme(10) }), 0);
     test::equal(stream.size(), 6);
-    test::is_true(stream.peek().is(lexeme::integer, "20"));
-    test::is_true(stream.peek(1).is(lexeme::integer, "10"));
+    test::is_true(stream.peek().is(integer, "20"));
+    test::is_true(stream.peek(1).is(integer, "10"));
 
     stream.insert(std::vector<lexeme>({ lexeme(140), lexeme(190) }), 3);
     test::equal(stream.size(), 8);
-    test::is_true(stream.peek(3).is(lexeme::integer, "140"));
-    test::is_true(stream.peek(4).is(lexeme::integer, "190"));
+    test::is_true(stream.peek(3).is(integer, "140"));
+    test::is_true(stream.peek(4).is(integer, "190"));
 }
 
 TEST(lexer_lexemeStream_import_addsLexemesFromLexicalOutput_usingAnotherSourceFile)
@@ -0,0 +1,122 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <libTesting/testing.hpp>
+#include <libLexer/lexeme.hpp>
+
+using namespace lexer;
+
+// MARK: - Helpers
+
+static auto stub_owner_file() -> std::shared_ptr<foundation::filesystem::file>
+{
+    static std::shared_ptr<foundation::filesystem::file> stub;
+    if (!stub) {
+        stub = std::make_shared<foundation::filesystem::file>("/path/to/source.kdl", "example-contents");
+    }
+    return stub;
+}
+
+// MARK: - Tests
+
+TEST(lexer_lexeme_constructStringValueLexemeCorrectly)
+{
+    lexeme lx("example", string);
+    test::equal(lx.text(), "example");
+    test::equal(lx.type(), string);
+}
+
+TEST(lexer_lexeme_constructIntegerLexemeCorrectly)
+{
+    lexeme lx(50);
+    test::equal(lx.text(), "50");
+    test::equal(lx.type(), integer);
+}
+
+TEST(lexer_lexeme_constructEmptyLexemeCorrectly)
+{
+    lexeme lx;
+    test::equal(lx.text(), "");
+    test::equal(lx.type(), any);
+    test::equal(lx.line(), 0);
+}
+
+TEST(lexer_lexeme_constructBasicLexemeCorrectly)
+{
+    lexeme lx("example", identifier, 1, 2, 3, stub_owner_file());
+    test::equal(lx.text(), "example");
+    test::equal(lx.type(), identifier);
+    test::equal(lx.offset(), 2);
+    test::equal(lx.line(), 3);
+    test::equal(lx.source_directory().string(), "/path/to");
+}
+
+TEST(lexer_lexeme_reportsSourceLocationCorrectly)
+{
+    lexeme lx("example", identifier, 1, 2, 3, stub_owner_file());
+    test::equal(lx.location(), "/path/to/source.kdl:L3:2");
+}
+
+TEST(lexer_lexeme_isLexeme_reportsCorrectly)
+{
+    lexeme lx("example", identifier);
+    lexeme expected("example", identifier);
+    lexeme unexpected("foo", identifier);
+    lexeme unexpected2("example", percent);
+
+    test::is_true(lx.is(expected));
+    test::is_false(lx.is(unexpected));
+    test::is_false(lx.is(unexpected2));
+}
+
+TEST(lexer_lexeme_isLexemeType_reportsCorrectly)
+{
+    lexeme lx("example", identifier);
+    test::is_true(lx.is(identifier));
+    test::is_false(lx.is(hash));
+}
+
+TEST(lexer_lexeme_isLexemeString_reportsCorrectly)
+{
+    lexeme lx("example", identifier);
+    test::is_true(lx.is(std::string("example")));
+    test::is_false(lx.is(std::string("foo")));
+}
+
+TEST(lexer_lexeme_isLexemeTypeString_reportsCorrectly)
+{
+    lexeme lx("example", identifier);
+
+    test::is_true(lx.is(identifier, "example"));
+    test::is_false(lx.is(identifier, "foo"));
+    test::is_false(lx.is(string, "example"));
+}
+
+TEST(lexer_lexeme_reportsBasicTextCorrectly)
+{
+    lexeme lx("example", identifier);
+    test::equal(lx.text(), "example");
+}
+
+TEST(lexer_lexeme_reportsIntegerValueCorrectly)
+{
+    lexeme lx(128);
+    test::equal(lx.value<std::int32_t>(), 128);
+}
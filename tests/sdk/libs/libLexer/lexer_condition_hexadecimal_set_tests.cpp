@@ -19,9 +19,9 @@
 // SOFTWARE.
 
 #include <libTesting/testing.hpp>
-#include <libKDL/lexer/conditions/hexadecimal_set.hpp>
+#include <libLexer/conditions/hexadecimal_set.hpp>
 
-using namespace kdl::lexer::condition;
+using namespace lexer::condition;
 
 // MARK: - Tests
 
@@ -19,23 +19,26 @@
 // SOFTWARE.
 
 #include <libTesting/testing.hpp>
-#include <libKDL/lexer/conditions/match.hpp>
+#include <libLexer/conditions/identifier_set.hpp>
 
-using namespace kdl::lexer::condition;
+using namespace lexer::condition;
 
 // MARK: - Tests
 
 TEST(lexer_condition_identifierSet_limitedContainsDoesNotContainDecimalNumerals)
 {
-
+    test::is_true(identifier_set::limited_contains("_Identifier"));
+    test::is_false(identifier_set::limited_contains("0123456789"));
 }
 
 TEST(lexer_condition_identifierSet_containsDecimalNumerals)
 {
-
+    test::is_true(identifier_set::contains("identifier_0123456789"));
 }
 
 TEST(lexer_condition_identifierSet_doesNotContainUnexpectedCharacters)
 {
-
+    test::is_false(identifier_set::contains("identifier-name"));
+    test::is_false(identifier_set::contains("$#@!"));
+    test::is_false(identifier_set::limited_contains("name.value"));
 }
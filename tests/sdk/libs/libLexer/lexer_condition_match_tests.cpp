@@ -19,9 +19,9 @@
 // SOFTWARE.
 
 #include <libTesting/testing.hpp>
-#include <libKDL/lexer/conditions/match.hpp>
+#include <libLexer/conditions/match.hpp>
 
-using namespace kdl::lexer::condition;
+using namespace lexer::condition;
 
 // MARK: - Tests
 
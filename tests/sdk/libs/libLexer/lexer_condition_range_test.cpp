@@ -19,9 +19,9 @@
 // SOFTWARE.
 
 #include <libTesting/testing.hpp>
-#include <libKDL/lexer/conditions/range.hpp>
+#include <libLexer/conditions/range.hpp>
 
-using namespace kdl::lexer::condition;
+using namespace lexer::condition;
 
 // MARK: - Tests
 
@@ -19,9 +19,9 @@
 // SOFTWARE.
 
 #include <libTesting/testing.hpp>
-#include <libKDL/lexer/conditions/sequence.hpp>
+#include <libLexer/conditions/sequence.hpp>
 
-using namespace kdl::lexer::condition;
+using namespace lexer::condition;
 
 // MARK: - Tests
 
@@ -0,0 +1,127 @@
+// Copyright (c) 2023 Tom Hancocks
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <libTesting/testing.hpp>
+#include <libLexer/lexer.hpp>
+
+// MARK: - Helpers
+
+static auto generated_corpus(std::size_t declarations) -> std::string
+{
+    std::string corpus;
+    corpus.reserve(declarations * 160);
+    corpus += "/// A simple counter type.\n";
+    corpus += "type Counter : \"cntr\" {\n    template {\n        HWRD Value;\n        CSTR Name;\n    };\n};\n";
+
+    for (std::size_t n = 0; n < declarations; ++n) {
+        auto id = std::to_string(128 + n);
+        corpus += "declare Counter {\n";
+        corpus += "    new(#" + id + ", \"Counter " + id + "\") {\n";
+        corpus += "        Value = -" + id + ";\n";
+        corpus += "        Flags = 0x1F << 2 | Mask & (A + B * C / D) % 3;\n";
+        corpus += "    };\n};\n// Comment " + id + "\n";
+    }
+
+    return corpus;
+}
+
+static auto analyze(const std::shared_ptr<foundation::filesystem::file>& file) -> lexer::lexer::lexical_result
+{
+    lexer::lexer lx(file);
+    lx.add_keyword("declare");
+    return lx.analyze();
+}
+
+// MARK: - Tests
+
+TEST(lexer_analyze_identifiersShareInternedText)
+{
+    auto result = lexer::lexer("Foo Bar Foo").analyze();
+    auto first = result.read();
+    auto second = result.read();
+    auto third = result.read();
+
+    test::equal(first.text(), "Foo");
+    test::is_true(first.view().data() == third.view().data());
+    test::is_false(first.view().data() == second.view().data());
+    test::is_true(first.is(third));
+}
+
+TEST(lexer_analyze_literalsReferenceSourceContents)
+{
+    auto file = std::make_shared<foundation::filesystem::file>("source.kdl", "Name = \"Counter\"; Value = -42;");
+    auto result = analyze(file);
+    auto contents = file->contents();
+
+    result.advance(2);
+    auto string = result.read();
+    result.advance(3);
+    auto integer = result.read();
+
+    test::equal(string.text(), "Counter");
+    test::is_true(string.view().data() >= contents.data() && string.view().data() < contents.data() + contents.size());
+    test::equal(integer.text(), "-42");
+    test::equal(integer.value<std::int64_t>(), std::int64_t(-42));
+}
+
+TEST(lexer_analyze_lexemesOutliveLexerAndSource)
+{
+    lexer::lexer::lexical_result result;
+    {
+        auto file = std::make_shared<foundation::filesystem::file>("source.kdl", "Value = \"retained\";");
+        result = analyze(file);
+    }
+
+    result.advance(2);
+    test::equal(result.read().text(), "retained");
+}
+
+TEST(lexer_analyze_uppercaseHexPrefixIsNormalised)
+{
+    auto result = lexer::lexer("0X1F 0x2e").analyze();
+    auto upper = result.read();
+    auto lower = result.read();
+
+    test::equal(upper.text(), "0x1F");
+    test::equal(upper.value<std::int64_t>(), std::int64_t(0x1F));
+    test::equal(lower.text(), "0x2e");
+}
+
+TEST(lexer_analyze_keywordsAreRecognised)
+{
+    auto file = std::make_shared<foundation::filesystem::file>("source.kdl", "declare Counter");
+    auto result = analyze(file);
+
+    test::is_true(result.read().is(lexer::keyword, "declare"));
+    test::is_true(result.read().is(lexer::identifier, "Counter"));
+}
+
+TEST(lexer_analyze_largeCorpus_benchmark)
+{
+    constexpr std::size_t declarations = 20000;
+    auto file = std::make_shared<foundation::filesystem::file>("corpus.kdl", generated_corpus(declarations));
+
+    test::measure([&] {
+        auto result = analyze(file);
+
+        // Every declaration produces the same 39 lexemes, and the type definition 18 more.
+        test::equal(result.size(), declarations * 39 + 18);
+    });
+}